@@ -0,0 +1,113 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program for the bounded, multi-threaded and mini-batch kvs::KMeans.
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+#include <kvs/KMeans>
+#include <kvs/AnyValueTable>
+#include <kvs/ValueArray>
+#include <kvs/MersenneTwister>
+#include <kvs/Math>
+#include <kvs/Timer>
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the table of the points around the random centers.
+ *  @param  nrows [in] number of rows
+ *  @param  ncolumns [in] number of columns
+ *  @param  nclusters [in] number of clusters
+ *  @return table data
+ */
+/*===========================================================================*/
+kvs::AnyValueTable Blobs( const size_t nrows, const size_t ncolumns, const size_t nclusters )
+{
+    kvs::MersenneTwister random( 1 );
+    kvs::ValueArray<kvs::Real32> centers( nclusters * ncolumns );
+    for ( size_t i = 0; i < centers.size(); i++ ) { centers[i] = random() * 100.0f; }
+
+    std::vector<kvs::ValueArray<kvs::Real32>> columns( ncolumns );
+    for ( size_t j = 0; j < ncolumns; j++ ) { columns[j].allocate( nrows ); }
+    for ( size_t i = 0; i < nrows; i++ )
+    {
+        const size_t c = kvs::Math::Min( nclusters - 1, size_t( random() * nclusters ) );
+        for ( size_t j = 0; j < ncolumns; j++ )
+        {
+            // Approximately normal distribution by the sum of uniform numbers.
+            float r = 0.0f;
+            for ( size_t k = 0; k < 4; k++ ) { r += random(); }
+            columns[j][i] = centers[ c * ncolumns + j ] + ( r - 2.0f ) * 5.0f;
+        }
+    }
+
+    kvs::AnyValueTable table;
+    for ( size_t j = 0; j < ncolumns; j++ ) { table.pushBackColumn( columns[j] ); }
+    return table;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ *  @param  argc [i] argument counter
+ *  @param  argv [i] argument values
+ */
+/*===========================================================================*/
+int main( int argc, char** argv )
+{
+    const size_t nrows = argc > 1 ? std::atoi( argv[1] ) : 200000;
+    const size_t ncolumns = argc > 2 ? std::atoi( argv[2] ) : 8;
+    const size_t nclusters = argc > 3 ? std::atoi( argv[3] ) : 32;
+    const kvs::AnyValueTable table = Blobs( nrows, ncolumns, nclusters );
+
+    std::cout << "Rows: " << nrows << std::endl;
+    std::cout << "Columns: " << ncolumns << std::endl;
+    std::cout << "Clusters: " << nclusters << std::endl;
+    std::cout << std::setw( 24 ) << "mode"
+              << std::setw( 12 ) << "time [ms]"
+              << std::setw( 12 ) << "speedup"
+              << std::setw( 12 ) << "agreement" << std::endl;
+
+    // The cluster IDs are compared with the ones of the Lloyd's iterations.
+    kvs::ValueArray<kvs::UInt32> reference;
+    double reference_time = 0.0;
+    auto run = [&]( const std::string& mode, const bool mthreading, const bool bounded, const size_t batch_size )
+    {
+        kvs::KMeans kmeans;
+        kmeans.setSeedingMethod( kvs::KMeans::SmartSeeding );
+        kmeans.setSeed( 1 );
+        kmeans.setNumberOfClusters( nclusters );
+        kmeans.setInputTableData( table );
+        kmeans.setEnabledMultiThreading( mthreading );
+        kmeans.setBoundedAssignmentEnabled( bounded );
+        kmeans.setBatchSize( batch_size );
+
+        kvs::Timer timer( kvs::Timer::Start );
+        kmeans.run();
+        timer.stop();
+
+        const kvs::ValueArray<kvs::UInt32>& ids = kmeans.clusterIDs();
+        if ( reference.empty() ) { reference = ids.clone(); reference_time = timer.msec(); }
+
+        size_t nagreements = 0;
+        for ( size_t i = 0; i < ids.size(); i++ ) { if ( ids[i] == reference[i] ) { nagreements++; } }
+
+        std::cout << std::setw( 24 ) << mode
+                  << std::setw( 12 ) << timer.msec()
+                  << std::setw( 12 ) << reference_time / timer.msec()
+                  << std::setw( 12 ) << double( nagreements ) / ids.size() << std::endl;
+    };
+
+    run( "Lloyd", false, false, 0 );
+    run( "Lloyd (mthreading)", true, false, 0 );
+    run( "bounded", false, true, 0 );
+    run( "bounded (mthreading)", true, true, 0 );
+    run( "mini-batch", true, false, 1024 );
+
+    return 0;
+}
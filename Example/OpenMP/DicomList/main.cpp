@@ -0,0 +1,54 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program for reading the DICOM files in parallel.
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include <iostream>
+#include <kvs/DicomList>
+#include <kvs/StructuredVolumeImporter>
+#include <kvs/StructuredVolumeObject>
+#include <kvs/Timer>
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ *  @param  argc [i] argument counter
+ *  @param  argv [i] argument values
+ */
+/*===========================================================================*/
+int main( int argc, char** argv )
+{
+    if ( argc < 2 )
+    {
+        std::cerr << "Usage: " << argv[0] << " <directory of DICOM files>" << std::endl;
+        return 1;
+    }
+
+    // The DICOM files in the directory are read in parallel.
+    kvs::Timer timer( kvs::Timer::Start );
+    kvs::DicomList list;
+    list.enableMultiThreading();
+    list.read( argv[1] );
+    list.sort();
+    timer.stop();
+    if ( list.isFailure() )
+    {
+        std::cerr << "Cannot read " << argv[1] << "." << std::endl;
+        return 1;
+    }
+
+    std::cout << "Number of slices: " << list.size() << std::endl;
+    std::cout << "Reading time: " << timer.msec() << " [msec]" << std::endl;
+
+    // The slices are also copied into the volume in parallel.
+    kvs::StructuredVolumeImporter* volume = new kvs::StructuredVolumeImporter();
+    volume->enableMultiThreading();
+    volume->exec( &list );
+    volume->print( std::cout );
+    delete volume;
+
+    return 0;
+}
@@ -0,0 +1,47 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program for the multi-threaded kvs::ImageResampler.
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <kvs/ColorImage>
+#include <kvs/ImageResampler>
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ *  @param  argc [i] argument counter
+ *  @param  argv [i] argument values
+ */
+/*===========================================================================*/
+int main( int argc, char** argv )
+{
+    if ( argc < 2 )
+    {
+        std::cerr << "Usage: " << argv[0] << " <input image> [ratio] [output image]" << std::endl;
+        return 1;
+    }
+
+    const double ratio = argc > 2 ? std::atof( argv[2] ) : 0.5;
+    const std::string output = argc > 3 ? argv[3] : "output.bmp";
+
+    kvs::ColorImage image;
+    if ( !image.read( argv[1] ) )
+    {
+        std::cerr << "Cannot read " << argv[1] << "." << std::endl;
+        return 1;
+    }
+
+    // The image is resampled with the bicubic interpolation in parallel.
+    kvs::ImageResampler resampler( kvs::ImageResampler::Bicubic );
+    resampler.enableMultiThreading();
+    image.scale( ratio, resampler );
+
+    std::cout << "Resized image: " << image.width() << " x " << image.height() << std::endl;
+    return image.write( output ) ? 0 : 1;
+}
@@ -0,0 +1,47 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program for the multi-threaded kvs::LineIntegralConvolution.
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <kvs/StructuredVolumeObject>
+#include <kvs/LineIntegralConvolution>
+#include <kvs/TornadoVolumeData>
+#include <kvs/Timer>
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ *  @param  argc [i] argument counter
+ *  @param  argv [i] argument values
+ */
+/*===========================================================================*/
+int main( int argc, char** argv )
+{
+    const size_t dim = argc > 1 ? std::atoi( argv[1] ) : 64;
+    const double length = argc > 2 ? std::atof( argv[2] ) : 10.0;
+    auto* volume = new kvs::TornadoVolumeData( kvs::Vec3u( dim, dim, dim ) );
+
+    // The volume is convolved along the streamlines in parallel with the fast
+    // convolution, which shares the streamline traced from a node.
+    auto* filter = new kvs::LineIntegralConvolution();
+    filter->setLength( length );
+    filter->setEnabledMultiThreading( true );
+    filter->setFastConvolutionEnabled( true );
+
+    kvs::Timer timer( kvs::Timer::Start );
+    kvs::StructuredVolumeObject* object = filter->exec( volume );
+    timer.stop();
+
+    std::cout << "Stream length: " << length << std::endl;
+    std::cout << "Convolution time: " << timer.msec() << " [msec]" << std::endl;
+    object->print( std::cout );
+
+    delete object;
+    delete volume;
+    return 0;
+}
@@ -0,0 +1,52 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program for the multi-threaded kvs::PreIntegrationTable3D.
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <kvs/PreIntegrationTable3D>
+#include <kvs/TransferFunction>
+#include <kvs/OpacityMap>
+#include <kvs/Timer>
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ *  @param  argc [i] argument counter
+ *  @param  argv [i] argument values
+ */
+/*===========================================================================*/
+int main( int argc, char** argv )
+{
+    const size_t N = argc > 1 ? std::atoi( argv[1] ) : 128; // scalar resolution
+    const size_t D = argc > 2 ? std::atoi( argv[2] ) : 128; // depth resolution
+    const float max_size_of_cell = 2.0f;
+
+    kvs::TransferFunction tfunc( 256 );
+    kvs::OpacityMap omap( 256 );
+    omap.addPoint( 0.0f, 0.0f );
+    omap.addPoint( 0.3f, 0.8f );
+    omap.addPoint( 0.5f, 0.1f );
+    omap.addPoint( 1.0f, 1.0f );
+    omap.create();
+    tfunc.setOpacityMap( omap );
+
+    // The table is built with the summed-table integration in parallel.
+    kvs::PreIntegrationTable3D table( N, D );
+    table.setTransferFunction( tfunc, 0.0f, 1.0f );
+    table.setEnabledMultiThreading( true );
+
+    kvs::Timer timer( kvs::Timer::Start );
+    table.create( max_size_of_cell );
+    timer.stop();
+
+    std::cout << "Resolution: " << N << " x " << N << " x " << D << std::endl;
+    std::cout << "Number of entries: " << table.table().size() / 4 << std::endl;
+    std::cout << "Creation time: " << timer.msec() << " [msec]" << std::endl;
+
+    return 0;
+}
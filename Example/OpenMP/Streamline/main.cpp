@@ -0,0 +1,87 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program for the multi-threaded kvs::Streamline.
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <kvs/StructuredVolumeObject>
+#include <kvs/PointObject>
+#include <kvs/LineObject>
+#include <kvs/Streamline>
+#include <kvs/TornadoVolumeData>
+#include <kvs/MersenneTwister>
+#include <kvs/OpenMP>
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Traces the streamlines with the adaptive integrator.
+ *  @param  volume [in] pointer to the vector volume
+ *  @param  seeds [in] pointer to the seed points
+ *  @return pointer to the streamlines
+ */
+/*===========================================================================*/
+kvs::LineObject* Trace( const kvs::StructuredVolumeObject* volume, const kvs::PointObject* seeds )
+{
+    kvs::Streamline* mapper = new kvs::Streamline();
+    mapper->setSeedPoints( seeds );
+    mapper->setTransferFunction( kvs::TransferFunction( 256 ) );
+    mapper->setIntegrationMethod( kvs::Streamline::RungeKuttaFehlberg45 );
+    mapper->setIntegrationInterval( 0.5f );
+    mapper->setEnabledMultiThreading( true );
+    return mapper->exec( volume );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ *  @param  argc [i] argument counter
+ *  @param  argv [i] argument values
+ */
+/*===========================================================================*/
+int main( int argc, char** argv )
+{
+    const size_t dim = argc > 1 ? std::atoi( argv[1] ) : 32;
+    const size_t nseeds = argc > 2 ? std::atoi( argv[2] ) : 1000;
+    kvs::StructuredVolumeObject* volume = new kvs::TornadoVolumeData( kvs::Vec3u( dim, dim, dim ) );
+
+    // Random seed points in the volume.
+    kvs::MersenneTwister random( 1 );
+    kvs::ValueArray<kvs::Real32> coords( nseeds * 3 );
+    for ( size_t i = 0; i < coords.size(); i++ )
+    {
+        coords[i] = static_cast<kvs::Real32>( random() * ( dim - 1 ) );
+    }
+    kvs::PointObject* seeds = new kvs::PointObject;
+    seeds->setCoords( coords );
+
+    // The streamlines traced with any number of threads are the same as the
+    // ones traced with a single thread.
+    const int max_threads = kvs::OpenMP::GetMaxThreads();
+    kvs::OpenMP::SetNumberOfThreads( 1 );
+    kvs::LineObject* reference = Trace( volume, seeds );
+
+    bool identical = true;
+    for ( int nthreads = 2; nthreads <= max_threads; nthreads++ )
+    {
+        kvs::OpenMP::SetNumberOfThreads( nthreads );
+        kvs::LineObject* line = Trace( volume, seeds );
+        identical = identical &&
+            line->coords() == reference->coords() &&
+            line->connections() == reference->connections() &&
+            line->colors() == reference->colors();
+        delete line;
+    }
+
+    std::cout << "Number of vertices: " << reference->numberOfVertices() << std::endl;
+    std::cout << "Identical for 1 to " << kvs::Math::Max( 1, max_threads ) << " threads: "
+              << ( identical ? "yes" : "no" ) << std::endl;
+
+    delete reference;
+    delete seeds;
+    delete volume;
+    return identical ? 0 : 1;
+}
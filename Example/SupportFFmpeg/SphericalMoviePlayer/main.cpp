@@ -16,6 +16,7 @@ int main( int argc, char** argv )
     using Object = kvs::ffmpeg::MovieObject;
     using Renderer = kvs::ffmpeg::SphericalMovieRenderer;
     auto* object = new Object( argv[1] );
+    object->enableDecodeAhead(); // decode the frames on the background thread
     auto* renderer = new Renderer();
     screen.create();
     screen.scene()->mouse()->disableAutoUpdating();
@@ -27,7 +28,8 @@ int main( int argc, char** argv )
         {
             auto index = static_cast<kvs::UInt32>( object->currentFrameIndex() );
             auto frame = kvs::String::From( index, 6, '0' );
-            label.setText( "  Frame: " + frame );
+            auto missed = kvs::String::From( object->numberOfMissedFrames() );
+            label.setText( "  Frame: " + frame + " (missed: " + missed + ")" );
         } );
     label.show();
 
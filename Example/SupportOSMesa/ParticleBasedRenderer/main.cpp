@@ -0,0 +1,91 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program for the multi-threaded kvs::ParticleBasedRenderer class.
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cmath>
+#include <kvs/StructuredVolumeObject>
+#include <kvs/StructuredVolumeImporter>
+#include <kvs/HydrogenVolumeData>
+#include <kvs/PointObject>
+#include <kvs/CellByCellMetropolisSampling>
+#include <kvs/ParticleBasedRenderer>
+#include <kvs/TransferFunction>
+#include <kvs/ColorImage>
+#include <kvs/OpenMP>
+#include <kvs/Timer>
+#include <kvs/OffScreen>
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ *  @param  argc [i] argument counter
+ *  @param  argv [i] argument values
+ *  @return 0, if the process is done successfully.
+ */
+/*===========================================================================*/
+int main( int argc, char** argv )
+{
+    std::cout << "OSMesa version: " << kvs::osmesa::Version() << std::endl;
+
+    auto* volume = [&]() -> kvs::StructuredVolumeObject*
+    {
+        if ( argc > 1 ) return new kvs::StructuredVolumeImporter( std::string( argv[1] ) );
+        else return new kvs::HydrogenVolumeData( { 64, 64, 64 } );
+    }();
+
+    // Generate particles as point object.
+    const size_t repeat = 16; // number of repetitions
+    const float step = 0.5f; // sampling step
+    const auto tfunc = kvs::TransferFunction( 256 ); // transfer function
+    auto* object = new kvs::CellByCellMetropolisSampling( volume, repeat, step, tfunc );
+    delete volume;
+    std::cout << "Number of particles: " << object->numberOfVertices() << std::endl;
+
+    // Software based particle-based renderer with the multi-threading.
+    auto* renderer = new kvs::ParticleBasedRenderer();
+    renderer->setSubpixelLevel( size_t( std::sqrt( repeat ) ) );
+    renderer->enableMultiThreading();
+
+    kvs::OffScreen screen;
+    screen.setSize( 512, 512 );
+    screen.registerObject( object, renderer );
+
+    // Frames per second for each number of threads. Since the object turns
+    // around in the frames, the last images rendered with the threads are
+    // compared with the one rendered with a thread.
+    const size_t nframes = 12;
+    const int max_threads = kvs::Math::Max( 1, kvs::OpenMP::GetMaxThreads() );
+    kvs::ColorImage reference;
+    for ( int nthreads = 1; nthreads <= max_threads; nthreads *= 2 )
+    {
+        kvs::OpenMP::SetNumberOfThreads( nthreads );
+
+        bool identical = true;
+        kvs::Timer timer( kvs::Timer::Start );
+        for ( size_t i = 0; i < nframes; i++ )
+        {
+            object->multiplyXform( kvs::Xform::Rotation( kvs::Mat3::RotationY( 30 ) ) );
+            screen.draw();
+            if ( i == nframes - 1 )
+            {
+                const auto image = screen.capture();
+                if ( nthreads == 1 ) { reference = image; }
+                else { identical = ( image.pixels() == reference.pixels() ); }
+            }
+        }
+        timer.stop();
+
+        std::cout << "Threads: " << std::setw(3) << nthreads << ", ";
+        std::cout << "FPS: " << std::fixed << std::setprecision(2) << nframes / timer.sec() << ", ";
+        std::cout << "Image: " << ( identical ? "identical" : "different" ) << std::endl;
+    }
+
+    return 0;
+}
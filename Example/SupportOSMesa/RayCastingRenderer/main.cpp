@@ -0,0 +1,78 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program for the multi-threaded kvs::RayCastingRenderer class.
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <kvs/StructuredVolumeObject>
+#include <kvs/StructuredVolumeImporter>
+#include <kvs/HydrogenVolumeData>
+#include <kvs/RayCastingRenderer>
+#include <kvs/ColorImage>
+#include <kvs/OpenMP>
+#include <kvs/Timer>
+#include <kvs/OffScreen>
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ *  @param  argc [i] argument counter
+ *  @param  argv [i] argument values
+ *  @return 0, if the process is done successfully.
+ */
+/*===========================================================================*/
+int main( int argc, char** argv )
+{
+    std::cout << "OSMesa version: " << kvs::osmesa::Version() << std::endl;
+
+    auto* object = [&]() -> kvs::StructuredVolumeObject*
+    {
+        if ( argc > 1 ) return new kvs::StructuredVolumeImporter( std::string( argv[1] ) );
+        else return new kvs::HydrogenVolumeData( { 64, 64, 64 } );
+    }();
+
+    // Software based ray casting renderer with the multi-threading.
+    auto* renderer = new kvs::RayCastingRenderer();
+    renderer->enableMultiThreading();
+
+    kvs::OffScreen screen;
+    screen.setSize( 512, 512 );
+    screen.registerObject( object, renderer );
+
+    // Frames per second for each number of threads. Since the object turns
+    // around in the frames, the last images rendered with the threads are
+    // compared with the one rendered with a thread.
+    const size_t nframes = 12;
+    const int max_threads = kvs::Math::Max( 1, kvs::OpenMP::GetMaxThreads() );
+    kvs::ColorImage reference;
+    for ( int nthreads = 1; nthreads <= max_threads; nthreads *= 2 )
+    {
+        kvs::OpenMP::SetNumberOfThreads( nthreads );
+
+        bool identical = true;
+        kvs::Timer timer( kvs::Timer::Start );
+        for ( size_t i = 0; i < nframes; i++ )
+        {
+            object->multiplyXform( kvs::Xform::Rotation( kvs::Mat3::RotationY( 30 ) ) );
+            screen.draw();
+            if ( i == nframes - 1 )
+            {
+                const auto image = screen.capture();
+                if ( nthreads == 1 ) { reference = image; }
+                else { identical = ( image.pixels() == reference.pixels() ); }
+            }
+        }
+        timer.stop();
+
+        std::cout << "Threads: " << std::setw(3) << nthreads << ", ";
+        std::cout << "FPS: " << std::fixed << std::setprecision(2) << nframes / timer.sec() << ", ";
+        std::cout << "Image: " << ( identical ? "identical" : "different" ) << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,38 @@
+#include <kvs/python/Interpreter>
+#include <kvs/python/Module>
+#include <kvs/python/Dict>
+#include <kvs/python/Callable>
+#include <kvs/python/Tuple>
+#include <kvs/python/Volume>
+#include <kvs/StructuredVolumeObject>
+#include <kvs/HydrogenVolumeData>
+
+
+int main( int argc, char** argv )
+{
+    kvs::python::Interpreter intepreter;
+
+    const char* script_file_name = "volume"; // w/o '.py'
+    kvs::python::Module module( script_file_name );
+    kvs::python::Dict dict = module.dict();
+
+    const char* func_name = "main"; // function defined in 'volume.py'
+    kvs::python::Callable func( dict.find( func_name ) );
+
+    // The values of the volume are passed to the function without copying.
+    kvs::StructuredVolumeObject* volume = new kvs::HydrogenVolumeData( { 64, 64, 64 } );
+    volume->print( std::cout << "input volume:" << std::endl, kvs::Indent( 4 ) );
+
+    kvs::python::Tuple args( 1 );
+    args.set( 0, kvs::python::Volume( *volume ) );
+
+    kvs::python::Volume result = func.call( args );
+    volume->setResolution( result.resolution() );
+    volume->setVeclen( result.veclen() );
+    volume->setValues( result );
+    volume->updateMinMaxValues();
+    volume->print( std::cout << "output volume:" << std::endl, kvs::Indent( 4 ) );
+
+    delete volume;
+    return 0;
+}
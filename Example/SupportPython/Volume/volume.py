@@ -0,0 +1,5 @@
+import numpy as np
+
+def main( volume ):
+    print( volume.shape, volume.dtype )
+    return np.sqrt( volume.astype( np.float32 ) )
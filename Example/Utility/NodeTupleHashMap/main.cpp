@@ -0,0 +1,69 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program for kvs::NodeTupleHashMap class.
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include <iostream>
+#include <kvs/NodeTupleHashMap>
+#include <kvs/Type>
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ */
+/*===========================================================================*/
+int main()
+{
+    // Two tetrahedral cells sharing the face (1,2,3).
+    const size_t ncells = 2;
+    const kvs::UInt32 connections[] = {
+        0, 1, 2, 3,
+        4, 3, 2, 1 };
+
+    // Faces of the tetrahedral cell as the local node IDs.
+    const size_t faces[4][3] = {
+        { 0, 1, 2 }, { 0, 1, 3 }, { 0, 2, 3 }, { 1, 2, 3 } };
+
+    // Count the number of the cells referring to each face. The face is
+    // identified by the three node IDs regardless of their order.
+    kvs::NodeTupleHashMap<3,kvs::UInt32> face_map( 4 * ncells );
+    for ( size_t cell = 0; cell < ncells; cell++ )
+    {
+        const kvs::UInt32* id = connections + 4 * cell;
+        for ( size_t f = 0; f < 4; f++ )
+        {
+            const kvs::NodeTupleHashMap<3,kvs::UInt32>::Key key = {
+                id[ faces[f][0] ], id[ faces[f][1] ], id[ faces[f][2] ] };
+            const auto result = face_map.insert( key, 1 );
+            if ( !result.second ) { face_map.value( result.first )++; }
+        }
+    }
+
+    // The entries are stored in the order of the first insertion.
+    std::cout << "Number of faces: " << face_map.size() << std::endl;
+    for ( size_t index = 0; index < face_map.size(); index++ )
+    {
+        const auto& key = face_map.key( index );
+        std::cout << "    (" << key[0] << ", " << key[1] << ", " << key[2] << ") : "
+                  << ( face_map.value( index ) > 1 ? "shared" : "external" ) << std::endl;
+    }
+
+    // The face can be looked up with the node IDs in any order. The size
+    // of the map is returned if the face is not found.
+    const size_t index = face_map.find( { 3, 1, 2 } );
+    if ( index < face_map.size() )
+    {
+        std::cout << "Face (3, 1, 2) is referred by "
+                  << face_map.value( index ) << " cells." << std::endl;
+    }
+
+    if ( face_map.find( { 0, 1, 4 } ) == face_map.size() )
+    {
+        std::cout << "Face (0, 1, 4) is not found." << std::endl;
+    }
+
+    return 0;
+}
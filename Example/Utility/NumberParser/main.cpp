@@ -0,0 +1,137 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program for kvs::NumberParser class.
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <kvs/NumberParser>
+#include <kvs/MersenneTwister>
+#include <kvs/OpenMP>
+#include <kvs/Timer>
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Creates a text of the random numbers.
+ *  @param  nvalues [in] number of values
+ *  @param  integer [in] if true, the values are written as integers
+ *  @return text of the numbers separated by spaces and linefeeds
+ */
+/*===========================================================================*/
+std::string CreateText( const size_t nvalues, const bool integer )
+{
+    kvs::MersenneTwister random;
+    std::string text;
+    char buffer[64];
+    for ( size_t i = 0; i < nvalues; i++ )
+    {
+        const char* const separator = ( i % 3 == 2 ) ? "\n" : " ";
+        if ( integer ) { std::sprintf( buffer, "%d%s", int( random() * 1.0e7 ), separator ); }
+        else { std::sprintf( buffer, "%.7e%s", ( random() - 0.5 ) * 2.0e3, separator ); }
+        text += buffer;
+    }
+    return text;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Prints the parsing throughput.
+ *  @param  name [in] method name
+ *  @param  bytes [in] text size in bytes
+ *  @param  msec [in] elapsed time in msec
+ *  @param  nerrors [in] number of values different from atof
+ */
+/*===========================================================================*/
+void Print( const std::string& name, const size_t bytes, const double msec, const size_t nerrors )
+{
+    const double mb = bytes / 1024.0 / 1024.0;
+    std::cout << "    " << name << ": " << msec << " [msec], " << mb / ( msec / 1000.0 ) << " [MB/s]";
+    if ( nerrors > 0 ) { std::cout << " (" << nerrors << " values differ)"; }
+    std::cout << std::endl;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Measures the throughput of parsing the text.
+ *  @param  text [in] text of the numbers
+ *  @param  nvalues [in] number of values
+ */
+/*===========================================================================*/
+template <typename T>
+void Measure( const std::string& text, const size_t nvalues )
+{
+    kvs::Timer timer;
+
+    // strtok + atof (reference)
+    std::vector<T> reference( nvalues, T(0) );
+    {
+        std::vector<char> buffer( text.begin(), text.end() );
+        buffer.push_back( '\0' );
+        timer.start();
+        const char* delim = " ,\t\n";
+        char* value = strtok( buffer.data(), delim );
+        for ( size_t i = 0; i < nvalues && value; i++ )
+        {
+            reference[i] = static_cast<T>( atof( value ) );
+            value = strtok( 0, delim );
+        }
+        timer.stop();
+        Print( "strtok + atof", text.size(), timer.msec(), 0 );
+    }
+
+    // std::istringstream
+    {
+        std::vector<T> values( nvalues, T(0) );
+        timer.start();
+        std::istringstream stream( text );
+        for ( size_t i = 0; i < nvalues; i++ ) { stream >> values[i]; }
+        timer.stop();
+        size_t nerrors = 0;
+        for ( size_t i = 0; i < nvalues; i++ ) { if ( values[i] != reference[i] ) { nerrors++; } }
+        Print( "std::istringstream", text.size(), timer.msec(), nerrors );
+    }
+
+    // kvs::NumberParser
+    {
+        std::vector<T> values( nvalues, T(0) );
+        timer.start();
+        kvs::NumberParser::ParseArray( text.data(), text.data() + text.size(), values.data(), nvalues );
+        timer.stop();
+        size_t nerrors = 0;
+        for ( size_t i = 0; i < nvalues; i++ ) { if ( values[i] != reference[i] ) { nerrors++; } }
+        Print( "kvs::NumberParser", text.size(), timer.msec(), nerrors );
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ *  @param  argc [i] argument counter
+ *  @param  argv [i] argument values
+ */
+/*===========================================================================*/
+int main( int argc, char** argv )
+{
+    const size_t nvalues = argc > 1 ? std::atoi( argv[1] ) : 10000000;
+    std::cout << "Number of values: " << nvalues << std::endl;
+    std::cout << "Number of threads: " << kvs::OpenMP::GetMaxThreads() << std::endl;
+    std::cout << std::endl;
+
+    const std::string reals = CreateText( nvalues, false );
+    std::cout << "Real numbers (" << reals.size() / 1024 / 1024 << " [MB])" << std::endl;
+    Measure<kvs::Real32>( reals, nvalues );
+
+    const std::string integers = CreateText( nvalues, true );
+    std::cout << "Integer numbers (" << integers.size() / 1024 / 1024 << " [MB])" << std::endl;
+    Measure<kvs::Int32>( integers, nvalues );
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program for the adaptive integration of kvs::Streamline.
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include <iostream>
+#include <kvs/Application>
+#include <kvs/Screen>
+#include <kvs/StructuredVolumeObject>
+#include <kvs/StructuredVolumeImporter>
+#include <kvs/PointObject>
+#include <kvs/Streamline>
+#include <kvs/TornadoVolumeData>
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ *  @param  argc [i] argument counter
+ *  @param  argv [i] argument values
+ */
+/*===========================================================================*/
+int main( int argc, char** argv )
+{
+    kvs::Application app( argc, argv );
+    kvs::Screen screen( &app );
+    screen.setTitle( "kvs::Streamline (Runge-Kutta-Fehlberg 4(5))" );
+    screen.create();
+
+    // Import volume data as structured volume object.
+    auto* volume = [&]() -> kvs::StructuredVolumeObject*
+    {
+        if ( argc > 1 ) return new kvs::StructuredVolumeImporter( argv[1] );
+        else return new kvs::TornadoVolumeData( { 32, 32, 32 } );
+    }();
+
+    // Generate seed points as point object.
+    const kvs::Vec3i min_coord( 15, 15,  0 );
+    const kvs::Vec3i max_coord( 20, 20, 30 );
+    auto* point = new kvs::PointObject;
+    point->setCoords( [&]
+    {
+        std::vector<kvs::Real32> v;
+        for ( int k = min_coord.z(); k < max_coord.z(); k++ )
+        {
+            for ( int j = min_coord.y(); j < max_coord.y(); j++ )
+            {
+                for ( int i = min_coord.x(); i < max_coord.x(); i++ )
+                {
+                    v.push_back( static_cast<kvs::Real32>(i) );
+                    v.push_back( static_cast<kvs::Real32>(j) );
+                    v.push_back( static_cast<kvs::Real32>(k) );
+                }
+            }
+        }
+        return kvs::ValueArray<kvs::Real32>( v );
+    } () );
+
+    // Generate streamlines with the adaptive step size control.
+    auto* object = new kvs::Streamline();
+    object->setSeedPoints( point );
+    object->setIntegrationMethod( kvs::Streamline::RungeKuttaFehlberg45 );
+    object->setIntegrationTolerance( 1.0e-4f );
+    object->setTransferFunction( kvs::TransferFunction( 256 ) );
+    object->exec( volume );
+    delete point;
+    delete volume;
+
+    object->print( std::cout );
+
+    screen.registerObject( object );
+
+    return app.run();
+}
@@ -0,0 +1,69 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program for kvs::MinMaxMacroCells class.
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include <iostream>
+#include <iomanip>
+#include <kvs/StructuredVolumeObject>
+#include <kvs/PolygonObject>
+#include <kvs/MarchingCubes>
+#include <kvs/MinMaxMacroCells>
+#include <kvs/HydrogenVolumeData>
+#include <kvs/Timer>
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ *  @param  argc [i] argument counter
+ *  @param  argv [i] argument values
+ */
+/*===========================================================================*/
+int main( int argc, char** argv )
+{
+    const size_t dim = argc > 1 ? std::atoi( argv[1] ) : 128;
+    const kvs::Vec3u resolution( dim, dim, dim );
+    kvs::StructuredVolumeObject* volume = new kvs::HydrogenVolumeData( resolution );
+    volume->updateMinMaxValues();
+
+    // The macro-cells are built once and cached on the volume object.
+    kvs::Timer timer( kvs::Timer::Start );
+    const kvs::MinMaxMacroCells& macro_cells = volume->macroCells();
+    timer.stop();
+    std::cout << "Resolution: " << resolution << std::endl;
+    std::cout << "Macro-cells: " << macro_cells.resolution() << " (" << macro_cells.numberOfBlocks() << " blocks)" << std::endl;
+    std::cout << "Build time: " << timer.msec() << " [msec]" << std::endl;
+    std::cout << std::endl;
+
+    // Extraction time vs. isovalue selectivity (ratio of the active macro-cells).
+    const double min_value = volume->minValue();
+    const double max_value = volume->maxValue();
+    const size_t nsteps = 10;
+    std::cout << std::setw( 12 ) << "isovalue"
+              << std::setw( 12 ) << "active [%]"
+              << std::setw( 12 ) << "triangles"
+              << std::setw( 12 ) << "time [ms]" << std::endl;
+    for ( size_t i = 0; i < nsteps; ++i )
+    {
+        const double isovalue = min_value + ( max_value - min_value ) * ( i + 0.5 ) / nsteps;
+        const size_t nactives = macro_cells.numberOfActiveBlocks( isovalue );
+        const double selectivity = 100.0 * nactives / macro_cells.numberOfBlocks();
+
+        kvs::TransferFunction tfunc( 256 );
+        timer.start();
+        kvs::PolygonObject* object = new kvs::MarchingCubes( volume, isovalue, kvs::PolygonObject::VertexNormal, false, tfunc );
+        timer.stop();
+
+        std::cout << std::setw( 12 ) << isovalue
+                  << std::setw( 12 ) << selectivity
+                  << std::setw( 12 ) << object->numberOfConnections()
+                  << std::setw( 12 ) << timer.msec() << std::endl;
+        delete object;
+    }
+
+    delete volume;
+    return 0;
+}
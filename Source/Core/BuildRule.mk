@@ -134,6 +134,7 @@ $(OUTDIR)/./Image/HCLColor.o \
 $(OUTDIR)/./Image/HSLColor.o \
 $(OUTDIR)/./Image/HSVColor.o \
 $(OUTDIR)/./Image/ImageBase.o \
+$(OUTDIR)/./Image/ImageResampler.o \
 $(OUTDIR)/./Image/LabColor.o \
 $(OUTDIR)/./Image/MshColor.o \
 $(OUTDIR)/./Image/RGBAColor.o \
@@ -232,8 +233,10 @@ $(OUTDIR)/./Utility/Date.o \
 $(OUTDIR)/./Utility/Directory.o \
 $(OUTDIR)/./Utility/File.o \
 $(OUTDIR)/./Utility/Indent.o \
+$(OUTDIR)/./Utility/MappedFile.o \
 $(OUTDIR)/./Utility/MemoryTracer.o \
 $(OUTDIR)/./Utility/Message.o \
+$(OUTDIR)/./Utility/NumberParser.o \
 $(OUTDIR)/./Utility/Program.o \
 $(OUTDIR)/./Utility/Range.o \
 $(OUTDIR)/./Utility/Rectangle.o \
@@ -318,6 +321,7 @@ $(OUTDIR)/./Visualization/Mapper/MarchingPyramidTable.o \
 $(OUTDIR)/./Visualization/Mapper/MarchingTetrahedra.o \
 $(OUTDIR)/./Visualization/Mapper/MarchingTetrahedraTable.o \
 $(OUTDIR)/./Visualization/Mapper/MetropolisSampling.o \
+$(OUTDIR)/./Visualization/Mapper/MinMaxMacroCells.o \
 $(OUTDIR)/./Visualization/Mapper/OpacityMap.o \
 $(OUTDIR)/./Visualization/Mapper/OrthoSlice.o \
 $(OUTDIR)/./Visualization/Mapper/PrismaticCell.o \
@@ -335,6 +339,7 @@ $(OUTDIR)/./Visualization/Mapper/UniformGrid.o \
 $(OUTDIR)/./Visualization/Object/GeometryObjectBase.o \
 $(OUTDIR)/./Visualization/Object/ImageObject.o \
 $(OUTDIR)/./Visualization/Object/LineObject.o \
+$(OUTDIR)/./Visualization/Object/NodeToCellConnectivity.o \
 $(OUTDIR)/./Visualization/Object/ObjectBase.o \
 $(OUTDIR)/./Visualization/Object/PointObject.o \
 $(OUTDIR)/./Visualization/Object/PolygonGlyphObject.o \
@@ -346,6 +351,7 @@ $(OUTDIR)/./Visualization/Object/TexturedPolygonObject.o \
 $(OUTDIR)/./Visualization/Object/UnstructuredVolumeObject.o \
 $(OUTDIR)/./Visualization/Object/VolumeObjectBase.o \
 $(OUTDIR)/./Visualization/Pipeline/ObjectImporter.o \
+$(OUTDIR)/./Visualization/Pipeline/PipelineCache.o \
 $(OUTDIR)/./Visualization/Pipeline/PipelineModule.o \
 $(OUTDIR)/./Visualization/Pipeline/VisualizationPipeline.o \
 $(OUTDIR)/./Visualization/Renderer/ArrowGlyph.o \
@@ -134,6 +134,7 @@ $(OUTDIR)\.\Image\HCLColor.obj \
 $(OUTDIR)\.\Image\HSLColor.obj \
 $(OUTDIR)\.\Image\HSVColor.obj \
 $(OUTDIR)\.\Image\ImageBase.obj \
+$(OUTDIR)\.\Image\ImageResampler.obj \
 $(OUTDIR)\.\Image\LabColor.obj \
 $(OUTDIR)\.\Image\MshColor.obj \
 $(OUTDIR)\.\Image\RGBAColor.obj \
@@ -232,8 +233,10 @@ $(OUTDIR)\.\Utility\Date.obj \
 $(OUTDIR)\.\Utility\Directory.obj \
 $(OUTDIR)\.\Utility\File.obj \
 $(OUTDIR)\.\Utility\Indent.obj \
+$(OUTDIR)\.\Utility\MappedFile.obj \
 $(OUTDIR)\.\Utility\MemoryTracer.obj \
 $(OUTDIR)\.\Utility\Message.obj \
+$(OUTDIR)\.\Utility\NumberParser.obj \
 $(OUTDIR)\.\Utility\Program.obj \
 $(OUTDIR)\.\Utility\Range.obj \
 $(OUTDIR)\.\Utility\Rectangle.obj \
@@ -318,6 +321,7 @@ $(OUTDIR)\.\Visualization\Mapper\MarchingPyramidTable.obj \
 $(OUTDIR)\.\Visualization\Mapper\MarchingTetrahedra.obj \
 $(OUTDIR)\.\Visualization\Mapper\MarchingTetrahedraTable.obj \
 $(OUTDIR)\.\Visualization\Mapper\MetropolisSampling.obj \
+$(OUTDIR)\.\Visualization\Mapper\MinMaxMacroCells.obj \
 $(OUTDIR)\.\Visualization\Mapper\OpacityMap.obj \
 $(OUTDIR)\.\Visualization\Mapper\OrthoSlice.obj \
 $(OUTDIR)\.\Visualization\Mapper\PrismaticCell.obj \
@@ -335,6 +339,7 @@ $(OUTDIR)\.\Visualization\Mapper\UniformGrid.obj \
 $(OUTDIR)\.\Visualization\Object\GeometryObjectBase.obj \
 $(OUTDIR)\.\Visualization\Object\ImageObject.obj \
 $(OUTDIR)\.\Visualization\Object\LineObject.obj \
+$(OUTDIR)\.\Visualization\Object\NodeToCellConnectivity.obj \
 $(OUTDIR)\.\Visualization\Object\ObjectBase.obj \
 $(OUTDIR)\.\Visualization\Object\PointObject.obj \
 $(OUTDIR)\.\Visualization\Object\PolygonGlyphObject.obj \
@@ -346,6 +351,7 @@ $(OUTDIR)\.\Visualization\Object\TexturedPolygonObject.obj \
 $(OUTDIR)\.\Visualization\Object\UnstructuredVolumeObject.obj \
 $(OUTDIR)\.\Visualization\Object\VolumeObjectBase.obj \
 $(OUTDIR)\.\Visualization\Pipeline\ObjectImporter.obj \
+$(OUTDIR)\.\Visualization\Pipeline\PipelineCache.obj \
 $(OUTDIR)\.\Visualization\Pipeline\PipelineModule.obj \
 $(OUTDIR)\.\Visualization\Pipeline\VisualizationPipeline.obj \
 $(OUTDIR)\.\Visualization\Renderer\ArrowGlyph.obj \
@@ -14,6 +14,7 @@
 #include <kvs/Platform>
 #include <kvs/Version>
 #include <kvs/Endian>
+#include <kvs/NumberParser>
 
 
 namespace
@@ -231,12 +232,12 @@ bool AVSField::read_header( FILE* ifs )
 
         if( strcmp( equal, "=" ) ) continue;
 
-        if( !strcmp( tag, "veclen" ) ) m_veclen  = atoi( value );
-        if( !strcmp( tag, "nspace" ) ) m_nspace  = atoi( value );
-        if( !strcmp( tag, "ndim"   ) ) m_ndim    = atoi( value );
-        if( !strcmp( tag, "dim1"   ) ) m_dim.x() = atoi( value );
-        if( !strcmp( tag, "dim2"   ) ) m_dim.y() = atoi( value );
-        if( !strcmp( tag, "dim3"   ) ) m_dim.z() = atoi( value );
+        if( !strcmp( tag, "veclen" ) ) m_veclen  = kvs::NumberParser::To<int>( value );
+        if( !strcmp( tag, "nspace" ) ) m_nspace  = kvs::NumberParser::To<int>( value );
+        if( !strcmp( tag, "ndim"   ) ) m_ndim    = kvs::NumberParser::To<int>( value );
+        if( !strcmp( tag, "dim1"   ) ) m_dim.x() = kvs::NumberParser::To<int>( value );
+        if( !strcmp( tag, "dim2"   ) ) m_dim.y() = kvs::NumberParser::To<int>( value );
+        if( !strcmp( tag, "dim3"   ) ) m_dim.z() = kvs::NumberParser::To<int>( value );
 
         if( !strcmp( tag, "field"  ) )
         {
@@ -271,18 +272,18 @@ bool AVSField::read_header( FILE* ifs )
 
         if( !strcmp( tag, "min_ext" ) )
         {
-            m_min_ext.x() = static_cast<float>( atof( value ) ); value = strtok( NULL, seps );
-            m_min_ext.y() = static_cast<float>( atof( value ) ); value = strtok( NULL, seps );
-            m_min_ext.z() = static_cast<float>( atof( value ) );
+            m_min_ext.x() = kvs::NumberParser::To<float>( value ); value = strtok( NULL, seps );
+            m_min_ext.y() = kvs::NumberParser::To<float>( value ); value = strtok( NULL, seps );
+            m_min_ext.z() = kvs::NumberParser::To<float>( value );
 
             m_has_min_max_ext = true;
         }
 
         if( !strcmp( tag, "max_ext" ) )
         {
-            m_max_ext.x() = static_cast<float>( atof( value ) ); value = strtok( NULL, seps );
-            m_max_ext.y() = static_cast<float>( atof( value ) ); value = strtok( NULL, seps );
-            m_max_ext.z() = static_cast<float>( atof( value ) );
+            m_max_ext.x() = kvs::NumberParser::To<float>( value ); value = strtok( NULL, seps );
+            m_max_ext.y() = kvs::NumberParser::To<float>( value ); value = strtok( NULL, seps );
+            m_max_ext.z() = kvs::NumberParser::To<float>( value );
 
             m_has_min_max_ext = true;
         }
@@ -356,7 +357,7 @@ bool AVSField::read_comment( FILE* ifs )
             char* value = strtok( NULL, seps ) ;
             if( strcmp( equal, "=" ) ) continue;
 
-            if( !strcmp( tag, "bits"   ) ) m_bits      = atoi( value );
+            if( !strcmp( tag, "bits"   ) ) m_bits      = kvs::NumberParser::To<int>( value );
             if( !strcmp( tag, "signed" ) ) m_is_signed = strcmp( value, "signed" ) == 0;
         }
     }
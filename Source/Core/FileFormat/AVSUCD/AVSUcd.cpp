@@ -17,6 +17,7 @@
 #include <kvs/Message>
 #include <kvs/ValueArray>
 #include <kvs/IgnoreUnusedVariable>
+#include <kvs/NumberParser>
 #include <cstdlib>
 #include <cstring>
 
@@ -876,12 +877,14 @@ void AVSUcd::read_coords( FILE* const ifs )
     {
         if ( fgets( buffer, ::MaxLineLength, ifs ) )
         {
+            kvs::NumberParser parser( buffer );
+
             // Node index.
-            const int index = atoi( strtok( buffer, ::Delimiter ) ) - 1;
+            const int index = parser.next<int>() - 1;
 
-            coord[ index * 3 + 0 ] = static_cast<float>( atof( strtok( 0, ::Delimiter ) ) );
-            coord[ index * 3 + 1 ] = static_cast<float>( atof( strtok( 0, ::Delimiter ) ) );
-            coord[ index * 3 + 2 ] = static_cast<float>( atof( strtok( 0, ::Delimiter ) ) );
+            coord[ index * 3 + 0 ] = parser.next<kvs::Real32>();
+            coord[ index * 3 + 1 ] = parser.next<kvs::Real32>();
+            coord[ index * 3 + 2 ] = parser.next<kvs::Real32>();
         }
     }
 }
@@ -891,329 +894,62 @@ void AVSUcd::read_connections( FILE* const ifs )
     char buffer[ ::MaxLineLength ];
 
     // Read first line.
-    if ( fgets( buffer, ::MaxLineLength, ifs ) != 0 )
+    if ( fgets( buffer, ::MaxLineLength, ifs ) == 0 )
     {
-        strtok( buffer, ::Delimiter ); // Skip element index.
-        strtok( 0, ::Delimiter ); // Skip material index.
+        throw "Unexpected EOF in reading first line of connections.";
+    }
 
-        const char* const element_type = strtok( 0, ::Delimiter );
+    kvs::NumberParser parser( buffer );
+    parser.skip(); // Skip element index.
+    parser.skip(); // Skip material index.
 
-        m_element_type =
-            !strcmp( element_type, "pt"  ) ? Point :
-            !strcmp( element_type, "tet"  ) ? Tetrahedra :
-            !strcmp( element_type, "tet2" ) ? Tetrahedra2 :
-            !strcmp( element_type, "hex2" ) ? Hexahedra2 :
-            !strcmp( element_type, "hex" ) ? Hexahedra :
-            !strcmp( element_type, "pyr" ) ? Pyramid :
-            !strcmp( element_type, "prism" ) ? Prism : ElementTypeUnknown;
+    const std::string element_type = parser.nextToken();
 
-        if ( m_element_type == Point )
-        {
-            m_connections.allocate( 1 * m_nelements );
-        }
-        else if ( m_element_type == Tetrahedra )
-        {
-            m_connections.allocate( 4 * m_nelements );
-        }
-        else if ( m_element_type == Tetrahedra2 )
-        {
-            m_connections.allocate( 10 * m_nelements );
-        }
-        else if ( m_element_type == Hexahedra )
-        {
-            m_connections.allocate( 8 * m_nelements );
-        }
-        else if ( m_element_type == Hexahedra2 )
-        {
-            m_connections.allocate( 20 * m_nelements );
-        }
-        else if ( m_element_type == Pyramid )
-        {
-            m_connections.allocate( 5 * m_nelements );
-        }
-        else if ( m_element_type == Prism )
-        {
-            m_connections.allocate( 6 * m_nelements );
-        }
-        else
-        {
-            throw "Unknown element type.";
-        }
-    }
+    size_t nnodes_per_element = 0;
+    if ( element_type == "pt" ) { m_element_type = Point; nnodes_per_element = 1; }
+    else if ( element_type == "tet" ) { m_element_type = Tetrahedra; nnodes_per_element = 4; }
+    else if ( element_type == "tet2" ) { m_element_type = Tetrahedra2; nnodes_per_element = 10; }
+    else if ( element_type == "hex" ) { m_element_type = Hexahedra; nnodes_per_element = 8; }
+    else if ( element_type == "hex2" ) { m_element_type = Hexahedra2; nnodes_per_element = 20; }
+    else if ( element_type == "pyr" ) { m_element_type = Pyramid; nnodes_per_element = 5; }
+    else if ( element_type == "prism" ) { m_element_type = Prism; nnodes_per_element = 6; }
     else
     {
-        throw "Unexpected EOF in reading first line of connections.";
+        m_element_type = ElementTypeUnknown;
+        throw "Unknown element type.";
     }
 
+    m_connections.allocate( nnodes_per_element * m_nelements );
+
     kvs::UInt32*       connection = m_connections.data();
     kvs::UInt32* const end        = connection + m_connections.size();
 
-    if ( m_element_type == Point )
+    for ( size_t j = 0; j < nnodes_per_element; j++ )
     {
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-
-        while ( connection < end )
-        {
-            if ( fgets( buffer, ::MaxLineLength, ifs ) )
-            {
-                // skip element index.
-                strtok( buffer, ::Delimiter );
-
-                // skip material index.
-                strtok( 0, ::Delimiter );
-
-                const char* const element_type = strtok( 0, ::Delimiter );
-                if ( strcmp( element_type, "pt" ) != 0 )
-                {
-                    throw "Multi-element type is not supported.";
-                }
-
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-            }
-        }
-    }
-    else if ( m_element_type == Tetrahedra )
-    {
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-
-        while ( connection < end )
-        {
-            if ( fgets( buffer, ::MaxLineLength, ifs ) )
-            {
-                // skip element index.
-                strtok( buffer, ::Delimiter );
-
-                // skip material index.
-                strtok( 0, ::Delimiter );
-
-                const char* const element_type = strtok( 0, ::Delimiter );
-                if ( strcmp( element_type, "tet" ) != 0 )
-                {
-                    throw "Multi-element type is not supported.";
-                }
-
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-            }
-        }
+        *( connection++ ) = parser.next<kvs::UInt32>() - 1;
     }
-    else if ( m_element_type == Tetrahedra2 )
-    {
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-
-        while ( connection < end )
-        {
-            if ( fgets( buffer, ::MaxLineLength, ifs ) )
-            {
-                // skip element index.
-                strtok( buffer, ::Delimiter );
 
-                // skip material index.
-                strtok( 0, ::Delimiter );
-
-                const char* const element_type = strtok( 0, ::Delimiter );
-                if ( strcmp( element_type, "tet2" ) != 0 )
-                {
-                    throw "Multi-element type is not supported.";
-                }
-
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-            }
-        }
-    }
-    else if ( m_element_type == Hexahedra )
+    while ( connection < end )
     {
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-
-        while ( connection < end )
+        if ( fgets( buffer, ::MaxLineLength, ifs ) == 0 )
         {
-            if ( fgets( buffer, ::MaxLineLength, ifs ) )
-            {
-                // Skip element index.
-                strtok( buffer, ::Delimiter );
-
-                // Skip material index.
-                strtok( 0, ::Delimiter );
-
-                const char* const element_type = strtok( 0, ::Delimiter );
-                if ( strcmp( element_type, "hex" ) != 0 )
-                {
-                    throw "Multi-element type is not supported.";
-                }
-
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-            }
+            throw "Unexpected EOF in reading connections.";
         }
-    }
-    else if ( m_element_type == Hexahedra2 )
-    {
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-
-        while ( connection < end )
-        {
-            if ( fgets( buffer, ::MaxLineLength, ifs ) )
-            {
-                // Skip element index.
-                strtok( buffer, ::Delimiter );
 
-                // Skip material index.
-                strtok( 0, ::Delimiter );
+        kvs::NumberParser parser( buffer );
+        parser.skip(); // Skip element index.
+        parser.skip(); // Skip material index.
 
-                const char* const element_type = strtok( 0, ::Delimiter );
-                if ( strcmp( element_type, "hex2" ) != 0 )
-                {
-                    throw "Multi-element type is not supported.";
-                }
-
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-            }
-        }
-    }
-    else if ( m_element_type == Pyramid )
-    {
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-
-        while ( connection < end )
+        if ( parser.nextToken() != element_type )
         {
-            if ( fgets( buffer, ::MaxLineLength, ifs ) )
-            {
-                // skip element index.
-                strtok( buffer, ::Delimiter );
-
-                // skip material index.
-                strtok( 0, ::Delimiter );
-
-                const char* const element_type = strtok( 0, ::Delimiter );
-                if ( strcmp( element_type, "pyr" ) != 0 )
-                {
-                    throw "Multi-element type is not supported.";
-                }
-
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-            }
+            throw "Multi-element type is not supported.";
         }
-    }
-    else if ( m_element_type == Prism )
-    {
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-        *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
 
-        while ( connection < end )
+        for ( size_t j = 0; j < nnodes_per_element; j++ )
         {
-            if ( fgets( buffer, ::MaxLineLength, ifs ) )
-            {
-                // skip element index.
-                strtok( buffer, ::Delimiter );
-
-                // skip material index.
-                strtok( 0, ::Delimiter );
-
-                const char* const element_type = strtok( 0, ::Delimiter );
-                if ( strcmp( element_type, "prism" ) != 0 )
-                {
-                    throw "Multi-element type is not supported.";
-                }
-
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-                *( connection++ ) = atoi( strtok( 0, ::Delimiter ) ) - 1;
-            }
+            *( connection++ ) = parser.next<kvs::UInt32>() - 1;
         }
     }
-    else
-    {
-        throw "Unknown element type.";
-    }
 }
 
 void AVSUcd::read_components( FILE* const ifs )
@@ -1284,18 +1020,20 @@ void AVSUcd::read_values( FILE* const ifs )
     {
         if ( fgets( buffer, ::MaxLineLength, ifs ) )
         {
+            kvs::NumberParser parser( buffer );
+
             // Node index
-            const int index = atoi( strtok( buffer, ::Delimiter ) ) - 1;
+            const int index = parser.next<int>() - 1;
 
             // Skip other components
             for ( size_t j = 0; j < nskips; ++j )
             {
-                strtok( 0, ::Delimiter );
+                parser.skip();
             }
 
             for ( size_t j = 0; j < veclen; ++j )
             {
-                value[ index * veclen + j ] = static_cast<kvs::Real32>( atof( strtok( 0, ::Delimiter ) ) );
+                value[ index * veclen + j ] = parser.next<kvs::Real32>();
             }
         }
     }
@@ -7,6 +7,7 @@
 #include "Csv.h"
 #include <fstream>
 #include <sstream>
+#include <iterator>
 #include <kvs/Message>
 #include <kvs/File>
 
@@ -153,7 +154,7 @@ bool Csv::read( const std::string& filename )
     BaseClass::setFilename( filename );
     BaseClass::setSuccess( true );
 
-    std::ifstream ifs( filename.c_str() );
+    std::ifstream ifs( filename.c_str(), std::ios::in | std::ios::binary );
     if ( !ifs.is_open() )
     {
         kvsMessageError( "Cannot open %s.", filename.c_str() );
@@ -161,13 +162,19 @@ bool Csv::read( const std::string& filename )
         return false;
     }
 
+    // Read the whole file into the buffer at once, since reading character
+    // by character from the stream is slow for a large file.
+    const std::string buffer( ( std::istreambuf_iterator<char>( ifs ) ), std::istreambuf_iterator<char>() );
+    ifs.close();
+
     Row row;
     Item item;
     bool reading = false;
 
-    while ( !ifs.eof() )
+    const size_t size = buffer.size();
+    for ( size_t i = 0; i < size; i++ )
     {
-        int c = ifs.get();
+        const char c = buffer[i];
         if ( c == ',' )
         {
             if ( reading );
@@ -181,7 +188,7 @@ bool Csv::read( const std::string& filename )
         // Linefeed code: Windows CRLF(\r\n), Unix LF(\n), Mac CR(\r)
         else if ( c == '\n' || c == '\r' || c == '\0' )
         {
-            if ( c == '\r' ) { c = ifs.peek(); if ( c == '\n' ) c = ifs.get(); }
+            if ( c == '\r' && i + 1 < size && buffer[ i + 1 ] == '\n' ) { i++; }
 
             if ( reading ) { item.push_back( '\n' ); }
             else
@@ -192,11 +199,16 @@ bool Csv::read( const std::string& filename )
         }
         else
         {
-            item.push_back( static_cast<char>( c ) );
+            item.push_back( c );
         }
     }
 
-    ifs.close();
+    // Last line without the linefeed code.
+    if ( !item.empty() || !row.empty() )
+    {
+        row.push_back( item );
+        m_table.push_back( row );
+    }
 
     return true;
 }
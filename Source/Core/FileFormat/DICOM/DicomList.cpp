@@ -12,6 +12,7 @@
 #include <kvs/Message>
 #include <kvs/Math>
 #include <kvs/IgnoreUnusedVariable>
+#include <kvs/OpenMP>
 
 
 namespace kvs
@@ -82,8 +83,7 @@ bool DicomList::CheckDirectory( const std::string& dirname, const bool extension
     {
         if( extension_check )
         {
-            if( file->extension() != "dcm" ) continue;
-            else counter++;
+            if( file->extension() == "dcm" ) counter++;
         }
 
         ++file;
@@ -112,7 +112,8 @@ DicomList::DicomList():
     m_slice_thickness( 0.0 ),
     m_min_raw_value( 0 ),
     m_max_raw_value( 0 ),
-    m_extension_check( true )
+    m_extension_check( true ),
+    m_enable_mthreading( false )
 {
 }
 
@@ -129,7 +130,8 @@ DicomList::DicomList( const std::string& dirname, const bool extension_check ):
     m_slice_thickness( 0.0 ),
     m_min_raw_value( 0 ),
     m_max_raw_value( 0 ),
-    m_extension_check( extension_check )
+    m_extension_check( extension_check ),
+    m_enable_mthreading( false )
 {
     this->read( dirname );
     this->sort(); // Sorting by slice location. (default sorting method)
@@ -360,6 +362,48 @@ void DicomList::disableExtensionCheck()
     m_extension_check = false;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns true if multi-threading is enabled.
+ *  @return true, if the files are read in parallel
+ */
+/*===========================================================================*/
+bool DicomList::isEnabledMultiThreading() const
+{
+    return m_enable_mthreading;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets multi-threading flag.
+ *  @param  enable [in] if true, the files are read in parallel
+ */
+/*===========================================================================*/
+void DicomList::setEnabledMultiThreading( const bool enable )
+{
+    m_enable_mthreading = enable;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Enable multi-threading.
+ */
+/*===========================================================================*/
+void DicomList::enableMultiThreading()
+{
+    this->setEnabledMultiThreading( true );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Disable multi-threading.
+ */
+/*===========================================================================*/
+void DicomList::disableMultiThreading()
+{
+    this->setEnabledMultiThreading( false );
+}
+
 void DicomList::print( std::ostream& os, const kvs::Indent& indent )
 {
     os << indent << "Filename : " << BaseClass::filename() << std::endl;
@@ -406,8 +450,8 @@ bool DicomList::read( const std::string& dirname )
         return false;
     }
 
-    // Read DICOM data file. (".dcm" only, if extension_check is true)
-    bool flag = false;
+    // Collect DICOM data files. (".dcm" only, if extension_check is true)
+    std::vector<std::string> filenames;
     for ( const auto& file : dir.fileList() )
     {
         if ( m_extension_check )
@@ -415,7 +459,24 @@ bool DicomList::read( const std::string& dirname )
             if ( file.extension() != "dcm" ) continue;
         }
 
-        kvs::Dicom* dicom = new kvs::Dicom( file.filePath( true ) );
+        filenames.push_back( file.filePath( true ) );
+    }
+
+    // Read DICOM data files. The files, which are parsed independently,
+    // are read in parallel if multi-threading is enabled.
+    std::vector<kvs::Dicom*> dicoms( filenames.size(), NULL );
+    const long nfiles = static_cast<long>( filenames.size() );
+    KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(dynamic) )
+    for ( long i = 0; i < nfiles; i++ )
+    {
+        dicoms[i] = new kvs::Dicom( filenames[i] );
+    }
+
+    // Add the DICOM data to the list in the order of the files.
+    bool flag = false;
+    for ( size_t i = 0; i < dicoms.size(); i++ )
+    {
+        kvs::Dicom* dicom = dicoms[i];
         if ( !flag )
         {
             m_row = dicom->row();
@@ -431,7 +492,8 @@ bool DicomList::read( const std::string& dirname )
         {
             if ( m_row != dicom->row() || m_column != dicom->column() )
             {
-                kvsMessageError( "Not correspond image size (%s).", file.filePath().c_str() );
+                kvsMessageError( "Not correspond image size (%s).", filenames[i].c_str() );
+                delete dicom;
                 continue;
             }
 
@@ -22,6 +22,11 @@ namespace kvs
 /*===========================================================================*/
 /**
  *  @brief  DICOM list class.
+ *
+ *  The DICOM files in the directory are read as the list of kvs::Dicom. If
+ *  multi-threading is enabled, the files are parsed in parallel, and then
+ *  they are added to the list in the order of the files, so that the list
+ *  is the same as the one read serially.
  */
 /*===========================================================================*/
 class DicomList : public kvs::FileFormatBase
@@ -58,6 +63,7 @@ protected:
     int m_min_raw_value; ///< min. value of the raw data
     int m_max_raw_value; ///< max. value of the raw data
     bool m_extension_check; ///< check the file extension
+    bool m_enable_mthreading; ///< flag for multi-threading
 
 public:
 
@@ -89,6 +95,10 @@ public:
     int maxRawValue() const;
     void enableExtensionCheck();
     void disableExtensionCheck();
+    bool isEnabledMultiThreading() const;
+    void setEnabledMultiThreading( const bool enable );
+    void enableMultiThreading();
+    void disableMultiThreading();
 
     void sort()
     {
@@ -12,6 +12,8 @@
 #include <kvs/Directory>
 #include <kvs/String>
 #include <kvs/File>
+#include <kvs/Message>
+#include <iterator>
 
 
 namespace
@@ -107,6 +109,12 @@ std::string ReplaceHour( const std::string& filename, const int hour )
     return filename;
 }
 
+size_t NumberOfLevels( const kvs::grads::Vars::Var& var )
+{
+    // The variable with zero levels is a surface variable of one level.
+    return var.levs > 0 ? static_cast<size_t>( var.levs ) : 1;
+}
+
 std::string ReplaceMinute( const std::string& filename, const int minute )
 {
     if ( filename.find("%n2",0) != std::string::npos )
@@ -250,6 +258,85 @@ void GrADS::print( std::ostream& os, const kvs::Indent& indent ) const
     return true;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Reads the values of the specified variable from the data file.
+ *  @param  index [in] index of the data file
+ *  @param  varname [in] variable name
+ *  @return values of all the levels of the variable (empty if failed)
+ */
+/*===========================================================================*/
+kvs::ValueArray<kvs::Real32> GrADS::readValues( const size_t index, const std::string& varname ) const
+{
+    const int vindex = m_data_descriptor.vars().indexOf( varname );
+    if ( vindex < 0 )
+    {
+        kvsMessageError( "Variable %s is not found.", varname.c_str() );
+        return kvs::ValueArray<kvs::Real32>();
+    }
+
+    const size_t nlevels = ::NumberOfLevels( *std::next( m_data_descriptor.vars().values.begin(), vindex ) );
+    return this->readValues( index, static_cast<size_t>( vindex ), 0, nlevels );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the values of the specified variable and levels from the data file.
+ *
+ *  Only the values of the levels are read from the data file, where the
+ *  offset to the values is computed from the grid size and the levels of
+ *  the variables stored in order in each time step. If a data file contains
+ *  several time steps (e.g. the DSET without template), the time steps
+ *  stored before are skipped.
+ *
+ *  @param  index [in] index of the data file
+ *  @param  vindex [in] index of the variable
+ *  @param  level_begin [in] index of the first level
+ *  @param  nlevels [in] number of levels
+ *  @return values of the levels of the variable (empty if failed)
+ */
+/*===========================================================================*/
+kvs::ValueArray<kvs::Real32> GrADS::readValues(
+    const size_t index,
+    const size_t vindex,
+    const size_t level_begin,
+    const size_t nlevels ) const
+{
+    const std::list<kvs::grads::Vars::Var>& vars = m_data_descriptor.vars().values;
+    if ( index >= m_data_list.size() || vindex >= vars.size() )
+    {
+        kvsMessageError( "Data file or variable index is out of range." );
+        return kvs::ValueArray<kvs::Real32>();
+    }
+
+    // Offset to the variable and size of each time step in number of levels.
+    size_t level_offset = 0;
+    size_t levels_per_step = 0;
+    size_t v = 0;
+    for ( const auto& var : vars )
+    {
+        if ( v++ == vindex )
+        {
+            if ( level_begin + nlevels > ::NumberOfLevels( var ) )
+            {
+                kvsMessageError( "Level of %s is out of range.", var.varname.c_str() );
+                return kvs::ValueArray<kvs::Real32>();
+            }
+            level_offset = levels_per_step + level_begin;
+        }
+        levels_per_step += ::NumberOfLevels( var );
+    }
+
+    // Time steps stored in the same file before the specified one.
+    const std::string& filename = m_data_list[index].filename();
+    size_t step = 0;
+    while ( step < index && m_data_list[ index - step - 1 ].filename() == filename ) { step++; }
+
+    const size_t nvalues_per_level = m_data_descriptor.xdef().num * m_data_descriptor.ydef().num;
+    const size_t offset = ( step * levels_per_step + level_offset ) * nvalues_per_level;
+    return m_data_list[index].readValues( offset, nlevels * nvalues_per_level );
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Writes GrADS data.
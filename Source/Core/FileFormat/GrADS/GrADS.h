@@ -43,6 +43,12 @@ public:
     const DataDescriptorFile& dataDescriptor() const { return m_data_descriptor; }
     const GriddedBinaryDataFileList& dataList() const { return m_data_list; }
     const GriddedBinaryDataFile& data( const size_t index ) const { return m_data_list[index]; }
+    kvs::ValueArray<kvs::Real32> readValues( const size_t index, const std::string& varname ) const;
+    kvs::ValueArray<kvs::Real32> readValues(
+        const size_t index,
+        const size_t vindex,
+        const size_t level_begin,
+        const size_t nlevels ) const;
 
     void print( std::ostream& os, const kvs::Indent& indent = kvs::Indent(0) ) const;
     bool read( const std::string& filename );
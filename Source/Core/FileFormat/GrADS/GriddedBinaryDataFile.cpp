@@ -6,7 +6,10 @@
 /*****************************************************************************/
 #include "GriddedBinaryDataFile.h"
 #include <fstream>
+#include <cstring>
 #include <kvs/Endian>
+#include <kvs/MappedFile>
+#include <kvs/Message>
 
 
 namespace kvs
@@ -36,6 +39,103 @@ const kvs::ValueArray<kvs::Real32> GriddedBinaryDataFile::values(
     return dst;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Reads a part of data values from the data file.
+ *
+ *  The data values in the range [offset, offset + nvalues) are read without
+ *  loading the whole file. The byte offset of the range is computed from the
+ *  element size of the file format, and only the read values are swapped if
+ *  the byte order differs from the machine. The region of the file is mapped
+ *  into the memory for the non-sequential format, and it is read with the
+ *  seek if the mapping fails or the format is sequential. If the whole data
+ *  values have already been loaded, the range is copied from them.
+ *
+ *  @param  offset [in] offset to the first value (in number of values)
+ *  @param  nvalues [in] number of values
+ *  @return data values (empty if the range is out of the file)
+ */
+/*===========================================================================*/
+kvs::ValueArray<kvs::Real32> GriddedBinaryDataFile::readValues(
+    const size_t offset,
+    const size_t nvalues ) const
+{
+    if ( nvalues == 0 ) { return kvs::ValueArray<kvs::Real32>(); }
+
+    if ( m_values.size() > 0 )
+    {
+        if ( m_values.size() < offset + nvalues ) { return kvs::ValueArray<kvs::Real32>(); }
+        return kvs::ValueArray<kvs::Real32>( m_values.data() + offset, nvalues );
+    }
+
+    if ( m_filename.length() == 0 )
+    {
+        kvsMessageError("Filename of binary data has not been specified.");
+        return kvs::ValueArray<kvs::Real32>();
+    }
+
+    const bool swap = m_big_endian != kvs::Endian::IsBig();
+    if ( !m_sequential )
+    {
+        // The mapped region is copy-on-write, so that the values can be
+        // swapped in place.
+        const size_t element_size = sizeof( kvs::Real32 );
+        kvs::ValueArray<kvs::Real32> mapped = kvs::MappedFile::MapArray<kvs::Real32>(
+            m_filename, offset * element_size, nvalues );
+        if ( mapped.size() == nvalues )
+        {
+            if ( swap ) { kvs::Endian::Swap( mapped.data(), mapped.size() ); }
+            return mapped;
+        }
+    }
+
+    std::ifstream ifs( m_filename.c_str(), std::ios::binary | std::ios::in );
+    if( !ifs.is_open() )
+    {
+        kvsMessageError( "Cannot open %s.", m_filename.c_str() );
+        return kvs::ValueArray<kvs::Real32>();
+    }
+
+    ifs.seekg( 0, std::ios::end );
+    const std::streamoff file_size = ifs.tellg(); // [byte]
+
+    // Each value is enclosed by the paddings of 4 bytes in the sequential format.
+    const size_t padding_size = m_sequential ? 2 * sizeof( kvs::Int16 ) : 0;
+    const size_t element_size = sizeof( kvs::Real32 ) + 2 * padding_size;
+    if ( static_cast<std::streamoff>( ( offset + nvalues ) * element_size ) > file_size )
+    {
+        kvsMessageError( "Values out of range are specified for %s.", m_filename.c_str() );
+        return kvs::ValueArray<kvs::Real32>();
+    }
+
+    kvs::ValueArray<kvs::Real32> values( nvalues );
+    ifs.seekg( static_cast<std::streamoff>( offset * element_size ), std::ios::beg );
+    if ( m_sequential )
+    {
+        kvs::ValueArray<char> buffer( nvalues * element_size );
+        ifs.read( buffer.data(), buffer.size() );
+        for ( size_t i = 0; i < nvalues; i++ )
+        {
+            const char* src = buffer.data() + i * element_size + padding_size;
+            std::memcpy( values.data() + i, src, sizeof( kvs::Real32 ) );
+        }
+    }
+    else
+    {
+        ifs.read( reinterpret_cast<char*>( values.data() ), nvalues * element_size );
+    }
+
+    if ( !ifs )
+    {
+        kvsMessageError( "Cannot read %s.", m_filename.c_str() );
+        return kvs::ValueArray<kvs::Real32>();
+    }
+
+    if ( swap ) { kvs::Endian::Swap( values.data(), values.size() ); }
+
+    return values;
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Loads data values from the specified data file.
@@ -20,6 +20,11 @@ namespace grads
 /*===========================================================================*/
 /**
  *  @brief  GriddedBinaryDataFile class.
+ *
+ *  The whole data values in the file are loaded into the memory by load().
+ *  A part of the data values, e.g. a field of a variable at a time step, can
+ *  be read by readValues() without loading the whole file, where only the
+ *  byte range of the part is read from the file and byte-swapped.
  */
 /*===========================================================================*/
 class GriddedBinaryDataFile
@@ -54,6 +59,7 @@ public:
     const std::string& filename() const { return m_filename; }
     const kvs::ValueArray<kvs::Real32>& values() const { return m_values; }
     const kvs::ValueArray<kvs::Real32> values( const size_t vindex, const kvs::Vec3ui& dim ) const;
+    kvs::ValueArray<kvs::Real32> readValues( const size_t offset, const size_t nvalues ) const;
     bool load() const;
     void free() const;
 };
@@ -10,6 +10,8 @@
 #include <kvs/ValueArray>
 #include <kvs/AnyValueArray>
 #include <kvs/IgnoreUnusedVariable>
+#include <kvs/NumberParser>
+#include <kvs/MappedFile>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -27,19 +29,9 @@ namespace temporal
 template <typename T>
 inline T To( const std::string& value )
 {
-    return static_cast<T>( atof( value.c_str() ) );
-}
-
-template <>
-inline kvs::Int8 To( const std::string& value )
-{
-    return static_cast<kvs::Int8>( atoi( value.c_str() ) );
-}
-
-template <>
-inline kvs::UInt8 To( const std::string& value )
-{
-    return static_cast<kvs::UInt8>( atoi( value.c_str() ) );
+    T result = T(0);
+    kvs::NumberParser::Parse( value.data(), value.data() + value.size(), &result );
+    return result;
 }
 
 inline std::string TypeName( const std::type_info& type )
@@ -168,6 +160,7 @@ inline bool ReadInternalData(
  *  @param  nelements  [in] number of elements
  *  @param  filename   [in] external file name
  *  @param  format     [in] file format (binary or ascii)
+ *  @param  mapping    [in] if true, the binary data is memory-mapped
  *  @return true, if the reading process is done successfully
  */
 /*===========================================================================*/
@@ -176,8 +169,21 @@ inline bool ReadExternalData(
     kvs::AnyValueArray* data_array,
     const size_t nelements,
     const std::string& filename,
-    const std::string& format )
+    const std::string& format,
+    const bool mapping = false )
 {
+    if ( format == "binary" && mapping )
+    {
+        // The array refers to the mapped file, and the pages are read on
+        // demand. The reading falls back to fread if the mapping fails.
+        kvs::ValueArray<T> mapped = kvs::MappedFile::MapArray<T>( filename, 0, nelements );
+        if ( mapped.size() == nelements )
+        {
+            *data_array = kvs::AnyValueArray( mapped );
+            return true;
+        }
+    }
+
     data_array->template allocate<T>( nelements );
 
     if ( format == "binary" )
@@ -227,17 +233,7 @@ inline bool ReadExternalData(
         }
 
         T* data = static_cast<T*>( data_array->data() );
-
-        const char* delim = " ,\t\n";
-        char* value = strtok( buffer, delim );
-        for ( size_t i = 0; i < nelements; i++ )
-        {
-            if ( value )
-            {
-                *(data++) = static_cast<T>( atof( value ) );
-                value = strtok( 0, delim );
-            }
-        }
+        kvs::NumberParser::ParseArray( buffer, buffer + size, data, nelements );
 
         free( buffer );
 
@@ -259,6 +255,7 @@ inline bool ReadExternalData(
  *  @param  nelements  [in] number of elements
  *  @param  filename   [in] external file name
  *  @param  format     [in] file format (binary or ascii)
+ *  @param  mapping    [in] if true, the binary data is memory-mapped
  *  @return true, if the reading process is done successfully
  */
 /*===========================================================================*/
@@ -267,8 +264,20 @@ inline bool ReadExternalData(
     kvs::ValueArray<T1>* out_array,
     const size_t nelements,
     const std::string& filename,
-    const std::string& format )
+    const std::string& format,
+    const bool mapping = false )
 {
+    if ( format == "binary" && mapping && typeid( T1 ) == typeid( T2 ) )
+    {
+        // The data can be mapped only if the type conversion is not needed.
+        kvs::ValueArray<T1> mapped = kvs::MappedFile::MapArray<T1>( filename, 0, nelements );
+        if ( mapped.size() == nelements )
+        {
+            *out_array = mapped;
+            return true;
+        }
+    }
+
     kvs::ValueArray<T1> data_array( nelements );
 
     if ( format == "binary" )
@@ -329,17 +338,7 @@ inline bool ReadExternalData(
         }
 
         T1* data = data_array.data();
-
-        const char* delim = " ,\t\n";
-        char* value = strtok( &( buffer[0] ), delim );
-        for ( size_t i = 0; i < nelements; i++ )
-        {
-            if ( value )
-            {
-                *( data++ ) = static_cast<T1>( atof( value ) );
-                value = strtok( 0, delim );
-            }
-        }
+        kvs::NumberParser::ParseArray( buffer.data(), buffer.data() + size, data, nelements );
 
         fclose( ifs );
     }
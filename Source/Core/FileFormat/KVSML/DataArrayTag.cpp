@@ -39,7 +39,8 @@ DataArrayTag::DataArrayTag():
     m_type( "" ),
     m_file( "" ),
     m_format( "" ),
-    m_endian( "" )
+    m_endian( "" ),
+    m_memory_mapping( false )
 {
 }
 
@@ -338,9 +339,12 @@ bool DataArrayTag::read_data( const size_t nelements, kvs::AnyValueArray* data )
         const std::string path = kvs::File( document->filename() ).pathName( true );
         const std::string filename = path + kvs::Directory::Separator() + m_file;
 
+        // The binary data is mapped if the byte swapping is not needed.
+        const bool mapping = m_memory_mapping && !byte_swap;
+
         if( m_type == "char" )
         {
-            if ( !kvs::kvsml::DataArray::ReadExternalData<kvs::Int8>( data, nelements, filename, m_format ) )
+            if ( !kvs::kvsml::DataArray::ReadExternalData<kvs::Int8>( data, nelements, filename, m_format, mapping ) )
             {
                 kvsMessageError( "Cannot read the data array in <%s>.", tag_name.c_str() );
                 return false;
@@ -350,7 +354,7 @@ bool DataArrayTag::read_data( const size_t nelements, kvs::AnyValueArray* data )
         }
         else if( m_type == "unsigned char" || m_type == "uchar" )
         {
-            if ( !kvs::kvsml::DataArray::ReadExternalData<kvs::UInt8>( data, nelements, filename, m_format ) )
+            if ( !kvs::kvsml::DataArray::ReadExternalData<kvs::UInt8>( data, nelements, filename, m_format, mapping ) )
             {
                 kvsMessageError( "Cannot read the data array in <%s>.", tag_name.c_str() );
                 return false;
@@ -360,7 +364,7 @@ bool DataArrayTag::read_data( const size_t nelements, kvs::AnyValueArray* data )
         }
         else if ( m_type == "short" )
         {
-            if ( !kvs::kvsml::DataArray::ReadExternalData<kvs::Int16>( data, nelements, filename, m_format ) )
+            if ( !kvs::kvsml::DataArray::ReadExternalData<kvs::Int16>( data, nelements, filename, m_format, mapping ) )
             {
                 kvsMessageError( "Cannot read the data array in <%s>.", tag_name.c_str() );
                 return false;
@@ -370,7 +374,7 @@ bool DataArrayTag::read_data( const size_t nelements, kvs::AnyValueArray* data )
         }
         else if ( m_type == "unsigned short" || m_type == "ushort" )
         {
-            if ( !kvs::kvsml::DataArray::ReadExternalData<kvs::UInt16>( data, nelements, filename, m_format ) )
+            if ( !kvs::kvsml::DataArray::ReadExternalData<kvs::UInt16>( data, nelements, filename, m_format, mapping ) )
             {
                 kvsMessageError( "Cannot read the data array in <%s>.", tag_name.c_str() );
                 return false;
@@ -380,7 +384,7 @@ bool DataArrayTag::read_data( const size_t nelements, kvs::AnyValueArray* data )
         }
         else if ( m_type == "int" )
         {
-            if ( !kvs::kvsml::DataArray::ReadExternalData<kvs::Int32>( data, nelements, filename, m_format ) )
+            if ( !kvs::kvsml::DataArray::ReadExternalData<kvs::Int32>( data, nelements, filename, m_format, mapping ) )
             {
                 kvsMessageError( "Cannot read the data array in <%s>.", tag_name.c_str() );
                 return false;
@@ -390,7 +394,7 @@ bool DataArrayTag::read_data( const size_t nelements, kvs::AnyValueArray* data )
         }
         else if ( m_type == "unsigned int" || m_type == "uint" )
         {
-            if ( !kvs::kvsml::DataArray::ReadExternalData<kvs::UInt32>( data, nelements, filename, m_format ) )
+            if ( !kvs::kvsml::DataArray::ReadExternalData<kvs::UInt32>( data, nelements, filename, m_format, mapping ) )
             {
                 kvsMessageError( "Cannot read the data array in <%s>.", tag_name.c_str() );
                 return false;
@@ -400,7 +404,7 @@ bool DataArrayTag::read_data( const size_t nelements, kvs::AnyValueArray* data )
         }
         else if ( m_type == "float" )
         {
-            if ( !kvs::kvsml::DataArray::ReadExternalData<kvs::Real32>( data, nelements, filename, m_format ) )
+            if ( !kvs::kvsml::DataArray::ReadExternalData<kvs::Real32>( data, nelements, filename, m_format, mapping ) )
             {
                 kvsMessageError( "Cannot read the data array in <%s>.", tag_name.c_str() );
                 return false;
@@ -410,7 +414,7 @@ bool DataArrayTag::read_data( const size_t nelements, kvs::AnyValueArray* data )
         }
         else if ( m_type == "double" )
         {
-            if ( !kvs::kvsml::DataArray::ReadExternalData<kvs::Real64>( data, nelements, filename, m_format ) )
+            if ( !kvs::kvsml::DataArray::ReadExternalData<kvs::Real64>( data, nelements, filename, m_format, mapping ) )
             {
                 kvsMessageError( "Cannot read the data array in <%s>.", tag_name.c_str() );
                 return false;
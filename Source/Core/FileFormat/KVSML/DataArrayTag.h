@@ -43,6 +43,7 @@ private:
     std::string m_file; ///< external file name
     std::string m_format; ///< external file format
     std::string m_endian; ///< endianness of the binary data
+    bool m_memory_mapping; ///< flag to map the external binary data into the memory
 
 public:
     DataArrayTag();
@@ -55,10 +56,12 @@ public:
     const std::string& file() const { return m_file; }
     const std::string& format() const { return m_format; }
     const std::string& endian() const { return m_endian; }
+    bool isEnabledMemoryMapping() const { return m_memory_mapping; }
 
     void setFile( const std::string& file ) { m_has_file = true; m_file = file; }
     void setFormat( const std::string& format ) { m_has_format = true; m_format = format; }
     void setEndian( const std::string& endian ) { m_has_endian = true; m_endian = endian; }
+    void setEnabledMemoryMapping( const bool enable ) { m_memory_mapping = enable; }
 
     bool read( const kvs::XMLNode::SuperClass* parent, const size_t nelements, kvs::AnyValueArray* data );
     template <typename T>
@@ -228,9 +231,12 @@ bool DataArrayTag::read_data( const size_t nelements, kvs::ValueArray<T>* data )
         const std::string path = kvs::File( document->filename() ).pathName( true );
         const std::string filename = path + kvs::Directory::Separator() + m_file;
 
+        // The binary data is mapped if the byte swapping is not needed.
+        const bool mapping = m_memory_mapping && !byte_swap;
+
         if( m_type == "char" )
         {
-            if ( !kvs::kvsml::DataArray::ReadExternalData<T,kvs::Int8>( data, nelements, filename, m_format ) )
+            if ( !kvs::kvsml::DataArray::ReadExternalData<T,kvs::Int8>( data, nelements, filename, m_format, mapping ) )
             {
                 kvsMessageError( "Cannot read the data array in <%s>.", tag_name.c_str() );
                 return false;
@@ -238,7 +244,7 @@ bool DataArrayTag::read_data( const size_t nelements, kvs::ValueArray<T>* data )
         }
         else if( m_type == "unsigned char" || m_type == "uchar" )
         {
-            if ( !kvs::kvsml::DataArray::ReadExternalData<T,kvs::UInt8>( data, nelements, filename, m_format ) )
+            if ( !kvs::kvsml::DataArray::ReadExternalData<T,kvs::UInt8>( data, nelements, filename, m_format, mapping ) )
             {
                 kvsMessageError( "Cannot read the data array in <%s>.", tag_name.c_str() );
                 return false;
@@ -246,7 +252,7 @@ bool DataArrayTag::read_data( const size_t nelements, kvs::ValueArray<T>* data )
         }
         else if( m_type == "short" )
         {
-            if ( !kvs::kvsml::DataArray::ReadExternalData<T,kvs::Int16>( data, nelements, filename, m_format ) )
+            if ( !kvs::kvsml::DataArray::ReadExternalData<T,kvs::Int16>( data, nelements, filename, m_format, mapping ) )
             {
                 kvsMessageError( "Cannot read the data array in <%s>.", tag_name.c_str() );
                 return false;
@@ -254,7 +260,7 @@ bool DataArrayTag::read_data( const size_t nelements, kvs::ValueArray<T>* data )
         }
         else if( m_type == "unsigned short" || m_type == "ushort" )
         {
-            if ( !kvs::kvsml::DataArray::ReadExternalData<T,kvs::UInt16>( data, nelements, filename, m_format ) )
+            if ( !kvs::kvsml::DataArray::ReadExternalData<T,kvs::UInt16>( data, nelements, filename, m_format, mapping ) )
             {
                 kvsMessageError( "Cannot read the data array in <%s>.", tag_name.c_str() );
                 return false;
@@ -262,7 +268,7 @@ bool DataArrayTag::read_data( const size_t nelements, kvs::ValueArray<T>* data )
         }
         else if( m_type == "int" )
         {
-            if ( !kvs::kvsml::DataArray::ReadExternalData<T,kvs::Int32>( data, nelements, filename, m_format ) )
+            if ( !kvs::kvsml::DataArray::ReadExternalData<T,kvs::Int32>( data, nelements, filename, m_format, mapping ) )
             {
                 kvsMessageError( "Cannot read the data array in <%s>.", tag_name.c_str() );
                 return false;
@@ -270,7 +276,7 @@ bool DataArrayTag::read_data( const size_t nelements, kvs::ValueArray<T>* data )
         }
         else if( m_type == "unsigned int" || m_type == "uint" )
         {
-            if ( !kvs::kvsml::DataArray::ReadExternalData<T,kvs::UInt32>( data, nelements, filename, m_format ) )
+            if ( !kvs::kvsml::DataArray::ReadExternalData<T,kvs::UInt32>( data, nelements, filename, m_format, mapping ) )
             {
                 kvsMessageError( "Cannot read the data array in <%s>.", tag_name.c_str() );
                 return false;
@@ -278,7 +284,7 @@ bool DataArrayTag::read_data( const size_t nelements, kvs::ValueArray<T>* data )
         }
         else if( m_type == "float" )
         {
-            if ( !kvs::kvsml::DataArray::ReadExternalData<T,kvs::Real32>( data, nelements, filename, m_format ) )
+            if ( !kvs::kvsml::DataArray::ReadExternalData<T,kvs::Real32>( data, nelements, filename, m_format, mapping ) )
             {
                 kvsMessageError( "Cannot read the data array in <%s>.", tag_name.c_str() );
                 return false;
@@ -286,7 +292,7 @@ bool DataArrayTag::read_data( const size_t nelements, kvs::ValueArray<T>* data )
         }
         else if( m_type == "double" )
         {
-            if ( !kvs::kvsml::DataArray::ReadExternalData<T,kvs::Real64>( data, nelements, filename, m_format ) )
+            if ( !kvs::kvsml::DataArray::ReadExternalData<T,kvs::Real64>( data, nelements, filename, m_format, mapping ) )
             {
                 kvsMessageError( "Cannot read the data array in <%s>.", tag_name.c_str() );
                 return false;
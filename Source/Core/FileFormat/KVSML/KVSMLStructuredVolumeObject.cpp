@@ -92,7 +92,8 @@ KVSMLStructuredVolumeObject::KVSMLStructuredVolumeObject():
     m_veclen( 0 ),
     m_resolution( 0, 0, 0 ),
     m_min_value( 0.0 ),
-    m_max_value( 0.0 )
+    m_max_value( 0.0 ),
+    m_memory_mapping( false )
 {
 }
 
@@ -114,7 +115,8 @@ KVSMLStructuredVolumeObject::KVSMLStructuredVolumeObject( const std::string& fil
     m_veclen( 0 ),
     m_resolution( 0, 0, 0 ),
     m_min_value( 0.0 ),
-    m_max_value( 0.0 )
+    m_max_value( 0.0 ),
+    m_memory_mapping( false )
 {
     this->read( filename );
 }
@@ -242,6 +244,7 @@ bool KVSMLStructuredVolumeObject::read( const std::string& filename )
     const size_t veclen = value_tag.veclen();
     const size_t nelements = nnodes * veclen;
     kvs::kvsml::DataArrayTag values;
+    values.setEnabledMemoryMapping( m_memory_mapping );
     if ( !values.read( value_tag.node(), nelements, &m_values ) )
     {
         kvsMessageError( "Cannot read <%s> for <%s>.",
@@ -262,6 +265,7 @@ bool KVSMLStructuredVolumeObject::read( const std::string& filename )
 
         // <DataArray>
         kvs::kvsml::DataArrayTag coords;
+        coords.setEnabledMemoryMapping( m_memory_mapping );
         const size_t dimension = 3;
         size_t coord_nelements = 0;
         for ( size_t i = 0; i < dimension; i++ ) coord_nelements += resolution[i];
@@ -284,6 +288,7 @@ bool KVSMLStructuredVolumeObject::read( const std::string& filename )
 
         // <DataArray>
         kvs::kvsml::DataArrayTag coords;
+        coords.setEnabledMemoryMapping( m_memory_mapping );
         const size_t dimension = 3;
         const size_t coord_nelements = nnodes * dimension;
         if ( !coords.read( coord_tag.node(), coord_nelements, &m_coords ) )
@@ -53,6 +53,7 @@ private:
     double m_max_value; ///< max. value
     kvs::AnyValueArray m_values; ///< field value array
     kvs::ValueArray<float> m_coords; ///< coordinate array
+    bool m_memory_mapping; ///< flag to map the external binary data into the memory
 
 public:
     static bool CheckExtension( const std::string& filename );
@@ -71,6 +72,7 @@ public:
     bool hasMaxValue() const { return m_has_max_value; }
     bool hasObjectCoord() const { return m_object_tag.hasObjectCoord(); }
     bool hasExternalCoord() const { return m_object_tag.hasExternalCoord(); }
+    bool isEnabledMemoryMapping() const { return m_memory_mapping; }
     const std::string& label() const { return m_label; }
     const std::string& unit() const { return m_unit; }
     size_t veclen() const { return m_veclen; }
@@ -84,6 +86,7 @@ public:
     const kvs::AnyValueArray& values() const { return m_values; }
     const kvs::ValueArray<float>& coords() const { return m_coords; }
 
+    void setEnabledMemoryMapping( const bool enable ) { m_memory_mapping = enable; }
     void setWritingDataType( const WritingDataType type ) { m_writing_type = type; }
     void setWritingDataTypeToAscii() { this->setWritingDataType( Ascii ); }
     void setWritingDataTypeToExternalAscii() { this->setWritingDataType( ExternalAscii ); }
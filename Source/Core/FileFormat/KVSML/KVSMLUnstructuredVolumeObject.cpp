@@ -107,7 +107,8 @@ bool KVSMLUnstructuredVolumeObject::CheckFormat( const std::string& filename )
  */
 /*===========================================================================*/
 KVSMLUnstructuredVolumeObject::KVSMLUnstructuredVolumeObject():
-    m_writing_type( kvs::KVSMLUnstructuredVolumeObject::Ascii )
+    m_writing_type( kvs::KVSMLUnstructuredVolumeObject::Ascii ),
+    m_memory_mapping( false )
 {
 }
 
@@ -118,7 +119,8 @@ KVSMLUnstructuredVolumeObject::KVSMLUnstructuredVolumeObject():
  */
 /*===========================================================================*/
 KVSMLUnstructuredVolumeObject::KVSMLUnstructuredVolumeObject( const std::string& filename ):
-    m_writing_type( kvs::KVSMLUnstructuredVolumeObject::Ascii )
+    m_writing_type( kvs::KVSMLUnstructuredVolumeObject::Ascii ),
+    m_memory_mapping( false )
 {
     this->read( filename );
 }
@@ -226,6 +228,7 @@ bool KVSMLUnstructuredVolumeObject::read( const std::string& filename )
     // <DataArray>
     const size_t value_nelements = m_node_tag.nnodes() * m_value_tag.veclen();
     kvs::kvsml::DataArrayTag values;
+    values.setEnabledMemoryMapping( m_memory_mapping );
     if ( !values.read( m_value_tag.node(), value_nelements, &m_values ) )
     {
         kvsMessageError( "Cannot read <%s> for <%s>.",
@@ -245,6 +248,7 @@ bool KVSMLUnstructuredVolumeObject::read( const std::string& filename )
     const size_t dimension = 3;
     const size_t coord_nelements = m_node_tag.nnodes() * dimension;
     kvs::kvsml::DataArrayTag coords;
+    coords.setEnabledMemoryMapping( m_memory_mapping );
     if ( !coords.read( m_coord_tag.node(), coord_nelements, &m_coords ) )
     {
         kvsMessageError( "Cannot read <%s> for <%s>.",
@@ -284,6 +288,7 @@ bool KVSMLUnstructuredVolumeObject::read( const std::string& filename )
     const size_t nnodes_per_element = ::GetNumberOfNodesPerElement( m_volume_tag.cellType() );
     const size_t connection_nelements = m_cell_tag.ncells() * nnodes_per_element;
     kvs::kvsml::DataArrayTag connections;
+    connections.setEnabledMemoryMapping( m_memory_mapping );
     if ( !connections.read( m_connection_tag.node(), connection_nelements, &m_connections ) )
     {
         kvsMessageError( "Cannot read <%s> for <%s>.",
@@ -55,6 +55,7 @@ private:
     kvs::AnyValueArray m_values; ///< field value array
     kvs::ValueArray<kvs::Real32> m_coords; ///< coordinate value array
     kvs::ValueArray<kvs::UInt32> m_connections; ///< connection id array
+    bool m_memory_mapping; ///< flag to map the external binary data into the memory
 
 public:
     static bool CheckExtension( const std::string& filename );
@@ -73,6 +74,7 @@ public:
     bool hasMaxValue() const { return m_value_tag.hasMaxValue(); }
     bool hasObjectCoord() const { return m_object_tag.hasObjectCoord(); }
     bool hasExternalCoord() const { return m_object_tag.hasExternalCoord(); }
+    bool isEnabledMemoryMapping() const { return m_memory_mapping; }
     const std::string& label() const { return m_value_tag.label(); }
     const std::string& unit() const { return m_value_tag.unit(); }
     size_t veclen() const { return m_value_tag.veclen(); }
@@ -88,6 +90,7 @@ public:
     const kvs::ValueArray<kvs::Real32>& coords() const { return m_coords; }
     const kvs::ValueArray<kvs::UInt32>& connections() const { return m_connections; }
 
+    void setEnabledMemoryMapping( const bool enable ) { m_memory_mapping = enable; }
     void setWritingDataType( const WritingDataType type ) { m_writing_type = type; }
     void setWritingDataTypeToAscii() { this->setWritingDataType( Ascii ); }
     void setWritingDataTypeToExternalAscii() { this->setWritingDataType( ExternalAscii ); }
@@ -2,6 +2,8 @@
 #include <kvs/IgnoreUnusedVariable>
 #include <kvs/File>
 #include <kvs/Assert>
+#include <kvs/Message>
+#include <kvs/NumberParser>
 /****************************************************************************/
 /**
  *  @file   PTS.cpp
@@ -65,97 +67,40 @@ bool PTS::read( const std::string& filename )
     BaseClass::setSuccess( true );
 
     std::ifstream ifs( filename, std::ios::in);
+    if ( !ifs.is_open() )
+    {
+        kvsMessageError( "Cannot open %s.", filename.c_str() );
+        BaseClass::setSuccess( false );
+        return false;
+    }
 
     std::string line_buffer;
 
     // Read first line as num of points.
-    std::getline(ifs, line_buffer);    
-    m_npoints = std::stoi( line_buffer );    
+    std::getline(ifs, line_buffer);
+    m_npoints = kvs::NumberParser::To<kvs::UInt32>( line_buffer.c_str() );
 
     // Read second line as data components
-    std::getline(ifs, line_buffer);    
+    std::getline(ifs, line_buffer);
     // Count num of components in a line
-    std::vector<std::string> data;
-    data = this->split( line_buffer, ' ' );
-    m_ncomponents = data.size();    
-
-    kvs::ValueArray<kvs::Real32> coordinates( 3*m_npoints );
-    kvs::ValueArray<kvs::UInt8>  colors     ( 3*m_npoints );
+    m_ncomponents = this->split( line_buffer, ' ' ).size();
 
+    // Column indices of the color components (the intensity is used as
+    // the gray-scale color for the 4 components).
+    size_t column_r = 0;
+    size_t column_g = 0;
+    size_t column_b = 0;
     if( m_ncomponents == 4 )
     {
-        coordinates[0] = std::stof( data[0] );
-        coordinates[1] = std::stof( data[1] );
-        coordinates[2] = std::stof( data[2] );
-
-        colors[0] = (kvs::UInt8)std::stoi( data[3] );
-        colors[1] = (kvs::UInt8)std::stoi( data[3] );
-        colors[2] = (kvs::UInt8)std::stoi( data[3] );
-
-        for( int i = 1; i < m_npoints; i++ )
-        {
-            // Read lines
-            std::getline(ifs, line_buffer);
-            data = this->split( line_buffer, ' ' );
-
-            coordinates[3*i  ] = std::stof( data[0] );
-            coordinates[3*i+1] = std::stof( data[1] );
-            coordinates[3*i+2] = std::stof( data[2] );
-
-            colors[3*i  ] = (kvs::UInt8)std::stoi( data[3] );
-            colors[3*i+1] = (kvs::UInt8)std::stoi( data[3] );
-            colors[3*i+2] = (kvs::UInt8)std::stoi( data[3] );
-        }
+        column_r = 3; column_g = 3; column_b = 3;
     }
     else if( m_ncomponents == 6 || m_ncomponents == 9 )
     {
-        coordinates[0] = std::stof( data[0] );
-        coordinates[1] = std::stof( data[1] );
-        coordinates[2] = std::stof( data[2] );
-
-        colors[0] = (kvs::UInt8)std::stoi( data[3] );;
-        colors[1] = (kvs::UInt8)std::stoi( data[4] );
-        colors[2] = (kvs::UInt8)std::stoi( data[5] );
-
-        for( int i = 1; i < m_npoints; i++ )
-        {
-            // Read lines
-            std::getline(ifs, line_buffer);
-            data = this->split( line_buffer, ' ' );
-
-            coordinates[3*i  ] = std::stof( data[0] );
-            coordinates[3*i+1] = std::stof( data[1] );
-            coordinates[3*i+2] = std::stof( data[2] );
-
-            colors[3*i  ] = (kvs::UInt8)std::stoi( data[3] );
-            colors[3*i+1] = (kvs::UInt8)std::stoi( data[4] );
-            colors[3*i+2] = (kvs::UInt8)std::stoi( data[5] );
-        }
+        column_r = 3; column_g = 4; column_b = 5;
     }
     else if( m_ncomponents == 7 || m_ncomponents == 10 )
     {
-        coordinates[0] = std::stof( data[0] );
-        coordinates[1] = std::stof( data[1] );
-        coordinates[2] = std::stof( data[2] );
-
-        colors[0] = (kvs::UInt8)std::stoi( data[4] );;
-        colors[1] = (kvs::UInt8)std::stoi( data[5] );
-        colors[2] = (kvs::UInt8)std::stoi( data[6] );
-
-        for( int i = 1; i < m_npoints; i++ )
-        {
-            // Read lines
-            std::getline(ifs, line_buffer);
-            data = this->split( line_buffer, ' ' );
-
-            coordinates[3*i  ] = std::stof( data[0] );
-            coordinates[3*i+1] = std::stof( data[1] );
-            coordinates[3*i+2] = std::stof( data[2] );
-
-            colors[3*i  ] = (kvs::UInt8)std::stoi( data[4] );
-            colors[3*i+1] = (kvs::UInt8)std::stoi( data[5] );
-            colors[3*i+2] = (kvs::UInt8)std::stoi( data[6] );
-        }
+        column_r = 4; column_g = 5; column_b = 6;
     }
     else
     {
@@ -164,6 +109,27 @@ bool PTS::read( const std::string& filename )
         return false;
     }
 
+    kvs::ValueArray<kvs::Real32> coordinates( 3*m_npoints );
+    kvs::ValueArray<kvs::UInt8>  colors     ( 3*m_npoints );
+
+    for( size_t i = 0; i < m_npoints; i++ )
+    {
+        // Read lines (the second line has been read)
+        if ( i > 0 ) { std::getline(ifs, line_buffer); }
+
+        kvs::NumberParser parser( line_buffer.c_str() );
+        coordinates[3*i  ] = parser.next<kvs::Real32>();
+        coordinates[3*i+1] = parser.next<kvs::Real32>();
+        coordinates[3*i+2] = parser.next<kvs::Real32>();
+
+        int values[4] = { 0, 0, 0, 0 };
+        for( size_t j = 3; j <= column_b; j++ ) { values[j-3] = parser.next<int>(); }
+
+        colors[3*i  ] = static_cast<kvs::UInt8>( values[column_r-3] );
+        colors[3*i+1] = static_cast<kvs::UInt8>( values[column_g-3] );
+        colors[3*i+2] = static_cast<kvs::UInt8>( values[column_b-3] );
+    }
+
     m_coords = kvs::ValueArray<kvs::Real32>( coordinates );
     m_colors = kvs::ValueArray<UInt8>( colors );
 
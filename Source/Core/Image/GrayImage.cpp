@@ -462,7 +462,21 @@ void GrayImage::scale( const double ratio, Interpolator interpolator )
 {
     const size_t width = static_cast<size_t>( BaseClass::width() * ratio );
     const size_t height = static_cast<size_t>( BaseClass::height() * ratio );
-    BaseClass::resizeImage( width, height, this, interpolator );
+    this->resize( width, height, interpolator );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Scales the image data with the resampler.
+ *  @param  ratio [in] scaling ratio
+ *  @param  resampler [in] image resampler
+ */
+/*===========================================================================*/
+void GrayImage::scale( const double ratio, const kvs::ImageResampler& resampler )
+{
+    const size_t width = static_cast<size_t>( BaseClass::width() * ratio );
+    const size_t height = static_cast<size_t>( BaseClass::height() * ratio );
+    this->resize( width, height, resampler );
 }
 
 /*===========================================================================*/
@@ -475,9 +489,31 @@ void GrayImage::scale( const double ratio, Interpolator interpolator )
 /*===========================================================================*/
 void GrayImage::resize( const size_t width, const size_t height, Interpolator interpolator )
 {
+    // The built-in interpolators are replaced with the specialized resampler,
+    // which gives the same pixels.
+    kvs::ImageResampler::Method method;
+    if ( BaseClass::BuiltInMethod( interpolator, &method ) )
+    {
+        BaseClass::resizeImage( width, height, kvs::ImageResampler( method ) );
+        return;
+    }
+
     BaseClass::resizeImage( width, height, this, interpolator );
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Resizes the image data with the resampler.
+ *  @param  width  [in] resized width
+ *  @param  height [in] resized height
+ *  @param  resampler [in] image resampler
+ */
+/*===========================================================================*/
+void GrayImage::resize( const size_t width, const size_t height, const kvs::ImageResampler& resampler )
+{
+    BaseClass::resizeImage( width, height, resampler );
+}
+
 /*==========================================================================*/
 /**
  *  Read a image file.
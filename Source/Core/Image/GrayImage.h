@@ -63,7 +63,9 @@ public:
     void setPixel( const size_t i, const size_t j, const kvs::UInt8 pixel );
 
     void scale( const double ratio, Interpolator interpolator = Bilinear() );
+    void scale( const double ratio, const kvs::ImageResampler& resampler );
     void resize( const size_t width, const size_t height, Interpolator interpolator = Bilinear() );
+    void resize( const size_t width, const size_t height, const kvs::ImageResampler& resampler );
     bool read( const std::string& filename );
     bool write( const std::string& filename ) const;
 
@@ -9,6 +9,7 @@
 #include "GrayImage.h"
 #include "RGBColor.h"
 #include <kvs/Type>
+#include <kvs/Message>
 #include <utility>
 
 
@@ -92,6 +93,34 @@ kvs::RGBColor ImageBase::ColorBilinear( double u, double v, const ColorImage& im
     };
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns the resampling method equivalent to the built-in interpolator.
+ *  @param  interpolator [in] interpolator
+ *  @param  method [out] resampling method
+ *  @return true, if the interpolator is one of the built-in interpolators
+ */
+/*===========================================================================*/
+bool ImageBase::BuiltInMethod( const GrayInterpolator& interpolator, kvs::ImageResampler::Method* method )
+{
+    using Function = kvs::UInt8 (*)( double, double, const GrayImage& );
+    const Function* function = interpolator.target<Function>();
+    if ( !function ) { return false; }
+    if ( *function == GrayNearest ) { *method = kvs::ImageResampler::NearestNeighbor; return true; }
+    if ( *function == GrayBilinear ) { *method = kvs::ImageResampler::Bilinear; return true; }
+    return false;
+}
+
+bool ImageBase::BuiltInMethod( const ColorInterpolator& interpolator, kvs::ImageResampler::Method* method )
+{
+    using Function = kvs::RGBColor (*)( double, double, const ColorImage& );
+    const Function* function = interpolator.target<Function>();
+    if ( !function ) { return false; }
+    if ( *function == ColorNearest ) { *method = kvs::ImageResampler::NearestNeighbor; return true; }
+    if ( *function == ColorBilinear ) { *method = kvs::ImageResampler::Bilinear; return true; }
+    return false;
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Flip the image data.
@@ -228,6 +257,39 @@ void ImageBase::resizeImage(
     *image = resized_image;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Resizes the image data with the resampler.
+ *  @param  width [in] resized width
+ *  @param  height [in] resized height
+ *  @param  resampler [in] image resampler
+ */
+/*===========================================================================*/
+void ImageBase::resizeImage(
+    const size_t width,
+    const size_t height,
+    const kvs::ImageResampler& resampler )
+{
+    if ( m_bpp != 8 && m_bpp != 24 )
+    {
+        kvsMessageError("Not supported image type.");
+        return;
+    }
+
+    const auto type = static_cast<ImageType>( m_bpp / 8 );
+    const size_t nchannels = static_cast<size_t>( type );
+    PixelData pixels( width * height * nchannels );
+    if ( !resampler.resample(
+             m_pixels.data(), m_width, m_height, nchannels,
+             pixels.data(), width, height ) )
+    {
+        // The original pixels are kept if the resampling fails.
+        return;
+    }
+
+    this->create( width, height, type, pixels );
+}
+
 template void ImageBase::resizeImage<kvs::GrayImage,ImageBase::GrayInterpolator>(
     const size_t, const size_t, kvs::GrayImage*, GrayInterpolator );
 
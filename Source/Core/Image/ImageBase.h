@@ -11,6 +11,7 @@
 #include <kvs/Math>
 #include <kvs/RGBColor>
 #include <kvs/Deprecated>
+#include <kvs/ImageResampler>
 #include <functional>
 
 
@@ -45,6 +46,8 @@ protected:
     static kvs::UInt8 GrayBilinear( double u, double v, const GrayImage& image );
     static kvs::RGBColor ColorNearest( double u, double v, const ColorImage& image );
     static kvs::RGBColor ColorBilinear( double u, double v, const ColorImage& image );
+    static bool BuiltInMethod( const GrayInterpolator& interpolator, kvs::ImageResampler::Method* method );
+    static bool BuiltInMethod( const ColorInterpolator& interpolator, kvs::ImageResampler::Method* method );
 
 private:
     size_t m_width = 0; ///< image width [pix]
@@ -84,6 +87,11 @@ protected:
         Image* image,
         Interpolator interpolator );
 
+    void resizeImage(
+        const size_t width,
+        const size_t height,
+        const kvs::ImageResampler& resampler );
+
 public:
     KVS_DEPRECATED( const kvs::ValueArray<kvs::UInt8>& data() const ) { return this->pixels(); }
     KVS_DEPRECATED( kvs::ValueArray<kvs::UInt8>& data() ) { return this->pixelData(); }
@@ -0,0 +1,428 @@
+/****************************************************************************/
+/**
+ *  @file   ImageResampler.cpp
+ *  @author Naohisa Sakamoto
+ */
+/****************************************************************************/
+#include "ImageResampler.h"
+#include <vector>
+#include <limits>
+#include <kvs/Math>
+#include <kvs/Message>
+#include <kvs/OpenMP>
+#include <kvs/IgnoreUnusedVariable>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Resampling filter along an axis.
+ *
+ *  The i-th resampled value is the weighted sum of the source samples
+ *  indices[k] with weights[k] for k in [ offsets[i], offsets[i+1] ).
+ */
+/*===========================================================================*/
+struct Filter
+{
+    std::vector<size_t> offsets{ 0 }; ///< offsets to the samples
+    std::vector<size_t> indices{}; ///< source indices of the samples
+    std::vector<double> weights{}; ///< weights of the samples
+    size_t span = 0; ///< max. range of the source indices for a resampled value
+
+    void add( const size_t index, const double weight )
+    {
+        indices.push_back( index );
+        weights.push_back( weight );
+    }
+
+    void close()
+    {
+        const size_t first = indices[ offsets.back() ];
+        offsets.push_back( indices.size() );
+        span = kvs::Math::Max( span, indices.back() - first + 1 );
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the weight of Keys' cubic convolution kernel (a = -0.5).
+ *  @param  d [in] distance from the sampling position
+ *  @return weight
+ */
+/*===========================================================================*/
+inline double CubicWeight( const double d )
+{
+    const double a = -0.5;
+    const double x = kvs::Math::Abs( d );
+    if ( x <= 1.0 ) { return ( ( a + 2.0 ) * x - ( a + 3.0 ) ) * x * x + 1.0; }
+    if ( x < 2.0 ) { return ( ( a * x - 5.0 * a ) * x + 8.0 * a ) * x - 4.0 * a; }
+    return 0.0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the resampling filter along an axis.
+ *  @param  method [in] resampling method (except for the nearest neighbor)
+ *  @param  size [in] number of the source samples
+ *  @param  resized_size [in] number of the resampled values
+ *  @return resampling filter
+ */
+/*===========================================================================*/
+Filter MakeFilter(
+    const kvs::ImageResampler::Method method,
+    const size_t size,
+    const size_t resized_size )
+{
+    Filter filter;
+    const double ratio = size / static_cast<double>( resized_size );
+    for ( size_t i = 0; i < resized_size; i++ )
+    {
+        switch ( method )
+        {
+        case kvs::ImageResampler::Bicubic:
+        {
+            const double u = i * ratio;
+            const long x = kvs::Math::Floor( u );
+            const double t = u - static_cast<double>( x );
+            for ( long k = -1; k <= 2; k++ )
+            {
+                const long index = kvs::Math::Clamp( x + k, 0L, static_cast<long>( size - 1 ) );
+                filter.add( static_cast<size_t>( index ), ::CubicWeight( t - k ) );
+            }
+            break;
+        }
+        case kvs::ImageResampler::Area:
+        {
+            const double begin = i * ratio;
+            const double end = kvs::Math::Min( ( i + 1 ) * ratio, static_cast<double>( size ) );
+            const size_t x0 = static_cast<size_t>( kvs::Math::Floor( begin ) );
+            for ( size_t x = x0; x < size && x < end; x++ )
+            {
+                const double overlap = kvs::Math::Min( end, x + 1.0 ) - kvs::Math::Max( begin, double( x ) );
+                filter.add( x, kvs::Math::Max( overlap, 0.0 ) / ( end - begin ) );
+            }
+            break;
+        }
+        default:
+        {
+            // Same as the bilinear interpolator of the image classes.
+            const double u = i * ratio;
+            const size_t x0 = static_cast<size_t>( kvs::Math::Floor( u ) );
+            const size_t x1 = x0 + ( size - 1 > x0 ? 1 : 0 );
+            const double rate = u - static_cast<double>( x0 );
+            filter.add( x0, 1 - rate );
+            filter.add( x1, rate );
+            break;
+        }
+        }
+        filter.close();
+    }
+    return filter;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the rounded and saturated pixel value.
+ *  @param  value [in] value
+ *  @param  max_value [in] max. value of the pixel type
+ *  @return pixel value
+ */
+/*===========================================================================*/
+template <typename T>
+inline T Saturate( const double value, const double max_value )
+{
+    // Branchless form of the rounding with the saturation, which can be vectorized.
+    const double v = kvs::Math::Min( kvs::Math::Max( value, 0.0 ), max_value );
+    return static_cast<T>( static_cast<int>( v + 0.5 ) );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Resamples a row of the pixels along the horizontal axis.
+ *
+ *  The number of the samples K is fixed at compile time for the bilinear
+ *  and the bicubic filters, and it is variable for the area filter (K = 0).
+ *
+ *  @param  pixels [in] pointer to the source row
+ *  @param  filter [in] horizontal resampling filter
+ *  @param  row [out] pointer to the resampled row
+ */
+/*===========================================================================*/
+template <typename T, size_t C, size_t K>
+inline void FilterRow( const T* pixels, const Filter& filter, double* row )
+{
+    const size_t width = filter.offsets.size() - 1;
+    const size_t* indices = filter.indices.data();
+    const double* weights = filter.weights.data();
+    for ( size_t i = 0; i < width; i++ )
+    {
+        const size_t begin = K > 0 ? i * K : filter.offsets[i];
+        const size_t end = K > 0 ? begin + K : filter.offsets[ i + 1 ];
+
+        double value[C];
+        const T* p = pixels + indices[ begin ] * C;
+        const double w = weights[ begin ];
+        for ( size_t c = 0; c < C; c++ ) { value[c] = p[c] * w; }
+        for ( size_t k = begin + 1; k < end; k++ )
+        {
+            const T* q = pixels + indices[k] * C;
+            const double v = weights[k];
+            for ( size_t c = 0; c < C; c++ ) { value[c] += q[c] * v; }
+        }
+
+        for ( size_t c = 0; c < C; c++ ) { row[ i * C + c ] = value[c]; }
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Resamples the pixels by the nearest neighbor sampling.
+ */
+/*===========================================================================*/
+template <typename T, size_t C>
+void ResampleNearest(
+    const T* pixels,
+    const size_t width,
+    const size_t height,
+    T* resized_pixels,
+    const size_t resized_width,
+    const size_t resized_height,
+    const bool enable_mthreading )
+{
+    kvs::IgnoreUnusedVariable( enable_mthreading );
+
+    const double ratio_width = width / static_cast<double>( resized_width );
+    const double ratio_height = height / static_cast<double>( resized_height );
+    std::vector<size_t> xs( resized_width );
+    for ( size_t i = 0; i < resized_width; i++ )
+    {
+        xs[i] = static_cast<size_t>( kvs::Math::Floor( i * ratio_width ) ) * C;
+    }
+
+    const long H = static_cast<long>( resized_height );
+    KVS_OMP_PARALLEL_FOR( if( enable_mthreading ) schedule(static) )
+    for ( long j = 0; j < H; j++ )
+    {
+        const size_t y = static_cast<size_t>( kvs::Math::Floor( j * ratio_height ) );
+        const T* src = pixels + y * width * C;
+        T* dst = resized_pixels + j * resized_width * C;
+        for ( size_t i = 0; i < resized_width; i++ )
+        {
+            for ( size_t c = 0; c < C; c++ ) { dst[ i * C + c ] = src[ xs[i] + c ]; }
+        }
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Resamples the pixels by the separable filters.
+ *
+ *  The horizontally resampled source rows are cached in the slots indexed
+ *  by the row index modulo the vertical span of the filter, and each row of
+ *  the resized image is blended from the cached rows in a contiguous loop,
+ *  which can be vectorized by the compiler.
+ */
+/*===========================================================================*/
+template <typename T, size_t C, size_t K>
+void ResampleSeparable(
+    const kvs::ImageResampler::Method method,
+    const T* pixels,
+    const size_t width,
+    const size_t height,
+    T* resized_pixels,
+    const size_t resized_width,
+    const size_t resized_height,
+    const bool enable_mthreading )
+{
+    kvs::IgnoreUnusedVariable( enable_mthreading );
+
+    const Filter fx = ::MakeFilter( method, width, resized_width );
+    const Filter fy = ::MakeFilter( method, height, resized_height );
+    const size_t row_size = resized_width * C;
+    const size_t nslots = fy.span;
+    const double max_value = static_cast<double>( std::numeric_limits<T>::max() );
+
+    const long H = static_cast<long>( resized_height );
+    KVS_OMP_PARALLEL( if( enable_mthreading ) )
+    {
+        std::vector<double> rows( nslots * row_size );
+        std::vector<size_t> cached( nslots, std::numeric_limits<size_t>::max() );
+        std::vector<double> values( row_size );
+
+        KVS_OMP_FOR( schedule(static) )
+        for ( long j = 0; j < H; j++ )
+        {
+            const size_t begin = fy.offsets[j];
+            const size_t end = fy.offsets[ j + 1 ];
+            for ( size_t k = begin; k < end; k++ )
+            {
+                const size_t y = fy.indices[k];
+                const size_t slot = y % nslots;
+                double* row = rows.data() + slot * row_size;
+                if ( cached[ slot ] != y )
+                {
+                    ::FilterRow<T,C,K>( pixels + y * width * C, fx, row );
+                    cached[ slot ] = y;
+                }
+
+                // The last sample is blended with the rounding to the pixels.
+                const double w = fy.weights[k];
+                const double* r = row;
+                double* v = values.data();
+                T* dst = resized_pixels + j * row_size;
+                if ( k + 1 == end )
+                {
+                    if ( k == begin ) { for ( size_t n = 0; n < row_size; n++ ) { dst[n] = ::Saturate<T>( r[n] * w, max_value ); } }
+                    else { for ( size_t n = 0; n < row_size; n++ ) { dst[n] = ::Saturate<T>( v[n] + r[n] * w, max_value ); } }
+                }
+                else
+                {
+                    if ( k == begin ) { for ( size_t n = 0; n < row_size; n++ ) { v[n] = r[n] * w; } }
+                    else { for ( size_t n = 0; n < row_size; n++ ) { v[n] += r[n] * w; } }
+                }
+            }
+        }
+    }
+}
+
+template <typename T, size_t C>
+void Resample(
+    const kvs::ImageResampler::Method method,
+    const T* pixels,
+    const size_t width,
+    const size_t height,
+    T* resized_pixels,
+    const size_t resized_width,
+    const size_t resized_height,
+    const bool enable_mthreading )
+{
+    if ( method == kvs::ImageResampler::NearestNeighbor )
+    {
+        ::ResampleNearest<T,C>(
+            pixels, width, height,
+            resized_pixels, resized_width, resized_height,
+            enable_mthreading );
+    }
+    else if ( method == kvs::ImageResampler::Bilinear )
+    {
+        ::ResampleSeparable<T,C,2>(
+            method, pixels, width, height,
+            resized_pixels, resized_width, resized_height,
+            enable_mthreading );
+    }
+    else if ( method == kvs::ImageResampler::Bicubic )
+    {
+        ::ResampleSeparable<T,C,4>(
+            method, pixels, width, height,
+            resized_pixels, resized_width, resized_height,
+            enable_mthreading );
+    }
+    else
+    {
+        ::ResampleSeparable<T,C,0>(
+            method, pixels, width, height,
+            resized_pixels, resized_width, resized_height,
+            enable_mthreading );
+    }
+}
+
+template <typename T>
+bool Resample(
+    const kvs::ImageResampler::Method method,
+    const T* pixels,
+    const size_t width,
+    const size_t height,
+    const size_t nchannels,
+    T* resized_pixels,
+    const size_t resized_width,
+    const size_t resized_height,
+    const bool enable_mthreading )
+{
+    if ( resized_width == 0 || resized_height == 0 ) { return true; }
+    if ( width == 0 || height == 0 )
+    {
+        kvsMessageError("Source image is empty.");
+        return false;
+    }
+
+    switch ( nchannels )
+    {
+    case 1: ::Resample<T,1>( method, pixels, width, height, resized_pixels, resized_width, resized_height, enable_mthreading ); break;
+    case 2: ::Resample<T,2>( method, pixels, width, height, resized_pixels, resized_width, resized_height, enable_mthreading ); break;
+    case 3: ::Resample<T,3>( method, pixels, width, height, resized_pixels, resized_width, resized_height, enable_mthreading ); break;
+    case 4: ::Resample<T,4>( method, pixels, width, height, resized_pixels, resized_width, resized_height, enable_mthreading ); break;
+    default:
+    {
+        kvsMessageError("Not supported number of channels.");
+        return false;
+    }
+    }
+
+    return true;
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Resamples the 8-bit pixel data.
+ *  @param  pixels [in] pointer to the pixel data
+ *  @param  width [in] image width
+ *  @param  height [in] image height
+ *  @param  nchannels [in] number of channels (1 to 4)
+ *  @param  resized_pixels [out] pointer to the resized pixel data
+ *  @param  resized_width [in] resized image width
+ *  @param  resized_height [in] resized image height
+ *  @return true, if the pixel data is resampled successfully
+ */
+/*===========================================================================*/
+bool ImageResampler::resample(
+    const kvs::UInt8* pixels,
+    const size_t width,
+    const size_t height,
+    const size_t nchannels,
+    kvs::UInt8* resized_pixels,
+    const size_t resized_width,
+    const size_t resized_height ) const
+{
+    return ::Resample(
+        m_method, pixels, width, height, nchannels,
+        resized_pixels, resized_width, resized_height,
+        m_enable_mthreading );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Resamples the 16-bit pixel data.
+ *  @param  pixels [in] pointer to the pixel data
+ *  @param  width [in] image width
+ *  @param  height [in] image height
+ *  @param  nchannels [in] number of channels (1 to 4)
+ *  @param  resized_pixels [out] pointer to the resized pixel data
+ *  @param  resized_width [in] resized image width
+ *  @param  resized_height [in] resized image height
+ *  @return true, if the pixel data is resampled successfully
+ */
+/*===========================================================================*/
+bool ImageResampler::resample(
+    const kvs::UInt16* pixels,
+    const size_t width,
+    const size_t height,
+    const size_t nchannels,
+    kvs::UInt16* resized_pixels,
+    const size_t resized_width,
+    const size_t resized_height ) const
+{
+    return ::Resample(
+        m_method, pixels, width, height, nchannels,
+        resized_pixels, resized_width, resized_height,
+        m_enable_mthreading );
+}
+
+} // end of namespace kvs
@@ -0,0 +1,77 @@
+/****************************************************************************/
+/**
+ *  @file   ImageResampler.h
+ *  @author Naohisa Sakamoto
+ */
+/****************************************************************************/
+#pragma once
+#include <cstddef>
+#include <kvs/Type>
+
+
+namespace kvs
+{
+
+/*==========================================================================*/
+/**
+ *  @brief  Image resampler class.
+ *
+ *  The pixel data with an arbitrary number of interleaved channels is
+ *  resampled by the separable filters specialized for each method. The
+ *  pixel (i,j) of the resized image is sampled at the position
+ *  ( i * width / resized_width, j * height / resized_height ) of the
+ *  original image, which is the same as the interpolators of the
+ *  kvs::GrayImage and kvs::ColorImage, and the nearest neighbor and the
+ *  bilinear methods give the same pixels as the interpolators. For each
+ *  row of the resized image, the source rows are filtered horizontally
+ *  and cached, and then they are blended vertically over the whole row.
+ *  The rows are resampled in parallel if multi-threading is enabled.
+ */
+/*==========================================================================*/
+class ImageResampler
+{
+public:
+    enum Method
+    {
+        NearestNeighbor, ///< nearest neighbor sampling
+        Bilinear, ///< bilinear interpolation
+        Bicubic, ///< bicubic interpolation (Keys' cubic convolution with a = -0.5)
+        Area ///< area averaging (box filter over the pixel footprint)
+    };
+
+private:
+    Method m_method = Bilinear; ///< resampling method
+    bool m_enable_mthreading = false; ///< flag for multi-threading
+
+public:
+    ImageResampler() = default;
+    ImageResampler( const Method method ): m_method( method ) {}
+
+    Method method() const { return m_method; }
+    void setMethod( const Method method ) { m_method = method; }
+
+    bool isEnabledMultiThreading() const { return m_enable_mthreading; }
+    void setEnabledMultiThreading( const bool enable ) { m_enable_mthreading = enable; }
+    void enableMultiThreading() { this->setEnabledMultiThreading( true ); }
+    void disableMultiThreading() { this->setEnabledMultiThreading( false ); }
+
+    bool resample(
+        const kvs::UInt8* pixels,
+        const size_t width,
+        const size_t height,
+        const size_t nchannels,
+        kvs::UInt8* resized_pixels,
+        const size_t resized_width,
+        const size_t resized_height ) const;
+
+    bool resample(
+        const kvs::UInt16* pixels,
+        const size_t width,
+        const size_t height,
+        const size_t nchannels,
+        kvs::UInt16* resized_pixels,
+        const size_t resized_width,
+        const size_t resized_height ) const;
+};
+
+} // end of namespace kvs
@@ -9,27 +9,73 @@
  * [1] D. Arthur and S. Vassilvitskii, k-means++ : The Advantages of Careful
  *     Seeding, in Proceedings of the eighteenth annual ACM-SIAM symposium on
  *     Discrete algorithms, 2007, pp. 1027-1035.
+ * [2] Greg Hamerly, Making k-means even faster, In proceedings of the 2010 SIAM
+ *     international conference on data mining (SDM 2010), April 2010.
+ * [3] D. Sculley, Web-scale k-means clustering, In Proceedings of the 19th
+ *     international conference on World Wide Web, 2010, pp. 1177-1178.
  */
 /*****************************************************************************/
 #include "KMeans.h"
+#include <vector>
+#include <cmath>
 #include <kvs/Value>
 #include <kvs/Message>
 #include <kvs/Math>
+#include <kvs/OpenMP>
+#include <kvs/IgnoreUnusedVariable>
 
 
 namespace
 {
 
+// Columns of the table data as float arrays.
+typedef std::vector< kvs::ValueArray<kvs::Real32> > Columns;
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the columns of the table data as float arrays.
+ *
+ *  The columns of float values are shared with the table data, and the
+ *  other columns are converted to float once, so that the values are read
+ *  without the type conversion in the iterations.
+ *
+ *  @param  table [in] table data
+ *  @return columns
+ */
+/*===========================================================================*/
+inline Columns GetColumns( const kvs::AnyValueTable& table )
+{
+    Columns columns( table.columnSize() );
+    for ( size_t i = 0; i < table.columnSize(); i++ )
+    {
+        const kvs::AnyValueArray& column = table.column(i);
+        if ( column.typeID() == kvs::Type::TypeReal32 )
+        {
+            columns[i] = column.asValueArray<kvs::Real32>();
+        }
+        else
+        {
+            columns[i].allocate( column.size() );
+            for ( size_t j = 0; j < column.size(); j++ )
+            {
+                columns[i][j] = column.at<kvs::Real32>(j);
+            }
+        }
+    }
+
+    return columns;
+}
+
 inline kvs::Real32 GetEuclideanDistance(
-    const kvs::AnyValueTable& table,
-    const kvs::UInt32 row_index,
+    const Columns& columns,
+    const size_t row_index,
     const kvs::ValueArray<kvs::Real32>& center )
 {
     kvs::Real32 distance = 0.0;
-    for ( size_t i = 0; i < table.columnSize(); i++ )
+    for ( size_t i = 0; i < columns.size(); i++ )
     {
         const kvs::Real32 x0 = center[i];
-        const kvs::Real32 x1 = table.column(i).at<kvs::Real32>( row_index );
+        const kvs::Real32 x1 = columns[i][ row_index ];
         distance += ( x1 - x0 ) * ( x1 - x0 );
     }
 
@@ -37,12 +83,11 @@ inline kvs::Real32 GetEuclideanDistance(
 }
 
 inline kvs::Real32 GetEuclideanDistance(
-    const kvs::AnyValueTable& table,
     const kvs::ValueArray<kvs::Real32>& center_old,
     const kvs::ValueArray<kvs::Real32>& center_new )
 {
     kvs::Real32 distance = 0.0;
-    for ( size_t i = 0; i < table.columnSize(); i++ )
+    for ( size_t i = 0; i < center_old.size(); i++ )
     {
         const kvs::Real32 x0 = center_old[i];
         const kvs::Real32 x1 = center_new[i];
@@ -52,106 +97,181 @@ inline kvs::Real32 GetEuclideanDistance(
     return distance;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of the chunks of the rows processed in parallel.
+ *  @param  enable_mthreading [in] flag for multi-threading
+ *  @return number of the chunks
+ */
+/*===========================================================================*/
+inline int NumberOfChunks( const bool enable_mthreading )
+{
+    return enable_mthreading ? kvs::Math::Max( 1, kvs::OpenMP::GetMaxThreads() ) : 1;
 }
 
-namespace
+/*===========================================================================*/
+/**
+ *  @brief  Finds the nearest cluster center.
+ *  @param  columns [in] columns of the table data
+ *  @param  row_index [in] row index
+ *  @param  nclusters [in] number of clusters
+ *  @param  centers [in] cluster centers
+ *  @param  distance [out] squared distance to the nearest center
+ *  @param  second [out] squared distance to the second nearest center (optional)
+ *  @return index of the nearest center
+ */
+/*===========================================================================*/
+inline kvs::UInt32 FindNearestCenter(
+    const Columns& columns,
+    const size_t row_index,
+    const size_t nclusters,
+    const kvs::ValueArray<kvs::Real32>* centers,
+    kvs::Real32* distance,
+    kvs::Real32* second = NULL )
 {
+    kvs::UInt32 id = 0;
+    kvs::Real32 dmin1 = kvs::Value<kvs::Real32>::Max();
+    kvs::Real32 dmin2 = kvs::Value<kvs::Real32>::Max();
+    for ( size_t j = 0; j < nclusters; j++ )
+    {
+        const kvs::Real32 d = ::GetEuclideanDistance( columns, row_index, centers[j] );
+        if ( d < dmin1 ) { dmin2 = dmin1; dmin1 = d; id = kvs::UInt32( j ); }
+        else if ( d < dmin2 ) { dmin2 = d; }
+    }
+
+    *distance = dmin1;
+    if ( second ) { *second = dmin2; }
+    return id;
+}
 
 /*===========================================================================*/
 /**
- *  @brief  Calculates the cluster centroid.
- *  @param  table [in] table data
- *  @param  cluster_id [in] target cluster ID
+ *  @brief  Calculates the cluster centroids.
+ *
+ *  The rows are divided into the chunks, and the values of the rows in each
+ *  chunk are summed up in the order of the rows. The sums of the chunks are
+ *  added in the order of the chunks, so that the centroids do not depend on
+ *  the scheduling of the threads.
+ *
+ *  @param  columns [in] columns of the table data
  *  @param  ids [in] cluster ID array
- *  @param  center [out] cluster centroid
+ *  @param  nclusters [in] number of clusters
+ *  @param  nchunks [in] number of the chunks
+ *  @param  centers [out] cluster centroids
  */
 /*===========================================================================*/
-inline void CalculateCenter(
-    const kvs::AnyValueTable& table,
-    const kvs::UInt32 cluster_id,
+inline void CalculateCenters(
+    const Columns& columns,
     const kvs::ValueArray<kvs::UInt32>& ids,
-    kvs::ValueArray<kvs::Real32>* center )
+    const size_t nclusters,
+    const int nchunks,
+    kvs::ValueArray<kvs::Real32>* centers )
 {
-    const size_t nrows = table.column(0).size();
-    const size_t ncolumns = table.columnSize();
-
-    for ( size_t j = 0; j < ncolumns; j++ ) { center->at(j) = 0.0; }
-
-    size_t counter = 0;
-    for ( size_t j = 0; j < nrows; j++ )
+    const size_t nrows = ids.size();
+    const size_t ncolumns = columns.size();
+    const size_t chunk_size = ( nrows + nchunks - 1 ) / nchunks;
+    std::vector<kvs::Real32> sums( nchunks * nclusters * ncolumns, 0.0f );
+    std::vector<size_t> counters( nchunks * nclusters, 0 );
+
+    KVS_OMP_PARALLEL_FOR( schedule(static) )
+    for ( int c = 0; c < nchunks; c++ )
     {
-        if ( ids[j] == cluster_id )
+        kvs::Real32* sum = &sums[ c * nclusters * ncolumns ];
+        size_t* counter = &counters[ c * nclusters ];
+        const size_t end = kvs::Math::Min( nrows, ( c + 1 ) * chunk_size );
+        for ( size_t j = c * chunk_size; j < end; j++ )
         {
+            const kvs::UInt32 id = ids[j];
+            if ( id >= nclusters ) { continue; }
             for ( size_t k = 0; k < ncolumns; k++ )
             {
-                center->at(k) += table.column(k).at<kvs::Real32>(j);
+                sum[ id * ncolumns + k ] += columns[k][j];
             }
-            counter++;
+            counter[id]++;
         }
     }
-    if ( counter != 0 )
+
+    for ( size_t i = 0; i < nclusters; i++ )
     {
-        for ( size_t k = 0; k < ncolumns; k++ ) { center->at(k) /= counter; }
+        size_t counter = 0;
+        for ( size_t k = 0; k < ncolumns; k++ ) { centers[i][k] = 0.0; }
+        for ( int c = 0; c < nchunks; c++ )
+        {
+            const kvs::Real32* sum = &sums[ ( c * nclusters + i ) * ncolumns ];
+            for ( size_t k = 0; k < ncolumns; k++ ) { centers[i][k] += sum[k]; }
+            counter += counters[ c * nclusters + i ];
+        }
+        if ( counter != 0 )
+        {
+            for ( size_t k = 0; k < ncolumns; k++ ) { centers[i][k] /= counter; }
+        }
     }
 }
 
 /*===========================================================================*/
 /**
  *  @brief  Initialize centers of clusters with random seeding method.
- *  @param  table [in] pointer to table
+ *  @param  columns [in] columns of the table data
  *  @param  nclusters [in] number of clusters
  *  @param  ids [i]
  *  @param  centers [in/out] pointer to center array
  */
 /*===========================================================================*/
 inline void InitializeCentersWithRandomSeeding(
-    const kvs::AnyValueTable& table,
+    const Columns& columns,
     const size_t nclusters,
     const kvs::ValueArray<kvs::UInt32>& ids,
     kvs::ValueArray<kvs::Real32>* centers )
 {
-    for ( size_t i = 0; i < nclusters; i++ )
-    {
-        CalculateCenter( table, i, ids, &centers[i] );
-    }
+    ::CalculateCenters( columns, ids, nclusters, 1, centers );
 }
 
 /*===========================================================================*/
 /**
  *  @brief  Initialize centers of clusters with k-means++.
- *  @param  table [in] table data
+ *
+ *  The squared distance from each row to the nearest center is updated
+ *  with the center added in the previous step.
+ *
+ *  @param  columns [in] columns of the table data
  *  @param  nclusters [in] number of clusters
  *  @param  ids [i]
+ *  @param  enable_mthreading [in] flag for multi-threading
  *  @param  centers [in/out] pointer to center array
  */
 /*===========================================================================*/
 inline void InitializeCentersWithSmartSeeding(
-    const kvs::AnyValueTable& table,
+    const Columns& columns,
     const size_t nclusters,
     const kvs::ValueArray<kvs::UInt32>& ids,
+    const bool enable_mthreading,
     kvs::ValueArray<kvs::Real32>* centers )
 {
-    const size_t nrows = table.column(0).size();
-    const size_t ncolumns = table.columnSize();
+    kvs::IgnoreUnusedVariable( enable_mthreading );
+
+    const size_t nrows = ids.size();
+    const size_t ncolumns = columns.size();
+
+    // The rows with the cluster ID 0 are used for the first center.
+    ::CalculateCenters( columns, ids, 1, 1, centers );
 
-    CalculateCenter( table, 0, ids, &(centers[0]) );
+    kvs::ValueArray<kvs::Real32> D( nrows );
+    D.fill( kvs::Value<kvs::Real32>::Max() );
 
+    const long nrows_long = static_cast<long>( nrows );
     for ( size_t i = 1; i < nclusters; i++ )
     {
-        kvs::Real32 S = 0.0;
-        kvs::Real32* D = new kvs::Real32 [ nrows ];
-        for ( size_t j = 0; j < nrows; j++ )
+        const kvs::ValueArray<kvs::Real32>& center = centers[ i - 1 ];
+        KVS_OMP_PARALLEL_FOR( if( enable_mthreading ) schedule(static) )
+        for ( long j = 0; j < nrows_long; j++ )
         {
-            kvs::Real32 distance = kvs::Value<kvs::Real32>::Max();
-            for ( size_t k = 0; k < nclusters; k++ )
-            {
-                const kvs::Real32 d = ::GetEuclideanDistance( table, j, centers[k] );
-                if ( d < distance ) { distance = d; }
-            }
-            D[j] = distance;
-            S += distance * distance;
+            const kvs::Real32 d = ::GetEuclideanDistance( columns, j, center );
+            if ( d < D[j] ) { D[j] = d; }
         }
 
+        kvs::Real32 S = 0.0;
+        for ( size_t j = 0; j < nrows; j++ ) { S += D[j] * D[j]; }
+
         size_t index = 0;
         kvs::Real32 P = 0.0;
         for ( size_t j = 0; j < nrows; j++ )
@@ -166,9 +286,8 @@ inline void InitializeCentersWithSmartSeeding(
 
         for ( size_t j = 0; j < ncolumns; j++ )
         {
-            centers[i].at(j) = table.column(j).at<kvs::Real32>(index);
+            centers[i].at(j) = columns[j][ index ];
         }
-        delete [] D;
     }
 }
 
@@ -202,7 +321,12 @@ void KMeans::run()
         }
     }
 
+    const Columns columns = ::GetColumns( m_input_table );
+    const int nchunks = ::NumberOfChunks( m_enable_mthreading );
+    const long nrows_long = static_cast<long>( nrows );
+
     // Allocate memory for the cluster center.
+    if ( m_cluster_centers ) { delete [] m_cluster_centers; }
     m_cluster_centers = new kvs::ValueArray<kvs::Real32> [ m_nclusters ];
     for ( size_t i = 0; i < m_nclusters; i++ ) { m_cluster_centers[i].allocate( ncolumns ); }
 
@@ -214,18 +338,89 @@ void KMeans::run()
     switch ( m_seeding_method )
     {
     case RandomSeeding:
-        ::InitializeCentersWithRandomSeeding( m_input_table, m_nclusters, IDs, m_cluster_centers );
+        ::InitializeCentersWithRandomSeeding( columns, m_nclusters, IDs, m_cluster_centers );
         break;
     case SmartSeeding:
-        ::InitializeCentersWithSmartSeeding( m_input_table, m_nclusters, IDs, m_cluster_centers );
+        ::InitializeCentersWithSmartSeeding( columns, m_nclusters, IDs, m_enable_mthreading, m_cluster_centers );
         break;
     default:
-        ::InitializeCentersWithRandomSeeding( m_input_table, m_nclusters, IDs, m_cluster_centers );
+        ::InitializeCentersWithRandomSeeding( columns, m_nclusters, IDs, m_cluster_centers );
         break;
     }
 
-    // Cluster center used for convergence test.
-    kvs::ValueArray<kvs::Real32> center_new( ncolumns );
+    // Mini-batch clustering.
+    if ( m_batch_size > 0 && m_batch_size < nrows )
+    {
+        const size_t nsamples = m_batch_size;
+        const long nsamples_long = static_cast<long>( nsamples );
+        kvs::ValueArray<kvs::UInt32> samples( nsamples );
+        kvs::ValueArray<kvs::UInt32> sample_ids( nsamples );
+        std::vector< kvs::ValueArray<kvs::Real32> > centers_old( m_nclusters );
+        std::vector<size_t> counters( m_nclusters, 0 );
+        for ( size_t counter = 0; counter < m_max_iterations; counter++ )
+        {
+            // Assign the randomly sampled rows to the nearest centers.
+            for ( size_t i = 0; i < nsamples; i++ )
+            {
+                samples[i] = kvs::UInt32( kvs::Math::Min( nrows - 1, size_t( nrows * m_random() ) ) );
+            }
+
+            KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(static) )
+            for ( long i = 0; i < nsamples_long; i++ )
+            {
+                kvs::Real32 distance = 0.0f;
+                sample_ids[i] = ::FindNearestCenter( columns, samples[i], m_nclusters, m_cluster_centers, &distance );
+            }
+
+            // Move the centers toward the rows with the per-center learning rate.
+            for ( size_t i = 0; i < m_nclusters; i++ ) { centers_old[i] = m_cluster_centers[i].clone(); }
+            for ( size_t i = 0; i < nsamples; i++ )
+            {
+                const kvs::UInt32 id = sample_ids[i];
+                const kvs::Real32 eta = 1.0f / ++counters[id];
+                for ( size_t k = 0; k < ncolumns; k++ )
+                {
+                    const kvs::Real32 x = columns[k][ samples[i] ];
+                    m_cluster_centers[id][k] += eta * ( x - m_cluster_centers[id][k] );
+                }
+            }
+
+            kvs::Real32 movement = 0.0f;
+            for ( size_t i = 0; i < m_nclusters; i++ )
+            {
+                movement = kvs::Math::Max( movement, ::GetEuclideanDistance( centers_old[i], m_cluster_centers[i] ) );
+            }
+
+            if ( movement < m_tolerance ) break;
+        }
+
+        // Assign all of the rows to the nearest centers.
+        KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(static) )
+        for ( long i = 0; i < nrows_long; i++ )
+        {
+            kvs::Real32 distance = 0.0f;
+            IDs[i] = ::FindNearestCenter( columns, i, m_nclusters, m_cluster_centers, &distance );
+        }
+
+        m_cluster_ids = IDs;
+        return;
+    }
+
+    // Cluster centers used for convergence test.
+    kvs::ValueArray<kvs::Real32>* centers_new = new kvs::ValueArray<kvs::Real32> [ m_nclusters ];
+    for ( size_t i = 0; i < m_nclusters; i++ ) { centers_new[i].allocate( ncolumns ); }
+
+    // Upper and lower bounds of the distance from each row to the nearest
+    // center and the other centers, and the parameters of the centers for
+    // the bounded assignment.
+    /*   p: distance that the center last moved
+     *   s: half distance from the center to its closest other center
+     */
+    const bool bounded = m_enable_bounded_assignment && m_nclusters > 1;
+    kvs::ValueArray<kvs::Real32> upper( bounded ? nrows : 0 );
+    kvs::ValueArray<kvs::Real32> lower( bounded ? nrows : 0 );
+    kvs::ValueArray<kvs::Real32> p( m_nclusters );
+    kvs::ValueArray<kvs::Real32> s( m_nclusters );
 
     // Clustering.
     bool converged = false;
@@ -233,25 +428,59 @@ void KMeans::run()
     while ( !converged )
     {
         // Calculate euclidean distance between the center of cluster and the point, and update the IDs.
-        for ( size_t i = 0; i < nrows; i++ )
+        if ( bounded && counter > 0 )
         {
-            size_t id = 0;
-            kvs::Real32 distance = kvs::Value<kvs::Real32>::Max();
-            for ( size_t j = 0; j < m_nclusters; j++ )
+            for ( size_t i = 0; i < m_nclusters; i++ )
             {
-                const kvs::Real32 d = ::GetEuclideanDistance( m_input_table, i, m_cluster_centers[j] );
-                if ( d < distance ) { distance = d; id = j; }
+                kvs::Real32 dmin = kvs::Value<kvs::Real32>::Max();
+                for ( size_t j = 0; j < m_nclusters; j++ )
+                {
+                    if ( i == j ) { continue; }
+                    const kvs::Real32 d = ::GetEuclideanDistance( m_cluster_centers[i], m_cluster_centers[j] );
+                    dmin = kvs::Math::Min( dmin, d );
+                }
+                s[i] = 0.5f * std::sqrt( dmin );
+            }
+
+            KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(static) )
+            for ( long i = 0; i < nrows_long; i++ )
+            {
+                const kvs::Real32 m = kvs::Math::Max( s[ IDs[i] ], lower[i] );
+                if ( upper[i] <= m ) { continue; }
+
+                // Tighten the upper bound.
+                upper[i] = std::sqrt( ::GetEuclideanDistance( columns, i, m_cluster_centers[ IDs[i] ] ) );
+                if ( upper[i] <= m ) { continue; }
+
+                kvs::Real32 d1 = 0.0f;
+                kvs::Real32 d2 = 0.0f;
+                IDs[i] = ::FindNearestCenter( columns, i, m_nclusters, m_cluster_centers, &d1, &d2 );
+                upper[i] = std::sqrt( d1 );
+                lower[i] = std::sqrt( d2 );
+            }
+        }
+        else
+        {
+            KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(static) )
+            for ( long i = 0; i < nrows_long; i++ )
+            {
+                kvs::Real32 d1 = 0.0f;
+                kvs::Real32 d2 = 0.0f;
+                IDs[i] = ::FindNearestCenter( columns, i, m_nclusters, m_cluster_centers, &d1, &d2 );
+                if ( bounded )
+                {
+                    upper[i] = std::sqrt( d1 );
+                    lower[i] = std::sqrt( d2 );
+                }
             }
-            IDs[i] = id;
         }
 
         // Convergence test.
+        ::CalculateCenters( columns, IDs, m_nclusters, nchunks, centers_new );
         converged = true;
         for ( size_t i = 0; i < m_nclusters; i++ )
         {
-            ::CalculateCenter( m_input_table, i, IDs, &center_new );
-
-            const kvs::Real32 distance = ::GetEuclideanDistance( m_input_table, m_cluster_centers[i], center_new );
+            const kvs::Real32 distance = ::GetEuclideanDistance( m_cluster_centers[i], centers_new[i] );
             if ( !( distance < m_tolerance ) )
             {
                 converged = false;
@@ -266,12 +495,30 @@ void KMeans::run()
         {
             for ( size_t i = 0; i < m_nclusters; i++ )
             {
-                ::CalculateCenter( m_input_table, i, IDs, &(m_cluster_centers[i]) );
+                p[i] = std::sqrt( ::GetEuclideanDistance( m_cluster_centers[i], centers_new[i] ) );
+                for ( size_t k = 0; k < ncolumns; k++ ) { m_cluster_centers[i][k] = centers_new[i][k]; }
+            }
+
+            // Update the bounds with the movements of the centers.
+            if ( bounded )
+            {
+                size_t r = 0;
+                for ( size_t i = 1; i < m_nclusters; i++ ) { if ( p[i] > p[r] ) { r = i; } }
+                kvs::Real32 pmax2 = 0.0f;
+                for ( size_t i = 0; i < m_nclusters; i++ ) { if ( i != r ) { pmax2 = kvs::Math::Max( pmax2, p[i] ); } }
+
+                KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(static) )
+                for ( long i = 0; i < nrows_long; i++ )
+                {
+                    upper[i] += p[ IDs[i] ];
+                    lower[i] -= ( IDs[i] == r ) ? pmax2 : p[r];
+                }
             }
         }
 
     } // end of while
 
+    delete [] centers_new;
     m_cluster_ids = IDs;
 }
 
@@ -9,6 +9,10 @@
  * [1] D. Arthur and S. Vassilvitskii, k-means++ : The Advantages of Careful
  *     Seeding, in Proceedings of the eighteenth annual ACM-SIAM symposium on
  *     Discrete algorithms, 2007, pp. 1027-1035.
+ * [2] Greg Hamerly, Making k-means even faster, In proceedings of the 2010 SIAM
+ *     international conference on data mining (SDM 2010), April 2010.
+ * [3] D. Sculley, Web-scale k-means clustering, In Proceedings of the 19th
+ *     international conference on World Wide Web, 2010, pp. 1177-1178.
  */
 /*****************************************************************************/
 #pragma once
@@ -23,6 +27,13 @@ namespace kvs
 /*===========================================================================*/
 /**
  *  @brief  K-means clustering class.
+ *
+ *  In addition to the Lloyd's iterations, the rows can be assigned to the
+ *  clusters with the upper and lower bounds of the distances based on the
+ *  triangle inequality [2], which skip most of the distance calculations
+ *  and give the same clusters. For the large table, the cluster centers
+ *  can be updated with the randomly sampled rows (mini-batch) [3], and
+ *  then all of the rows are assigned to the nearest centers once.
  */
 /*===========================================================================*/
 class KMeans
@@ -40,6 +51,9 @@ private:
     size_t m_nclusters = 1; ///< number of clusters
     size_t m_max_iterations = 100; ///< maximum number of interations
     float m_tolerance = 1.e-6; ///< tolerance of distance
+    bool m_enable_mthreading = false; ///< flag for multi-threading
+    bool m_enable_bounded_assignment = false; ///< flag for the assignment with distance bounds
+    size_t m_batch_size = 0; ///< number of rows in a mini-batch (0: all of the rows)
     kvs::AnyValueTable m_input_table{}; ///< input table data
     kvs::ValueArray<kvs::UInt32> m_cluster_ids{}; ///< cluster IDs
     kvs::ValueArray<kvs::Real32>* m_cluster_centers = nullptr; ///< cluster centers
@@ -54,11 +68,21 @@ public:
     void setMaxIterations( const size_t max_iterations ) { m_max_iterations = max_iterations; }
     void setTolerance( const float tolerance ) { m_tolerance = tolerance; }
     void setInputTableData( const kvs::AnyValueTable& table ) { m_input_table = table; }
+    void setEnabledMultiThreading( const bool enable ) { m_enable_mthreading = enable; }
+    void enableMultiThreading() { this->setEnabledMultiThreading( true ); }
+    void disableMultiThreading() { this->setEnabledMultiThreading( false ); }
+    void setBoundedAssignmentEnabled( const bool enable ) { m_enable_bounded_assignment = enable; }
+    void enableBoundedAssignment() { this->setBoundedAssignmentEnabled( true ); }
+    void disableBoundedAssignment() { this->setBoundedAssignmentEnabled( false ); }
+    void setBatchSize( const size_t batch_size ) { m_batch_size = batch_size; }
 
     SeedingMethod seedingMethod() const { return m_seeding_method; }
     size_t numberOfClusters() const { return m_nclusters; }
     size_t maxIterations() const { return m_max_iterations; }
     float tolerance() const { return m_tolerance; }
+    bool isEnabledMultiThreading() const { return m_enable_mthreading; }
+    bool isBoundedAssignmentEnabled() const { return m_enable_bounded_assignment; }
+    size_t batchSize() const { return m_batch_size; }
 
     void run();
     const kvs::ValueArray<kvs::UInt32>& clusterIDs() const { return m_cluster_ids; }
@@ -0,0 +1,132 @@
+/*****************************************************************************/
+/**
+ *  @file   MappedFile.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "MappedFile.h"
+#include <kvs/Type>
+#include <kvs/Platform>
+#if defined ( KVS_PLATFORM_WINDOWS )
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Deleter to unmap the region.
+ */
+/*===========================================================================*/
+struct Unmapper
+{
+    void* base; ///< start address of the mapped pages
+    size_t length; ///< byte length of the mapped pages
+
+    void operator ()( void* ) const
+    {
+#if defined ( KVS_PLATFORM_WINDOWS )
+        UnmapViewOfFile( base );
+#else
+        munmap( base, length );
+#endif
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the alignment of the offset for mapping.
+ *  @return alignment in bytes
+ */
+/*===========================================================================*/
+size_t Granularity()
+{
+#if defined ( KVS_PLATFORM_WINDOWS )
+    SYSTEM_INFO info;
+    GetSystemInfo( &info );
+    return static_cast<size_t>( info.dwAllocationGranularity );
+#else
+    return static_cast<size_t>( sysconf( _SC_PAGESIZE ) );
+#endif
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Maps the region of the file.
+ *  @param  filename [in] filename
+ *  @param  offset [in] offset of the region in bytes
+ *  @param  size [in] size of the region in bytes
+ *  @return shared pointer to the mapped region (null if failed)
+ */
+/*===========================================================================*/
+kvs::SharedPointer<void> MappedFile::Map( const std::string& filename, const size_t offset, const size_t size )
+{
+    if ( size == 0 ) { return kvs::SharedPointer<void>(); }
+
+    // The mapping starts at the aligned offset.
+    const size_t granularity = ::Granularity();
+    const size_t aligned_offset = offset - offset % granularity;
+    const size_t length = size + ( offset - aligned_offset );
+
+#if defined ( KVS_PLATFORM_WINDOWS )
+    HANDLE file = CreateFileA(
+        filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+    if ( file == INVALID_HANDLE_VALUE ) { return kvs::SharedPointer<void>(); }
+
+    LARGE_INTEGER file_size;
+    if ( !GetFileSizeEx( file, &file_size ) || kvs::UInt64( file_size.QuadPart ) < kvs::UInt64( offset + size ) )
+    {
+        CloseHandle( file );
+        return kvs::SharedPointer<void>();
+    }
+
+    HANDLE mapping = CreateFileMappingA( file, NULL, PAGE_WRITECOPY, 0, 0, NULL );
+    CloseHandle( file );
+    if ( !mapping ) { return kvs::SharedPointer<void>(); }
+
+    const kvs::UInt64 view_offset = aligned_offset;
+    void* base = MapViewOfFile(
+        mapping, FILE_MAP_COPY,
+        static_cast<DWORD>( view_offset >> 32 ),
+        static_cast<DWORD>( view_offset & 0xFFFFFFFF ),
+        length );
+    // The view keeps the mapping object alive.
+    CloseHandle( mapping );
+    if ( !base ) { return kvs::SharedPointer<void>(); }
+#else
+    const int fd = open( filename.c_str(), O_RDONLY );
+    if ( fd < 0 ) { return kvs::SharedPointer<void>(); }
+
+    struct stat file_stat;
+    if ( fstat( fd, &file_stat ) != 0 || kvs::UInt64( file_stat.st_size ) < kvs::UInt64( offset + size ) )
+    {
+        close( fd );
+        return kvs::SharedPointer<void>();
+    }
+
+    void* base = mmap( NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, static_cast<off_t>( aligned_offset ) );
+    // The mapping keeps the file referenced.
+    close( fd );
+    if ( base == MAP_FAILED ) { return kvs::SharedPointer<void>(); }
+#endif
+
+    void* data = static_cast<char*>( base ) + ( offset - aligned_offset );
+    ::Unmapper unmapper = { base, length };
+    return kvs::SharedPointer<void>( data, unmapper );
+}
+
+} // end of namespace kvs
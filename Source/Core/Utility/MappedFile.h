@@ -0,0 +1,58 @@
+/*****************************************************************************/
+/**
+ *  @file   MappedFile.h
+ *  @author Naohisa Sakamoto
+ *  @brief  Memory-mapped file region shared by the value arrays
+ */
+/*****************************************************************************/
+#pragma once
+#include <string>
+#include <kvs/SharedPointer>
+#include <kvs/ValueArray>
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Memory-mapped file class.
+ *
+ *  A region of the file is mapped into the memory and returned as the shared
+ *  pointer, whose deleter unmaps the region, so that the value array can
+ *  refer to the file data without reading and copying it. The pages are
+ *  read from the file when they are accessed first. The region is mapped as
+ *  copy-on-write, so the values can be modified (e.g. byte swapping) without
+ *  writing back to the file. The file must not be truncated or overwritten
+ *  while the region is mapped.
+ */
+/*===========================================================================*/
+class MappedFile
+{
+public:
+    static kvs::SharedPointer<void> Map( const std::string& filename, const size_t offset, const size_t size );
+    template <typename T>
+    static kvs::ValueArray<T> MapArray( const std::string& filename, const size_t offset, const size_t nvalues );
+
+private:
+    MappedFile();
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Maps the region of the file as value array.
+ *  @param  filename [in] filename
+ *  @param  offset [in] offset of the region in bytes
+ *  @param  nvalues [in] number of values
+ *  @return value array referring to the mapped region (empty if failed)
+ */
+/*===========================================================================*/
+template <typename T>
+inline kvs::ValueArray<T> MappedFile::MapArray( const std::string& filename, const size_t offset, const size_t nvalues )
+{
+    kvs::SharedPointer<void> region = Map( filename, offset, nvalues * sizeof( T ) );
+    if ( !region ) { return kvs::ValueArray<T>(); }
+    return kvs::ValueArray<T>( kvs::static_pointer_cast<T>( region ), nvalues );
+}
+
+} // end of namespace kvs
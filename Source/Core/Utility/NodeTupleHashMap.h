@@ -0,0 +1,275 @@
+/*****************************************************************************/
+/**
+ *  @file   NodeTupleHashMap.h
+ *  @author Naohisa Sakamoto
+ *  @brief  Flat hash map keyed by an unordered tuple of node IDs
+ */
+/*****************************************************************************/
+#pragma once
+#include <array>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <kvs/Type>
+#include <kvs/Assert>
+#include <kvs/OpenMP>
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Flat hash map keyed by an unordered tuple of node IDs.
+ *
+ *  The map is used to find the shared edges (N=2) or faces (N=3, 4) of the
+ *  cells in the unstructured volume. The key is compared regardless of the
+ *  order of the node IDs. The entries are stored in contiguous arrays in
+ *  the order of insertion and looked up through an open-addressing table
+ *  with linear probing, so that no allocation per entry is needed. Each
+ *  slot of the table holds the upper bits of the hash value together with
+ *  the entry index, so that most of the mismatched entries are rejected
+ *  without touching the key array. The entries cannot be erased
+ *  individually, and the number of the entries is limited to 2^32 - 1.
+ */
+/*===========================================================================*/
+template <size_t N, typename T>
+class NodeTupleHashMap
+{
+public:
+    using Key = std::array<kvs::UInt32,N>;
+    using Value = T;
+
+private:
+    std::vector<Key> m_keys{}; ///< keys (sorted node IDs) of the entries
+    std::vector<Value> m_values{}; ///< values of the entries
+    std::vector<kvs::UInt64> m_table{}; ///< hash table (upper 32-bit hash value and entry index + 1, or 0 for empty slot)
+
+public:
+    NodeTupleHashMap() = default;
+    explicit NodeTupleHashMap( const size_t nentries ) { this->reserve( nentries ); }
+
+    size_t size() const { return m_keys.size(); }
+    bool empty() const { return m_keys.empty(); }
+    const Key& key( const size_t index ) const { return m_keys[ index ]; }
+    const Value& value( const size_t index ) const { return m_values[ index ]; }
+    Value& value( const size_t index ) { return m_values[ index ]; }
+
+    size_t byteSize() const;
+    void reserve( const size_t nentries );
+    void clear();
+
+    size_t find( Key ids ) const;
+    std::pair<size_t,bool> insert( Key ids, const Value& value );
+
+private:
+    static kvs::UInt64 Hash( const Key& key );
+    void rehash( const size_t nslots );
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the memory size used by the map.
+ *  @return memory size in bytes
+ */
+/*===========================================================================*/
+template <size_t N, typename T>
+inline size_t NodeTupleHashMap<N,T>::byteSize() const
+{
+    return
+        m_keys.capacity() * sizeof( Key ) +
+        m_values.capacity() * sizeof( Value ) +
+        m_table.capacity() * sizeof( kvs::UInt64 );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reserves the memory for the given number of entries.
+ *  @param  nentries [in] expected number of entries
+ */
+/*===========================================================================*/
+template <size_t N, typename T>
+inline void NodeTupleHashMap<N,T>::reserve( const size_t nentries )
+{
+    m_keys.reserve( nentries );
+    m_values.reserve( nentries );
+
+    // The load factor of the table is kept less than or equal to 0.5.
+    size_t nslots = 16;
+    while ( nslots < 2 * nentries ) { nslots *= 2; }
+    if ( nslots > m_table.size() ) { this->rehash( nslots ); }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Removes all of the entries.
+ */
+/*===========================================================================*/
+template <size_t N, typename T>
+inline void NodeTupleHashMap<N,T>::clear()
+{
+    m_keys.clear();
+    m_values.clear();
+    std::fill( m_table.begin(), m_table.end(), 0 );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Finds the entry with the given node IDs.
+ *  @param  ids [in] node IDs in any order
+ *  @return index of the entry, or size() if not found
+ */
+/*===========================================================================*/
+template <size_t N, typename T>
+inline size_t NodeTupleHashMap<N,T>::find( Key ids ) const
+{
+    if ( m_table.empty() ) { return this->size(); }
+
+    std::sort( ids.begin(), ids.end() );
+    const kvs::UInt64 hash = Hash( ids );
+    const kvs::UInt64 tag = hash & 0xFFFFFFFF00000000ULL;
+    const size_t mask = m_table.size() - 1;
+    size_t slot = static_cast<size_t>( hash ) & mask;
+    while ( m_table[ slot ] != 0 )
+    {
+        const size_t index = ( m_table[ slot ] & 0xFFFFFFFFULL ) - 1;
+        if ( ( m_table[ slot ] & 0xFFFFFFFF00000000ULL ) == tag && m_keys[ index ] == ids ) { return index; }
+        slot = ( slot + 1 ) & mask;
+    }
+
+    return this->size();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Inserts a new entry if the node IDs are not in the map.
+ *  @param  ids [in] node IDs in any order
+ *  @param  value [in] value of the entry
+ *  @return pair of the index of the entry and the flag whether the entry is inserted
+ */
+/*===========================================================================*/
+template <size_t N, typename T>
+inline std::pair<size_t,bool> NodeTupleHashMap<N,T>::insert( Key ids, const Value& value )
+{
+    if ( 2 * ( this->size() + 1 ) > m_table.size() )
+    {
+        this->rehash( m_table.empty() ? 16 : 2 * m_table.size() );
+    }
+
+    std::sort( ids.begin(), ids.end() );
+    const kvs::UInt64 hash = Hash( ids );
+    const kvs::UInt64 tag = hash & 0xFFFFFFFF00000000ULL;
+    const size_t mask = m_table.size() - 1;
+    size_t slot = static_cast<size_t>( hash ) & mask;
+    while ( m_table[ slot ] != 0 )
+    {
+        const size_t index = ( m_table[ slot ] & 0xFFFFFFFFULL ) - 1;
+        if ( ( m_table[ slot ] & 0xFFFFFFFF00000000ULL ) == tag && m_keys[ index ] == ids )
+        {
+            return std::make_pair( index, false );
+        }
+        slot = ( slot + 1 ) & mask;
+    }
+
+    // The entry index + 1 is packed into the lower 32 bits of the slot.
+    const size_t index = this->size();
+    KVS_ASSERT( index < 0xFFFFFFFFULL );
+    m_keys.push_back( ids );
+    m_values.push_back( value );
+    m_table[ slot ] = tag | kvs::UInt64( index + 1 );
+
+    return std::make_pair( index, true );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the hash value of the sorted node IDs.
+ *  @param  key [in] sorted node IDs
+ *  @return hash value
+ */
+/*===========================================================================*/
+template <size_t N, typename T>
+inline kvs::UInt64 NodeTupleHashMap<N,T>::Hash( const Key& key )
+{
+    // Combines the node IDs and mixes the bits with the finalizer of the
+    // MurmurHash3, so that all the bits of the IDs affect the slot index.
+    kvs::UInt64 h = 0;
+    for ( size_t i = 0; i < N; i++ )
+    {
+        h = h * 0x9E3779B97F4A7C15ULL + key[i];
+    }
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Rebuilds the hash table with the given number of slots.
+ *  @param  nslots [in] number of slots (power of two)
+ */
+/*===========================================================================*/
+template <size_t N, typename T>
+inline void NodeTupleHashMap<N,T>::rehash( const size_t nslots )
+{
+    KVS_ASSERT( ( nslots & ( nslots - 1 ) ) == 0 );
+
+    m_table.assign( nslots, 0 );
+    const size_t mask = nslots - 1;
+    const size_t nentries = this->size();
+    for ( size_t index = 0; index < nentries; index++ )
+    {
+        const kvs::UInt64 hash = Hash( m_keys[ index ] );
+        size_t slot = static_cast<size_t>( hash ) & mask;
+        while ( m_table[ slot ] != 0 ) { slot = ( slot + 1 ) & mask; }
+        m_table[ slot ] = ( hash & 0xFFFFFFFF00000000ULL ) | kvs::UInt64( index + 1 );
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Merges the partitioned entries in the order of the sequence numbers.
+ *
+ *  When the node tuples are distributed over several maps (partitions) that
+ *  are built in parallel, the entries can be output in the same order as a
+ *  single map by recording the sequence number of the first insertion of
+ *  each entry. The rank of each entry in the merged order is calculated in
+ *  parallel over the partitions.
+ *
+ *  @param  sequences [in] sorted sequence numbers of the entries in each partition
+ *  @param  function [in] function called with (partition, index, rank) of each entry
+ */
+/*===========================================================================*/
+template <typename Function>
+inline void MergeBySequence(
+    const std::vector<std::vector<kvs::UInt64>>& sequences,
+    Function function )
+{
+    const size_t npartitions = sequences.size();
+    KVS_OMP_PARALLEL_FOR( schedule(dynamic) )
+    for ( size_t p = 0; p < npartitions; p++ )
+    {
+        std::vector<size_t> position( npartitions, 0 );
+        const size_t nentries = sequences[p].size();
+        for ( size_t i = 0; i < nentries; i++ )
+        {
+            // The rank is the number of the entries with smaller sequence
+            // numbers in all of the partitions.
+            const kvs::UInt64 sequence = sequences[p][i];
+            size_t rank = i;
+            for ( size_t q = 0; q < npartitions; q++ )
+            {
+                if ( q == p ) { continue; }
+                const std::vector<kvs::UInt64>& other = sequences[q];
+                while ( position[q] < other.size() && other[ position[q] ] < sequence ) { position[q]++; }
+                rank += position[q];
+            }
+            function( p, i, rank );
+        }
+    }
+}
+
+} // end of namespace kvs
@@ -0,0 +1,280 @@
+/*****************************************************************************/
+/**
+ *  @file   NumberParser.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "NumberParser.h"
+#include <cstdlib>
+#include <clocale>
+#include <cmath>
+#include <limits>
+
+
+namespace
+{
+
+inline bool IsDigit( const char c )
+{
+    return '0' <= c && c <= '9';
+}
+
+inline char ToLower( const char c )
+{
+    return ( 'A' <= c && c <= 'Z' ) ? static_cast<char>( c - 'A' + 'a' ) : c;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns true if the text starts with the given word (case-insensitive).
+ *  @param  first [in] pointer to the first character
+ *  @param  last [in] pointer to the end of the text
+ *  @param  word [in] word in lower case
+ *  @return true, if the text starts with the word
+ */
+/*===========================================================================*/
+inline bool StartsWith( const char* first, const char* last, const char* word )
+{
+    for ( ; *word; word++, first++ )
+    {
+        if ( first == last || ::ToLower( *first ) != *word ) { return false; }
+    }
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Converts the text of the floating-point number with strtod.
+ *  @param  first [in] pointer to the first character of the number
+ *  @param  last [in] pointer to the end of the number
+ *  @return converted value
+ */
+/*===========================================================================*/
+double StrToD( const char* first, const char* last )
+{
+    // The text is copied with the decimal point of the current locale,
+    // since strtod depends on the locale.
+    const char point = std::localeconv()->decimal_point[0];
+    std::string text( first, last );
+    for ( size_t i = 0; i < text.size(); i++ )
+    {
+        if ( text[i] == '.' ) { text[i] = point; }
+    }
+    return std::strtod( text.c_str(), nullptr );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Parses the sign.
+ *  @param  first [in] pointer to the first character
+ *  @param  last [in] pointer to the end of the text
+ *  @param  negative [out] true if the minus sign is found
+ *  @return pointer to the next character of the sign
+ */
+/*===========================================================================*/
+inline const char* ParseSign( const char* first, const char* last, bool* negative )
+{
+    *negative = false;
+    if ( first < last && ( *first == '-' || *first == '+' ) )
+    {
+        *negative = ( *first == '-' );
+        return first + 1;
+    }
+    return first;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Parses the unsigned decimal digits.
+ *  @param  first [in] pointer to the first character
+ *  @param  last [in] pointer to the end of the text
+ *  @param  value [out] parsed value (wrapped around if overflowed)
+ *  @return pointer to the next character of the digits
+ */
+/*===========================================================================*/
+inline const char* ParseDigits( const char* first, const char* last, kvs::UInt64* value )
+{
+    kvs::UInt64 v = 0;
+    const char* p = first;
+    while ( p < last && ::IsDigit( *p ) )
+    {
+        v = v * 10 + static_cast<kvs::UInt64>( *p - '0' );
+        p++;
+    }
+    *value = v;
+    return p;
+}
+
+// Powers of ten exactly represented by double.
+const double Pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Parses a signed integer.
+ *  @param  first [in] pointer to the first character
+ *  @param  last [in] pointer to the end of the text
+ *  @param  value [out] parsed value
+ *  @return pointer to the first character not matching the number
+ */
+/*===========================================================================*/
+const char* NumberParser::Parse( const char* first, const char* last, kvs::Int64* value )
+{
+    bool negative = false;
+    const char* p = ::ParseSign( first, last, &negative );
+
+    kvs::UInt64 v = 0;
+    const char* q = ::ParseDigits( p, last, &v );
+    if ( q == p ) { return first; }
+
+    *value = negative ? static_cast<kvs::Int64>( 0 - v ) : static_cast<kvs::Int64>( v );
+    return q;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Parses an unsigned integer.
+ *  @param  first [in] pointer to the first character
+ *  @param  last [in] pointer to the end of the text
+ *  @param  value [out] parsed value
+ *  @return pointer to the first character not matching the number
+ */
+/*===========================================================================*/
+const char* NumberParser::Parse( const char* first, const char* last, kvs::UInt64* value )
+{
+    bool negative = false;
+    const char* p = ::ParseSign( first, last, &negative );
+
+    kvs::UInt64 v = 0;
+    const char* q = ::ParseDigits( p, last, &v );
+    if ( q == p ) { return first; }
+
+    *value = negative ? 0 - v : v;
+    return q;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Parses a floating-point number.
+ *
+ *  The decimal number is converted to the significand of up to 19 digits and
+ *  the exponent. If the significand and the power of ten are exactly
+ *  represented by double, the value is calculated by a single multiplication
+ *  or division, which is correctly rounded (Clinger's fast path). Otherwise,
+ *  the value is converted with strtod.
+ *
+ *  @param  first [in] pointer to the first character
+ *  @param  last [in] pointer to the end of the text
+ *  @param  value [out] parsed value
+ *  @return pointer to the first character not matching the number
+ */
+/*===========================================================================*/
+const char* NumberParser::Parse( const char* first, const char* last, kvs::Real64* value )
+{
+    bool negative = false;
+    const char* p = ::ParseSign( first, last, &negative );
+
+    // Significand and exponent.
+    kvs::UInt64 significand = 0;
+    int ndigits = 0;
+    int exponent = 0;
+    bool truncated = false;
+    bool found = false;
+    while ( p < last && ::IsDigit( *p ) )
+    {
+        const int digit = *p - '0';
+        if ( ndigits < 19 )
+        {
+            significand = significand * 10 + digit;
+            if ( significand > 0 ) { ndigits++; }
+        }
+        else
+        {
+            exponent++;
+            truncated |= ( digit != 0 );
+        }
+        found = true;
+        p++;
+    }
+
+    if ( p < last && *p == '.' )
+    {
+        p++;
+        while ( p < last && ::IsDigit( *p ) )
+        {
+            const int digit = *p - '0';
+            if ( ndigits < 19 )
+            {
+                significand = significand * 10 + digit;
+                if ( significand > 0 ) { ndigits++; }
+                exponent--;
+            }
+            else
+            {
+                truncated |= ( digit != 0 );
+            }
+            found = true;
+            p++;
+        }
+    }
+
+    if ( !found )
+    {
+        // Infinity and NaN.
+        if ( ::StartsWith( p, last, "inf" ) )
+        {
+            *value = negative ? -HUGE_VAL : HUGE_VAL;
+            return ::StartsWith( p, last, "infinity" ) ? p + 8 : p + 3;
+        }
+        if ( ::StartsWith( p, last, "nan" ) )
+        {
+            *value = std::numeric_limits<double>::quiet_NaN();
+            return p + 3;
+        }
+        return first;
+    }
+
+    if ( p < last && ( *p == 'e' || *p == 'E' ) )
+    {
+        // The exponent part is ignored if no digit follows.
+        bool exponent_negative = false;
+        const char* q = ::ParseSign( p + 1, last, &exponent_negative );
+        if ( q < last && ::IsDigit( *q ) )
+        {
+            int e = 0;
+            while ( q < last && ::IsDigit( *q ) )
+            {
+                if ( e < 100000 ) { e = e * 10 + ( *q - '0' ); }
+                q++;
+            }
+            exponent += exponent_negative ? -e : e;
+            p = q;
+        }
+    }
+
+    if ( significand == 0 && !truncated )
+    {
+        *value = negative ? -0.0 : 0.0;
+        return p;
+    }
+
+    if ( !truncated && significand <= ( kvs::UInt64(1) << 53 ) && -22 <= exponent && exponent <= 22 )
+    {
+        const double v = static_cast<double>( significand );
+        const double r = exponent < 0 ? v / ::Pow10[ -exponent ] : v * ::Pow10[ exponent ];
+        *value = negative ? -r : r;
+        return p;
+    }
+
+    *value = ::StrToD( first, p );
+    return p;
+}
+
+} // end of namespace kvs
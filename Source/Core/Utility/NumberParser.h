@@ -0,0 +1,359 @@
+/*****************************************************************************/
+/**
+ *  @file   NumberParser.h
+ *  @author Naohisa Sakamoto
+ *  @brief  Locale-independent parser for the numbers in the text data
+ */
+/*****************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <cstring>
+#include <type_traits>
+#include <kvs/Type>
+#include <kvs/Math>
+#include <kvs/OpenMP>
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Number parser class.
+ *
+ *  The numbers are parsed directly from the character buffer without any
+ *  intermediate string or the locale settings, in the same manner as
+ *  std::from_chars. The parse functions return the pointer to the first
+ *  character not matching the number, or the given first pointer if no
+ *  number is found. The numbers in the text are separated by the white
+ *  spaces or commas (delimiters), and a token that is not a number is read
+ *  as zero like atof.
+ *
+ *  The parser object is used to read the numbers in the line sequentially,
+ *  and ParseArray is used to read a large number of values from the whole
+ *  file buffer, which is divided into chunks parsed in parallel.
+ */
+/*===========================================================================*/
+class NumberParser
+{
+private:
+    const char* m_current = nullptr; ///< current position in the text
+    const char* m_end = nullptr; ///< end of the text
+
+public:
+    static bool IsDelimiter( const char c );
+
+    static const char* Parse( const char* first, const char* last, kvs::Int64* value );
+    static const char* Parse( const char* first, const char* last, kvs::UInt64* value );
+    static const char* Parse( const char* first, const char* last, kvs::Real64* value );
+    template <typename T>
+    static const char* Parse( const char* first, const char* last, T* value );
+    template <typename T>
+    static T To( const char* text );
+    template <typename T>
+    static size_t ParseArray( const char* first, const char* last, T* values, const size_t nvalues );
+
+public:
+    NumberParser( const char* text );
+    NumberParser( const char* first, const char* last );
+
+    const char* current() const { return m_current; }
+    bool isEnd();
+    bool skip();
+    std::string nextToken();
+    template <typename T>
+    T next();
+
+private:
+    template <typename T>
+    static const char* ParseToken( const char* first, const char* last, T* value );
+    template <typename T>
+    static size_t ParseChunk( const char* first, const char* last, T* values, const size_t nvalues );
+    static size_t CountTokens( const char* first, const char* last );
+    void skip_delimiters();
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns true if the character is a delimiter of the numbers.
+ *  @param  c [in] character
+ *  @return true, if the character is a white space or comma
+ */
+/*===========================================================================*/
+inline bool NumberParser::IsDelimiter( const char c )
+{
+    return c == ' ' || c == ',' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Parses a number as the given type.
+ *
+ *  The integer types are parsed as the 64-bit integer, and if the number is
+ *  written in the floating-point notation (e.g. 1.0 or 1e3), it is parsed
+ *  as the double value and converted to the integer type.
+ *
+ *  @param  first [in] pointer to the first character
+ *  @param  last [in] pointer to the end of the text
+ *  @param  value [out] parsed value
+ *  @return pointer to the first character not matching the number
+ */
+/*===========================================================================*/
+template <typename T>
+inline const char* NumberParser::Parse( const char* first, const char* last, T* value )
+{
+    if ( std::is_integral<T>::value )
+    {
+        typedef typename std::conditional<std::is_signed<T>::value, kvs::Int64, kvs::UInt64>::type Integer;
+        Integer integer = 0;
+        const char* p = Parse( first, last, &integer );
+        if ( p == first || ( p < last && ( *p == '.' || *p == 'e' || *p == 'E' ) ) )
+        {
+            kvs::Real64 real = 0.0;
+            p = Parse( first, last, &real );
+            if ( p != first ) { *value = static_cast<T>( real ); }
+            return p;
+        }
+        *value = static_cast<T>( integer );
+        return p;
+    }
+    else
+    {
+        kvs::Real64 real = 0.0;
+        const char* p = Parse( first, last, &real );
+        if ( p != first ) { *value = static_cast<T>( real ); }
+        return p;
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Converts the null-terminated text to the number.
+ *  @param  text [in] text
+ *  @return number, or zero if the text is not a number
+ */
+/*===========================================================================*/
+template <typename T>
+inline T NumberParser::To( const char* text )
+{
+    T value = T(0);
+    if ( text )
+    {
+        while ( IsDelimiter( *text ) ) { text++; }
+        Parse( text, text + std::strlen( text ), &value );
+    }
+    return value;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Parses the numbers separated by the delimiters.
+ *
+ *  Each token separated by the delimiters is read as a value, as the
+ *  strtok and atof do. If the text is large, it is divided into chunks at
+ *  the delimiters, and the chunks are parsed in parallel after the number
+ *  of the tokens in each chunk is counted.
+ *
+ *  @param  first [in] pointer to the first character
+ *  @param  last [in] pointer to the end of the text
+ *  @param  values [out] pointer to the parsed values
+ *  @param  nvalues [in] max. number of values
+ *  @return number of the parsed values
+ */
+/*===========================================================================*/
+template <typename T>
+inline size_t NumberParser::ParseArray( const char* first, const char* last, T* values, const size_t nvalues )
+{
+    // The text less than the chunk size is parsed in serial.
+    const size_t chunk_size = 1024 * 1024;
+    const size_t length = static_cast<size_t>( last - first );
+    const size_t nthreads = static_cast<size_t>( kvs::Math::Max( 1, kvs::OpenMP::GetMaxThreads() ) );
+    const size_t nchunks = kvs::Math::Min( 4 * nthreads, length / chunk_size );
+    if ( nthreads == 1 || nchunks < 2 )
+    {
+        return ParseChunk( first, last, values, nvalues );
+    }
+
+    // Chunk boundaries that do not split the tokens.
+    std::vector<const char*> bounds( nchunks + 1, last );
+    bounds[0] = first;
+    for ( size_t i = 1; i < nchunks; i++ )
+    {
+        const char* p = kvs::Math::Max( first + i * ( length / nchunks ), bounds[ i - 1 ] );
+        while ( p < last && !IsDelimiter( *p ) ) { p++; }
+        bounds[i] = p;
+    }
+
+    std::vector<size_t> offsets( nchunks + 1, 0 );
+    KVS_OMP_PARALLEL_FOR( schedule(dynamic) )
+    for ( size_t i = 0; i < nchunks; i++ )
+    {
+        offsets[ i + 1 ] = CountTokens( bounds[i], bounds[ i + 1 ] );
+    }
+    for ( size_t i = 0; i < nchunks; i++ ) { offsets[ i + 1 ] += offsets[i]; }
+
+    KVS_OMP_PARALLEL_FOR( schedule(dynamic) )
+    for ( size_t i = 0; i < nchunks; i++ )
+    {
+        if ( offsets[i] >= nvalues ) { continue; }
+        ParseChunk( bounds[i], bounds[ i + 1 ], values + offsets[i], nvalues - offsets[i] );
+    }
+
+    return kvs::Math::Min( offsets[ nchunks ], nvalues );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new NumberParser class.
+ *  @param  text [in] null-terminated text
+ */
+/*===========================================================================*/
+inline NumberParser::NumberParser( const char* text ):
+    m_current( text ),
+    m_end( text + std::strlen( text ) )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new NumberParser class.
+ *  @param  first [in] pointer to the first character
+ *  @param  last [in] pointer to the end of the text
+ */
+/*===========================================================================*/
+inline NumberParser::NumberParser( const char* first, const char* last ):
+    m_current( first ),
+    m_end( last )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns true if no token remains in the text.
+ *  @return true, if no token remains
+ */
+/*===========================================================================*/
+inline bool NumberParser::isEnd()
+{
+    this->skip_delimiters();
+    return m_current == m_end;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Skips the next token.
+ *  @return true, if the token is skipped
+ */
+/*===========================================================================*/
+inline bool NumberParser::skip()
+{
+    if ( this->isEnd() ) { return false; }
+    while ( m_current < m_end && !IsDelimiter( *m_current ) ) { m_current++; }
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the next token as string.
+ *  @return token (empty if no token remains)
+ */
+/*===========================================================================*/
+inline std::string NumberParser::nextToken()
+{
+    this->skip_delimiters();
+    const char* first = m_current;
+    while ( m_current < m_end && !IsDelimiter( *m_current ) ) { m_current++; }
+    return std::string( first, m_current );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the next token as number.
+ *  @return number (zero if the token is not a number or no token remains)
+ */
+/*===========================================================================*/
+template <typename T>
+inline T NumberParser::next()
+{
+    T value = T(0);
+    this->skip_delimiters();
+    m_current = ParseToken( m_current, m_end, &value );
+    return value;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Parses the token as number.
+ *  @param  first [in] pointer to the first character of the token
+ *  @param  last [in] pointer to the end of the text
+ *  @param  value [out] parsed value (zero if the token is not a number)
+ *  @return pointer to the end of the token
+ */
+/*===========================================================================*/
+template <typename T>
+inline const char* NumberParser::ParseToken( const char* first, const char* last, T* value )
+{
+    const char* p = Parse( first, last, value );
+    if ( p == first ) { *value = T(0); }
+    while ( p < last && !IsDelimiter( *p ) ) { p++; }
+    return p;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Parses the tokens in the chunk in serial.
+ *  @param  first [in] pointer to the first character
+ *  @param  last [in] pointer to the end of the chunk
+ *  @param  values [out] pointer to the parsed values
+ *  @param  nvalues [in] max. number of values
+ *  @return number of the parsed values
+ */
+/*===========================================================================*/
+template <typename T>
+inline size_t NumberParser::ParseChunk( const char* first, const char* last, T* values, const size_t nvalues )
+{
+    size_t counter = 0;
+    const char* p = first;
+    while ( counter < nvalues )
+    {
+        while ( p < last && IsDelimiter( *p ) ) { p++; }
+        if ( p == last ) { break; }
+        p = ParseToken( p, last, values + counter );
+        counter++;
+    }
+    return counter;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Counts the tokens in the chunk.
+ *  @param  first [in] pointer to the first character
+ *  @param  last [in] pointer to the end of the chunk
+ *  @return number of the tokens
+ */
+/*===========================================================================*/
+inline size_t NumberParser::CountTokens( const char* first, const char* last )
+{
+    size_t counter = 0;
+    bool in_token = false;
+    for ( const char* p = first; p < last; p++ )
+    {
+        const bool delimiter = IsDelimiter( *p );
+        if ( !delimiter && !in_token ) { counter++; }
+        in_token = !delimiter;
+    }
+    return counter;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Skips the delimiters.
+ */
+/*===========================================================================*/
+inline void NumberParser::skip_delimiters()
+{
+    while ( m_current < m_end && IsDelimiter( *m_current ) ) { m_current++; }
+}
+
+} // end of namespace kvs
@@ -25,6 +25,9 @@ KMeansClustering::KMeansClustering():
     m_nclusters( 0 ),
     m_max_iterations( 100 ),
     m_tolerance( 1.e-6 ),
+    m_enable_mthreading( false ),
+    m_enable_bounded_assignment( false ),
+    m_batch_size( 0 ),
     m_cluster_centers( NULL )
 {
 }
@@ -42,6 +45,9 @@ KMeansClustering::KMeansClustering( const kvs::TableObject* table ):
     m_nclusters( 0 ),
     m_max_iterations( 100 ),
     m_tolerance( 1.e-6 ),
+    m_enable_mthreading( false ),
+    m_enable_bounded_assignment( false ),
+    m_batch_size( 0 ),
     m_cluster_centers( NULL )
 {
     this->exec( table );
@@ -67,6 +73,9 @@ KMeansClustering::KMeansClustering(
     m_nclusters( nclusters ),
     m_max_iterations( 100 ),
     m_tolerance( 1.e-6 ),
+    m_enable_mthreading( false ),
+    m_enable_bounded_assignment( false ),
+    m_batch_size( 0 ),
     m_cluster_centers( NULL )
 {
     this->exec( table );
@@ -138,6 +147,9 @@ void KMeansClustering::simple_kmeans( const kvs::TableObject* object )
     kmeans.setNumberOfClusters( m_nclusters );
     kmeans.setMaxIterations( m_max_iterations );
     kmeans.setTolerance( m_tolerance );
+    kmeans.setEnabledMultiThreading( m_enable_mthreading );
+    kmeans.setBoundedAssignmentEnabled( m_enable_bounded_assignment );
+    kmeans.setBatchSize( m_batch_size );
     kmeans.setInputTableData( object->table() );
     kmeans.run();
 
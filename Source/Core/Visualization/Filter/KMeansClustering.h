@@ -49,6 +49,9 @@ private:
     size_t m_nclusters; ///< number of clusters
     size_t m_max_iterations; ///< maximum number of interations
     float m_tolerance; ///< tolerance of distance
+    bool m_enable_mthreading; ///< flag for multi-threading (SimpleKMeans only)
+    bool m_enable_bounded_assignment; ///< flag for the assignment with distance bounds (SimpleKMeans only)
+    size_t m_batch_size; ///< number of rows in a mini-batch (SimpleKMeans only, 0: all of the rows)
     kvs::ValueArray<kvs::Real32>* m_cluster_centers; ///< cluster centers
 
 public:
@@ -69,6 +72,17 @@ public:
     void setNumberOfClusters( const size_t nclusters ) { m_nclusters = nclusters; }
     void setMaxInterations( const size_t max_iterations ) { m_max_iterations = max_iterations; }
     void setTolerance( const float tolerance ) { m_tolerance = tolerance; }
+    void setEnabledMultiThreading( const bool enable ) { m_enable_mthreading = enable; }
+    void enableMultiThreading() { this->setEnabledMultiThreading( true ); }
+    void disableMultiThreading() { this->setEnabledMultiThreading( false ); }
+    void setBoundedAssignmentEnabled( const bool enable ) { m_enable_bounded_assignment = enable; }
+    void enableBoundedAssignment() { this->setBoundedAssignmentEnabled( true ); }
+    void disableBoundedAssignment() { this->setBoundedAssignmentEnabled( false ); }
+    void setBatchSize( const size_t batch_size ) { m_batch_size = batch_size; }
+
+    bool isEnabledMultiThreading() const { return m_enable_mthreading; }
+    bool isBoundedAssignmentEnabled() const { return m_enable_bounded_assignment; }
+    size_t batchSize() const { return m_batch_size; }
 
     const kvs::ValueArray<kvs::Real32>& clusterCenter( const size_t index ) { return m_cluster_centers[index]; }
 
@@ -6,8 +6,363 @@
 /*****************************************************************************/
 #include "LineIntegralConvolution.h"
 #include <kvs/DebugNew>
-#include <kvs/MersenneTwister>
 #include <kvs/Vector3>
+#include <kvs/OpenMP>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Streamline tracer through the cells of the vector volume.
+ *
+ *  The streamline is traced from the center of the cell with the constant
+ *  vector of the cell, and moves to the neighboring cell at the exit point.
+ */
+/*===========================================================================*/
+template <typename T>
+class Tracer
+{
+private:
+    const T* m_vectors; ///< vector data
+    const kvs::UInt8* m_noise; ///< noise data
+    int m_size[3]; ///< resolution
+    unsigned int m_stride[3]; ///< index offsets to the next cells in x, y and z
+    T m_sign; ///< 1 for forward, -1 for backward
+    unsigned int m_loc; ///< index of the current cell
+    int m_pos[3]; ///< grid position of the current cell
+    T m_entry[3]; ///< entry point to the current cell
+
+public:
+    Tracer(
+        const T* vectors,
+        const kvs::UInt8* noise,
+        const kvs::Vector3ui& resolution,
+        const T sign,
+        const size_t i,
+        const size_t j,
+        const size_t k,
+        const unsigned int loc ):
+        m_vectors( vectors ),
+        m_noise( noise ),
+        m_sign( sign ),
+        m_loc( loc )
+    {
+        m_size[0] = static_cast<int>( resolution.x() );
+        m_size[1] = static_cast<int>( resolution.y() );
+        m_size[2] = static_cast<int>( resolution.z() );
+        m_stride[0] = 1;
+        m_stride[1] = resolution.x();
+        m_stride[2] = resolution.x() * resolution.y();
+        m_pos[0] = static_cast<int>( i );
+        m_pos[1] = static_cast<int>( j );
+        m_pos[2] = static_cast<int>( k );
+        m_entry[0] = T( i + 0.5 );
+        m_entry[1] = T( j + 0.5 );
+        m_entry[2] = T( k + 0.5 );
+    }
+
+    unsigned int location() const { return m_loc; }
+    int k() const { return m_pos[2]; }
+
+    bool isInside() const
+    {
+        return
+            m_pos[0] >= 0 && m_pos[0] < m_size[0] &&
+            m_pos[1] >= 0 && m_pos[1] < m_size[1] &&
+            m_pos[2] >= 0 && m_pos[2] < m_size[2];
+    }
+
+    /*=======================================================================*/
+    /**
+     *  @brief  Moves to the next cell along the streamline.
+     *  @param  length [out] length of the streamline in the current cell
+     *  @param  scalar [out] noise value of the current cell
+     *  @return false if the streamline stops in the current cell
+     */
+    /*=======================================================================*/
+    bool step( T* length, int* scalar )
+    {
+        *scalar = m_noise[ m_loc ];
+
+        const T* v = m_vectors + 3 * m_loc;
+        const T u[3] = { m_sign * v[0], m_sign * v[1], m_sign * v[2] };
+
+        // Parameters to the exit points through the cell faces in x, y and z.
+        T t_min = 1.0e+10;
+        int l_min = -1;
+        for ( int l = 0; l < 3; l++ )
+        {
+            const T p = static_cast<T>( m_pos[l] );
+            T travel_t = T( 1.1e+10 );
+            if ( !kvs::Math::IsZero( u[l] ) )
+            {
+                const T exit = u[l] < T(0) ? p : p + 1;
+                travel_t = ( exit - m_entry[l] ) / u[l];
+            }
+
+            if ( travel_t < t_min )
+            {
+                t_min = travel_t;
+                l_min = l;
+            }
+        }
+
+        if ( l_min == -1 ) { return false; }
+
+        m_entry[0] += u[0] * t_min;
+        m_entry[1] += u[1] * t_min;
+        m_entry[2] += u[2] * t_min;
+
+        const int inc = u[l_min] < T(0) ? -1 : 1;
+        m_loc += inc * m_stride[ l_min ];
+        m_pos[ l_min ] += inc;
+
+        double squared_length = 0.0;
+        squared_length += static_cast<double>( u[0] * u[0] );
+        squared_length += static_cast<double>( u[1] * u[1] );
+        squared_length += static_cast<double>( u[2] * u[2] );
+        *length = t_min * static_cast<T>( std::sqrt( squared_length ) );
+
+        /* For small length (close to 0.0) it enters in a infinite loop */
+        if ( kvs::Math::IsZero( *length ) ) *length = T( 1.1e+10 );
+
+        return true;
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Accumulates the noise values along the streamline.
+ *  @param  tracer [in/out] streamline tracer
+ *  @param  stream_length [in] stream length
+ *  @param  acc_length [in/out] accumulated length
+ *  @param  acc_data [in/out] accumulated noise value weighted by the length
+ */
+/*===========================================================================*/
+template <typename T>
+void Accumulate( ::Tracer<T>& tracer, const double stream_length, T& acc_length, T& acc_data )
+{
+    while ( acc_length < stream_length )
+    {
+        T length = T(0);
+        int scalar = 0;
+        if ( !tracer.step( &length, &scalar ) ) break;
+
+        if ( acc_length < 1.1e-10 ) acc_length = T(0);
+
+        acc_data += length * scalar;
+        acc_length += length;
+
+        if ( !tracer.isInside() ) break;
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the convolved noise value at the node.
+ *
+ *  The noise values are accumulated along the streamline traced forward
+ *  from the node, and then backward if the forward streamline is shorter
+ *  than the stream length.
+ *
+ *  @param  vectors [in] vector data
+ *  @param  noise [in] noise data
+ *  @param  resolution [in] resolution
+ *  @param  i [in] grid position in x
+ *  @param  j [in] grid position in y
+ *  @param  k [in] grid position in z
+ *  @param  loc [in] node index
+ *  @param  stream_length [in] stream length
+ *  @return convolved value
+ */
+/*===========================================================================*/
+template <typename T>
+kvs::UInt8 Convolute(
+    const T* vectors,
+    const kvs::UInt8* noise,
+    const kvs::Vector3ui& resolution,
+    const size_t i,
+    const size_t j,
+    const size_t k,
+    const unsigned int loc,
+    const double stream_length )
+{
+    T acc_length = T(0);
+    T acc_data = T(0);
+    for ( int m = 1; m > -2; m -= 2 )
+    {
+        ::Tracer<T> tracer( vectors, noise, resolution, T( m ), i, j, k, loc );
+        ::Accumulate( tracer, stream_length, acc_length, acc_data );
+    }
+
+    acc_data /= acc_length;
+    return (kvs::UInt8)( (int)(acc_data) % 256 );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Convolves the noise values of the nodes in the slab (fast LIC).
+ *
+ *  The streamline traced forward from the node which has not been convolved
+ *  yet (seed node) is shared with the following nodes on the streamline.
+ *  The value of each node on the streamline is calculated by sliding the
+ *  box filter of the stream length along the samples of the streamline,
+ *  instead of tracing the streamline from the node. The value of the seed
+ *  node is calculated exactly, and the tracing is terminated when the
+ *  streamline passes through the convolved nodes successively.
+ *
+ *  @param  vectors [in] vector data
+ *  @param  noise [in] noise data
+ *  @param  resolution [in] resolution
+ *  @param  k0 [in] first z-position of the slab
+ *  @param  k1 [in] last z-position of the slab (excluded)
+ *  @param  stream_length [in] stream length
+ *  @param  convolved [in/out] flags of the convolved nodes
+ *  @param  dst [out] convolved values
+ */
+/*===========================================================================*/
+template <typename T>
+void ConvoluteSlab(
+    const T* vectors,
+    const kvs::UInt8* noise,
+    const kvs::Vector3ui& resolution,
+    const size_t k0,
+    const size_t k1,
+    const double stream_length,
+    kvs::UInt8* convolved,
+    kvs::UInt8* dst )
+{
+    struct Sample
+    {
+        unsigned int loc; ///< index of the cell
+        bool inside; ///< true if the cell is in the slab
+        T length; ///< length of the streamline in the cell
+        T data; ///< length times noise value
+    };
+
+    // Maximum length of the streamline and number of the successive nodes
+    // which have been convolved before the tracing is terminated.
+    const double max_length = stream_length * 64.0;
+    const size_t max_skips = 4;
+
+    std::vector<Sample> samples;
+
+    const size_t nx = resolution.x();
+    const size_t ny = resolution.y();
+    for ( size_t k = k0; k < k1; k++ )
+    {
+        for ( size_t j = 0; j < ny; j++ )
+        {
+            for ( size_t i = 0; i < nx; i++ )
+            {
+                const unsigned int loc = static_cast<unsigned int>( ( k * ny + j ) * nx + i );
+                if ( convolved[ loc ] ) { continue; }
+
+                // Trace the streamline backward from the seed node, so that
+                // the nodes behind the seed node are convolved with the
+                // window including the forward streamline.
+                samples.clear();
+                ::Tracer<T> backward( vectors, noise, resolution, T(-1), i, j, k, loc );
+                T total_length = T(0);
+                size_t skips = 0;
+                while ( total_length < max_length && skips < max_skips )
+                {
+                    const unsigned int cell = backward.location();
+                    const size_t kc = static_cast<size_t>( backward.k() );
+                    T length = T(0);
+                    int scalar = 0;
+                    if ( !backward.step( &length, &scalar ) ) break;
+
+                    const Sample sample = { cell, k0 <= kc && kc < k1, length, length * scalar };
+                    samples.push_back( sample );
+                    total_length += length;
+                    skips = ( cell != loc && sample.inside && !convolved[ cell ] ) ? 0 : skips + 1;
+
+                    if ( !backward.isInside() ) break;
+                }
+                std::reverse( samples.begin(), samples.end() );
+                const size_t origin = samples.size();
+
+                // Trace the streamline forward with sliding the window
+                // [first, samples.size()) along the streamline.
+                ::Tracer<T> forward( vectors, noise, resolution, T(1), i, j, k, loc );
+                T window_length = T(0);
+                T window_data = T(0);
+                for ( size_t n = 0; n < origin; n++ )
+                {
+                    window_length += samples[n].length;
+                    window_data += samples[n].data;
+                }
+
+                size_t first = 0;
+                total_length = T(0);
+                skips = 0;
+                while ( total_length < max_length && skips < max_skips )
+                {
+                    const unsigned int cell = forward.location();
+                    const size_t kc = static_cast<size_t>( forward.k() );
+                    T length = T(0);
+                    int scalar = 0;
+                    if ( !forward.step( &length, &scalar ) ) break;
+
+                    const Sample sample = { cell, k0 <= kc && kc < k1, length, length * scalar };
+                    samples.push_back( sample );
+                    total_length += length;
+                    window_length += length;
+                    window_data += sample.data;
+
+                    while ( window_length >= stream_length )
+                    {
+                        const Sample& front = samples[ first ];
+                        if ( front.loc != loc && front.inside && !convolved[ front.loc ] )
+                        {
+                            const T data = window_data / window_length;
+                            dst[ front.loc ] = (kvs::UInt8)( (int)(data) % 256 );
+                            convolved[ front.loc ] = 1;
+                            skips = 0;
+                        }
+                        else if ( first > origin ) { skips++; }
+
+                        window_length -= front.length;
+                        window_data -= front.data;
+                        first++;
+                    }
+
+                    if ( !forward.isInside() ) break;
+                }
+
+                // The seed node is convolved exactly with the forward samples,
+                // and the backward streamline if they are shorter than the
+                // stream length.
+                T acc_length = T(0);
+                T acc_data = T(0);
+                for ( size_t n = origin; n < samples.size() && acc_length < stream_length; n++ )
+                {
+                    if ( acc_length < 1.1e-10 ) acc_length = T(0);
+                    acc_data += samples[n].data;
+                    acc_length += samples[n].length;
+                }
+
+                if ( acc_length < stream_length )
+                {
+                    ::Tracer<T> tracer( vectors, noise, resolution, T(-1), i, j, k, loc );
+                    ::Accumulate( tracer, stream_length, acc_length, acc_data );
+                }
+
+                acc_data /= acc_length;
+                dst[ loc ] = (kvs::UInt8)( (int)(acc_data) % 256 );
+                convolved[ loc ] = 1;
+            }
+        }
+    }
+}
+
+} // end of namespace
 
 
 namespace kvs
@@ -20,7 +375,9 @@ namespace kvs
 /*===========================================================================*/
 LineIntegralConvolution::LineIntegralConvolution():
     m_length( 0.0 ),
-    m_noise( NULL )
+    m_noise( NULL ),
+    m_enable_mthreading( false ),
+    m_enable_fast_convolution( false )
 {
 }
 
@@ -31,7 +388,9 @@ LineIntegralConvolution::LineIntegralConvolution():
  */
 /*===========================================================================*/
 LineIntegralConvolution::LineIntegralConvolution( const kvs::StructuredVolumeObject* volume ):
-    m_noise( NULL )
+    m_noise( NULL ),
+    m_enable_mthreading( false ),
+    m_enable_fast_convolution( false )
 {
     const kvs::Vector3ui& r = volume->resolution();
     m_length = kvs::Math::Max<double>( r.x(), r.y(), r.z() ) * 0.1;
@@ -47,7 +406,9 @@ LineIntegralConvolution::LineIntegralConvolution( const kvs::StructuredVolumeObj
 /*===========================================================================*/
 LineIntegralConvolution::LineIntegralConvolution( const kvs::StructuredVolumeObject* volume, const double length ):
     m_length( length ),
-    m_noise( NULL )
+    m_noise( NULL ),
+    m_enable_mthreading( false ),
+    m_enable_fast_convolution( false )
 {
     this->exec( volume );
 }
@@ -145,16 +506,14 @@ void LineIntegralConvolution::create_noise_volume( const kvs::StructuredVolumeOb
     kvs::ValueArray<kvs::UInt8> data( volume->numberOfNodes() );
     kvs::UInt8* pdata = data.data();
 
-    // Random number generator. R = [0,1)
-    kvs::MersenneTwister R;
-
     // Create a white noise volume.
     for ( size_t i = 0; i < volume->numberOfNodes(); i++ )
     {
-        *(pdata++) = static_cast<kvs::UInt8>( R() * 255.0 );
+        *(pdata++) = static_cast<kvs::UInt8>( m_random() * 255.0 );
     }
 
     // Copy the white noise volume to m_noise.
+    if ( m_noise ) { delete m_noise; }
     m_noise = new kvs::StructuredVolumeObject();
     m_noise->setVeclen( 1 );
     m_noise->setValues( kvs::AnyValueArray( data ) );
@@ -165,130 +524,56 @@ void LineIntegralConvolution::create_noise_volume( const kvs::StructuredVolumeOb
 /*===========================================================================*/
 /**
  *  @brief  Convolution.
+ *
+ *  The nodes are convolved in parallel for each row if the multi-threading
+ *  is enabled, and the result is identical to the serial convolution. In the
+ *  fast convolution, the volume is divided into the slabs of the fixed
+ *  number of z-positions, which are convolved in parallel, so that the
+ *  result does not depend on the number of threads.
+ *
  *  @param  volume [i] pointer to a uniform volume data
  */
 /*===========================================================================*/
 template <typename T>
 void LineIntegralConvolution::convolution( const kvs::StructuredVolumeObject* volume )
 {
-    kvs::Vector3<T> u;         // vector of node
-    kvs::Vector3<T> p;         // position of node
-    kvs::Vector3<T> travel_t;  //
-    kvs::Vector3<T> entry_pos; //
-
-    const kvs::UInt8*           noise_data = static_cast<const kvs::UInt8*>( m_noise->values().data() );
-    const T*                    src_data = static_cast<const T*>( volume->values().data() );
+    const kvs::UInt8* noise_data = static_cast<const kvs::UInt8*>( m_noise->values().data() );
+    const T* src_data = static_cast<const T*>( volume->values().data() );
 
     kvs::ValueArray<kvs::UInt8> dst_data( volume->numberOfNodes() );
+    kvs::UInt8* pdst = dst_data.data();
 
     const kvs::Vector3ui resol( volume->resolution() );
+    const double length = m_length;
 
-    unsigned int counter = 0;
-    for( size_t k = 0; k < resol.z(); k++ )
+    if ( m_enable_fast_convolution )
+    {
+        const size_t slab_size = 16;
+        const long nslabs = static_cast<long>( ( resol.z() + slab_size - 1 ) / slab_size );
+        kvs::ValueArray<kvs::UInt8> convolved( volume->numberOfNodes() );
+        convolved.fill( 0 );
+        kvs::UInt8* pconvolved = convolved.data();
+
+        KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(dynamic) )
+        for ( long s = 0; s < nslabs; s++ )
+        {
+            const size_t k0 = s * slab_size;
+            const size_t k1 = kvs::Math::Min( k0 + slab_size, size_t( resol.z() ) );
+            ::ConvoluteSlab( src_data, noise_data, resol, k0, k1, length, pconvolved, pdst );
+        }
+    }
+    else
     {
-        for( size_t j = 0; j < resol.y(); j++ )
+        const long nrows = static_cast<long>( resol.y() * resol.z() );
+        KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(dynamic) )
+        for ( long row = 0; row < nrows; row++ )
         {
-            for( size_t i = 0; i < resol.x(); i++ )
+            const size_t j = row % resol.y();
+            const size_t k = row / resol.y();
+            unsigned int counter = static_cast<unsigned int>( row * resol.x() );
+            for ( size_t i = 0; i < resol.x(); i++, counter++ )
             {
-                int i_c = i;
-                int j_c = j;
-                int k_c = k;
-
-                T acc_length = T(0);
-                T acc_data   = T(0);
-
-                unsigned int loc_c = counter;
-
-                for( int m = 1; m > -2; m -= 2  )
-                {
-                    i_c = i;
-                    j_c = j;
-                    k_c = k;
-
-                    entry_pos[0] = T( i + 0.5 );
-                    entry_pos[1] = T( j + 0.5 );
-                    entry_pos[2] = T( k + 0.5 );
-
-                    loc_c = counter;
-
-                    while( acc_length < m_length )
-                    {
-                        T   t_min = 1.0e+10;
-                        int l_min = -1;
-                        int inc;
-
-                        int scalar = noise_data[loc_c];
-
-                        u = (T)m * kvs::Vector3<T>( src_data + 3 * loc_c );
-
-                        p[0] = T( i_c );
-                        p[1] = T( j_c );
-                        p[2] = T( k_c );
-
-                        for( int l = 0; l < 3; l++ )
-                        {
-                            if( kvs::Math::IsZero( u[l] ) )
-                            {
-                                travel_t[l] = T( 1.1e+10 );
-                            }
-                            else if( u[l] < T(0) )
-                            {
-                                travel_t[l] = ( p[l] - entry_pos[l] ) / u[l];
-                            }
-                            else
-                            {
-                                travel_t[l] = ( p[l] + 1 - entry_pos[l] ) / u[l];
-                            }
-
-                            if( travel_t[l] < t_min )
-                            {
-                                t_min = travel_t[l];
-                                l_min = l;
-                            }
-                        }
-
-                        if( l_min == -1 ) break;
-
-                        entry_pos += u * t_min;
-
-                        inc = u[l_min] < T(0) ? -1 : 1;
-
-                        if( l_min == 0 )
-                        {
-                            loc_c += inc;
-                            i_c   += inc;
-                        }
-                        else if( l_min == 1 )
-                        {
-                            loc_c += inc * resol.x();
-                            j_c   += inc;
-                        }
-                        else if( l_min == 2 )
-                        { 
-                            loc_c += inc * resol.x() * resol.y();
-                            k_c   += inc;
-                        }
-
-                        T length = t_min * static_cast<T>( u.length() );
-
-                        /* For small length (close to 0.0) it enters in a infinite loop */
-                        if( kvs::Math::IsZero( length ) ) length = T( 1.1e+10 );
-
-                        if( acc_length < 1.1e-10 ) acc_length = T(0);
-
-                        acc_data   += length * scalar;
-                        acc_length += length;
-
-                        if( i_c < 0 || i_c >= static_cast<int>(resol.x()) ||
-                            j_c < 0 || j_c >= static_cast<int>(resol.y()) ||
-                            k_c < 0 || k_c >= static_cast<int>(resol.z()) ) break;
-                    }
-                }
-
-                acc_data /= acc_length;
-                dst_data[counter] = (kvs::UInt8)( (int)(acc_data) % 256 );
-
-                counter++;
+                pdst[ counter ] = ::Convolute( src_data, noise_data, resol, i, j, k, counter, length );
             }
         }
     }
@@ -10,6 +10,7 @@
 #include <kvs/StructuredVolumeObject>
 #include <kvs/FilterBase>
 #include <kvs/Module>
+#include <kvs/MersenneTwister>
 
 
 namespace kvs
@@ -18,6 +19,11 @@ namespace kvs
 /*===========================================================================*/
 /**
  *  @brief  LIC class.
+ *
+ *  The nodes can be convolved in parallel with the multi-threading. In the
+ *  fast convolution (fast LIC), the streamline traced from a node is shared
+ *  with the nodes on the streamline, which approximates the convolution
+ *  with much fewer streamline steps.
  */
 /*===========================================================================*/
 class LineIntegralConvolution : public kvs::FilterBase, public kvs::StructuredVolumeObject
@@ -30,6 +36,9 @@ protected:
 
     double m_length; ///< stream length
     kvs::StructuredVolumeObject* m_noise; ///< white noise volume
+    kvs::MersenneTwister m_random; ///< random number generator for the white noise
+    bool m_enable_mthreading; ///< flag for multi-threading
+    bool m_enable_fast_convolution; ///< flag for the fast convolution
 
 public:
 
@@ -39,6 +48,17 @@ public:
     virtual ~LineIntegralConvolution();
 
     void setLength( const double length );
+    void setSeed( const kvs::UInt32 seed ) { m_random.setSeed( seed ); }
+
+    bool isEnabledMultiThreading() const { return m_enable_mthreading; }
+    void setEnabledMultiThreading( const bool enable ) { m_enable_mthreading = enable; }
+    void enableMultiThreading() { this->setEnabledMultiThreading( true ); }
+    void disableMultiThreading() { this->setEnabledMultiThreading( false ); }
+
+    bool isFastConvolutionEnabled() const { return m_enable_fast_convolution; }
+    void setFastConvolutionEnabled( const bool enable ) { m_enable_fast_convolution = enable; }
+    void enableFastConvolution() { this->setFastConvolutionEnabled( true ); }
+    void disableFastConvolution() { this->setFastConvolutionEnabled( false ); }
 
     SuperClass* exec( const kvs::ObjectBase* object );
 
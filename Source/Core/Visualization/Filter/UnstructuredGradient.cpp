@@ -5,9 +5,11 @@
  */
 /*****************************************************************************/
 #include "UnstructuredGradient.h"
-#include "InverseDistanceWeighting.h"
+#include <vector>
 #include <kvs/UnstructuredVolumeObject>
+#include <kvs/NodeToCellConnectivity>
 #include <kvs/PrismaticCell>
+#include <kvs/OpenMP>
 
 
 namespace
@@ -44,6 +46,145 @@ const kvs::UnstructuredVolumeObject* Cast( const kvs::ObjectBase* object )
     return kvs::UnstructuredVolumeObject::DownCast( volume );
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Stores the value to the array.
+ *  @param  value [in] vector or tensor value
+ *  @param  data [out] pointer to the array
+ */
+/*===========================================================================*/
+inline void Store( const kvs::Vec3& value, kvs::Real32* data )
+{
+    data[0] = value[0];
+    data[1] = value[1];
+    data[2] = value[2];
+}
+
+inline void Store( const kvs::Mat3& value, kvs::Real32* data )
+{
+    for ( size_t i = 0; i < 3; i++ )
+    {
+        data[ 3 * i + 0 ] = value[i][0];
+        data[ 3 * i + 1 ] = value[i][1];
+        data[ 3 * i + 2 ] = value[i][2];
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the gradient at the center of the cell.
+ *  @param  cell [in] cell bound to the cell of the volume
+ *  @return gradient vector or tensor
+ */
+/*===========================================================================*/
+template <typename Value>
+Value Gradient( const kvs::PrismaticCell& cell );
+
+template <>
+inline kvs::Vec3 Gradient<kvs::Vec3>( const kvs::PrismaticCell& cell )
+{
+    return cell.gradientVector();
+}
+
+template <>
+inline kvs::Mat3 Gradient<kvs::Mat3>( const kvs::PrismaticCell& cell )
+{
+    return cell.gradientTensor();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the node gradients by the inverse distance weighting.
+ *
+ *  The gradient at the center of each cell and the distances from the
+ *  center to the cell nodes are calculated for each cell, and then they are
+ *  gathered to each node through the node-to-cell connectivity. Since each
+ *  node is written by only one thread, the cells and the nodes can be
+ *  processed in parallel without any locks. The cells of each node are
+ *  gathered in ascending order, so the result does not depend on the number
+ *  of threads.
+ *
+ *  @param  volume [in] pointer to the input volume object
+ *  @param  enable_mthreading [in] if true, the gradients are calculated in parallel
+ *  @return gradients of the nodes
+ */
+/*===========================================================================*/
+template <typename Value, size_t VecLen>
+kvs::ValueArray<kvs::Real32> NodeGradients(
+    const kvs::UnstructuredVolumeObject* volume,
+    const bool enable_mthreading )
+{
+    const size_t ncells = volume->numberOfCells();
+    const size_t nnodes = volume->numberOfNodes();
+    const size_t cell_nnodes = volume->numberOfCellNodes();
+    const kvs::UInt32* connections = volume->connections().data();
+
+    // Gradients and distances for each cell.
+    std::vector<Value> gradients( ncells );
+    kvs::ValueArray<kvs::Real32> distances( ncells * cell_nnodes );
+    KVS_OMP_PARALLEL( if( enable_mthreading ) )
+    {
+        kvs::PrismaticCell cell( volume );
+        const kvs::Vec3 center = cell.localCenter();
+        const long N = static_cast<long>( ncells );
+        KVS_OMP_FOR( schedule(static) )
+        for ( long i = 0; i < N; i++ )
+        {
+            cell.bindCell( i );
+            cell.setLocalPoint( center );
+            gradients[i] = ::Gradient<Value>( cell );
+
+            const kvs::Vec3 c = cell.center();
+            for ( size_t j = 0; j < cell_nnodes; j++ )
+            {
+                distances[ i * cell_nnodes + j ] = ( cell.coord(j) - c ).length();
+            }
+        }
+    }
+
+    // Inverse distance weighting for each node.
+    const auto& connectivity = volume->nodeToCellConnectivity( enable_mthreading );
+    kvs::ValueArray<kvs::Real32> values( nnodes * VecLen );
+    const long N = static_cast<long>( nnodes );
+    KVS_OMP_PARALLEL_FOR( if( enable_mthreading ) schedule(static) )
+    for ( long i = 0; i < N; i++ )
+    {
+        const kvs::UInt32* begin = connectivity->beginCells(i);
+        const kvs::UInt32* end = connectivity->endCells(i);
+
+        // The cell sharing the node more than once appears the same times
+        // in the connectivity, so the duplicated entries are skipped here.
+        float w = 0.0f;
+        for ( const kvs::UInt32* c = begin; c != end; c++ )
+        {
+            if ( c != begin && *c == *( c - 1 ) ) { continue; }
+            const size_t offset = *c * cell_nnodes;
+            for ( size_t j = 0; j < cell_nnodes; j++ )
+            {
+                if ( connections[ offset + j ] != kvs::UInt32( i ) ) { continue; }
+                w += 1.0f / distances[ offset + j ];
+            }
+        }
+
+        Value value = Value::Zero();
+        for ( const kvs::UInt32* c = begin; c != end; c++ )
+        {
+            if ( c != begin && *c == *( c - 1 ) ) { continue; }
+            const size_t offset = *c * cell_nnodes;
+            for ( size_t j = 0; j < cell_nnodes; j++ )
+            {
+                if ( connections[ offset + j ] != kvs::UInt32( i ) ) { continue; }
+                const kvs::Real32 d = distances[ offset + j ];
+                value += ( ( 1.0f / d ) / w ) * gradients[ *c ];
+            }
+        }
+
+        ::Store( value, values.data() + i * VecLen );
+    }
+
+    return values;
+}
+
 } // end of namespace
 
 
@@ -95,31 +236,11 @@ UnstructuredGradient::SuperClass* UnstructuredGradient::exec( const kvs::ObjectB
 /*===========================================================================*/
 void UnstructuredGradient::scalar_gradient( const kvs::UnstructuredVolumeObject* volume )
 {
-    const size_t ncells = volume->numberOfCells();
-    const size_t nnodes = volume->numberOfNodes();
-    const kvs::UInt32* connections = volume->connections().data();
-
-    kvs::InverseDistanceWeighting<kvs::Vec3> idw( nnodes );
-    kvs::PrismaticCell cell( volume );
-    const kvs::Vec3 center = cell.localCenter();
-    for ( size_t i = 0; i < ncells; i++ )
-    {
-        cell.bindCell( i );
-        cell.setLocalPoint( center );
-        const kvs::Vec3 V = cell.gradientVector();
-
-        const kvs::Vec3 c = cell.center();
-        for ( size_t j = 0; j < cell.numberOfCellNodes(); j++ )
-        {
-            const kvs::UInt32 id = *( connections++ );
-            const kvs::Real32 d = ( cell.coord(j) - c ).length();
-            idw.insert( id, V, d );
-        }
-    }
+    const auto values = ::NodeGradients<kvs::Vec3,3>( volume, m_enable_mthreading );
 
     SuperClass::shallowCopy( *volume );
     SuperClass::setVeclen( 3 );
-    SuperClass::setValues( kvs::AnyValueArray( idw.serialize() ) );
+    SuperClass::setValues( kvs::AnyValueArray( values ) );
     SuperClass::updateMinMaxValues();
 }
 
@@ -131,31 +252,11 @@ void UnstructuredGradient::scalar_gradient( const kvs::UnstructuredVolumeObject*
 /*===========================================================================*/
 void UnstructuredGradient::vector_gradient( const kvs::UnstructuredVolumeObject* volume )
 {
-    const size_t ncells = volume->numberOfCells();
-    const size_t nnodes = volume->numberOfNodes();
-    const kvs::UInt32* connections = volume->connections().data();
-
-    kvs::InverseDistanceWeighting<kvs::Mat3> idw( nnodes );
-    kvs::PrismaticCell cell( volume );
-    const kvs::Vec3 center = cell.localCenter();
-    for ( size_t i = 0; i < ncells; i++ )
-    {
-        cell.bindCell( i );
-        cell.setLocalPoint( center );
-        const kvs::Mat3 T = cell.gradientTensor();
-
-        const kvs::Vec3 c = cell.center();
-        for ( size_t j = 0; j < cell.numberOfCellNodes(); j++ )
-        {
-            const kvs::UInt32 id = *( connections++ );
-            const kvs::Real32 d = ( cell.coord(j) - c ).length();
-            idw.insert( id, T, d );
-        }
-    }
+    const auto values = ::NodeGradients<kvs::Mat3,9>( volume, m_enable_mthreading );
 
     SuperClass::shallowCopy( *volume );
     SuperClass::setVeclen( 9 );
-    SuperClass::setValues( kvs::AnyValueArray( idw.serialize() ) );
+    SuperClass::setValues( kvs::AnyValueArray( values ) );
     SuperClass::updateMinMaxValues();
 }
 
@@ -24,11 +24,21 @@ class UnstructuredGradient : public kvs::FilterBase, public kvs::UnstructuredVol
     kvsModuleBaseClass( kvs::FilterBase );
     kvsModuleSuperClass( kvs::UnstructuredVolumeObject );
 
+private:
+
+    bool m_enable_mthreading = false; ///< flag for multi-threading
+
 public:
 
+    UnstructuredGradient() = default;
     UnstructuredGradient( const kvs::UnstructuredVolumeObject* volume );
     SuperClass* exec( const kvs::ObjectBase* object );
 
+    bool isEnabledMultiThreading() const { return m_enable_mthreading; }
+    void setEnabledMultiThreading( const bool enable ) { m_enable_mthreading = enable; }
+    void enableMultiThreading() { this->setEnabledMultiThreading( true ); }
+    void disableMultiThreading() { this->setEnabledMultiThreading( false ); }
+
 private:
 
     void scalar_gradient( const kvs::UnstructuredVolumeObject* volume );
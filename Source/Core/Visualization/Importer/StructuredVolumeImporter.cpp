@@ -12,6 +12,8 @@
 #include <kvs/Vector3>
 #include <kvs/Directory>
 #include <kvs/Value>
+#include <kvs/OpenMP>
+#include <algorithm>
 
 
 namespace kvs
@@ -30,9 +32,11 @@ StructuredVolumeImporter::StructuredVolumeImporter()
 /**
  *  @brief  Constructs a new StructuredVolumeImporter class.
  *  @param  filename [in] input filename
+ *  @param  enable_mthreading [in] if true, the DICOM files are read in parallel
  */
 /*===========================================================================*/
-StructuredVolumeImporter::StructuredVolumeImporter( const std::string& filename )
+StructuredVolumeImporter::StructuredVolumeImporter( const std::string& filename, const bool enable_mthreading ):
+    m_enable_mthreading( enable_mthreading )
 {
     if ( kvs::KVSMLStructuredVolumeObject::CheckExtension( filename ) )
     {
@@ -61,7 +65,7 @@ StructuredVolumeImporter::StructuredVolumeImporter( const std::string& filename
     }
     else if ( kvs::DicomList::CheckDirectory( filename ) )
     {
-        kvs::DicomList* file_format = new kvs::DicomList( filename );
+        kvs::DicomList* file_format = new kvs::DicomList;
         if( !file_format )
         {
             BaseClass::setSuccess( false );
@@ -69,6 +73,10 @@ StructuredVolumeImporter::StructuredVolumeImporter( const std::string& filename
             return;
         }
 
+        file_format->setEnabledMultiThreading( m_enable_mthreading );
+        file_format->read( filename );
+        file_format->sort();
+
         if( file_format->isFailure() )
         {
             BaseClass::setSuccess( false );
@@ -124,9 +132,9 @@ StructuredVolumeImporter::SuperClass* StructuredVolumeImporter::exec( const kvs:
         return NULL;
     }
 
-    if ( dynamic_cast<const kvs::KVSMLStructuredVolumeObject*>( file_format ) )
+    if ( const kvs::KVSMLStructuredVolumeObject* kvsml = dynamic_cast<const kvs::KVSMLStructuredVolumeObject*>( file_format ) )
     {
-        BaseClass::setSuccess( SuperClass::read( file_format->filename() ) );
+        BaseClass::setSuccess( SuperClass::read( kvsml->filename(), kvsml->isEnabledMemoryMapping() ) );
     }
     else if ( const kvs::AVSField* volume = dynamic_cast<const kvs::AVSField*>( file_format ) )
     {
@@ -279,29 +287,40 @@ const kvs::AnyValueArray StructuredVolumeImporter::get_dicom_data(
     const size_t nslices = dicom_list->nslices();
     const size_t nnodes = width * height * nslices;
 
-    const double min_range = static_cast<double>( kvs::Value<T>::Min() );
-    const double max_range = static_cast<double>( kvs::Value<T>::Max() );
+    const int min_range = static_cast<int>( kvs::Value<T>::Min() );
+    const int max_range = static_cast<int>( kvs::Value<T>::Max() );
 
     kvs::AnyValueArray values;
     values.template allocate<T>( nnodes );
 
+    // The slices are copied into the values with flipping vertically, in
+    // parallel if the multi-threading is enabled.
     T* pvalues = static_cast<T*>( values.data() );
-    for ( size_t k = 0; k < nslices; k++ )
+    const long N = static_cast<long>( nslices );
+    KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(static) )
+    for ( long k = 0; k < N; k++ )
     {
         const kvs::Dicom* dicom = (*dicom_list)[k];
         const T* const raw_data = reinterpret_cast<const T*>( dicom->rawData().data() );
-        const int shift_value = shift ? dicom->minRawValue() : 0;
+        T* slice = pvalues + k * width * height;
+        if ( !shift )
+        {
+            for ( size_t j = 0; j < height; j++ )
+            {
+                const T* const row = raw_data + ( height - j - 1 ) * width;
+                std::copy( row, row + width, slice + j * width );
+            }
+            continue;
+        }
 
+        const int shift_value = dicom->minRawValue();
         for ( size_t j = 0; j < height; j++ )
         {
+            const T* const row = raw_data + ( height - j - 1 ) * width;
             for ( size_t i = 0; i < width; i++ )
             {
-                const size_t pixel_index = ( height - j - 1 ) * width + i;
-                double value = static_cast<double>( raw_data[ pixel_index ] );
-                value = value - shift_value;
-                value = kvs::Math::Clamp( value, min_range, max_range );
-
-                *(pvalues++) = static_cast<T>( value );
+                const int value = static_cast<int>( row[i] ) - shift_value;
+                slice[ j * width + i ] = static_cast<T>( kvs::Math::Clamp( value, min_range, max_range ) );
             }
         }
     }
@@ -27,12 +27,20 @@ class StructuredVolumeImporter : public kvs::ImporterBase, public kvs::Structure
     kvsModuleBaseClass( kvs::ImporterBase );
     kvsModuleSuperClass( kvs::StructuredVolumeObject );
 
+private:
+    bool m_enable_mthreading = false; ///< flag for the multi-threading
+
 public:
     StructuredVolumeImporter();
-    StructuredVolumeImporter( const std::string& filename );
+    StructuredVolumeImporter( const std::string& filename, const bool enable_mthreading = false );
     StructuredVolumeImporter( const kvs::FileFormatBase* file_format );
     virtual ~StructuredVolumeImporter();
 
+    bool isEnabledMultiThreading() const { return m_enable_mthreading; }
+    void setEnabledMultiThreading( const bool enable ) { m_enable_mthreading = enable; }
+    void enableMultiThreading() { this->setEnabledMultiThreading( true ); }
+    void disableMultiThreading() { this->setEnabledMultiThreading( false ); }
+
     SuperClass* exec( const kvs::FileFormatBase* file_format );
 
 private:
@@ -193,9 +193,9 @@ UnstructuredVolumeImporter::SuperClass* UnstructuredVolumeImporter::exec( const
         return NULL;
     }
 
-    if ( dynamic_cast<const kvs::KVSMLUnstructuredVolumeObject*>( file_format ) )
+    if ( const kvs::KVSMLUnstructuredVolumeObject* kvsml = dynamic_cast<const kvs::KVSMLUnstructuredVolumeObject*>( file_format ) )
     {
-        BaseClass::setSuccess( SuperClass::read( file_format->filename() ) );
+        BaseClass::setSuccess( SuperClass::read( kvsml->filename(), kvsml->isEnabledMemoryMapping() ) );
     }
     else if ( const kvs::AVSUcd* volume = dynamic_cast<const kvs::AVSUcd*>( file_format ) )
     {
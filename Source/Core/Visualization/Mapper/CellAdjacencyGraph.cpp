@@ -8,8 +8,7 @@
 #include <kvs/UnstructuredVolumeObject>
 #include <kvs/Message>
 #include <kvs/Assert>
-#include <map>
-#include <algorithm>
+#include <kvs/NodeTupleHashMap>
 
 
 namespace
@@ -17,151 +16,11 @@ namespace
 
 /*===========================================================================*/
 /**
- *  @brief  Face class.
+ *  @brief  Face map (node IDs of the face -> index of the face in the graph).
  */
 /*===========================================================================*/
-class Face
-{
-private:
-
-    kvs::UInt32 m_id[5]; ///< node ID x 3, cell ID, face ID
-
-public:
-
-    Face(
-        const kvs::UInt32 node_id0,
-        const kvs::UInt32 node_id1,
-        const kvs::UInt32 node_id2,
-        const kvs::UInt32 cell_id,
-        const kvs::UInt32 face_id );
-
-    Face(
-        const kvs::UInt32 node_id0,
-        const kvs::UInt32 node_id1,
-        const kvs::UInt32 node_id2,
-        const kvs::UInt32 node_id3,
-        const kvs::UInt32 cell_id,
-        const kvs::UInt32 face_id );
-
-    kvs::UInt32 nodeID( const size_t index ) const;
-    kvs::UInt32 cellID() const;
-    kvs::UInt32 faceID() const;
-    friend bool operator == ( const Face& f0, const Face& f1 );
-};
-
-/*===========================================================================*/
-/**
- *  @brief  Constructs a new Face class.
- *  @param  node_id0 [in] node ID 0
- *  @param  node_id1 [in] node ID 1
- *  @param  node_id2 [in] node ID 2
- *  @param  cell_id [in] cell ID
- *  @param  face_id [in] face ID
- */
-/*===========================================================================*/
-inline Face::Face(
-    const kvs::UInt32 node_id0,
-    const kvs::UInt32 node_id1,
-    const kvs::UInt32 node_id2,
-    const kvs::UInt32 cell_id,
-    const kvs::UInt32 face_id )
-{
-    m_id[0] = node_id0;
-    m_id[1] = node_id1;
-    m_id[2] = node_id2;
-    m_id[3] = cell_id;
-    m_id[4] = face_id;
-}
-
-/*===========================================================================*/
-/**
- *  @brief  Constructs a new Face class.
- *  @param  node_id0 [in] node ID 0
- *  @param  node_id1 [in] node ID 1
- *  @param  node_id2 [in] node ID 2
- *  @param  node_id3 [in] node ID 3
- *  @param  cell_id [in] cell ID
- *  @param  face_id [in] face ID
- */
-/*===========================================================================*/
-inline Face::Face(
-    const kvs::UInt32 node_id0,
-    const kvs::UInt32 node_id1,
-    const kvs::UInt32 node_id2,
-    const kvs::UInt32 node_id3,
-    const kvs::UInt32 cell_id,
-    const kvs::UInt32 face_id )
-{
-    kvs::UInt32 id[4] = { node_id0, node_id1, node_id2, node_id3 };
-    std::sort( id, id + 4 );
-
-    m_id[0] = id[0];
-    m_id[1] = id[1];
-    m_id[2] = id[2];
-    m_id[3] = cell_id;
-    m_id[4] = face_id;
-}
-
-/*===========================================================================*/
-/**
- *  @brief  Returns a node ID.
- *  @param  index [in] index (0-2)
- *  @return node ID
- */
-/*===========================================================================*/
-inline kvs::UInt32 Face::nodeID( const size_t index ) const
-{
-    KVS_ASSERT( index < 3 );
-
-    return m_id[ index ];
-}
-
-/*===========================================================================*/
-/**
- *  @brief  Returns a cell ID.
- *  @return cell ID
- */
-/*===========================================================================*/
-inline kvs::UInt32 Face::cellID() const
-{
-    return m_id[3];
-}
-
-/*===========================================================================*/
-/**
- *  @brief  Returns a face ID.
- *  @return face ID
- */
-/*===========================================================================*/
-inline kvs::UInt32 Face::faceID() const
-{
-    return m_id[4];
-}
-
-/*===========================================================================*/
-/**
- *  @brief  '==' operator for the Face class.
- *  @param  f0 [in] face #0
- *  @param  f1 [in] face #1
- *  @return true, if the face #0 is equal to the face #1
- */
-/*===========================================================================*/
-inline bool operator == ( const Face& f0, const Face& f1 )
-{
-    for ( size_t i = 0; i < 3; i++ )
-    {
-        bool flag = false;
-        for ( size_t j = 0; j < 3; j++ )
-        {
-            if ( f0.nodeID(i) == f1.nodeID(j) ) { flag = true; continue; }
-        }
-        if ( !flag ) return false;
-    }
-
-    return true;
-}
-
-typedef std::multimap<kvs::UInt32,Face> FaceMap;
+template <size_t N>
+using FaceMap = kvs::NodeTupleHashMap<N,kvs::UInt32>;
 
 const kvs::UInt32 TetrahedralCellFaces[12] = {
     0, 1, 2, // face 0
@@ -262,7 +121,6 @@ const kvs::BitArray& CellAdjacencyGraph::mask() const
 void CellAdjacencyGraph::create_for_tetrahedral_cell( const kvs::UnstructuredVolumeObject* volume )
 {
     const kvs::UInt32* const connections = volume->connections().data();
-    const size_t nnodes = volume->numberOfNodes();
     const size_t ncells = volume->numberOfCells();
 //    const size_t nnodes_per_cell = static_cast<size_t>( volume->cellType() );
     const size_t nnodes_per_cell = volume->numberOfCellNodes();
@@ -271,7 +129,7 @@ void CellAdjacencyGraph::create_for_tetrahedral_cell( const kvs::UnstructuredVol
     m_graph.fill( 0 );
     m_mask.allocate( ncells * 4 );
 
-    ::FaceMap face_map;
+    ::FaceMap<3> face_map( ncells * 2 );
     for ( size_t cell_id = 0, index = 0; cell_id < ncells; cell_id++ )
     {
         // IDs of the first-order nodes.
@@ -290,32 +148,19 @@ void CellAdjacencyGraph::create_for_tetrahedral_cell( const kvs::UnstructuredVol
                 node[ ::TetrahedralCellFaces[ face_id * 3 + 2 ] ]
             };
 
-            const kvs::UInt32 key( ( n[0] + n[1] + n[2] ) % nnodes );
-            const ::Face value( n[0], n[1], n[2], cell_id, face_id );
-
             // Search.
             m_mask.reset( index );
-            ::FaceMap::iterator f = face_map.find( key );
-            ::FaceMap::const_iterator last = face_map.end();
-            if ( f != last )
+            const auto result = face_map.insert( { n[0], n[1], n[2] }, kvs::UInt32( index ) );
+            if ( !result.second )
             {
-                ::FaceMap::const_iterator upper = face_map.upper_bound( key );
-                while ( f != upper )
-                {
-                    if ( f->second == value )
-                    {
-                        // The edge has been already inserted in the bucket.
-                        m_graph[ index ] = f->second.cellID();
-                        m_graph[ f->second.cellID() * 4 + f->second.faceID() ] = cell_id;
-                        m_mask.set( index );
-                        m_mask.set( f->second.cellID() * 4 + f->second.faceID() );
-                        face_map.erase( f );
-                        break;
-                    }
-                    f++;
-                }
+                // The face has been already inserted in the bucket.
+                const kvs::UInt32 adjacent_index = face_map.value( result.first );
+                m_graph[ index ] = adjacent_index / 4;
+                m_graph[ adjacent_index ] = kvs::UInt32( cell_id );
+                m_mask.set( index );
+                m_mask.set( adjacent_index );
+                face_map.value( result.first ) = kvs::UInt32( index );
             }
-            face_map.insert( std::make_pair( key, value ) );
         }
     }
 }
@@ -329,7 +174,6 @@ void CellAdjacencyGraph::create_for_tetrahedral_cell( const kvs::UnstructuredVol
 void CellAdjacencyGraph::create_for_hexahedral_cell( const kvs::UnstructuredVolumeObject* volume )
 {
     const kvs::UInt32* const connections = volume->connections().data();
-    const size_t nnodes = volume->numberOfNodes();
     const size_t ncells = volume->numberOfCells();
 //    const size_t nnodes_per_cell = static_cast<size_t>( volume->cellType() );
     const size_t nnodes_per_cell = volume->numberOfCellNodes();
@@ -338,7 +182,7 @@ void CellAdjacencyGraph::create_for_hexahedral_cell( const kvs::UnstructuredVolu
     m_graph.fill( 0 );
     m_mask.allocate( ncells * 6 );
 
-    ::FaceMap face_map;
+    ::FaceMap<4> face_map( ncells * 3 );
     for ( size_t cell_id = 0, index = 0; cell_id < ncells; cell_id++ )
     {
         // IDs of the first-order nodes.
@@ -362,32 +206,19 @@ void CellAdjacencyGraph::create_for_hexahedral_cell( const kvs::UnstructuredVolu
                 node[ ::HexahedralCellFaces[ face_id * 4 + 3 ] ]
             };
 
-            const kvs::UInt32 key( ( n[0] + n[1] + n[2] + n[3] ) % nnodes );
-            const ::Face value( n[0], n[1], n[2], n[3], cell_id, face_id );
-
             // Search.
             m_mask.reset( index );
-            ::FaceMap::iterator f = face_map.find( key );
-            ::FaceMap::const_iterator last = face_map.end();
-            if ( f != last )
+            const auto result = face_map.insert( { n[0], n[1], n[2], n[3] }, kvs::UInt32( index ) );
+            if ( !result.second )
             {
-                ::FaceMap::const_iterator upper = face_map.upper_bound( key );
-                while ( f != upper )
-                {
-                    if ( f->second == value )
-                    {
-                        // The edge has been already inserted in the bucket.
-                        m_graph[ index ] = f->second.cellID();
-                        m_graph[ f->second.cellID() * 6 + f->second.faceID() ] = cell_id;
-                        m_mask.set( index );
-                        m_mask.set( f->second.cellID() * 6 + f->second.faceID() );
-                        face_map.erase( f );
-                        break;
-                    }
-                    f++;
-                }
+                // The face has been already inserted in the bucket.
+                const kvs::UInt32 adjacent_index = face_map.value( result.first );
+                m_graph[ index ] = adjacent_index / 6;
+                m_graph[ adjacent_index ] = kvs::UInt32( cell_id );
+                m_mask.set( index );
+                m_mask.set( adjacent_index );
+                face_map.value( result.first ) = kvs::UInt32( index );
             }
-            face_map.insert( std::make_pair( key, value ) );
         }
     }
 }
@@ -35,15 +35,24 @@ CellTreeLocator::CellTreeLocator(
     this->build();
 }
 
+CellTreeLocator::CellTreeLocator( const CellTreeLocator& other ):
+    m_cell_tree( other.m_cell_tree ),
+    m_enable_mthreading( other.m_enable_mthreading )
+{
+    if ( other.volume() ) { BaseClass::attachVolume( other.volume() ); }
+    BaseClass::setCacheMode( other.cacheMode() );
+    this->clearCache();
+}
+
 CellTreeLocator::~CellTreeLocator()
 {
-    if ( m_cell_tree ) { delete m_cell_tree; }
 }
 
 void CellTreeLocator::build()
 {
     KVS_ASSERT( BaseClass::volume() );
-    m_cell_tree = new kvs::CellTree( BaseClass::volume(), m_enable_mthreading );
+    // The cell tree cached on the volume object is used.
+    m_cell_tree = BaseClass::volume()->cellTree( m_enable_mthreading );
 }
 
 int CellTreeLocator::findCell( const kvs::Vec3 p )
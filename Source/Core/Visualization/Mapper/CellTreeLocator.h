@@ -16,6 +16,7 @@
 #pragma once
 #include "CellLocator.h"
 #include "CellTree.h"
+#include <kvs/SharedPointer>
 
 
 namespace kvs
@@ -24,6 +25,11 @@ namespace kvs
 /*===========================================================================*/
 /**
  *  @brief  Cell tree locator class.
+ *
+ *  The cell tree is built once for each volume object and cached on it, so
+ *  that the locators for the same volume share the tree. Each locator has
+ *  its own cell interpolator and cache. Therefore, the copied locators can
+ *  be used to find the cells in different threads.
  */
 /*===========================================================================*/
 class CellTreeLocator : public CellLocator
@@ -34,7 +40,7 @@ public:
 
 private:
 
-    kvs::CellTree* m_cell_tree;
+    kvs::SharedPointer<kvs::CellTree> m_cell_tree; ///< cell tree (shared with the copies)
     bool m_enable_mthreading;
     unsigned int m_cache1[32];
     unsigned int* m_cp1;
@@ -45,9 +51,11 @@ public:
 
     CellTreeLocator();
     CellTreeLocator( const kvs::UnstructuredVolumeObject* volume, const bool enable_mthreading = false );
+    CellTreeLocator( const CellTreeLocator& other );
+    CellTreeLocator& operator =( const CellTreeLocator& ) = delete;
     ~CellTreeLocator();
 
-    const kvs::CellTree* cellTree() const { return m_cell_tree; }
+    const kvs::CellTree* cellTree() const { return m_cell_tree.get(); }
     void setEnabledMultiThreading( const bool enable ) { m_enable_mthreading = enable; }
     void enableMultiThreading() { this->setEnabledMultiThreading( true ); }
     void disableMultiThreading() { this->setEnabledMultiThreading( false ); }
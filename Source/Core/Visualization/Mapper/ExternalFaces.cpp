@@ -11,7 +11,11 @@
 #include <kvs/TransferFunction>
 #include <kvs/IgnoreUnusedVariable>
 #include <kvs/Timer>
-#include <map>
+#include <kvs/NodeTupleHashMap>
+#include <kvs/OpenMP>
+#include <kvs/Value>
+#include <vector>
+#include <algorithm>
 #include <cstring>
 
 
@@ -83,6 +87,7 @@ private:
     kvs::UInt32 m_id[3]; ///< vertex IDs
 
 public:
+    TriangleFace() = default;
     TriangleFace( const kvs::UInt32 id0, const kvs::UInt32 id1, const kvs::UInt32 id2 )
     {
         this->set( id0, id1, id2 );
@@ -97,20 +102,6 @@ public:
     {
         m_id[0] = id0; m_id[1] = id1; m_id[2] = id2;
     }
-
-    friend bool operator == ( const TriangleFace& f0, const TriangleFace& f1 )
-    {
-        for ( size_t i = 0; i < 3; i++ )
-        {
-            bool flag = false;
-            for ( size_t j = 0; j < 3; j++ )
-            {
-                if ( f0.id(i) == f1.id(j) ) { flag = true; continue; }
-            }
-            if ( !flag ) { return false; }
-        }
-        return true;
-    }
 };
 
 /*===========================================================================*/
@@ -124,6 +115,7 @@ private:
     kvs::UInt32 m_id[4]; ///< vertex IDs
 
 public:
+    QuadrangleFace() = default;
     QuadrangleFace( const kvs::UInt32 id0, const kvs::UInt32 id1, const kvs::UInt32 id2, const kvs::UInt32 id3 )
     {
         this->set( id0, id1, id2, id3 );
@@ -138,20 +130,6 @@ public:
     {
         m_id[0] = id0; m_id[1] = id1; m_id[2] = id2; m_id[3] = id3;
     }
-
-    friend bool operator == ( const QuadrangleFace& f0, const QuadrangleFace& f1 )
-    {
-        for ( size_t i = 0; i < 4; i++ )
-        {
-            bool flag = false;
-            for ( size_t j = 0; j < 4; j++ )
-            {
-                if ( f0.id(i) == f1.id(j) ) { flag = true; continue; }
-            }
-            if ( !flag ) return false;
-        }
-        return true;
-    }
 };
 
 /*===========================================================================*/
@@ -162,50 +140,62 @@ public:
 class TriangleFaceMap
 {
 public:
-    typedef kvs::UInt32 Key;
     typedef TriangleFace Value;
-    typedef std::multimap<Key,Value> Bucket;
+    typedef kvs::NodeTupleHashMap<3,Value> Bucket;
 
 private:
-    size_t m_nvertices; ///< number of vertices of the original data
-    Bucket m_bucket; ///< bucket for the edge data
+    Bucket m_bucket; ///< bucket for the face data
+    std::vector<kvs::UInt8> m_counters{}; ///< number of insertions (modulo 2) of each face
+    size_t m_nfaces = 0; ///< number of external faces
+    kvs::UInt32 m_min_node = 0; ///< min. node ID of the partition
+    kvs::UInt32 m_max_node = kvs::Value<kvs::UInt32>::Max(); ///< max. node ID (not included) of the partition
+    bool m_partitioned = false; ///< true if the map holds a partition of the faces
+    kvs::UInt64 m_sequence = 0; ///< number of the calls of insert
+    std::vector<kvs::UInt64> m_sequences{}; ///< sequence number of the first insertion of each face
 
 public:
-    TriangleFaceMap( const size_t nvertices ):
-        m_nvertices( nvertices ) {}
+    // The number of faces is estimated as half of the total number of the
+    // local faces, since each internal face is shared by two cells.
+    TriangleFaceMap( const size_t nfaces ):
+        m_bucket( nfaces ) { m_counters.reserve( nfaces ); }
+
+    // The map holds only the faces whose smallest node ID is in the range
+    // [min_node, max_node).
+    TriangleFaceMap( const size_t nfaces, const kvs::UInt32 min_node, const kvs::UInt32 max_node ):
+        m_bucket( nfaces ),
+        m_min_node( min_node ),
+        m_max_node( max_node ),
+        m_partitioned( true ) { m_counters.reserve( nfaces ); m_sequences.reserve( nfaces ); }
 
     const Bucket& bucket() const { return m_bucket; }
+    size_t size() const { return m_nfaces; }
+    bool isExternal( const size_t index ) const { return m_counters[ index ] != 0; }
+    kvs::UInt64 sequence( const size_t index ) const { return m_sequences[ index ]; }
 
     void insert( const kvs::UInt32 id0, const kvs::UInt32 id1, const kvs::UInt32 id2 )
     {
-        const Key key( this->get_key( id0, id1, id2 ) );
-        const Value value( id0, id1, id2 );
-
-        Bucket::iterator f = m_bucket.find( key );
-        Bucket::const_iterator last = m_bucket.end();
-        if ( f != last )
+        const kvs::UInt64 sequence = m_sequence++;
+        if ( m_partitioned )
         {
-            Bucket::const_iterator upper = m_bucket.upper_bound( key );
-            do
-            {
-                if ( f->second == value )
-                {
-                    // The edge has been already inserted in the bucket.
-                    m_bucket.erase( f );
-                    return;
-                }
-                f++;
-            } while ( f != upper );
+            const kvs::UInt32 min_id = std::min( { id0, id1, id2 } );
+            if ( min_id < m_min_node || m_max_node <= min_id ) { return; }
         }
 
-        m_bucket.insert( std::make_pair( key, value ) );
-    }
-
-private:
-    Key get_key( const kvs::UInt32 id0, const kvs::UInt32 id1, const kvs::UInt32 id2 )
-    {
-        const kvs::UInt32 sum = id0 + id1 + id2;
-        return sum % kvs::UInt32( m_nvertices );
+        const auto result = m_bucket.insert( { id0, id1, id2 }, Value( id0, id1, id2 ) );
+        if ( result.second )
+        {
+            m_counters.push_back( 1 );
+            if ( m_partitioned ) { m_sequences.push_back( sequence ); }
+            m_nfaces++;
+        }
+        else
+        {
+            // The face has been already inserted in the bucket, which is
+            // shared with the adjacent cell (internal face).
+            kvs::UInt8& counter = m_counters[ result.first ];
+            if ( counter ) { m_nfaces--; } else { m_nfaces++; }
+            counter ^= 1;
+        }
     }
 };
 
@@ -217,52 +207,150 @@ private:
 class QuadrangleFaceMap
 {
 public:
-    typedef kvs::UInt32 Key;
     typedef QuadrangleFace Value;
-    typedef std::multimap<Key,Value> Bucket;
+    typedef kvs::NodeTupleHashMap<4,Value> Bucket;
 
 private:
-    size_t m_nvertices; ///< number of vertices of the original data
-    Bucket m_bucket; ///< bucket for the edge data
+    Bucket m_bucket; ///< bucket for the face data
+    std::vector<kvs::UInt8> m_counters{}; ///< number of insertions (modulo 2) of each face
+    size_t m_nfaces = 0; ///< number of external faces
+    kvs::UInt32 m_min_node = 0; ///< min. node ID of the partition
+    kvs::UInt32 m_max_node = kvs::Value<kvs::UInt32>::Max(); ///< max. node ID (not included) of the partition
+    bool m_partitioned = false; ///< true if the map holds a partition of the faces
+    kvs::UInt64 m_sequence = 0; ///< number of the calls of insert
+    std::vector<kvs::UInt64> m_sequences{}; ///< sequence number of the first insertion of each face
 
 public:
-    QuadrangleFaceMap( const size_t nvertices ):
-        m_nvertices( nvertices ) {}
+    // The number of faces is estimated as half of the total number of the
+    // local faces, since each internal face is shared by two cells.
+    QuadrangleFaceMap( const size_t nfaces ):
+        m_bucket( nfaces ) { m_counters.reserve( nfaces ); }
+
+    // The map holds only the faces whose smallest node ID is in the range
+    // [min_node, max_node).
+    QuadrangleFaceMap( const size_t nfaces, const kvs::UInt32 min_node, const kvs::UInt32 max_node ):
+        m_bucket( nfaces ),
+        m_min_node( min_node ),
+        m_max_node( max_node ),
+        m_partitioned( true ) { m_counters.reserve( nfaces ); m_sequences.reserve( nfaces ); }
 
     const Bucket& bucket() const { return m_bucket; }
+    size_t size() const { return m_nfaces; }
+    bool isExternal( const size_t index ) const { return m_counters[ index ] != 0; }
+    kvs::UInt64 sequence( const size_t index ) const { return m_sequences[ index ]; }
 
     void insert( const kvs::UInt32 id0, const kvs::UInt32 id1, const kvs::UInt32 id2, const kvs::UInt32 id3 )
     {
-        const Key key( this->get_key( id0, id1, id2, id3 ) );
-        const Value value( id0, id1, id2, id3 );
+        const kvs::UInt64 sequence = m_sequence++;
+        if ( m_partitioned )
+        {
+            const kvs::UInt32 min_id = std::min( { id0, id1, id2, id3 } );
+            if ( min_id < m_min_node || m_max_node <= min_id ) { return; }
+        }
 
-        Bucket::iterator f = m_bucket.find( key );
-        Bucket::const_iterator last = m_bucket.end();
-        if ( f != last )
+        const auto result = m_bucket.insert( { id0, id1, id2, id3 }, Value( id0, id1, id2, id3 ) );
+        if ( result.second )
         {
-            Bucket::const_iterator upper = m_bucket.upper_bound( key );
-            do
-            {
-                if ( f->second == value )
-                {
-                    // The edge has been already inserted in the bucket.
-                    m_bucket.erase( f );
-                    return;
-                }
-                f++;
-            } while ( f != upper );
+            m_counters.push_back( 1 );
+            if ( m_partitioned ) { m_sequences.push_back( sequence ); }
+            m_nfaces++;
+        }
+        else
+        {
+            // The face has been already inserted in the bucket, which is
+            // shared with the adjacent cell (internal face).
+            kvs::UInt8& counter = m_counters[ result.first ];
+            if ( counter ) { m_nfaces--; } else { m_nfaces++; }
+            counter ^= 1;
         }
+    }
+};
 
-        m_bucket.insert( std::make_pair( key, value ) );
+/*===========================================================================*/
+/**
+ *  @brief  Allocates the face maps for the partitions of the faces.
+ *  @param  nnodes [in] number of nodes of the volume
+ *  @param  nfaces [in] expected number of faces
+ *  @param  npartitions [in] number of partitions
+ *  @return face maps
+ */
+/*===========================================================================*/
+template <typename FaceMap>
+inline std::vector<FaceMap> AllocateFaceMaps(
+    const size_t nnodes,
+    const size_t nfaces,
+    const size_t npartitions )
+{
+    std::vector<FaceMap> face_maps;
+    if ( npartitions <= 1 )
+    {
+        face_maps.emplace_back( nfaces );
+        return face_maps;
     }
 
-private:
-    Key get_key( const kvs::UInt32 id0, const kvs::UInt32 id1, const kvs::UInt32 id2, const kvs::UInt32 id3 )
+    // The faces are partitioned by the range of the smallest node ID.
+    face_maps.reserve( npartitions );
+    for ( size_t p = 0; p < npartitions; p++ )
     {
-        const kvs::UInt32 sum = id0 + id1 + id2 + id3;
-        return sum % kvs::UInt32( m_nvertices );
+        const kvs::UInt32 min_node = kvs::UInt32( nnodes * p / npartitions );
+        const kvs::UInt32 max_node = kvs::UInt32( nnodes * ( p + 1 ) / npartitions );
+        face_maps.emplace_back( nfaces / npartitions, min_node, max_node );
+    }
+    return face_maps;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the external faces in the order of the first insertion.
+ *  @param  face_maps [in] face maps
+ *  @return external faces
+ */
+/*===========================================================================*/
+template <typename FaceMap>
+inline std::vector<typename FaceMap::Value> ExternalFaceList( const std::vector<FaceMap>& face_maps )
+{
+    using Face = typename FaceMap::Value;
+    if ( face_maps.size() == 1 )
+    {
+        const FaceMap& face_map = face_maps[0];
+        std::vector<Face> faces;
+        faces.reserve( face_map.size() );
+        for ( size_t i = 0; i < face_map.bucket().size(); i++ )
+        {
+            if ( face_map.isExternal( i ) ) { faces.push_back( face_map.bucket().value( i ) ); }
+        }
+        return faces;
     }
-};
+
+    // The external faces in the partitions are merged in the order of the
+    // first insertion, so that the output is the same as the single map.
+    const size_t npartitions = face_maps.size();
+    std::vector<std::vector<kvs::UInt64>> sequences( npartitions );
+    std::vector<std::vector<size_t>> indices( npartitions );
+    size_t nfaces = 0;
+    for ( size_t p = 0; p < npartitions; p++ ) { nfaces += face_maps[p].size(); }
+
+    KVS_OMP_PARALLEL_FOR( schedule(dynamic) )
+    for ( size_t p = 0; p < npartitions; p++ )
+    {
+        const FaceMap& face_map = face_maps[p];
+        sequences[p].reserve( face_map.size() );
+        indices[p].reserve( face_map.size() );
+        for ( size_t i = 0; i < face_map.bucket().size(); i++ )
+        {
+            if ( !face_map.isExternal( i ) ) { continue; }
+            sequences[p].push_back( face_map.sequence( i ) );
+            indices[p].push_back( i );
+        }
+    }
+
+    std::vector<Face> faces( nfaces );
+    kvs::MergeBySequence( sequences, [&]( const size_t p, const size_t i, const size_t rank )
+    {
+        faces[ rank ] = face_maps[p].bucket().value( indices[p][i] );
+    } );
+    return faces;
+}
 
 /*===========================================================================*/
 /**
@@ -495,21 +583,25 @@ inline void CreatePyramidFaceMap(
  *  @brief  Calculates external faces using the face map.
  *  @param  volume [in] pointer to the unstructured volume object
  *  @param  cmap [in] color map
- *  @param  face_map [in] face map
+ *  @param  faces [in] external faces
  *  @param  coords [out] pointer to the coordinate value array
  *  @param  colors [out] pointer to the color value array
  *  @param  normals [out] pointer to the normal vector array
+ *  @param  enable_mthreading [in] if true, the faces are calculated in parallel
  */
 /*===========================================================================*/
 template <typename T>
 void CalculateFaces(
     const kvs::UnstructuredVolumeObject* volume,
     const kvs::ColorMap cmap,
-    const TriangleFaceMap& face_map,
+    const std::vector<TriangleFace>& faces,
     kvs::ValueArray<kvs::Real32>* coords,
     kvs::ValueArray<kvs::UInt8>* colors,
-    kvs::ValueArray<kvs::Real32>* normals )
+    kvs::ValueArray<kvs::Real32>* normals,
+    const bool enable_mthreading )
 {
+    kvs::IgnoreUnusedVariable( enable_mthreading );
+
     // Parameters of the volume data.
     if ( !volume->hasMinMaxValues() ) { volume->updateMinMaxValues(); }
     const kvs::Real64 min_value = volume->minValue();
@@ -517,27 +609,27 @@ void CalculateFaces(
     const size_t veclen = volume->veclen();
     const T* value = reinterpret_cast<const T*>( volume->values().data() );
 
-    const size_t nfaces = face_map.bucket().size();
+    const size_t nfaces = faces.size();
     const size_t nvertices = nfaces * 3;
     const kvs::Real32* volume_coord = volume->coords().data();
 
     coords->allocate( nvertices * 3 );
     colors->allocate( nvertices * 3 );
     normals->allocate( nfaces * 3 );
-    kvs::Real32* coord = coords->data();
-    kvs::UInt8* color = colors->data();
-    kvs::Real32* normal = normals->data();
 
-    kvs::UInt32 node_index[3] = { 0, 0, 0 };
-    kvs::UInt32 color_level[3] = { 0, 0, 0 };
-
-    TriangleFaceMap::Bucket::const_iterator f = face_map.bucket().begin();
-    TriangleFaceMap::Bucket::const_iterator last = face_map.bucket().end();
-    while ( f != last )
+    KVS_OMP_PARALLEL_FOR( if( enable_mthreading ) schedule(static) )
+    for ( size_t i = 0; i < nfaces; i++ )
     {
-        node_index[0] = f->second.id(0);
-        node_index[1] = f->second.id(1);
-        node_index[2] = f->second.id(2);
+        kvs::Real32* coord = coords->data() + 9 * i;
+        kvs::UInt8* color = colors->data() + 9 * i;
+        kvs::Real32* normal = normals->data() + 3 * i;
+        kvs::UInt32 node_index[3] = { 0, 0, 0 };
+        kvs::UInt32 color_level[3] = { 0, 0, 0 };
+
+        const TriangleFace& f = faces[i];
+        node_index[0] = f.id(0);
+        node_index[1] = f.id(1);
+        node_index[2] = f.id(2);
 
         const kvs::Vec3 v0( volume_coord + 3 * node_index[0] );
         const kvs::Vec3 v1( volume_coord + 3 * node_index[1] );
@@ -574,8 +666,6 @@ void CalculateFaces(
         *( normal++ ) = n.x();
         *( normal++ ) = n.y();
         *( normal++ ) = n.z();
-
-        f++;
     }
 }
 
@@ -584,21 +674,25 @@ void CalculateFaces(
  *  @brief  Calculates external faces using the face map.
  *  @param  volume [in] pointer to the unstructured volume object
  *  @param  cmap [in] color map
- *  @param  face_map [in] face map
+ *  @param  faces [in] external faces
  *  @param  coords [out] pointer to the coordinate value array
  *  @param  colors [out] pointer to the color value array
  *  @param  normals [out] pointer to the normal vector array
+ *  @param  enable_mthreading [in] if true, the faces are calculated in parallel
  */
 /*===========================================================================*/
 template <typename T>
 void CalculateFaces(
     const kvs::UnstructuredVolumeObject* volume,
     const kvs::ColorMap cmap,
-    const QuadrangleFaceMap& face_map,
+    const std::vector<QuadrangleFace>& faces,
     kvs::ValueArray<kvs::Real32>* coords,
     kvs::ValueArray<kvs::UInt8>* colors,
-    kvs::ValueArray<kvs::Real32>* normals )
+    kvs::ValueArray<kvs::Real32>* normals,
+    const bool enable_mthreading )
 {
+    kvs::IgnoreUnusedVariable( enable_mthreading );
+
     // Parameters of the volume data.
     if ( !volume->hasMinMaxValues() ) { volume->updateMinMaxValues(); }
     const kvs::Real64 min_value = volume->minValue();
@@ -607,7 +701,7 @@ void CalculateFaces(
     const T* value = reinterpret_cast<const T*>( volume->values().data() );
 
     // A quadrangle face is composed of two triangle faces
-    const size_t nfaces = face_map.bucket().size() * 2;
+    const size_t nfaces = faces.size() * 2;
 //    const size_t nvertices = nfaces * 4;
     const size_t nvertices = nfaces * 3;
     const kvs::Real32* volume_coord = volume->coords().data();
@@ -615,21 +709,21 @@ void CalculateFaces(
     coords->allocate( nvertices * 3 );
     colors->allocate( nvertices * 3 );
     normals->allocate( nfaces * 3 );
-    kvs::Real32* coord = coords->data();
-    kvs::UInt8* color = colors->data();
-    kvs::Real32* normal = normals->data();
 
-    kvs::UInt32 node_index[4] = { 0, 0, 0, 0 };
-    kvs::UInt32 color_level[4] = { 0, 0, 0, 0 };
-
-    QuadrangleFaceMap::Bucket::const_iterator f = face_map.bucket().begin();
-    QuadrangleFaceMap::Bucket::const_iterator last = face_map.bucket().end();
-    while ( f != last )
+    KVS_OMP_PARALLEL_FOR( if( enable_mthreading ) schedule(static) )
+    for ( size_t i = 0; i < faces.size(); i++ )
     {
-        node_index[0] = f->second.id(0);
-        node_index[1] = f->second.id(1);
-        node_index[2] = f->second.id(2);
-        node_index[3] = f->second.id(3);
+        kvs::Real32* coord = coords->data() + 18 * i;
+        kvs::UInt8* color = colors->data() + 18 * i;
+        kvs::Real32* normal = normals->data() + 6 * i;
+        kvs::UInt32 node_index[4] = { 0, 0, 0, 0 };
+        kvs::UInt32 color_level[4] = { 0, 0, 0, 0 };
+
+        const QuadrangleFace& f = faces[i];
+        node_index[0] = f.id(0);
+        node_index[1] = f.id(1);
+        node_index[2] = f.id(2);
+        node_index[3] = f.id(3);
 
         const kvs::Vec3 v0( volume_coord + 3 * node_index[0] );
         const kvs::Vec3 v1( volume_coord + 3 * node_index[1] );
@@ -698,8 +792,6 @@ void CalculateFaces(
         *( normal++ ) = n.x();
         *( normal++ ) = n.y();
         *( normal++ ) = n.z();
-
-        f++;
     }
 }
 
@@ -707,12 +799,15 @@ template <typename T>
 void CalculateFaces(
     const kvs::UnstructuredVolumeObject* volume,
     const kvs::ColorMap cmap,
-    const TriangleFaceMap& tri_face_map,
-    const QuadrangleFaceMap& quad_face_map,
+    const std::vector<TriangleFace>& tri_faces,
+    const std::vector<QuadrangleFace>& quad_faces,
     kvs::ValueArray<kvs::Real32>* coords,
     kvs::ValueArray<kvs::UInt8>* colors,
-    kvs::ValueArray<kvs::Real32>* normals )
+    kvs::ValueArray<kvs::Real32>* normals,
+    const bool enable_mthreading )
 {
+    kvs::IgnoreUnusedVariable( enable_mthreading );
+
     // Parameters of the volume data.
     if ( !volume->hasMinMaxValues() ) { volume->updateMinMaxValues(); }
     const kvs::Real64 min_value = volume->minValue();
@@ -720,8 +815,8 @@ void CalculateFaces(
     const size_t veclen = volume->veclen();
     const T* value = reinterpret_cast<const T*>( volume->values().data() );
 
-    const size_t tri_nfaces = tri_face_map.bucket().size();
-    const size_t quad_nfaces = quad_face_map.bucket().size() * 2; // div into two tri faces.
+    const size_t tri_nfaces = tri_faces.size();
+    const size_t quad_nfaces = quad_faces.size() * 2; // div into two tri faces.
 
     const size_t nfaces = tri_nfaces + quad_nfaces;
     const size_t nvertices = nfaces * 3;
@@ -730,22 +825,22 @@ void CalculateFaces(
     coords->allocate( nvertices * 3 );
     colors->allocate( nvertices * 3 );
     normals->allocate( nfaces * 3 );
-    kvs::Real32* coord = coords->data();
-    kvs::UInt8* color = colors->data();
-    kvs::Real32* normal = normals->data();
 
     // For triangle faces
     {
-        kvs::UInt32 node_index[3] = { 0, 0, 0 };
-        kvs::UInt32 color_level[3] = { 0, 0, 0 };
-
-        TriangleFaceMap::Bucket::const_iterator f = tri_face_map.bucket().begin();
-        TriangleFaceMap::Bucket::const_iterator last = tri_face_map.bucket().end();
-        while ( f != last )
+        KVS_OMP_PARALLEL_FOR( if( enable_mthreading ) schedule(static) )
+        for ( size_t i = 0; i < tri_faces.size(); i++ )
         {
-            node_index[0] = f->second.id(0);
-            node_index[1] = f->second.id(1);
-            node_index[2] = f->second.id(2);
+            kvs::Real32* coord = coords->data() + 9 * i;
+            kvs::UInt8* color = colors->data() + 9 * i;
+            kvs::Real32* normal = normals->data() + 3 * i;
+            kvs::UInt32 node_index[3] = { 0, 0, 0 };
+            kvs::UInt32 color_level[3] = { 0, 0, 0 };
+
+            const TriangleFace& f = tri_faces[i];
+            node_index[0] = f.id(0);
+            node_index[1] = f.id(1);
+            node_index[2] = f.id(2);
 
             const kvs::Vec3 v0( volume_coord + 3 * node_index[0] );
             const kvs::Vec3 v1( volume_coord + 3 * node_index[1] );
@@ -782,24 +877,25 @@ void CalculateFaces(
             *( normal++ ) = n.x();
             *( normal++ ) = n.y();
             *( normal++ ) = n.z();
-
-            f++;
         }
     }
 
     // For quadrangle faces
     {
-        kvs::UInt32 node_index[4] = { 0, 0, 0, 0 };
-        kvs::UInt32 color_level[4] = { 0, 0, 0, 0 };
-
-        QuadrangleFaceMap::Bucket::const_iterator f = quad_face_map.bucket().begin();
-        QuadrangleFaceMap::Bucket::const_iterator last = quad_face_map.bucket().end();
-        while ( f != last )
+        KVS_OMP_PARALLEL_FOR( if( enable_mthreading ) schedule(static) )
+        for ( size_t i = 0; i < quad_faces.size(); i++ )
         {
-            node_index[0] = f->second.id(0);
-            node_index[1] = f->second.id(1);
-            node_index[2] = f->second.id(2);
-            node_index[3] = f->second.id(3);
+            kvs::Real32* coord = coords->data() + 9 * tri_nfaces + 18 * i;
+            kvs::UInt8* color = colors->data() + 9 * tri_nfaces + 18 * i;
+            kvs::Real32* normal = normals->data() + 3 * tri_nfaces + 6 * i;
+            kvs::UInt32 node_index[4] = { 0, 0, 0, 0 };
+            kvs::UInt32 color_level[4] = { 0, 0, 0, 0 };
+
+            const QuadrangleFace& f = quad_faces[i];
+            node_index[0] = f.id(0);
+            node_index[1] = f.id(1);
+            node_index[2] = f.id(2);
+            node_index[3] = f.id(3);
 
             const kvs::Vec3 v0( volume_coord + 3 * node_index[0] );
             const kvs::Vec3 v1( volume_coord + 3 * node_index[1] );
@@ -868,8 +964,6 @@ void CalculateFaces(
             *( normal++ ) = n.x();
             *( normal++ ) = n.y();
             *( normal++ ) = n.z();
-
-            f++;
         }
     }
 }
@@ -2101,6 +2195,18 @@ void ExternalFaces::mapping( const kvs::UnstructuredVolumeObject* volume )
     if ( SuperClass::numberOfOpacities() == 0 ) SuperClass::setOpacity( 255 );
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of partitions of the faces.
+ *  @return number of partitions (number of threads if multi-threading is enabled)
+ */
+/*===========================================================================*/
+size_t ExternalFaces::number_of_partitions() const
+{
+    if ( !m_enable_mthreading ) { return 1; }
+    return static_cast<size_t>( kvs::Math::Max( 1, kvs::OpenMP::GetMaxThreads() ) );
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Calculates external faces for the tetrahedral cells.
@@ -2110,13 +2216,21 @@ void ExternalFaces::mapping( const kvs::UnstructuredVolumeObject* volume )
 template <typename T>
 void ExternalFaces::calculate_tetrahedral_faces( const kvs::UnstructuredVolumeObject* volume )
 {
-    ::TriangleFaceMap face_map( volume->numberOfNodes() );
-    CreateTetrahedraFaceMap( volume, &face_map );
+    const size_t nnodes = volume->numberOfNodes();
+    const size_t nfaces = volume->numberOfCells() * 4 / 2;
+    const size_t npartitions = this->number_of_partitions();
+    auto face_maps = ::AllocateFaceMaps<::TriangleFaceMap>( nnodes, nfaces, npartitions );
+    KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(dynamic) )
+    for ( size_t p = 0; p < npartitions; p++ )
+    {
+        CreateTetrahedraFaceMap( volume, &face_maps[p] );
+    }
+    const auto faces = ::ExternalFaceList( face_maps );
 
     kvs::ValueArray<kvs::Real32> coords;
     kvs::ValueArray<kvs::UInt8> colors;
     kvs::ValueArray<kvs::Real32> normals;
-    ::CalculateFaces<T>( volume, BaseClass::colorMap(), face_map, &coords, &colors, &normals );
+    ::CalculateFaces<T>( volume, BaseClass::colorMap(), faces, &coords, &colors, &normals, m_enable_mthreading );
 
     SuperClass::setPolygonType( kvs::PolygonObject::Triangle );
     SuperClass::setCoords( coords );
@@ -2133,13 +2247,21 @@ void ExternalFaces::calculate_tetrahedral_faces( const kvs::UnstructuredVolumeOb
 template <typename T>
 void ExternalFaces::calculate_quadratic_tetrahedral_faces( const kvs::UnstructuredVolumeObject* volume )
 {
-    ::TriangleFaceMap face_map( volume->numberOfNodes() );
-    CreateQuadraticTetrahedraFaceMap( volume, &face_map );
+    const size_t nnodes = volume->numberOfNodes();
+    const size_t nfaces = volume->numberOfCells() * 16 / 2;
+    const size_t npartitions = this->number_of_partitions();
+    auto face_maps = ::AllocateFaceMaps<::TriangleFaceMap>( nnodes, nfaces, npartitions );
+    KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(dynamic) )
+    for ( size_t p = 0; p < npartitions; p++ )
+    {
+        CreateQuadraticTetrahedraFaceMap( volume, &face_maps[p] );
+    }
+    const auto faces = ::ExternalFaceList( face_maps );
 
     kvs::ValueArray<kvs::Real32> coords;
     kvs::ValueArray<kvs::UInt8> colors;
     kvs::ValueArray<kvs::Real32> normals;
-    ::CalculateFaces<T>( volume, BaseClass::colorMap(), face_map, &coords, &colors, &normals );
+    ::CalculateFaces<T>( volume, BaseClass::colorMap(), faces, &coords, &colors, &normals, m_enable_mthreading );
 
     SuperClass::setPolygonType( kvs::PolygonObject::Triangle );
     SuperClass::setCoords( coords );
@@ -2156,13 +2278,21 @@ void ExternalFaces::calculate_quadratic_tetrahedral_faces( const kvs::Unstructur
 template <typename T>
 void ExternalFaces::calculate_hexahedral_faces( const kvs::UnstructuredVolumeObject* volume )
 {
-    ::QuadrangleFaceMap face_map( volume->numberOfNodes() );
-    CreateHexahedraFaceMap( volume, &face_map );
+    const size_t nnodes = volume->numberOfNodes();
+    const size_t nfaces = volume->numberOfCells() * 6 / 2;
+    const size_t npartitions = this->number_of_partitions();
+    auto face_maps = ::AllocateFaceMaps<::QuadrangleFaceMap>( nnodes, nfaces, npartitions );
+    KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(dynamic) )
+    for ( size_t p = 0; p < npartitions; p++ )
+    {
+        CreateHexahedraFaceMap( volume, &face_maps[p] );
+    }
+    const auto faces = ::ExternalFaceList( face_maps );
 
     kvs::ValueArray<kvs::Real32> coords;
     kvs::ValueArray<kvs::UInt8> colors;
     kvs::ValueArray<kvs::Real32> normals;
-    ::CalculateFaces<T>( volume, BaseClass::colorMap(), face_map, &coords, &colors, &normals );
+    ::CalculateFaces<T>( volume, BaseClass::colorMap(), faces, &coords, &colors, &normals, m_enable_mthreading );
 
     SuperClass::setPolygonType( kvs::PolygonObject::Triangle );
     SuperClass::setCoords( coords );
@@ -2179,13 +2309,21 @@ void ExternalFaces::calculate_hexahedral_faces( const kvs::UnstructuredVolumeObj
 template <typename T>
 void ExternalFaces::calculate_quadratic_hexahedral_faces( const kvs::UnstructuredVolumeObject* volume )
 {
-    ::QuadrangleFaceMap face_map( volume->numberOfNodes() );
-    CreateQuadraticHexahedraFaceMap( volume, &face_map );
+    const size_t nnodes = volume->numberOfNodes();
+    const size_t nfaces = volume->numberOfCells() * 6 / 2;
+    const size_t npartitions = this->number_of_partitions();
+    auto face_maps = ::AllocateFaceMaps<::QuadrangleFaceMap>( nnodes, nfaces, npartitions );
+    KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(dynamic) )
+    for ( size_t p = 0; p < npartitions; p++ )
+    {
+        CreateQuadraticHexahedraFaceMap( volume, &face_maps[p] );
+    }
+    const auto faces = ::ExternalFaceList( face_maps );
 
     kvs::ValueArray<kvs::Real32> coords;
     kvs::ValueArray<kvs::UInt8> colors;
     kvs::ValueArray<kvs::Real32> normals;
-    ::CalculateFaces<T>( volume, BaseClass::colorMap(), face_map, &coords, &colors, &normals );
+    ::CalculateFaces<T>( volume, BaseClass::colorMap(), faces, &coords, &colors, &normals, m_enable_mthreading );
 
     SuperClass::setPolygonType( kvs::PolygonObject::Triangle );
     SuperClass::setCoords( coords );
@@ -2196,14 +2334,22 @@ void ExternalFaces::calculate_quadratic_hexahedral_faces( const kvs::Unstructure
 template <typename T>
 void ExternalFaces::calculate_prism_faces( const kvs::UnstructuredVolumeObject* volume )
 {
-    ::TriangleFaceMap tri_face_map( volume->numberOfNodes() );
-    ::QuadrangleFaceMap quad_face_map( volume->numberOfNodes() );
-    CreatePrismFaceMap( volume, &tri_face_map, &quad_face_map );
+    const size_t nnodes = volume->numberOfNodes();
+    const size_t npartitions = this->number_of_partitions();
+    auto tri_face_maps = ::AllocateFaceMaps<::TriangleFaceMap>( nnodes, volume->numberOfCells(), npartitions );
+    auto quad_face_maps = ::AllocateFaceMaps<::QuadrangleFaceMap>( nnodes, volume->numberOfCells() * 3 / 2, npartitions );
+    KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(dynamic) )
+    for ( size_t p = 0; p < npartitions; p++ )
+    {
+        CreatePrismFaceMap( volume, &tri_face_maps[p], &quad_face_maps[p] );
+    }
+    const auto tri_faces = ::ExternalFaceList( tri_face_maps );
+    const auto quad_faces = ::ExternalFaceList( quad_face_maps );
 
     kvs::ValueArray<kvs::Real32> coords;
     kvs::ValueArray<kvs::UInt8> colors;
     kvs::ValueArray<kvs::Real32> normals;
-    ::CalculateFaces<T>( volume, BaseClass::colorMap(), tri_face_map, quad_face_map, &coords, &colors, &normals );
+    ::CalculateFaces<T>( volume, BaseClass::colorMap(), tri_faces, quad_faces, &coords, &colors, &normals, m_enable_mthreading );
 
     SuperClass::setPolygonType( kvs::PolygonObject::Triangle );
     SuperClass::setCoords( coords );
@@ -2214,14 +2360,22 @@ void ExternalFaces::calculate_prism_faces( const kvs::UnstructuredVolumeObject*
 template <typename T>
 void ExternalFaces::calculate_pyramid_faces( const kvs::UnstructuredVolumeObject* volume )
 {
-    ::TriangleFaceMap tri_face_map( volume->numberOfNodes() );
-    ::QuadrangleFaceMap quad_face_map( volume->numberOfNodes() );
-    CreatePyramidFaceMap( volume, &tri_face_map, &quad_face_map );
+    const size_t nnodes = volume->numberOfNodes();
+    const size_t npartitions = this->number_of_partitions();
+    auto tri_face_maps = ::AllocateFaceMaps<::TriangleFaceMap>( nnodes, volume->numberOfCells() * 4 / 2, npartitions );
+    auto quad_face_maps = ::AllocateFaceMaps<::QuadrangleFaceMap>( nnodes, volume->numberOfCells() / 2, npartitions );
+    KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(dynamic) )
+    for ( size_t p = 0; p < npartitions; p++ )
+    {
+        CreatePyramidFaceMap( volume, &tri_face_maps[p], &quad_face_maps[p] );
+    }
+    const auto tri_faces = ::ExternalFaceList( tri_face_maps );
+    const auto quad_faces = ::ExternalFaceList( quad_face_maps );
 
     kvs::ValueArray<kvs::Real32> coords;
     kvs::ValueArray<kvs::UInt8> colors;
     kvs::ValueArray<kvs::Real32> normals;
-    ::CalculateFaces<T>( volume, BaseClass::colorMap(), tri_face_map, quad_face_map, &coords, &colors, &normals );
+    ::CalculateFaces<T>( volume, BaseClass::colorMap(), tri_faces, quad_faces, &coords, &colors, &normals, m_enable_mthreading );
 
     SuperClass::setPolygonType( kvs::PolygonObject::Triangle );
     SuperClass::setCoords( coords );
@@ -29,12 +29,19 @@ class ExternalFaces : public kvs::MapperBase, public kvs::PolygonObject
     kvsModuleBaseClass( kvs::MapperBase );
     kvsModuleSuperClass( kvs::PolygonObject );
 
+private:
+    bool m_enable_mthreading = false; ///< flag for multi-threaded extraction
+
 public:
     ExternalFaces();
     ExternalFaces( const kvs::VolumeObjectBase* volume );
     ExternalFaces( const kvs::VolumeObjectBase* volume, const kvs::TransferFunction& transfer_function );
     virtual ~ExternalFaces();
 
+    void setEnabledMultiThreading( const bool enable ) { m_enable_mthreading = enable; }
+    void enableMultiThreading() { this->setEnabledMultiThreading( true ); }
+    void disableMultiThreading() { this->setEnabledMultiThreading( false ); }
+
     SuperClass* exec( const kvs::ObjectBase* object );
 
 private:
@@ -46,6 +53,7 @@ private:
     template <typename T> void calculate_colors( const kvs::StructuredVolumeObject* volume );
 
     void mapping( const kvs::UnstructuredVolumeObject* volume );
+    size_t number_of_partitions() const;
     template <typename T> void calculate_tetrahedral_faces( const kvs::UnstructuredVolumeObject* volume );
     template <typename T> void calculate_quadratic_tetrahedral_faces( const kvs::UnstructuredVolumeObject* volume );
     template <typename T> void calculate_hexahedral_faces( const kvs::UnstructuredVolumeObject* volume );
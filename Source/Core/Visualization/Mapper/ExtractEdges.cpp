@@ -11,7 +11,10 @@
 #include <kvs/TransferFunction>
 #include <kvs/IgnoreUnusedVariable>
 #include <kvs/Timer>
-#include <map>
+#include <kvs/NodeTupleHashMap>
+#include <kvs/OpenMP>
+#include <kvs/Value>
+#include <vector>
 
 
 namespace
@@ -26,21 +29,27 @@ class EdgeMap
 {
 public:
 
-    typedef kvs::UInt32 Key;
-    typedef std::pair<kvs::UInt32,kvs::UInt32> Value;
-    typedef std::multimap<Key,Value> Bucket;
+    typedef kvs::NodeTupleHashMap<2,kvs::UInt8> Bucket;
 
 private:
 
-    size_t m_nvertices; ///< number of vertices of the original data
     Bucket m_bucket; ///< bucket for the edge data
+    kvs::UInt32 m_min_node = 0; ///< min. node ID of the partition
+    kvs::UInt32 m_max_node = kvs::Value<kvs::UInt32>::Max(); ///< max. node ID (not included) of the partition
+    bool m_partitioned = false; ///< true if the map holds a partition of the edges
+    kvs::UInt64 m_sequence = 0; ///< number of the calls of insert
+    std::vector<kvs::UInt64> m_sequences; ///< sequence number of the first insertion of each edge
 
 public:
 
     EdgeMap( const size_t nvertices );
+    EdgeMap( const size_t nvertices, const kvs::UInt32 min_node, const kvs::UInt32 max_node );
 
 public:
 
+    const Bucket& bucket() const { return m_bucket; }
+    std::vector<kvs::UInt64>& sequences() { return m_sequences; }
+
     void insert( const kvs::UInt32 v0, const kvs::UInt32 v1 );
 
     const kvs::ValueArray<kvs::UInt32> serialize();
@@ -53,8 +62,25 @@ public:
  */
 /*===========================================================================*/
 EdgeMap::EdgeMap( const size_t nvertices ):
-    m_nvertices( nvertices )
+    m_bucket( nvertices ) // the number of edges is greater than the number of vertices
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new EdgeMap class for a partition of the edges.
+ *  @param  nvertices [in] number of vertices in the partition
+ *  @param  min_node [in] min. node ID of the partition
+ *  @param  max_node [in] max. node ID (not included) of the partition
+ */
+/*===========================================================================*/
+EdgeMap::EdgeMap( const size_t nvertices, const kvs::UInt32 min_node, const kvs::UInt32 max_node ):
+    m_bucket( nvertices ),
+    m_min_node( min_node ),
+    m_max_node( max_node ),
+    m_partitioned( true )
 {
+    m_sequences.reserve( nvertices );
 }
 
 /*===========================================================================*/
@@ -66,26 +92,17 @@ EdgeMap::EdgeMap( const size_t nvertices ):
 /*===========================================================================*/
 void EdgeMap::insert( const kvs::UInt32 v0, const kvs::UInt32 v1 )
 {
-    const Key key = ( v0 + v1 ) % kvs::UInt32( m_nvertices );
-
-    Bucket::iterator e = m_bucket.find( key );
-    Bucket::const_iterator last = m_bucket.end();
-    if ( e != last )
+    const kvs::UInt64 sequence = m_sequence++;
+    if ( m_partitioned )
     {
-        Bucket::const_iterator upper = m_bucket.upper_bound( key );
-        while ( e != upper )
-        {
-            if ( ( e->second.first == v0 && e->second.second == v1 ) ||
-                 ( e->second.first == v1 && e->second.second == v0 ) )
-            {
-                // The edge has been already inserted in the bucket.
-                return;
-            }
-            e++;
-        }
+        // The edge whose smaller node ID is out of the partition is ignored.
+        const kvs::UInt32 min_id = kvs::Math::Min( v0, v1 );
+        if ( min_id < m_min_node || m_max_node <= min_id ) { return; }
     }
 
-    m_bucket.insert( std::make_pair( key, std::make_pair( v0, v1 ) ) );
+    // The edge that has been already inserted in the bucket is ignored.
+    const auto result = m_bucket.insert( { v0, v1 }, 0 );
+    if ( result.second && m_partitioned ) { m_sequences.push_back( sequence ); }
 }
 
 /*===========================================================================*/
@@ -96,21 +113,78 @@ void EdgeMap::insert( const kvs::UInt32 v0, const kvs::UInt32 v1 )
 /*===========================================================================*/
 const kvs::ValueArray<kvs::UInt32> EdgeMap::serialize()
 {
-    kvs::ValueArray<kvs::UInt32> connections( 2 * m_bucket.size() );
+    const size_t nedges = m_bucket.size();
+    kvs::ValueArray<kvs::UInt32> connections( 2 * nedges );
 
-    Bucket::const_iterator e = m_bucket.begin();
-    Bucket::const_iterator last = m_bucket.end();
     size_t connection_index = 0;
-    while ( e != last )
+    for ( size_t i = 0; i < nedges; i++ )
     {
-        connections[ connection_index++ ] = e->second.first;
-        connections[ connection_index++ ] = e->second.second;
-        e++;
+        connections[ connection_index++ ] = m_bucket.key(i)[0];
+        connections[ connection_index++ ] = m_bucket.key(i)[1];
     }
 
     return connections;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Allocates the edge maps for the partitions of the edges.
+ *  @param  nvertices [in] number of vertices of the orignal volume data
+ *  @param  npartitions [in] number of partitions
+ *  @return edge maps
+ */
+/*===========================================================================*/
+std::vector<EdgeMap> AllocateEdgeMaps( const size_t nvertices, const size_t npartitions )
+{
+    std::vector<EdgeMap> edge_maps;
+    if ( npartitions <= 1 )
+    {
+        edge_maps.emplace_back( nvertices );
+        return edge_maps;
+    }
+
+    // The edges are partitioned by the range of the smaller node ID.
+    edge_maps.reserve( npartitions );
+    for ( size_t p = 0; p < npartitions; p++ )
+    {
+        const kvs::UInt32 min_node = kvs::UInt32( nvertices * p / npartitions );
+        const kvs::UInt32 max_node = kvs::UInt32( nvertices * ( p + 1 ) / npartitions );
+        edge_maps.emplace_back( max_node - min_node, min_node, max_node );
+    }
+    return edge_maps;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Serializes the edge maps in the order of the first insertion.
+ *  @param  edge_maps [in] edge maps
+ *  @return serialized indices of the end vertices of the edges
+ */
+/*===========================================================================*/
+const kvs::ValueArray<kvs::UInt32> SerializeEdgeMaps( std::vector<EdgeMap>& edge_maps )
+{
+    if ( edge_maps.size() == 1 ) { return edge_maps[0].serialize(); }
+
+    // The edges in the partitions are merged in the order of the first
+    // insertion, so that the output is the same as the single map.
+    const size_t npartitions = edge_maps.size();
+    std::vector<std::vector<kvs::UInt64>> sequences( npartitions );
+    size_t nedges = 0;
+    for ( size_t p = 0; p < npartitions; p++ )
+    {
+        nedges += edge_maps[p].bucket().size();
+        sequences[p].swap( edge_maps[p].sequences() );
+    }
+
+    kvs::ValueArray<kvs::UInt32> connections( 2 * nedges );
+    kvs::MergeBySequence( sequences, [&]( const size_t p, const size_t i, const size_t rank )
+    {
+        connections[ 2 * rank + 0 ] = edge_maps[p].bucket().key(i)[0];
+        connections[ 2 * rank + 1 ] = edge_maps[p].bucket().key(i)[1];
+    } );
+    return connections;
+}
+
 } // end of namespace
 
 
@@ -446,6 +520,18 @@ void ExtractEdges::calculate_connections( const kvs::UnstructuredVolumeObject* v
     }
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of partitions of the edges.
+ *  @return number of partitions (number of threads if multi-threading is enabled)
+ */
+/*===========================================================================*/
+size_t ExtractEdges::number_of_partitions() const
+{
+    if ( !m_enable_mthreading ) { return 1; }
+    return static_cast<size_t>( kvs::Math::Max( 1, kvs::OpenMP::GetMaxThreads() ) );
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Calculates connection values for the tetrahedra cells.
@@ -459,24 +545,30 @@ void ExtractEdges::calculate_tetrahedra_connections(
     const size_t ncells = volume->numberOfCells();
     const size_t nnodes = volume->numberOfNodes();
 
-    ::EdgeMap edge_map( nnodes );
-    for ( size_t cell_index = 0, connection_index = 0; cell_index < ncells; cell_index++ )
+    const size_t npartitions = this->number_of_partitions();
+    auto edge_maps = ::AllocateEdgeMaps( nnodes, npartitions );
+    KVS_OMP_PARALLEL_FOR( schedule(dynamic) )
+    for ( size_t p = 0; p < npartitions; p++ )
     {
-        const kvs::UInt32 local_vertex0 = connections[ connection_index     ];
-        const kvs::UInt32 local_vertex1 = connections[ connection_index + 1 ];
-        const kvs::UInt32 local_vertex2 = connections[ connection_index + 2 ];
-        const kvs::UInt32 local_vertex3 = connections[ connection_index + 3 ];
-        connection_index += 4;
-
-        edge_map.insert( local_vertex0, local_vertex1 );
-        edge_map.insert( local_vertex0, local_vertex2 );
-        edge_map.insert( local_vertex0, local_vertex3 );
-        edge_map.insert( local_vertex1, local_vertex2 );
-        edge_map.insert( local_vertex2, local_vertex3 );
-        edge_map.insert( local_vertex3, local_vertex1 );
+        ::EdgeMap& edge_map = edge_maps[p];
+        for ( size_t cell_index = 0, connection_index = 0; cell_index < ncells; cell_index++ )
+        {
+            const kvs::UInt32 local_vertex0 = connections[ connection_index     ];
+            const kvs::UInt32 local_vertex1 = connections[ connection_index + 1 ];
+            const kvs::UInt32 local_vertex2 = connections[ connection_index + 2 ];
+            const kvs::UInt32 local_vertex3 = connections[ connection_index + 3 ];
+            connection_index += 4;
+
+            edge_map.insert( local_vertex0, local_vertex1 );
+            edge_map.insert( local_vertex0, local_vertex2 );
+            edge_map.insert( local_vertex0, local_vertex3 );
+            edge_map.insert( local_vertex1, local_vertex2 );
+            edge_map.insert( local_vertex2, local_vertex3 );
+            edge_map.insert( local_vertex3, local_vertex1 );
+        }
     }
 
-    SuperClass::setConnections( edge_map.serialize() );
+    SuperClass::setConnections( ::SerializeEdgeMaps( edge_maps ) );
 }
 
 /*===========================================================================*/
@@ -492,34 +584,40 @@ void ExtractEdges::calculate_hexahedra_connections(
     const size_t ncells = volume->numberOfCells();
     const size_t nnodes = volume->numberOfNodes();
 
-    ::EdgeMap edge_map( nnodes );
-    for ( size_t cell_index = 0, connection_index = 0; cell_index < ncells; cell_index++ )
+    const size_t npartitions = this->number_of_partitions();
+    auto edge_maps = ::AllocateEdgeMaps( nnodes, npartitions );
+    KVS_OMP_PARALLEL_FOR( schedule(dynamic) )
+    for ( size_t p = 0; p < npartitions; p++ )
     {
-        const kvs::UInt32 local_vertex0 = connections[ connection_index     ];
-        const kvs::UInt32 local_vertex1 = connections[ connection_index + 1 ];
-        const kvs::UInt32 local_vertex2 = connections[ connection_index + 2 ];
-        const kvs::UInt32 local_vertex3 = connections[ connection_index + 3 ];
-        const kvs::UInt32 local_vertex4 = connections[ connection_index + 4 ];
-        const kvs::UInt32 local_vertex5 = connections[ connection_index + 5 ];
-        const kvs::UInt32 local_vertex6 = connections[ connection_index + 6 ];
-        const kvs::UInt32 local_vertex7 = connections[ connection_index + 7 ];
-        connection_index += 8;
-
-        edge_map.insert( local_vertex0, local_vertex1 );
-        edge_map.insert( local_vertex1, local_vertex2 );
-        edge_map.insert( local_vertex2, local_vertex3 );
-        edge_map.insert( local_vertex3, local_vertex0 );
-        edge_map.insert( local_vertex4, local_vertex5 );
-        edge_map.insert( local_vertex5, local_vertex6 );
-        edge_map.insert( local_vertex6, local_vertex7 );
-        edge_map.insert( local_vertex7, local_vertex4 );
-        edge_map.insert( local_vertex0, local_vertex4 );
-        edge_map.insert( local_vertex1, local_vertex5 );
-        edge_map.insert( local_vertex2, local_vertex6 );
-        edge_map.insert( local_vertex3, local_vertex7 );
+        ::EdgeMap& edge_map = edge_maps[p];
+        for ( size_t cell_index = 0, connection_index = 0; cell_index < ncells; cell_index++ )
+        {
+            const kvs::UInt32 local_vertex0 = connections[ connection_index     ];
+            const kvs::UInt32 local_vertex1 = connections[ connection_index + 1 ];
+            const kvs::UInt32 local_vertex2 = connections[ connection_index + 2 ];
+            const kvs::UInt32 local_vertex3 = connections[ connection_index + 3 ];
+            const kvs::UInt32 local_vertex4 = connections[ connection_index + 4 ];
+            const kvs::UInt32 local_vertex5 = connections[ connection_index + 5 ];
+            const kvs::UInt32 local_vertex6 = connections[ connection_index + 6 ];
+            const kvs::UInt32 local_vertex7 = connections[ connection_index + 7 ];
+            connection_index += 8;
+
+            edge_map.insert( local_vertex0, local_vertex1 );
+            edge_map.insert( local_vertex1, local_vertex2 );
+            edge_map.insert( local_vertex2, local_vertex3 );
+            edge_map.insert( local_vertex3, local_vertex0 );
+            edge_map.insert( local_vertex4, local_vertex5 );
+            edge_map.insert( local_vertex5, local_vertex6 );
+            edge_map.insert( local_vertex6, local_vertex7 );
+            edge_map.insert( local_vertex7, local_vertex4 );
+            edge_map.insert( local_vertex0, local_vertex4 );
+            edge_map.insert( local_vertex1, local_vertex5 );
+            edge_map.insert( local_vertex2, local_vertex6 );
+            edge_map.insert( local_vertex3, local_vertex7 );
+        }
     }
 
-    SuperClass::setConnections( edge_map.serialize() );
+    SuperClass::setConnections( ::SerializeEdgeMaps( edge_maps ) );
 }
 
 /*===========================================================================*/
@@ -535,36 +633,42 @@ void ExtractEdges::calculate_quadratic_tetrahedra_connections(
     const size_t ncells = volume->numberOfCells();
     const size_t nnodes = volume->numberOfNodes();
 
-    ::EdgeMap edge_map( nnodes );
-    for ( size_t cell_index = 0, connection_index = 0; cell_index < ncells; cell_index++ )
+    const size_t npartitions = this->number_of_partitions();
+    auto edge_maps = ::AllocateEdgeMaps( nnodes, npartitions );
+    KVS_OMP_PARALLEL_FOR( schedule(dynamic) )
+    for ( size_t p = 0; p < npartitions; p++ )
     {
-        const kvs::UInt32 local_vertex0 = connections[ connection_index     ];
-        const kvs::UInt32 local_vertex1 = connections[ connection_index + 1 ];
-        const kvs::UInt32 local_vertex2 = connections[ connection_index + 2 ];
-        const kvs::UInt32 local_vertex3 = connections[ connection_index + 3 ];
-        const kvs::UInt32 local_vertex4 = connections[ connection_index + 4 ];
-        const kvs::UInt32 local_vertex5 = connections[ connection_index + 5 ];
-        const kvs::UInt32 local_vertex6 = connections[ connection_index + 6 ];
-        const kvs::UInt32 local_vertex7 = connections[ connection_index + 7 ];
-        const kvs::UInt32 local_vertex8 = connections[ connection_index + 8 ];
-        const kvs::UInt32 local_vertex9 = connections[ connection_index + 9 ];
-        connection_index += 10;
-
-        edge_map.insert( local_vertex0, local_vertex4 );
-        edge_map.insert( local_vertex4, local_vertex1 );
-        edge_map.insert( local_vertex0, local_vertex5 );
-        edge_map.insert( local_vertex5, local_vertex2 );
-        edge_map.insert( local_vertex0, local_vertex6 );
-        edge_map.insert( local_vertex6, local_vertex3 );
-        edge_map.insert( local_vertex1, local_vertex7 );
-        edge_map.insert( local_vertex7, local_vertex2 );
-        edge_map.insert( local_vertex2, local_vertex8 );
-        edge_map.insert( local_vertex8, local_vertex3 );
-        edge_map.insert( local_vertex3, local_vertex9 );
-        edge_map.insert( local_vertex9, local_vertex1 );
+        ::EdgeMap& edge_map = edge_maps[p];
+        for ( size_t cell_index = 0, connection_index = 0; cell_index < ncells; cell_index++ )
+        {
+            const kvs::UInt32 local_vertex0 = connections[ connection_index     ];
+            const kvs::UInt32 local_vertex1 = connections[ connection_index + 1 ];
+            const kvs::UInt32 local_vertex2 = connections[ connection_index + 2 ];
+            const kvs::UInt32 local_vertex3 = connections[ connection_index + 3 ];
+            const kvs::UInt32 local_vertex4 = connections[ connection_index + 4 ];
+            const kvs::UInt32 local_vertex5 = connections[ connection_index + 5 ];
+            const kvs::UInt32 local_vertex6 = connections[ connection_index + 6 ];
+            const kvs::UInt32 local_vertex7 = connections[ connection_index + 7 ];
+            const kvs::UInt32 local_vertex8 = connections[ connection_index + 8 ];
+            const kvs::UInt32 local_vertex9 = connections[ connection_index + 9 ];
+            connection_index += 10;
+
+            edge_map.insert( local_vertex0, local_vertex4 );
+            edge_map.insert( local_vertex4, local_vertex1 );
+            edge_map.insert( local_vertex0, local_vertex5 );
+            edge_map.insert( local_vertex5, local_vertex2 );
+            edge_map.insert( local_vertex0, local_vertex6 );
+            edge_map.insert( local_vertex6, local_vertex3 );
+            edge_map.insert( local_vertex1, local_vertex7 );
+            edge_map.insert( local_vertex7, local_vertex2 );
+            edge_map.insert( local_vertex2, local_vertex8 );
+            edge_map.insert( local_vertex8, local_vertex3 );
+            edge_map.insert( local_vertex3, local_vertex9 );
+            edge_map.insert( local_vertex9, local_vertex1 );
+        }
     }
 
-    SuperClass::setConnections( edge_map.serialize() );
+    SuperClass::setConnections( ::SerializeEdgeMaps( edge_maps ) );
 }
 
 /*===========================================================================*/
@@ -580,58 +684,64 @@ void ExtractEdges::calculate_quadratic_hexahedra_connections(
     const size_t ncells = volume->numberOfCells();
     const size_t nnodes = volume->numberOfNodes();
 
-    ::EdgeMap edge_map( nnodes );
-    for ( size_t cell_index = 0, connection_index = 0; cell_index < ncells; cell_index++ )
+    const size_t npartitions = this->number_of_partitions();
+    auto edge_maps = ::AllocateEdgeMaps( nnodes, npartitions );
+    KVS_OMP_PARALLEL_FOR( schedule(dynamic) )
+    for ( size_t p = 0; p < npartitions; p++ )
     {
-        const kvs::UInt32 local_vertex0  = connections[ connection_index      ];
-        const kvs::UInt32 local_vertex1  = connections[ connection_index +  1 ];
-        const kvs::UInt32 local_vertex2  = connections[ connection_index +  2 ];
-        const kvs::UInt32 local_vertex3  = connections[ connection_index +  3 ];
-        const kvs::UInt32 local_vertex4  = connections[ connection_index +  4 ];
-        const kvs::UInt32 local_vertex5  = connections[ connection_index +  5 ];
-        const kvs::UInt32 local_vertex6  = connections[ connection_index +  6 ];
-        const kvs::UInt32 local_vertex7  = connections[ connection_index +  7 ];
-        const kvs::UInt32 local_vertex8  = connections[ connection_index +  8 ];
-        const kvs::UInt32 local_vertex9  = connections[ connection_index +  9 ];
-        const kvs::UInt32 local_vertex10 = connections[ connection_index + 10 ];
-        const kvs::UInt32 local_vertex11 = connections[ connection_index + 11 ];
-        const kvs::UInt32 local_vertex12 = connections[ connection_index + 12 ];
-        const kvs::UInt32 local_vertex13 = connections[ connection_index + 13 ];
-        const kvs::UInt32 local_vertex14 = connections[ connection_index + 14 ];
-        const kvs::UInt32 local_vertex15 = connections[ connection_index + 15 ];
-        const kvs::UInt32 local_vertex16 = connections[ connection_index + 16 ];
-        const kvs::UInt32 local_vertex17 = connections[ connection_index + 17 ];
-        const kvs::UInt32 local_vertex18 = connections[ connection_index + 18 ];
-        const kvs::UInt32 local_vertex19 = connections[ connection_index + 19 ];
-        connection_index += 20;
-
-        edge_map.insert( local_vertex0,  local_vertex8  );
-        edge_map.insert( local_vertex8,  local_vertex1  );
-        edge_map.insert( local_vertex1,  local_vertex9  );
-        edge_map.insert( local_vertex9,  local_vertex2  );
-        edge_map.insert( local_vertex2,  local_vertex10 );
-        edge_map.insert( local_vertex10, local_vertex3  );
-        edge_map.insert( local_vertex3,  local_vertex11 );
-        edge_map.insert( local_vertex11, local_vertex0  );
-        edge_map.insert( local_vertex4,  local_vertex12 );
-        edge_map.insert( local_vertex12, local_vertex5  );
-        edge_map.insert( local_vertex5,  local_vertex13 );
-        edge_map.insert( local_vertex13, local_vertex6  );
-        edge_map.insert( local_vertex6,  local_vertex14 );
-        edge_map.insert( local_vertex14, local_vertex7  );
-        edge_map.insert( local_vertex7,  local_vertex15 );
-        edge_map.insert( local_vertex15, local_vertex4  );
-        edge_map.insert( local_vertex0,  local_vertex16 );
-        edge_map.insert( local_vertex16, local_vertex4  );
-        edge_map.insert( local_vertex1,  local_vertex17 );
-        edge_map.insert( local_vertex17, local_vertex5  );
-        edge_map.insert( local_vertex2,  local_vertex18 );
-        edge_map.insert( local_vertex18, local_vertex6  );
-        edge_map.insert( local_vertex3,  local_vertex19 );
-        edge_map.insert( local_vertex19, local_vertex7  );
+        ::EdgeMap& edge_map = edge_maps[p];
+        for ( size_t cell_index = 0, connection_index = 0; cell_index < ncells; cell_index++ )
+        {
+            const kvs::UInt32 local_vertex0  = connections[ connection_index      ];
+            const kvs::UInt32 local_vertex1  = connections[ connection_index +  1 ];
+            const kvs::UInt32 local_vertex2  = connections[ connection_index +  2 ];
+            const kvs::UInt32 local_vertex3  = connections[ connection_index +  3 ];
+            const kvs::UInt32 local_vertex4  = connections[ connection_index +  4 ];
+            const kvs::UInt32 local_vertex5  = connections[ connection_index +  5 ];
+            const kvs::UInt32 local_vertex6  = connections[ connection_index +  6 ];
+            const kvs::UInt32 local_vertex7  = connections[ connection_index +  7 ];
+            const kvs::UInt32 local_vertex8  = connections[ connection_index +  8 ];
+            const kvs::UInt32 local_vertex9  = connections[ connection_index +  9 ];
+            const kvs::UInt32 local_vertex10 = connections[ connection_index + 10 ];
+            const kvs::UInt32 local_vertex11 = connections[ connection_index + 11 ];
+            const kvs::UInt32 local_vertex12 = connections[ connection_index + 12 ];
+            const kvs::UInt32 local_vertex13 = connections[ connection_index + 13 ];
+            const kvs::UInt32 local_vertex14 = connections[ connection_index + 14 ];
+            const kvs::UInt32 local_vertex15 = connections[ connection_index + 15 ];
+            const kvs::UInt32 local_vertex16 = connections[ connection_index + 16 ];
+            const kvs::UInt32 local_vertex17 = connections[ connection_index + 17 ];
+            const kvs::UInt32 local_vertex18 = connections[ connection_index + 18 ];
+            const kvs::UInt32 local_vertex19 = connections[ connection_index + 19 ];
+            connection_index += 20;
+
+            edge_map.insert( local_vertex0,  local_vertex8  );
+            edge_map.insert( local_vertex8,  local_vertex1  );
+            edge_map.insert( local_vertex1,  local_vertex9  );
+            edge_map.insert( local_vertex9,  local_vertex2  );
+            edge_map.insert( local_vertex2,  local_vertex10 );
+            edge_map.insert( local_vertex10, local_vertex3  );
+            edge_map.insert( local_vertex3,  local_vertex11 );
+            edge_map.insert( local_vertex11, local_vertex0  );
+            edge_map.insert( local_vertex4,  local_vertex12 );
+            edge_map.insert( local_vertex12, local_vertex5  );
+            edge_map.insert( local_vertex5,  local_vertex13 );
+            edge_map.insert( local_vertex13, local_vertex6  );
+            edge_map.insert( local_vertex6,  local_vertex14 );
+            edge_map.insert( local_vertex14, local_vertex7  );
+            edge_map.insert( local_vertex7,  local_vertex15 );
+            edge_map.insert( local_vertex15, local_vertex4  );
+            edge_map.insert( local_vertex0,  local_vertex16 );
+            edge_map.insert( local_vertex16, local_vertex4  );
+            edge_map.insert( local_vertex1,  local_vertex17 );
+            edge_map.insert( local_vertex17, local_vertex5  );
+            edge_map.insert( local_vertex2,  local_vertex18 );
+            edge_map.insert( local_vertex18, local_vertex6  );
+            edge_map.insert( local_vertex3,  local_vertex19 );
+            edge_map.insert( local_vertex19, local_vertex7  );
+        }
     }
 
-    SuperClass::setConnections( edge_map.serialize() );
+    SuperClass::setConnections( ::SerializeEdgeMaps( edge_maps ) );
 }
 
 void ExtractEdges::calculate_prism_connections( const kvs::UnstructuredVolumeObject* volume )
@@ -640,29 +750,35 @@ void ExtractEdges::calculate_prism_connections( const kvs::UnstructuredVolumeObj
     const size_t ncells = volume->numberOfCells();
     const size_t nnodes = volume->numberOfNodes();
 
-    ::EdgeMap edge_map( nnodes );
-    for ( size_t cell_index = 0, connection_index = 0; cell_index < ncells; cell_index++ )
+    const size_t npartitions = this->number_of_partitions();
+    auto edge_maps = ::AllocateEdgeMaps( nnodes, npartitions );
+    KVS_OMP_PARALLEL_FOR( schedule(dynamic) )
+    for ( size_t p = 0; p < npartitions; p++ )
     {
-        const kvs::UInt32 local_vertex0 = connections[ connection_index     ];
-        const kvs::UInt32 local_vertex1 = connections[ connection_index + 1 ];
-        const kvs::UInt32 local_vertex2 = connections[ connection_index + 2 ];
-        const kvs::UInt32 local_vertex3 = connections[ connection_index + 3 ];
-        const kvs::UInt32 local_vertex4 = connections[ connection_index + 4 ];
-        const kvs::UInt32 local_vertex5 = connections[ connection_index + 5 ];
-        connection_index += 6;
-
-        edge_map.insert( local_vertex0, local_vertex1 );
-        edge_map.insert( local_vertex1, local_vertex2 );
-        edge_map.insert( local_vertex2, local_vertex0 );
-        edge_map.insert( local_vertex3, local_vertex4 );
-        edge_map.insert( local_vertex4, local_vertex5 );
-        edge_map.insert( local_vertex5, local_vertex3 );
-        edge_map.insert( local_vertex0, local_vertex3 );
-        edge_map.insert( local_vertex1, local_vertex4 );
-        edge_map.insert( local_vertex2, local_vertex5 );
+        ::EdgeMap& edge_map = edge_maps[p];
+        for ( size_t cell_index = 0, connection_index = 0; cell_index < ncells; cell_index++ )
+        {
+            const kvs::UInt32 local_vertex0 = connections[ connection_index     ];
+            const kvs::UInt32 local_vertex1 = connections[ connection_index + 1 ];
+            const kvs::UInt32 local_vertex2 = connections[ connection_index + 2 ];
+            const kvs::UInt32 local_vertex3 = connections[ connection_index + 3 ];
+            const kvs::UInt32 local_vertex4 = connections[ connection_index + 4 ];
+            const kvs::UInt32 local_vertex5 = connections[ connection_index + 5 ];
+            connection_index += 6;
+
+            edge_map.insert( local_vertex0, local_vertex1 );
+            edge_map.insert( local_vertex1, local_vertex2 );
+            edge_map.insert( local_vertex2, local_vertex0 );
+            edge_map.insert( local_vertex3, local_vertex4 );
+            edge_map.insert( local_vertex4, local_vertex5 );
+            edge_map.insert( local_vertex5, local_vertex3 );
+            edge_map.insert( local_vertex0, local_vertex3 );
+            edge_map.insert( local_vertex1, local_vertex4 );
+            edge_map.insert( local_vertex2, local_vertex5 );
+        }
     }
 
-    SuperClass::setConnections( edge_map.serialize() );
+    SuperClass::setConnections( ::SerializeEdgeMaps( edge_maps ) );
 }
 
 /*===========================================================================*/
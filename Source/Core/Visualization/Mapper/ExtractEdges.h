@@ -31,6 +31,10 @@ class ExtractEdges : public kvs::MapperBase, public kvs::LineObject
     kvsModuleBaseClass( kvs::MapperBase );
     kvsModuleSuperClass( kvs::LineObject );
 
+private:
+
+    bool m_enable_mthreading = false; ///< flag for multi-threaded extraction
+
 public:
 
     ExtractEdges();
@@ -38,6 +42,10 @@ public:
     ExtractEdges( const kvs::VolumeObjectBase* volume, const kvs::TransferFunction& transfer_function );
     virtual ~ExtractEdges();
 
+    void setEnabledMultiThreading( const bool enable ) { m_enable_mthreading = enable; }
+    void enableMultiThreading() { this->setEnabledMultiThreading( true ); }
+    void disableMultiThreading() { this->setEnabledMultiThreading( false ); }
+
     SuperClass* exec( const kvs::ObjectBase* object );
 
 private:
@@ -51,6 +59,7 @@ private:
     void mapping( const kvs::UnstructuredVolumeObject* volume );
     void calculate_coords( const kvs::UnstructuredVolumeObject* volume );
     void calculate_connections( const kvs::UnstructuredVolumeObject* volume );
+    size_t number_of_partitions() const;
     void calculate_tetrahedra_connections( const kvs::UnstructuredVolumeObject* volume );
     void calculate_hexahedra_connections( const kvs::UnstructuredVolumeObject* volume );
     void calculate_quadratic_tetrahedra_connections( const kvs::UnstructuredVolumeObject* volume );
@@ -48,12 +48,11 @@ void FrequencyTable::create( const kvs::VolumeObjectBase* volume )
     // Calculate the min/max range value and the number of bins.
     this->calculate_range( volume );
 
-    // Allocate and initialize the bin array.
-    m_bin.allocate( static_cast<size_t>( m_nbins ) );
-    m_bin.fill( 0 );
-
-    // Count the bin.
-    this->count_bin( volume );
+    // Count the bin. The bin array is shared with the histogram cached on
+    // the volume object, so that the repeated creations for the same volume
+    // do not count the values again.
+    m_bin = volume->histogram( static_cast<size_t>( m_nbins ), m_min_range, m_max_range, m_ignore_values );
+    this->calculate_statistics();
 }
 
 /*==========================================================================*/
@@ -241,6 +240,7 @@ void FrequencyTable::calculate_range( const kvs::VolumeObjectBase* volume )
     {
         if ( kvs::Math::IsZero( m_min_range ) && kvs::Math::IsZero( m_max_range ) )
         {
+            if ( !volume->hasMinMaxValues() ) { volume->updateMinMaxValues(); }
             m_min_range = volume->minValue();
             m_max_range = volume->maxValue();
         }
@@ -279,21 +279,26 @@ void FrequencyTable::calculate_range( const kvs::ImageObject* image )
 
 /*==========================================================================*/
 /**
- *  @brief  Counts the bin.
- *  @param  volume [in] pointer to the volume object
+ *  @brief  Calculates the max. count and the statistics of the bin counts.
  */
 /*==========================================================================*/
-void FrequencyTable::count_bin( const kvs::VolumeObjectBase* volume )
+void FrequencyTable::calculate_statistics()
 {
-    const std::type_info& type = volume->values().typeInfo()->type();
-    if (      type == typeid( kvs::Int8 )   ) this->binning<kvs::Int8>( volume );
-    else if ( type == typeid( kvs::UInt8 )  ) this->binning<kvs::UInt8>( volume );
-    else if ( type == typeid( kvs::Int16 )  ) this->binning<kvs::Int16>( volume );
-    else if ( type == typeid( kvs::UInt16 ) ) this->binning<kvs::UInt16>( volume );
-    else if ( type == typeid( kvs::Int32 )  ) this->binning<kvs::Int32>( volume );
-    else if ( type == typeid( kvs::UInt32 ) ) this->binning<kvs::UInt32>( volume );
-    else if ( type == typeid( kvs::Real32 ) ) this->binning<kvs::Real32>( volume );
-    else if ( type == typeid( kvs::Real64 ) ) this->binning<kvs::Real64>( volume );
+    size_t total_count = 0;
+    m_max_count = 0;
+    for ( size_t i = 0; i < m_bin.size(); i++ )
+    {
+        total_count += m_bin[i];
+        m_max_count = kvs::Math::Max( m_max_count, m_bin[i] );
+    }
+
+    m_mean = static_cast<kvs::Real64>( total_count ) / m_nbins;
+
+    kvs::Real64 sum = 0;
+    for ( size_t i = 0; i < m_nbins; i++ ) sum += kvs::Math::Square( m_bin[i] - m_mean );
+    m_variance = sum / m_nbins;
+
+    m_standard_deviation = std::sqrt( m_variance );
 }
 
 /*==========================================================================*/
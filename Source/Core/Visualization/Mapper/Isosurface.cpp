@@ -176,8 +176,7 @@ void Isosurface::mapping( const kvs::VolumeObjectBase* volume )
     if ( volume->volumeType() == kvs::VolumeObjectBase::Structured )
     {
         const auto* svolume = kvs::StructuredVolumeObject::DownCast( volume );
-        auto* polygon = new kvs::MarchingCubes(
-            svolume, m_isolevel, ntype, m_duplication, tfunc );
+        auto* polygon = new kvs::MarchingCubes();
         if ( !polygon )
         {
             BaseClass::setSuccess( false );
@@ -185,6 +184,13 @@ void Isosurface::mapping( const kvs::VolumeObjectBase* volume )
             return;
         }
 
+        polygon->setIsolevel( m_isolevel );
+        polygon->setNormalType( ntype );
+        polygon->setDuplication( m_duplication );
+        polygon->setTransferFunction( tfunc );
+        polygon->setEnabledMultiThreading( m_enable_mthreading );
+        polygon->exec( svolume );
+
         shallow_copy( polygon );
         delete polygon;
     }
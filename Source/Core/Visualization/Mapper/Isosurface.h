@@ -28,6 +28,7 @@ class Isosurface : public kvs::MapperBase, public kvs::PolygonObject
 private:
     double m_isolevel = 0.0; ///< isosurface level
     bool m_duplication = true; ///< duplication flag
+    bool m_enable_mthreading = false; ///< flag for multi-threaded extraction
 
 public:
     Isosurface() = default;
@@ -47,6 +48,9 @@ public:
     virtual ~Isosurface() = default;
 
     void setIsolevel( const double isolevel ) { m_isolevel = isolevel; }
+    void setEnabledMultiThreading( const bool enable ) { m_enable_mthreading = enable; }
+    void enableMultiThreading() { this->setEnabledMultiThreading( true ); }
+    void disableMultiThreading() { this->setEnabledMultiThreading( false ); }
 
     SuperClass* exec( const kvs::ObjectBase* object );
 
@@ -7,6 +7,35 @@
 #include "MarchingCubes.h"
 #include "MarchingCubesTable.h"
 #include <cstring>
+#include <vector>
+#include <kvs/OpenMP>
+#include <kvs/MinMaxMacroCells>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Concatenates the arrays extracted on each slab in the slab order.
+ *  @param  slabs [in] arrays extracted on each slab
+ *  @param  array [in/out] concatenated array
+ */
+/*===========================================================================*/
+template <typename T>
+void Concatenate( const std::vector<std::vector<T>>& slabs, std::vector<T>& array )
+{
+    size_t size = array.size();
+    for ( const auto& slab : slabs ) { size += slab.size(); }
+
+    array.reserve( size );
+    for ( const auto& slab : slabs )
+    {
+        array.insert( array.end(), slab.begin(), slab.end() );
+    }
+}
+
+} // end of namespace
 
 
 namespace kvs
@@ -108,6 +137,11 @@ void MarchingCubes::mapping( const Volume* volume )
     const auto min_value = BaseClass::volume()->minValue();
     const auto max_value = BaseClass::volume()->maxValue();
     if ( kvs::Math::Equal( min_value, max_value ) ) { return; }
+    if ( volume->numberOfCells() == 0 ) { return; }
+
+    // The min/max macro-cells cached on the volume are used to skip the empty
+    // regions. They are built here, before the (multi-threaded) extraction.
+    volume->macroCells( m_enable_mthreading );
 
     // Extract surfaces.
     switch ( volume->values().typeID() )
@@ -159,6 +193,62 @@ void MarchingCubes::extract_surfaces_with_duplication( const Volume* volume )
     Coords coords;
     Normals normals;
 
+    // Each slab is a layer of cells along the z-axis.
+    const size_t nslabs = volume->resolution().z() - 1;
+    if ( m_enable_mthreading )
+    {
+        // The surfaces are extracted into the buffers for each slab, and then
+        // concatenated in the slab order to keep the same output as the serial
+        // extraction.
+        std::vector<Coords> slab_coords( nslabs );
+        std::vector<Normals> slab_normals( nslabs );
+        KVS_OMP_PARALLEL()
+        {
+            KVS_OMP_FOR( schedule(dynamic) )
+            for ( size_t z = 0; z < nslabs; ++z )
+            {
+                this->extract_slab_with_duplication<T>(
+                    volume, kvs::UInt32( z ), slab_coords[z], slab_normals[z] );
+            }
+        }
+
+        ::Concatenate( slab_coords, coords );
+        ::Concatenate( slab_normals, normals );
+    }
+    else
+    {
+        for ( size_t z = 0; z < nslabs; ++z )
+        {
+            this->extract_slab_with_duplication<T>(
+                volume, kvs::UInt32( z ), coords, normals );
+        }
+    }
+
+    if ( coords.size() > 0 )
+    {
+        SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( coords ) );
+        SuperClass::setColor( BaseClass::transferFunction().colorMap().at( m_isolevel ) );
+        SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
+        SuperClass::setOpacity( 255 );
+    }
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Extracts the surfaces with duplication on the specified slab.
+ *  @param  volume [in] pointer to the structured volume object
+ *  @param  z [in] z-index of the slab (layer of cells)
+ *  @param  coords [in/out] coordinate array
+ *  @param  normals [in/out] normal vector array
+ */
+/*==========================================================================*/
+template <typename T>
+void MarchingCubes::extract_slab_with_duplication(
+    const Volume* volume,
+    const kvs::UInt32 z,
+    Coords& coords,
+    Normals& normals ) const
+{
     const auto ncells = volume->resolution() - kvs::Vec3u::Constant(1);
     const auto line_size = kvs::UInt32( volume->numberOfNodesPerLine() );
     const auto slice_size = kvs::UInt32( volume->numberOfNodesPerSlice() );
@@ -175,13 +265,27 @@ void MarchingCubes::extract_surfaces_with_duplication( const Volume* volume )
     // Extract surfaces.
     auto Edge = MarchingCubesTable::TriangleID;
     auto Vert = MarchingCubesTable::VertexID;
-    size_t index = 0;
+    const auto& macro_cells = volume->macroCells( m_enable_mthreading );
+    const auto bsize = kvs::UInt32( macro_cells.blockSize() );
+    const kvs::UInt32 bz = z / bsize;
+    size_t index = size_t( z ) * slice_size;
     size_t local_index[8];
-    for ( kvs::UInt32 z = 0; z < ncells.z(); ++z )
+    for ( kvs::UInt32 y = 0; y < ncells.y(); ++y )
     {
-        for ( kvs::UInt32 y = 0; y < ncells.y(); ++y )
+        const kvs::UInt32 by = y / bsize;
+        for ( kvs::UInt32 bx = 0; bx < macro_cells.resolution().x(); ++bx )
         {
-            for ( kvs::UInt32 x = 0; x < ncells.x(); ++x )
+            const kvs::UInt32 x0 = bx * bsize;
+            const kvs::UInt32 x1 = kvs::Math::Min( x0 + bsize, ncells.x() );
+
+            // Skip the macro-cell that the isosurface does not pass through.
+            if ( !macro_cells.isActive( macro_cells.blockIndex( bx, by, bz ), m_isolevel ) )
+            {
+                index += x1 - x0;
+                continue;
+            }
+
+            for ( kvs::UInt32 x = x0; x < x1; ++x )
             {
                 // Calculate the indices of the target cell.
                 local_index[0] = index;
@@ -228,18 +332,9 @@ void MarchingCubes::extract_surfaces_with_duplication( const Volume* volume )
                     normals.push_back( n.x() ); normals.push_back( n.y() ); normals.push_back( n.z() );
                 }
             } // end of loop-x
-            ++index;
-        } // end of loop-y
-        index += line_size;
-    } // end of loop-z
-
-    if ( coords.size() > 0 )
-    {
-        SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( coords ) );
-        SuperClass::setColor( BaseClass::transferFunction().colorMap().at( m_isolevel ) );
-        SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
-        SuperClass::setOpacity( 255 );
-    }
+        } // end of loop-bx
+        ++index;
+    } // end of loop-y
 }
 
 /*==========================================================================*/
@@ -366,6 +461,70 @@ template <typename T>
 void MarchingCubes::calculate_isopoints(
     kvs::UInt32*& vertex_map,
     std::vector<kvs::Real32>& coords )
+{
+    const auto* volume = kvs::StructuredVolumeObject::DownCast( BaseClass::volume() );
+
+    // Each slab is a layer of nodes along the z-axis.
+    const size_t nslabs = volume->resolution().z();
+    if ( m_enable_mthreading )
+    {
+        // The isopoints are numbered locally on each slab, and then the local
+        // IDs in the vertex map are rebased with the number of the isopoints
+        // on the preceding slabs.
+        std::vector<Coords> slab_coords( nslabs );
+        KVS_OMP_PARALLEL()
+        {
+            KVS_OMP_FOR( schedule(dynamic) )
+            for ( size_t z = 0; z < nslabs; ++z )
+            {
+                this->calculate_isopoints_on_slab<T>(
+                    vertex_map, kvs::UInt32( z ), slab_coords[z] );
+            }
+        }
+
+        std::vector<kvs::UInt32> offsets( nslabs, 0 );
+        for ( size_t z = 1; z < nslabs; ++z )
+        {
+            offsets[z] = offsets[z-1] + kvs::UInt32( slab_coords[z-1].size() / 3 );
+        }
+
+        const size_t slab_size = 3 * volume->numberOfNodesPerSlice();
+        KVS_OMP_PARALLEL()
+        {
+            KVS_OMP_FOR( schedule(static) )
+            for ( size_t z = 1; z < nslabs; ++z )
+            {
+                const kvs::UInt32 offset = offsets[z];
+                kvs::UInt32* map = vertex_map + z * slab_size;
+                for ( size_t i = 0; i < slab_size; ++i ) { map[i] += offset; }
+            }
+        }
+
+        ::Concatenate( slab_coords, coords );
+    }
+    else
+    {
+        for ( size_t z = 0; z < nslabs; ++z )
+        {
+            this->calculate_isopoints_on_slab<T>(
+                vertex_map, kvs::UInt32( z ), coords );
+        }
+    }
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Calculates the coordinates on the surfaces on the specified slab.
+ *  @param  vertex_map [in/out] pointer to the vertex map
+ *  @param  z [in] z-index of the slab (layer of nodes)
+ *  @param  coords [in/out] coordinate array
+ */
+/*==========================================================================*/
+template <typename T>
+void MarchingCubes::calculate_isopoints_on_slab(
+    kvs::UInt32* vertex_map,
+    const kvs::UInt32 z,
+    std::vector<kvs::Real32>& coords ) const
 {
     const T* const values = static_cast<const T*>( BaseClass::volume()->values().data() );
     const auto* volume = kvs::StructuredVolumeObject::DownCast( BaseClass::volume() );
@@ -385,13 +544,30 @@ void MarchingCubes::calculate_isopoints(
         return ( p + min_coord ) * scale_factor;
     };
 
-    kvs::UInt32 nisopoints = 0;
-    size_t index = 0;
-    for ( kvs::UInt32 z = 0; z < resolution.z(); ++z )
+    auto nisopoints = kvs::UInt32( coords.size() / 3 );
+    const auto& macro_cells = volume->macroCells( m_enable_mthreading );
+    const auto bsize = kvs::UInt32( macro_cells.blockSize() );
+    const auto nbx = macro_cells.resolution().x();
+    const kvs::UInt32 bz = kvs::Math::Min( z, ncells.z() - 1 ) / bsize;
+    size_t index = size_t( z ) * slice_size;
+    for ( kvs::UInt32 y = 0; y < resolution.y(); ++y )
     {
-        for ( kvs::UInt32 y = 0; y < resolution.y(); ++y )
+        const kvs::UInt32 by = kvs::Math::Min( y, ncells.y() - 1 ) / bsize;
+        for ( kvs::UInt32 bx = 0; bx < nbx; ++bx )
         {
-            for ( kvs::UInt32 x = 0; x < resolution.x(); ++x )
+            const kvs::UInt32 x0 = bx * bsize;
+            const kvs::UInt32 x1 = bx + 1 < nbx ? x0 + bsize : resolution.x();
+
+            // Skip the nodes in the macro-cell that the isosurface does not
+            // pass through, since all the edges from the node are included
+            // in the cell of the macro-cell.
+            if ( !macro_cells.isActive( macro_cells.blockIndex( bx, by, bz ), isolevel ) )
+            {
+                index += x1 - x0;
+                continue;
+            }
+
+            for ( kvs::UInt32 x = x0; x < x1; ++x )
             {
                 const size_t id0 = index;
                 const size_t id1 = id0 + 1;
@@ -441,8 +617,8 @@ void MarchingCubes::calculate_isopoints(
                 }
                 ++index;
             } // x
-        } // y
-    } // z
+        } // bx
+    } // y
 }
 
 /*==========================================================================*/
@@ -459,20 +635,77 @@ void MarchingCubes::connect_isopoints(
 {
     const auto* volume = kvs::StructuredVolumeObject::DownCast( BaseClass::volume() );
 
+    // Each slab is a layer of cells along the z-axis.
+    const size_t nslabs = volume->resolution().z() - 1;
+    if ( m_enable_mthreading )
+    {
+        std::vector<Connects> slab_connections( nslabs );
+        KVS_OMP_PARALLEL()
+        {
+            KVS_OMP_FOR( schedule(dynamic) )
+            for ( size_t z = 0; z < nslabs; ++z )
+            {
+                this->connect_isopoints_on_slab<T>(
+                    vertex_map, kvs::UInt32( z ), slab_connections[z] );
+            }
+        }
+
+        ::Concatenate( slab_connections, connections );
+    }
+    else
+    {
+        for ( size_t z = 0; z < nslabs; ++z )
+        {
+            this->connect_isopoints_on_slab<T>(
+                vertex_map, kvs::UInt32( z ), connections );
+        }
+    }
+}
+
+/*==========================================================================*/
+/**
+ *  @brief  Connects the coordinates on the specified slab.
+ *  @param  vertex_map [in] pointer to the vertex map
+ *  @param  z [in] z-index of the slab (layer of cells)
+ *  @param  connections [in/out] connection array
+ */
+/*==========================================================================*/
+template <typename T>
+void MarchingCubes::connect_isopoints_on_slab(
+    const kvs::UInt32* vertex_map,
+    const kvs::UInt32 z,
+    std::vector<kvs::UInt32>& connections ) const
+{
+    const auto* volume = kvs::StructuredVolumeObject::DownCast( BaseClass::volume() );
+
     const kvs::Vec3u resolution( volume->resolution() );
     const kvs::Vec3u ncells( resolution - kvs::Vec3u::Constant(1) );
     const kvs::UInt32 line_size( volume->numberOfNodesPerLine() );
     const kvs::UInt32 slice_size( volume->numberOfNodesPerSlice() );
 
     auto Edge = MarchingCubesTable::TriangleID;
-    size_t index = 0;
+    const auto& macro_cells = volume->macroCells( m_enable_mthreading );
+    const auto bsize = kvs::UInt32( macro_cells.blockSize() );
+    const kvs::UInt32 bz = z / bsize;
+    size_t index = size_t( z ) * slice_size;
     size_t local_index[8];
     size_t local_edge[12];
-    for ( kvs::UInt32 z = 0; z < ncells.z(); ++z )
+    for ( kvs::UInt32 y = 0; y < ncells.y(); ++y )
     {
-        for ( kvs::UInt32 y = 0; y < ncells.y(); ++y )
+        const kvs::UInt32 by = y / bsize;
+        for ( kvs::UInt32 bx = 0; bx < macro_cells.resolution().x(); ++bx )
         {
-            for ( kvs::UInt32 x = 0; x < ncells.x(); ++x )
+            const kvs::UInt32 x0 = bx * bsize;
+            const kvs::UInt32 x1 = kvs::Math::Min( x0 + bsize, ncells.x() );
+
+            // Skip the macro-cell that the isosurface does not pass through.
+            if ( !macro_cells.isActive( macro_cells.blockIndex( bx, by, bz ), m_isolevel ) )
+            {
+                index += x1 - x0;
+                continue;
+            }
+
+            for ( kvs::UInt32 x = x0; x < x1; ++x )
             {
                 // Calculate the indices of the target cell.
                 local_index[0] = index;
@@ -505,19 +738,18 @@ void MarchingCubes::connect_isopoints(
 
                 for ( size_t i = 0; Edge[table_index][i] != -1; i += 3 )
                 {
-                    const int e0 = local_edge[ Edge[table_index][i]   ];
-                    const int e1 = local_edge[ Edge[table_index][i+2] ];
-                    const int e2 = local_edge[ Edge[table_index][i+1] ];
+                    const size_t e0 = local_edge[ Edge[table_index][i]   ];
+                    const size_t e1 = local_edge[ Edge[table_index][i+2] ];
+                    const size_t e2 = local_edge[ Edge[table_index][i+1] ];
 
                     connections.push_back( vertex_map[e0] );
                     connections.push_back( vertex_map[e1] );
                     connections.push_back( vertex_map[e2] );
                 }
             } // x
-            ++index;
-        } // y
-        index += line_size;
-    } // z
+        } // end of loop-bx
+        ++index;
+    } // y
 }
 
 /*==========================================================================*/
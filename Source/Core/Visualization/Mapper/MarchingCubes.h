@@ -28,6 +28,7 @@ class MarchingCubes : public kvs::MapperBase, public kvs::PolygonObject
 private:
     double m_isolevel = 0; ///< isosurface level
     bool m_duplication = true; ///< duplication flag
+    bool m_enable_mthreading = false; ///< flag for multi-threaded extraction
 
 public:
     MarchingCubes() = default;
@@ -41,6 +42,10 @@ public:
         const kvs::TransferFunction& transfer_function );
 
     void setIsolevel( const double isolevel ) { m_isolevel = isolevel; }
+    void setDuplication( const bool duplication ) { m_duplication = duplication; }
+    void setEnabledMultiThreading( const bool enable ) { m_enable_mthreading = enable; }
+    void enableMultiThreading() { this->setEnabledMultiThreading( true ); }
+    void disableMultiThreading() { this->setEnabledMultiThreading( false ); }
 
     SuperClass* exec( const kvs::ObjectBase* object );
 
@@ -54,10 +59,13 @@ private:
     template <typename T> void extract_surfaces( const Volume* volume );
     template <typename T> void extract_surfaces_with_duplication( const Volume* volume );
     template <typename T> void extract_surfaces_without_duplication( const Volume* volume );
+    template <typename T> void extract_slab_with_duplication( const Volume* volume, const kvs::UInt32 z, Coords& coords, Normals& normals ) const;
     template <typename T> size_t calculate_table_index( const size_t* local_index ) const;
     template <typename T> const kvs::Vec3 interpolate_vertex( const kvs::Vec3& vertex0, const kvs::Vec3& vertex1 ) const;
     template <typename T> void calculate_isopoints( kvs::UInt32*& vertex_map, Coords& coords );
+    template <typename T> void calculate_isopoints_on_slab( kvs::UInt32* vertex_map, const kvs::UInt32 z, Coords& coords ) const;
     template <typename T> void connect_isopoints( kvs::UInt32*& vertex_map, Connects& connections );
+    template <typename T> void connect_isopoints_on_slab( const kvs::UInt32* vertex_map, const kvs::UInt32 z, Connects& connections ) const;
     void calculate_normals_on_polygon( const Coords& coords, const Connects& connections, Normals& normals );
     void calculate_normals_on_vertex( const Coords& coords, const Connects& connections, Normals& normals );
 };
@@ -6,6 +6,7 @@
 /****************************************************************************/
 #include "MarchingHexahedra.h"
 #include "MarchingHexahedraTable.h"
+#include <kvs/MinMaxMacroCells>
 
 
 namespace kvs
@@ -151,72 +152,81 @@ void MarchingHexahedra::extract_surfaces_with_duplication(
     std::vector<kvs::Real32> coords;
     std::vector<kvs::Real32> normals;
 
-    const kvs::UInt32 ncells( volume->numberOfCells() );
     const kvs::UInt32* connections =
         static_cast<const kvs::UInt32*>( volume->connections().data() );
 
     // Extract surfaces.
-    size_t index = 0;
+    const auto& macro_cells = volume->macroCells();
+    const size_t nblocks = macro_cells.numberOfBlocks();
     size_t local_index[8];
-    for ( kvs::UInt32 cell = 0; cell < ncells; ++cell, index += 8 )
+    for ( size_t block = 0; block < nblocks; ++block )
     {
-        // Calculate the indices of the target cell.
-        local_index[0] = connections[ index + 4 ];
-        local_index[1] = connections[ index + 5 ];
-        local_index[2] = connections[ index + 6 ];
-        local_index[3] = connections[ index + 7 ];
-        local_index[4] = connections[ index + 0 ];
-        local_index[5] = connections[ index + 1 ];
-        local_index[6] = connections[ index + 2 ];
-        local_index[7] = connections[ index + 3 ];
-
-        // Calculate the index of the reference table.
-        const size_t table_index = this->calculate_table_index<T>( local_index );
-        if ( table_index == 0 ) continue;
-        if ( table_index == 255 ) continue;
-
-        // Calculate the triangle polygons.
-        for ( size_t i = 0; MarchingHexahedraTable::TriangleID[ table_index ][i] != -1; i += 3 )
+        // Skip the macro-cell that the isosurface does not pass through.
+        if ( !macro_cells.isActive( block, m_isolevel ) ) { continue; }
+
+        const size_t first = macro_cells.firstCell( block );
+        const size_t last = macro_cells.lastCell( block );
+        size_t index = 8 * first;
+        for ( size_t cell = first; cell < last; ++cell, index += 8 )
         {
-            // Refer the edge IDs from the TriangleTable by using the table_index.
-            const int e0 = MarchingHexahedraTable::TriangleID[table_index][i];
-            const int e1 = MarchingHexahedraTable::TriangleID[table_index][i+2];
-            const int e2 = MarchingHexahedraTable::TriangleID[table_index][i+1];
-
-            // Determine vertices for each edge.
-            const int v0 = local_index[MarchingHexahedraTable::VertexID[e0][0]];
-            const int v1 = local_index[MarchingHexahedraTable::VertexID[e0][1]];
-
-            const int v2 = local_index[MarchingHexahedraTable::VertexID[e1][0]];
-            const int v3 = local_index[MarchingHexahedraTable::VertexID[e1][1]];
-
-            const int v4 = local_index[MarchingHexahedraTable::VertexID[e2][0]];
-            const int v5 = local_index[MarchingHexahedraTable::VertexID[e2][1]];
-
-            // Calculate coordinates of the vertices which are composed
-            // of the triangle polygon.
-            const kvs::Vec3 vertex0( this->interpolate_vertex<T>( v0, v1 ) );
-            coords.push_back( vertex0.x() );
-            coords.push_back( vertex0.y() );
-            coords.push_back( vertex0.z() );
-
-            const kvs::Vec3 vertex1( this->interpolate_vertex<T>( v2, v3 ) );
-            coords.push_back( vertex1.x() );
-            coords.push_back( vertex1.y() );
-            coords.push_back( vertex1.z() );
-
-            const kvs::Vec3 vertex2( this->interpolate_vertex<T>( v4, v5 ) );
-            coords.push_back( vertex2.x() );
-            coords.push_back( vertex2.y() );
-            coords.push_back( vertex2.z() );
-
-            // Calculate a normal vector for the triangle polygon.
-            const kvs::Vec3 normal( ( vertex1 - vertex0 ).cross( vertex2 - vertex0 ) );
-            normals.push_back( normal.x() );
-            normals.push_back( normal.y() );
-            normals.push_back( normal.z() );
-        } // end of loop-triangle
-    } // end of loop-cell
+            // Calculate the indices of the target cell.
+            local_index[0] = connections[ index + 4 ];
+            local_index[1] = connections[ index + 5 ];
+            local_index[2] = connections[ index + 6 ];
+            local_index[3] = connections[ index + 7 ];
+            local_index[4] = connections[ index + 0 ];
+            local_index[5] = connections[ index + 1 ];
+            local_index[6] = connections[ index + 2 ];
+            local_index[7] = connections[ index + 3 ];
+
+            // Calculate the index of the reference table.
+            const size_t table_index = this->calculate_table_index<T>( local_index );
+            if ( table_index == 0 ) continue;
+            if ( table_index == 255 ) continue;
+
+            // Calculate the triangle polygons.
+            for ( size_t i = 0; MarchingHexahedraTable::TriangleID[ table_index ][i] != -1; i += 3 )
+            {
+                // Refer the edge IDs from the TriangleTable by using the table_index.
+                const int e0 = MarchingHexahedraTable::TriangleID[table_index][i];
+                const int e1 = MarchingHexahedraTable::TriangleID[table_index][i+2];
+                const int e2 = MarchingHexahedraTable::TriangleID[table_index][i+1];
+
+                // Determine vertices for each edge.
+                const int v0 = local_index[MarchingHexahedraTable::VertexID[e0][0]];
+                const int v1 = local_index[MarchingHexahedraTable::VertexID[e0][1]];
+
+                const int v2 = local_index[MarchingHexahedraTable::VertexID[e1][0]];
+                const int v3 = local_index[MarchingHexahedraTable::VertexID[e1][1]];
+
+                const int v4 = local_index[MarchingHexahedraTable::VertexID[e2][0]];
+                const int v5 = local_index[MarchingHexahedraTable::VertexID[e2][1]];
+
+                // Calculate coordinates of the vertices which are composed
+                // of the triangle polygon.
+                const kvs::Vec3 vertex0( this->interpolate_vertex<T>( v0, v1 ) );
+                coords.push_back( vertex0.x() );
+                coords.push_back( vertex0.y() );
+                coords.push_back( vertex0.z() );
+
+                const kvs::Vec3 vertex1( this->interpolate_vertex<T>( v2, v3 ) );
+                coords.push_back( vertex1.x() );
+                coords.push_back( vertex1.y() );
+                coords.push_back( vertex1.z() );
+
+                const kvs::Vec3 vertex2( this->interpolate_vertex<T>( v4, v5 ) );
+                coords.push_back( vertex2.x() );
+                coords.push_back( vertex2.y() );
+                coords.push_back( vertex2.z() );
+
+                // Calculate a normal vector for the triangle polygon.
+                const kvs::Vec3 normal( ( vertex1 - vertex0 ).cross( vertex2 - vertex0 ) );
+                normals.push_back( normal.x() );
+                normals.push_back( normal.y() );
+                normals.push_back( normal.z() );
+            } // end of loop-triangle
+        } // end of loop-cell
+    } // end of loop-block
 
     if ( coords.size() > 0 )
     {
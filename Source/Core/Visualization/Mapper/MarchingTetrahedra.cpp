@@ -7,6 +7,7 @@
 #include "MarchingTetrahedra.h"
 #include "MarchingTetrahedraTable.h"
 #include <kvs/IgnoreUnusedVariable>
+#include <kvs/MinMaxMacroCells>
 
 
 namespace kvs
@@ -169,10 +170,15 @@ void MarchingTetrahedra::extract_surfaces_with_duplication(
     const size_t ncells = volume->numberOfCells();
 
     // Extract surfaces.
+    const auto& macro_cells = volume->macroCells();
+    const size_t bsize = macro_cells.blockSize();
     size_t index = 0;
     size_t local_index[4];
     for ( kvs::UInt32 cell = 0; cell < ncells; ++cell, index += 4 )
     {
+        // Skip the cell in the macro-cell that the isosurface does not pass through.
+        if ( !macro_cells.isActive( cell / bsize, m_isolevel ) ) continue;
+
         // Calculate the indices of the target cell.
         local_index[0] = connections[ index ];
         local_index[1] = connections[ index + 1 ];
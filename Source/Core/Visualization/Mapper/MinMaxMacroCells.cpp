@@ -0,0 +1,348 @@
+/*****************************************************************************/
+/**
+ *  @file   MinMaxMacroCells.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "MinMaxMacroCells.h"
+#include <kvs/VolumeObjectBase>
+#include <kvs/StructuredVolumeObject>
+#include <kvs/UnstructuredVolumeObject>
+#include <kvs/Value>
+#include <kvs/Math>
+#include <kvs/Message>
+#include <kvs/OpenMP>
+
+
+namespace
+{
+
+const size_t DefaultStructuredBlockSize = 8; // 8x8x8 cells
+const size_t DefaultUnstructuredBlockSize = 64; // 64 consecutive cells
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new MinMaxMacroCells class.
+ *  @param  volume [in] pointer to the volume object
+ *  @param  block_size [in] block size (0: default size)
+ *  @param  enable_mthreading [in] if true, the macro-cells are built with the multi-threading
+ */
+/*===========================================================================*/
+MinMaxMacroCells::MinMaxMacroCells(
+    const kvs::VolumeObjectBase* volume,
+    const size_t block_size,
+    const bool enable_mthreading ):
+    m_enable_mthreading( enable_mthreading )
+{
+    this->build( volume, block_size );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns true if the slice plane can pass through the macro-cell.
+ *  @param  index [in] index of the macro-cell
+ *  @param  plane [in] coefficients of the plane equation
+ *  @return true, if the plane can pass through the macro-cell
+ */
+/*===========================================================================*/
+bool MinMaxMacroCells::isActive( const size_t index, const kvs::Vec4& plane ) const
+{
+    // The plane equation is linear, so that the range of the equation over
+    // the nodes in the macro-cell is bounded by the values at the corners of
+    // the bounding box. The range is slightly extended to absorb the rounding
+    // errors in the single-precision evaluation of each node.
+    const kvs::Vec3 min_coord = this->minCoord( index );
+    const kvs::Vec3 max_coord = this->maxCoord( index );
+
+    double fmin = plane.w();
+    double fmax = plane.w();
+    double scale = kvs::Math::Abs( plane.w() );
+    for ( int i = 0; i < 3; ++i )
+    {
+        const double f0 = double( plane[i] ) * min_coord[i];
+        const double f1 = double( plane[i] ) * max_coord[i];
+        fmin += kvs::Math::Min( f0, f1 );
+        fmax += kvs::Math::Max( f0, f1 );
+        scale += kvs::Math::Abs( f0 ) + kvs::Math::Abs( f1 );
+    }
+
+    const double epsilon = scale * 1.0e-5;
+    return fmin <= epsilon && fmax > -epsilon;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of the macro-cells intersected with the isosurface.
+ *  @param  isolevel [in] isolevel
+ *  @return number of the active macro-cells
+ */
+/*===========================================================================*/
+size_t MinMaxMacroCells::numberOfActiveBlocks( const double isolevel ) const
+{
+    size_t counter = 0;
+    const size_t nblocks = this->numberOfBlocks();
+    for ( size_t i = 0; i < nblocks; ++i )
+    {
+        if ( this->isActive( i, isolevel ) ) { counter++; }
+    }
+    return counter;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Builds the macro-cells for the specified volume.
+ *  @param  volume [in] pointer to the volume object
+ *  @param  block_size [in] block size (0: default size)
+ *  @return true, if the macro-cells are built successfully
+ */
+/*===========================================================================*/
+bool MinMaxMacroCells::build(
+    const kvs::VolumeObjectBase* volume,
+    const size_t block_size )
+{
+    m_has_values = false;
+    m_ncells = volume->numberOfCells();
+
+    if ( volume->volumeType() == kvs::VolumeObjectBase::Structured )
+    {
+        m_block_size = block_size > 0 ? block_size : ::DefaultStructuredBlockSize;
+        this->build_structured( kvs::StructuredVolumeObject::DownCast( volume ) );
+    }
+    else if ( volume->volumeType() == kvs::VolumeObjectBase::Unstructured )
+    {
+        m_block_size = block_size > 0 ? block_size : ::DefaultUnstructuredBlockSize;
+        this->build_unstructured( kvs::UnstructuredVolumeObject::DownCast( volume ) );
+    }
+    else
+    {
+        kvsMessageError("Unknown volume type.");
+        return false;
+    }
+
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Builds the macro-cells for the structured volume.
+ *  @param  volume [in] pointer to the structured volume object
+ */
+/*===========================================================================*/
+void MinMaxMacroCells::build_structured( const kvs::StructuredVolumeObject* volume )
+{
+    const kvs::Vec3ui ncells = volume->resolution() - kvs::Vec3ui::Constant(1);
+    const kvs::UInt32 bsize = kvs::UInt32( m_block_size );
+    m_resolution = kvs::Vec3ui(
+        ( ncells.x() + bsize - 1 ) / bsize,
+        ( ncells.y() + bsize - 1 ) / bsize,
+        ( ncells.z() + bsize - 1 ) / bsize );
+
+    const size_t nblocks = size_t( m_resolution.x() ) * m_resolution.y() * m_resolution.z();
+    m_min_coords.allocate( nblocks * 3 );
+    m_max_coords.allocate( nblocks * 3 );
+
+    // Bounding boxes in the index space.
+    size_t index = 0;
+    for ( kvs::UInt32 bz = 0; bz < m_resolution.z(); ++bz )
+    {
+        for ( kvs::UInt32 by = 0; by < m_resolution.y(); ++by )
+        {
+            for ( kvs::UInt32 bx = 0; bx < m_resolution.x(); ++bx, ++index )
+            {
+                const kvs::Vec3ui min_index( bx * bsize, by * bsize, bz * bsize );
+                const kvs::Vec3ui max_index(
+                    kvs::Math::Min( min_index.x() + bsize, ncells.x() ),
+                    kvs::Math::Min( min_index.y() + bsize, ncells.y() ),
+                    kvs::Math::Min( min_index.z() + bsize, ncells.z() ) );
+                for ( int i = 0; i < 3; ++i )
+                {
+                    m_min_coords[ 3 * index + i ] = kvs::Real32( min_index[i] );
+                    m_max_coords[ 3 * index + i ] = kvs::Real32( max_index[i] );
+                }
+            }
+        }
+    }
+
+    // Min/max values are available only for the scalar volume.
+    if ( volume->veclen() != 1 || volume->values().size() == 0 ) { return; }
+
+    m_min_values.allocate( nblocks );
+    m_max_values.allocate( nblocks );
+    switch ( volume->values().typeID() )
+    {
+    case kvs::Type::TypeInt8:   { this->calculate_structured_values<kvs::Int8>  ( volume ); break; }
+    case kvs::Type::TypeInt16:  { this->calculate_structured_values<kvs::Int16> ( volume ); break; }
+    case kvs::Type::TypeInt32:  { this->calculate_structured_values<kvs::Int32> ( volume ); break; }
+    case kvs::Type::TypeInt64:  { this->calculate_structured_values<kvs::Int64> ( volume ); break; }
+    case kvs::Type::TypeUInt8:  { this->calculate_structured_values<kvs::UInt8> ( volume ); break; }
+    case kvs::Type::TypeUInt16: { this->calculate_structured_values<kvs::UInt16>( volume ); break; }
+    case kvs::Type::TypeUInt32: { this->calculate_structured_values<kvs::UInt32>( volume ); break; }
+    case kvs::Type::TypeUInt64: { this->calculate_structured_values<kvs::UInt64>( volume ); break; }
+    case kvs::Type::TypeReal32: { this->calculate_structured_values<kvs::Real32>( volume ); break; }
+    case kvs::Type::TypeReal64: { this->calculate_structured_values<kvs::Real64>( volume ); break; }
+    default: return;
+    }
+
+    m_has_values = true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Builds the macro-cells for the unstructured volume.
+ *  @param  volume [in] pointer to the unstructured volume object
+ */
+/*===========================================================================*/
+void MinMaxMacroCells::build_unstructured( const kvs::UnstructuredVolumeObject* volume )
+{
+    const size_t nblocks = ( m_ncells + m_block_size - 1 ) / m_block_size;
+    m_resolution = kvs::Vec3ui( kvs::UInt32( nblocks ), 1, 1 );
+
+    m_min_coords.allocate( nblocks * 3 );
+    m_max_coords.allocate( nblocks * 3 );
+
+    // Bounding boxes in the object coordinates.
+    const kvs::Real32* coords = volume->coords().data();
+    const kvs::UInt32* connections = volume->connections().data();
+    const size_t nnodes = volume->numberOfCellNodes();
+    KVS_OMP_PARALLEL( if( m_enable_mthreading ) )
+    {
+        KVS_OMP_FOR( schedule(static) )
+        for ( size_t index = 0; index < nblocks; ++index )
+        {
+            kvs::Vec3 min_coord = kvs::Vec3::Constant( kvs::Value<kvs::Real32>::Max() );
+            kvs::Vec3 max_coord = kvs::Vec3::Constant( -kvs::Value<kvs::Real32>::Max() );
+            const size_t first = this->firstCell( index ) * nnodes;
+            const size_t last = this->lastCell( index ) * nnodes;
+            for ( size_t i = first; i < last; ++i )
+            {
+                const kvs::Real32* coord = coords + 3 * connections[i];
+                for ( int j = 0; j < 3; ++j )
+                {
+                    min_coord[j] = kvs::Math::Min( min_coord[j], coord[j] );
+                    max_coord[j] = kvs::Math::Max( max_coord[j], coord[j] );
+                }
+            }
+
+            for ( int j = 0; j < 3; ++j )
+            {
+                m_min_coords[ 3 * index + j ] = min_coord[j];
+                m_max_coords[ 3 * index + j ] = max_coord[j];
+            }
+        }
+    }
+
+    // Min/max values are available only for the scalar volume.
+    if ( volume->veclen() != 1 || volume->values().size() == 0 ) { return; }
+
+    m_min_values.allocate( nblocks );
+    m_max_values.allocate( nblocks );
+    switch ( volume->values().typeID() )
+    {
+    case kvs::Type::TypeInt8:   { this->calculate_unstructured_values<kvs::Int8>  ( volume ); break; }
+    case kvs::Type::TypeInt16:  { this->calculate_unstructured_values<kvs::Int16> ( volume ); break; }
+    case kvs::Type::TypeInt32:  { this->calculate_unstructured_values<kvs::Int32> ( volume ); break; }
+    case kvs::Type::TypeInt64:  { this->calculate_unstructured_values<kvs::Int64> ( volume ); break; }
+    case kvs::Type::TypeUInt8:  { this->calculate_unstructured_values<kvs::UInt8> ( volume ); break; }
+    case kvs::Type::TypeUInt16: { this->calculate_unstructured_values<kvs::UInt16>( volume ); break; }
+    case kvs::Type::TypeUInt32: { this->calculate_unstructured_values<kvs::UInt32>( volume ); break; }
+    case kvs::Type::TypeUInt64: { this->calculate_unstructured_values<kvs::UInt64>( volume ); break; }
+    case kvs::Type::TypeReal32: { this->calculate_unstructured_values<kvs::Real32>( volume ); break; }
+    case kvs::Type::TypeReal64: { this->calculate_unstructured_values<kvs::Real64>( volume ); break; }
+    default: return;
+    }
+
+    m_has_values = true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Calculates the min/max values of each macro-cell in the structured volume.
+ *  @param  volume [in] pointer to the structured volume object
+ */
+/*===========================================================================*/
+template <typename T>
+void MinMaxMacroCells::calculate_structured_values( const kvs::StructuredVolumeObject* volume )
+{
+    const T* const values = static_cast<const T*>( volume->values().data() );
+    const size_t line_size = volume->numberOfNodesPerLine();
+    const size_t slice_size = volume->numberOfNodesPerSlice();
+    const size_t nblocks = this->numberOfBlocks();
+
+    KVS_OMP_PARALLEL( if( m_enable_mthreading ) )
+    {
+        KVS_OMP_FOR( schedule(static) )
+        for ( size_t index = 0; index < nblocks; ++index )
+        {
+            // The nodes on the upper faces of the block are shared with the
+            // neighboring blocks, and included in both.
+            const kvs::Vec3 min_index = this->minCoord( index );
+            const kvs::Vec3 max_index = this->maxCoord( index );
+            const size_t x0 = size_t( min_index.x() ), x1 = size_t( max_index.x() );
+            const size_t y0 = size_t( min_index.y() ), y1 = size_t( max_index.y() );
+            const size_t z0 = size_t( min_index.z() ), z1 = size_t( max_index.z() );
+
+            T min_value = values[ x0 + y0 * line_size + z0 * slice_size ];
+            T max_value = min_value;
+            for ( size_t z = z0; z <= z1; ++z )
+            {
+                for ( size_t y = y0; y <= y1; ++y )
+                {
+                    const T* value = values + x0 + y * line_size + z * slice_size;
+                    for ( size_t x = x0; x <= x1; ++x, ++value )
+                    {
+                        min_value = kvs::Math::Min( min_value, *value );
+                        max_value = kvs::Math::Max( max_value, *value );
+                    }
+                }
+            }
+
+            m_min_values[ index ] = static_cast<kvs::Real64>( min_value );
+            m_max_values[ index ] = static_cast<kvs::Real64>( max_value );
+        }
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Calculates the min/max values of each macro-cell in the unstructured volume.
+ *  @param  volume [in] pointer to the unstructured volume object
+ */
+/*===========================================================================*/
+template <typename T>
+void MinMaxMacroCells::calculate_unstructured_values( const kvs::UnstructuredVolumeObject* volume )
+{
+    const T* const values = static_cast<const T*>( volume->values().data() );
+    const kvs::UInt32* connections = volume->connections().data();
+    const size_t nnodes = volume->numberOfCellNodes();
+    const size_t nblocks = this->numberOfBlocks();
+
+    KVS_OMP_PARALLEL( if( m_enable_mthreading ) )
+    {
+        KVS_OMP_FOR( schedule(static) )
+        for ( size_t index = 0; index < nblocks; ++index )
+        {
+            const size_t first = this->firstCell( index ) * nnodes;
+            const size_t last = this->lastCell( index ) * nnodes;
+
+            T min_value = values[ connections[ first ] ];
+            T max_value = min_value;
+            for ( size_t i = first + 1; i < last; ++i )
+            {
+                const T value = values[ connections[i] ];
+                min_value = kvs::Math::Min( min_value, value );
+                max_value = kvs::Math::Max( max_value, value );
+            }
+
+            m_min_values[ index ] = static_cast<kvs::Real64>( min_value );
+            m_max_values[ index ] = static_cast<kvs::Real64>( max_value );
+        }
+    }
+}
+
+} // end of namespace kvs
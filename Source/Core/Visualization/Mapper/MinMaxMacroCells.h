@@ -0,0 +1,142 @@
+/*****************************************************************************/
+/**
+ *  @file   MinMaxMacroCells.h
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#pragma once
+#include <kvs/Type>
+#include <kvs/Vector3>
+#include <kvs/Vector4>
+#include <kvs/ValueArray>
+
+
+namespace kvs
+{
+
+class VolumeObjectBase;
+class StructuredVolumeObject;
+class UnstructuredVolumeObject;
+
+/*===========================================================================*/
+/**
+ *  @brief  Min/max macro-cell class.
+ *
+ *  The cells of the volume are grouped into macro-cells (blocks), and the
+ *  min/max values and the bounding box of the nodes are stored for each
+ *  macro-cell. For a structured volume, a macro-cell is a block of NxNxN
+ *  cells and its bounding box is given in the index space of the grid. For
+ *  an unstructured volume, a macro-cell is a run of N consecutive cells and
+ *  its bounding box is given in the object coordinates. The mappers can
+ *  skip whole macro-cells that do not intersect the isosurface or the slice
+ *  plane.
+ */
+/*===========================================================================*/
+class MinMaxMacroCells
+{
+private:
+    size_t m_block_size = 0; ///< number of cells along each axis (or in a run) in a macro-cell
+    kvs::Vec3ui m_resolution{ 0, 0, 0 }; ///< number of macro-cells along each axis
+    size_t m_ncells = 0; ///< number of cells of the volume
+    bool m_has_values = false; ///< true if the min/max values are available
+    kvs::ValueArray<kvs::Real64> m_min_values{}; ///< min. value of each macro-cell
+    kvs::ValueArray<kvs::Real64> m_max_values{}; ///< max. value of each macro-cell
+    kvs::ValueArray<kvs::Real32> m_min_coords{}; ///< min. coord of each macro-cell
+    kvs::ValueArray<kvs::Real32> m_max_coords{}; ///< max. coord of each macro-cell
+    bool m_enable_mthreading = false; ///< flag for the multi-threaded build
+
+public:
+    MinMaxMacroCells() = default;
+    MinMaxMacroCells( const kvs::VolumeObjectBase* volume, const size_t block_size = 0, const bool enable_mthreading = false );
+    virtual ~MinMaxMacroCells() = default;
+
+    bool isEnabledMultiThreading() const { return m_enable_mthreading; }
+    void setEnabledMultiThreading( const bool enable ) { m_enable_mthreading = enable; }
+    void enableMultiThreading() { this->setEnabledMultiThreading( true ); }
+    void disableMultiThreading() { this->setEnabledMultiThreading( false ); }
+
+    size_t blockSize() const { return m_block_size; }
+    const kvs::Vec3ui& resolution() const { return m_resolution; }
+    size_t numberOfBlocks() const { return m_min_coords.size() / 3; }
+    bool hasValues() const { return m_has_values; }
+    kvs::Real64 minValue( const size_t index ) const { return m_min_values[ index ]; }
+    kvs::Real64 maxValue( const size_t index ) const { return m_max_values[ index ]; }
+    kvs::Vec3 minCoord( const size_t index ) const { return kvs::Vec3( m_min_coords.data() + 3 * index ); }
+    kvs::Vec3 maxCoord( const size_t index ) const { return kvs::Vec3( m_max_coords.data() + 3 * index ); }
+    const kvs::ValueArray<kvs::Real64>& minValues() const { return m_min_values; }
+    const kvs::ValueArray<kvs::Real64>& maxValues() const { return m_max_values; }
+
+    size_t blockIndex( const size_t bx, const size_t by, const size_t bz ) const;
+    size_t firstCell( const size_t index ) const;
+    size_t lastCell( const size_t index ) const;
+
+    bool isActive( const size_t index, const double isolevel ) const;
+    bool isActive( const size_t index, const kvs::Vec4& plane ) const;
+    size_t numberOfActiveBlocks( const double isolevel ) const;
+
+    bool build( const kvs::VolumeObjectBase* volume, const size_t block_size = 0 );
+
+private:
+    void build_structured( const kvs::StructuredVolumeObject* volume );
+    void build_unstructured( const kvs::UnstructuredVolumeObject* volume );
+    template <typename T> void calculate_structured_values( const kvs::StructuredVolumeObject* volume );
+    template <typename T> void calculate_unstructured_values( const kvs::UnstructuredVolumeObject* volume );
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the index of the macro-cell in the structured volume.
+ *  @param  bx [in] x index of the macro-cell
+ *  @param  by [in] y index of the macro-cell
+ *  @param  bz [in] z index of the macro-cell
+ *  @return index of the macro-cell
+ */
+/*===========================================================================*/
+inline size_t MinMaxMacroCells::blockIndex( const size_t bx, const size_t by, const size_t bz ) const
+{
+    return bx + m_resolution.x() * ( by + m_resolution.y() * bz );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the first cell ID of the macro-cell in the unstructured volume.
+ *  @param  index [in] index of the macro-cell
+ *  @return first cell ID
+ */
+/*===========================================================================*/
+inline size_t MinMaxMacroCells::firstCell( const size_t index ) const
+{
+    return index * m_block_size;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the last cell ID + 1 of the macro-cell in the unstructured volume.
+ *  @param  index [in] index of the macro-cell
+ *  @return last cell ID + 1
+ */
+/*===========================================================================*/
+inline size_t MinMaxMacroCells::lastCell( const size_t index ) const
+{
+    const size_t last = ( index + 1 ) * m_block_size;
+    return last < m_ncells ? last : m_ncells;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns true if the isosurface can pass through the macro-cell.
+ *  @param  index [in] index of the macro-cell
+ *  @param  isolevel [in] isolevel
+ *  @return true, if the isosurface can pass through the macro-cell
+ */
+/*===========================================================================*/
+inline bool MinMaxMacroCells::isActive( const size_t index, const double isolevel ) const
+{
+    // The cell is classified by 'value > isolevel', so that the cells in the
+    // macro-cell are all outside (or all inside) if isolevel < min (or
+    // isolevel >= max).
+    if ( !m_has_values ) { return true; }
+    return m_min_values[ index ] <= isolevel && isolevel < m_max_values[ index ];
+}
+
+} // end of namespace kvs
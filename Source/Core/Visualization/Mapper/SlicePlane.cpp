@@ -10,6 +10,32 @@
 #include <kvs/MarchingHexahedraTable>
 #include <kvs/MarchingPyramidTable>
 #include <kvs/MarchingPrismTable>
+#include <kvs/MinMaxMacroCells>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the flags of the macro-cells that the plane passes through.
+ *  @param  macro_cells [in] min/max macro-cells
+ *  @param  plane [in] coefficients of the plane
+ *  @return flags for each macro-cell (1: active, 0: inactive)
+ */
+/*===========================================================================*/
+kvs::ValueArray<kvs::UInt8> ActiveBlocks( const kvs::MinMaxMacroCells& macro_cells, const kvs::Vec4& plane )
+{
+    const size_t nblocks = macro_cells.numberOfBlocks();
+    kvs::ValueArray<kvs::UInt8> active( nblocks );
+    for ( size_t i = 0; i < nblocks; ++i )
+    {
+        active[i] = macro_cells.isActive( i, plane ) ? 1 : 0;
+    }
+    return active;
+}
+
+} // end of namespace
 
 
 namespace kvs
@@ -176,12 +202,20 @@ void SlicePlane::extract_plane(
 
     // Extract surfaces.
 //    size_t index = 0;
+    const auto& macro_cells = volume->macroCells();
+    const auto bsize = kvs::UInt32( macro_cells.blockSize() );
+    const auto active = ::ActiveBlocks( macro_cells, m_coef );
     for ( kvs::UInt32 z = 0; z < ncells.z(); ++z )
     {
+        const kvs::UInt32 bz = z / bsize;
         for ( kvs::UInt32 y = 0; y < ncells.y(); ++y )
         {
+            const kvs::UInt32 by = y / bsize;
             for ( kvs::UInt32 x = 0; x < ncells.x(); ++x )
             {
+                // Skip the cell in the macro-cell that the slice plane does not pass through.
+                if ( !active[ macro_cells.blockIndex( x / bsize, by, bz ) ] ) continue;
+
                 // Calculate the index of the reference table.
                 const size_t table_index = this->calculate_table_index( x, y, z );
                 if ( table_index == 0 ) continue;
@@ -340,10 +374,16 @@ void SlicePlane::extract_tetrahedra_plane(
     const auto& color_map = BaseClass::transferFunction().colorMap();
 
     // Extract surfaces.
+    const auto& macro_cells = volume->macroCells();
+    const size_t bsize = macro_cells.blockSize();
+    const auto active = ::ActiveBlocks( macro_cells, m_coef );
     size_t index = 0;
     size_t local_index[4];
     for ( kvs::UInt32 cell = 0; cell < ncells; ++cell, index += 4 )
     {
+        // Skip the cell in the macro-cell that the slice plane does not pass through.
+        if ( !active[ cell / bsize ] ) continue;
+
         // Calculate the indices of the target cell.
         local_index[0] = volume_connections[ index ];
         local_index[1] = volume_connections[ index + 1 ];
@@ -456,10 +496,16 @@ void SlicePlane::extract_hexahedra_plane(
     const auto& color_map = BaseClass::transferFunction().colorMap();
 
     // Extract surfaces.
+    const auto& macro_cells = volume->macroCells();
+    const size_t bsize = macro_cells.blockSize();
+    const auto active = ::ActiveBlocks( macro_cells, m_coef );
     size_t index = 0;
     size_t local_index[8];
     for ( kvs::UInt32 cell = 0; cell < ncells; ++cell, index += 8 )
     {
+        // Skip the cell in the macro-cell that the slice plane does not pass through.
+        if ( !active[ cell / bsize ] ) continue;
+
         // Calculate the indices of the target cell.
         local_index[4] = volume_connections[ index ];
         local_index[5] = volume_connections[ index + 1 ];
@@ -576,10 +622,16 @@ void SlicePlane::extract_pyramid_plane(
     const auto& color_map = BaseClass::transferFunction().colorMap();
 
     // Extract surfaces.
+    const auto& macro_cells = volume->macroCells();
+    const size_t bsize = macro_cells.blockSize();
+    const auto active = ::ActiveBlocks( macro_cells, m_coef );
     size_t index = 0;
     size_t local_index[5];
     for ( kvs::UInt32 cell = 0; cell < ncells; ++cell, index += 5 )
     {
+        // Skip the cell in the macro-cell that the slice plane does not pass through.
+        if ( !active[ cell / bsize ] ) continue;
+
         // Calculate the indices of the target cell.
         local_index[0] = volume_connections[ index ];
         local_index[1] = volume_connections[ index + 1 ];
@@ -694,10 +746,16 @@ void SlicePlane::extract_prism_plane(
     const auto& color_map = BaseClass::transferFunction().colorMap();
 
     // Extract surfaces.
+    const auto& macro_cells = volume->macroCells();
+    const size_t bsize = macro_cells.blockSize();
+    const auto active = ::ActiveBlocks( macro_cells, m_coef );
     size_t index = 0;
     size_t local_index[6];
     for ( kvs::UInt32 cell = 0; cell < ncells; ++cell, index += 6 )
     {
+        // Skip the cell in the macro-cell that the slice plane does not pass through.
+        if ( !active[ cell / bsize ] ) continue;
+
         // Calculate the indices of the target cell.
         local_index[0] = volume_connections[ index + 0 ];
         local_index[1] = volume_connections[ index + 1 ];
@@ -20,6 +20,8 @@
 #include <kvs/PyramidalCell>
 #include <kvs/PrismaticCell>
 #include <kvs/CellTreeLocator>
+#include <kvs/OpenMP>
+#include <cmath>
 
 
 namespace kvs
@@ -64,59 +66,68 @@ bool Streamline::StructuredVolumeInterpolator::containsInVolume( const kvs::Vec3
 }
 
 Streamline::UnstructuredVolumeInterpolator::UnstructuredVolumeInterpolator(
-    const kvs::UnstructuredVolumeObject* volume )
+    const kvs::UnstructuredVolumeObject* volume ):
+    m_locator( new kvs::CellTreeLocator( volume ) ),
+    m_located( false ),
+    m_index( -1 )
 {
-    switch ( volume->cellType() )
-    {
-    case kvs::UnstructuredVolumeObject::Tetrahedra:
-        m_cell = new kvs::TetrahedralCell( volume );
-        break;
-    case kvs::UnstructuredVolumeObject::Hexahedra:
-        m_cell = new kvs::HexahedralCell( volume );
-        break;
-    case kvs::UnstructuredVolumeObject::QuadraticTetrahedra:
-        m_cell = new kvs::QuadraticTetrahedralCell( volume );
-        break;
-    case kvs::UnstructuredVolumeObject::QuadraticHexahedra:
-        m_cell = new kvs::QuadraticHexahedralCell( volume );
-        break;
-    case kvs::UnstructuredVolumeObject::Pyramid:
-        m_cell = new kvs::PyramidalCell( volume );
-        break;
-    case kvs::UnstructuredVolumeObject::Prism:
-        m_cell = new kvs::PrismaticCell( volume );
-        break;
-    default:
-        m_cell = NULL;
-        break;
-    }
+}
 
-    m_locator = new kvs::CellTreeLocator( volume );
+Streamline::UnstructuredVolumeInterpolator::UnstructuredVolumeInterpolator(
+    const UnstructuredVolumeInterpolator& other ):
+    m_locator( new kvs::CellTreeLocator( *other.m_locator ) ),
+    m_located( false ),
+    m_index( -1 )
+{
 }
 
 Streamline::UnstructuredVolumeInterpolator::~UnstructuredVolumeInterpolator()
 {
-    if ( m_cell ) { delete m_cell; }
     if ( m_locator ) { delete m_locator; }
 }
 
 kvs::Vec3 Streamline::UnstructuredVolumeInterpolator::interpolatedValue( const kvs::Vec3& point )
 {
-    int index = m_locator->findCell( point );
+    const int index = this->find_cell( point );
     if ( index < 0 ) { return kvs::Vec3::Zero(); }
 
-    m_cell->bindCell( kvs::UInt32( index ) );
-    return m_cell->vector();
+    // The cell of the locator has been bound to the cell containing the point.
+    kvs::CellBase* cell = m_locator->cell();
+    cell->setLocalPoint( cell->globalToLocal( point ) );
+    return cell->vector();
 }
 
 bool Streamline::UnstructuredVolumeInterpolator::containsInVolume( const kvs::Vec3& point )
 {
-    const kvs::Vec3& min_obj = m_cell->referenceVolume()->minObjectCoord();
-    const kvs::Vec3& max_obj = m_cell->referenceVolume()->maxObjectCoord();
+    const kvs::Vec3& min_obj = m_locator->volume()->minObjectCoord();
+    const kvs::Vec3& max_obj = m_locator->volume()->maxObjectCoord();
     if ( point.x() < min_obj.x() || max_obj.x() <= point.x() ) return false;
     if ( point.y() < min_obj.y() || max_obj.y() <= point.y() ) return false;
     if ( point.z() < min_obj.z() || max_obj.z() <= point.z() ) return false;
-    return m_locator->findCell( point ) != -1;
+    return this->find_cell( point ) != -1;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Finds the cell containing the point.
+ *
+ *  Since the integrators test the point with containsInVolume and then
+ *  evaluate the vector at the same point, the result of the last lookup is
+ *  reused for the same point.
+ *
+ *  @param  point [in] point in the object coordinate
+ *  @return index of the cell (-1: not found)
+ */
+/*===========================================================================*/
+int Streamline::UnstructuredVolumeInterpolator::find_cell( const kvs::Vec3& point )
+{
+    if ( !m_located || point != m_point )
+    {
+        m_index = m_locator->findCell( point );
+        m_point = point;
+        m_located = true;
+    }
+    return m_index;
 }
 
 kvs::Vec3 Streamline::EulerIntegrator::next( const kvs::Vec3& point )
@@ -162,6 +173,98 @@ kvs::Vec3 Streamline::RungeKutta4thIntegrator::next( const kvs::Vec3& point )
     return point + ( k1 + 2.0f * ( k2 + k3 ) + k4 ) / 6.0f;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new RungeKuttaFehlberg45Integrator class.
+ *  @param  tolerance [in] error tolerance per step
+ *  @param  min_step [in] min. step size
+ *  @param  max_step [in] max. step size
+ */
+/*===========================================================================*/
+Streamline::RungeKuttaFehlberg45Integrator::RungeKuttaFehlberg45Integrator(
+    const float tolerance,
+    const float min_step,
+    const float max_step ):
+    m_tolerance( tolerance ),
+    m_min_step( min_step ),
+    m_max_step( kvs::Math::Max( min_step, max_step ) ),
+    m_accepted_step( 0.0f )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the next point integrated with the adaptive step size.
+ *
+ *  The 4th and 5th order solutions of the Runge-Kutta-Fehlberg method are
+ *  calculated from six evaluations, and the difference of them is used as
+ *  the local error. The step is retried with the smaller size while the
+ *  error exceeds the tolerance, and the 5th order solution is accepted. The
+ *  size of the next step is estimated from the error and clamped to the
+ *  range of the min. and max. step sizes. The current step size is kept in
+ *  the step of the integrator, whose sign gives the integration direction.
+ *
+ *  @param  point [in] current point
+ *  @return next point (the current point if the step is out of the volume)
+ */
+/*===========================================================================*/
+kvs::Vec3 Streamline::RungeKuttaFehlberg45Integrator::next( const kvs::Vec3& point )
+{
+    const float sign = step() < 0.0f ? -1.0f : 1.0f;
+    float h = kvs::Math::Clamp( std::abs( step() ), m_min_step, m_max_step );
+
+    const kvs::Vec3 d1 = direction( point );
+    for ( ;; )
+    {
+        const bool shrinkable = h > m_min_step;
+        const float k0 = sign * h;
+        const kvs::Vec3 k1 = d1 * k0;
+
+        const kvs::Vec3 v2 = point + k1 / 4.0f;
+        bool inside = contains( v2 );
+        const kvs::Vec3 k2 = inside ? direction( v2 ) * k0 : kvs::Vec3::Zero();
+
+        const kvs::Vec3 v3 = point + ( 3.0f * k1 + 9.0f * k2 ) / 32.0f;
+        inside = inside && contains( v3 );
+        const kvs::Vec3 k3 = inside ? direction( v3 ) * k0 : kvs::Vec3::Zero();
+
+        const kvs::Vec3 v4 = point + ( 1932.0f * k1 - 7200.0f * k2 + 7296.0f * k3 ) / 2197.0f;
+        inside = inside && contains( v4 );
+        const kvs::Vec3 k4 = inside ? direction( v4 ) * k0 : kvs::Vec3::Zero();
+
+        const kvs::Vec3 v5 = point + ( 439.0f / 216.0f ) * k1 - 8.0f * k2 + ( 3680.0f / 513.0f ) * k3 - ( 845.0f / 4104.0f ) * k4;
+        inside = inside && contains( v5 );
+        const kvs::Vec3 k5 = inside ? direction( v5 ) * k0 : kvs::Vec3::Zero();
+
+        const kvs::Vec3 v6 = point - ( 8.0f / 27.0f ) * k1 + 2.0f * k2 - ( 3544.0f / 2565.0f ) * k3 + ( 1859.0f / 4104.0f ) * k4 - ( 11.0f / 40.0f ) * k5;
+        inside = inside && contains( v6 );
+        if ( !inside )
+        {
+            // The step across the boundary is retried with the half size.
+            if ( shrinkable ) { h = kvs::Math::Max( h * 0.5f, m_min_step ); continue; }
+            return point;
+        }
+        const kvs::Vec3 k6 = direction( v6 ) * k0;
+
+        const kvs::Vec3 y4 = point + ( 25.0f / 216.0f ) * k1 + ( 1408.0f / 2565.0f ) * k3 + ( 2197.0f / 4104.0f ) * k4 - ( 1.0f / 5.0f ) * k5;
+        const kvs::Vec3 y5 = point + ( 16.0f / 135.0f ) * k1 + ( 6656.0f / 12825.0f ) * k3 + ( 28561.0f / 56430.0f ) * k4 - ( 9.0f / 50.0f ) * k5 + ( 2.0f / 55.0f ) * k6;
+        const float error = ( y5 - y4 ).length();
+
+        // Step size scaling with the safety factor 0.84 (limited to 1/10 - 4).
+        const float scale = error > 0.0f ?
+            kvs::Math::Clamp( 0.84f * std::pow( m_tolerance / error, 0.25f ), 0.1f, 4.0f ) : 4.0f;
+        if ( error > m_tolerance && shrinkable )
+        {
+            h = kvs::Math::Max( h * scale, m_min_step );
+            continue;
+        }
+
+        m_accepted_step = k0;
+        setStep( sign * kvs::Math::Clamp( h * scale, m_min_step, m_max_step ) );
+        return y5;
+    }
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Constructs a new streamline class and executes this class.
@@ -223,49 +326,76 @@ Streamline::BaseClass::SuperClass* Streamline::exec( const kvs::ObjectBase* obje
         volume->updateMinMaxValues();
     }
 
-    Interpolator* interpolator = NULL;
+    // The interpolator and the integrator are created for each thread, since
+    // they have the state of the cell (or grid) bound to the point.
+    const size_t nthreads = m_enable_mthreading ? kvs::Math::Max( 1, kvs::OpenMP::GetMaxThreads() ) : 1;
+    std::vector<Interpolator*> interpolators( nthreads, NULL );
     switch ( volume->volumeType() )
     {
     case kvs::VolumeObjectBase::Structured:
     {
         const kvs::StructuredVolumeObject* svolume = kvs::StructuredVolumeObject::DownCast( volume );
-        interpolator = new StructuredVolumeInterpolator( svolume );
+        for ( size_t i = 0; i < nthreads; i++ )
+        {
+            interpolators[i] = new StructuredVolumeInterpolator( svolume );
+        }
         break;
     }
     case kvs::VolumeObjectBase::Unstructured:
     {
         const kvs::UnstructuredVolumeObject* uvolume = kvs::UnstructuredVolumeObject::DownCast( volume );
-        interpolator = new UnstructuredVolumeInterpolator( uvolume );
+        UnstructuredVolumeInterpolator* interpolator = new UnstructuredVolumeInterpolator( uvolume );
+        interpolators[0] = interpolator;
+        for ( size_t i = 1; i < nthreads; i++ )
+        {
+            interpolators[i] = new UnstructuredVolumeInterpolator( *interpolator );
+        }
         break;
     }
     default:
         break;
     }
 
-    Integrator* integrator = NULL;
-    switch ( m_integration_method )
+    std::vector<Integrator*> integrators( nthreads, NULL );
+    for ( size_t i = 0; i < nthreads; i++ )
     {
-    case BaseClass::Euler:
-        integrator = new EulerIntegrator();
-        break;
-    case BaseClass::RungeKutta2nd:
-        integrator = new RungeKutta2ndIntegrator();
-        break;
-    case BaseClass::RungeKutta4th:
-        integrator = new RungeKutta4thIntegrator();
-        break;
-    default:
-        break;
+        integrators[i] = this->create_integrator();
+        integrators[i]->setInterpolator( interpolators[i] );
+        integrators[i]->setStep( m_integration_interval * m_integration_direction );
     }
 
-    integrator->setInterpolator( interpolator );
-    integrator->setStep( m_integration_interval * m_integration_direction );
-    BaseClass::mapping( integrator );
+    BaseClass::mapping( integrators );
 
-    delete interpolator;
-    delete integrator;
+    for ( size_t i = 0; i < nthreads; i++ )
+    {
+        delete interpolators[i];
+        delete integrators[i];
+    }
 
     return this;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Creates the integrator for the integration method.
+ *  @return pointer to the integrator
+ */
+/*===========================================================================*/
+Streamline::Integrator* Streamline::create_integrator() const
+{
+    switch ( m_integration_method )
+    {
+    case BaseClass::Euler: return new EulerIntegrator();
+    case BaseClass::RungeKutta2nd: return new RungeKutta2ndIntegrator();
+    case BaseClass::RungeKutta4th: return new RungeKutta4thIntegrator();
+    case BaseClass::RungeKuttaFehlberg45:
+        return new RungeKuttaFehlberg45Integrator(
+            m_integration_tolerance,
+            m_min_integration_interval,
+            m_max_integration_interval );
+    default: break;
+    }
+    return NULL;
+}
+
 } // end of namespace kvs
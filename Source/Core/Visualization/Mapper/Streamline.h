@@ -10,7 +10,7 @@
 #include <kvs/Module>
 #include <kvs/GridBase>
 #include <kvs/CellBase>
-#include <kvs/CellLocator>
+#include <kvs/CellTreeLocator>
 #include "StreamlineBase.h"
 
 
@@ -43,13 +43,19 @@ public:
     class UnstructuredVolumeInterpolator : public Interpolator
     {
     private:
-        kvs::CellBase* m_cell;
-        kvs::CellLocator* m_locator;
+        kvs::CellTreeLocator* m_locator;
+        bool m_located; ///< true if the point has been located
+        kvs::Vec3 m_point; ///< last located point
+        int m_index; ///< index of the cell containing the last located point (-1: not found)
     public:
         UnstructuredVolumeInterpolator( const kvs::UnstructuredVolumeObject* volume );
+        UnstructuredVolumeInterpolator( const UnstructuredVolumeInterpolator& other );
+        UnstructuredVolumeInterpolator& operator =( const UnstructuredVolumeInterpolator& ) = delete;
         ~UnstructuredVolumeInterpolator();
         kvs::Vec3 interpolatedValue( const kvs::Vec3& point );
         bool containsInVolume( const kvs::Vec3& point );
+    private:
+        int find_cell( const kvs::Vec3& point );
     };
 
     class EulerIntegrator : public Integrator
@@ -70,6 +76,19 @@ public:
         kvs::Vec3 next( const kvs::Vec3& point );
     };
 
+    class RungeKuttaFehlberg45Integrator : public Integrator
+    {
+    private:
+        float m_tolerance; ///< error tolerance per step
+        float m_min_step; ///< min. step size
+        float m_max_step; ///< max. step size
+        float m_accepted_step; ///< step size accepted at the last integration
+    public:
+        RungeKuttaFehlberg45Integrator( const float tolerance, const float min_step, const float max_step );
+        float acceptedStep() const { return m_accepted_step; }
+        kvs::Vec3 next( const kvs::Vec3& point );
+    };
+
 public:
 
     Streamline() {}
@@ -80,6 +99,9 @@ public:
         const kvs::TransferFunction& transfer_function );
 
     BaseClass::SuperClass* exec( const kvs::ObjectBase* object );
+
+private:
+    Integrator* create_integrator() const;
 };
 
 } // end of namespace kvs
@@ -5,9 +5,11 @@
  */
 /*****************************************************************************/
 #include "StreamlineBase.h"
+#include <algorithm>
 #include <kvs/DebugNew>
 #include <kvs/Type>
 #include <kvs/IgnoreUnusedVariable>
+#include <kvs/OpenMP>
 
 
 namespace kvs
@@ -24,11 +26,15 @@ StreamlineBase::StreamlineBase():
     m_integration_method( StreamlineBase::RungeKutta2nd ),
     m_integration_direction( StreamlineBase::ForwardDirection ),
     m_integration_interval( 1.0f ),
+    m_integration_tolerance( 0.001f ),
+    m_min_integration_interval( 0.001f ),
+    m_max_integration_interval( 10.0f ),
     m_vector_length_threshold( 0.000001f ),
     m_integration_times_threshold( 1000 ),
     m_enable_boundary_condition( true ),
     m_enable_vector_length_condition( true ),
-    m_enable_integration_times_condition( true )
+    m_enable_integration_times_condition( true ),
+    m_enable_mthreading( false )
 {
 }
 
@@ -54,59 +60,79 @@ void StreamlineBase::setSeedPoints( const kvs::PointObject* seed_points )
     m_seed_points->setCoords( seed_points->coords() ); // shallow copy
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Traces the streamlines from the seed points.
+ *  @param  integrator [in] pointer to the integrator
+ */
+/*===========================================================================*/
 void StreamlineBase::mapping( Integrator* integrator )
 {
-    std::vector<kvs::Real32> coords;
-    std::vector<kvs::UInt8> colors;
-    std::vector<kvs::UInt32> connections;
+    this->mapping( std::vector<Integrator*>( 1, integrator ) );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Traces the streamlines from the seed points in parallel.
+ *
+ *  The seed points are dynamically scheduled on the threads, since the
+ *  lengths of the streamlines vary widely. Each thread uses the integrator
+ *  given for the thread number, and each streamline is stored separately
+ *  until all of the seed points are traced, so that the lines are packed
+ *  in the order of the seed points independently of the number of threads.
+ *
+ *  @param  integrators [in] integrators for each thread
+ */
+/*===========================================================================*/
+void StreamlineBase::mapping( const std::vector<Integrator*>& integrators )
+{
+    const size_t nseeds = m_seed_points->numberOfVertices();
 
-    for ( size_t i = 0; i < m_seed_points->numberOfVertices(); i++ )
+    std::vector<std::vector<kvs::Real32>> line_coords( nseeds );
+    std::vector<std::vector<kvs::UInt8>> line_colors( nseeds );
+    KVS_OMP_PARALLEL( if( integrators.size() > 1 ) num_threads( integrators.size() ) )
     {
-        kvs::Vec3 point = m_seed_points->coord( i );
-        if ( !integrator->contains( point ) ) { continue; }
-
-        kvs::Vec3 value = integrator->value( point );
-        if ( this->isTerminatedByVectorLength( value ) ) { continue; }
-
-        kvs::RGBColor color = this->interpolatedColor( value );
-        coords.push_back( point.x() );
-        coords.push_back( point.y() );
-        coords.push_back( point.z() );
-        colors.push_back( color.r() );
-        colors.push_back( color.g() );
-        colors.push_back( color.b() );
-
-        const size_t id0 = coords.size() / 3 - 1;
-        for ( size_t j = 0; !this->isTerminatedByIntegrationTimes(j); j++ )
+        Integrator* integrator = integrators[ kvs::OpenMP::GetThreadNumber() ];
+
+        KVS_OMP_FOR( schedule(dynamic) )
+        for ( long i = 0; i < static_cast<long>( nseeds ); i++ )
         {
-            point = integrator->next( point );
-            if ( !integrator->contains( point ) ) { break; }
-
-            value = integrator->value( point );
-            if ( this->isTerminatedByVectorLength( value ) ) { break; }
-
-            color = this->interpolatedColor( value );
-            coords.push_back( point.x() );
-            coords.push_back( point.y() );
-            coords.push_back( point.z() );
-            colors.push_back( color.r() );
-            colors.push_back( color.g() );
-            colors.push_back( color.b() );
+            const kvs::Vec3 seed = m_seed_points->coord( i );
+            this->trace( integrator, seed, &line_coords[i], &line_colors[i] );
         }
-        const size_t id1 = coords.size() / 3 - 1;
+    }
+
+    size_t nvertices = 0;
+    for ( size_t i = 0; i < nseeds; i++ ) { nvertices += line_coords[i].size() / 3; }
+
+    kvs::ValueArray<kvs::Real32> coords( nvertices * 3 );
+    kvs::ValueArray<kvs::UInt8> colors( nvertices * 3 );
+    std::vector<kvs::UInt32> connections;
+    size_t offset = 0;
+    for ( size_t i = 0; i < nseeds; i++ )
+    {
+        const size_t n = line_coords[i].size() / 3;
+        if ( n == 0 ) { continue; }
 
-        if ( id0 != id1 )
+        std::copy( line_coords[i].begin(), line_coords[i].end(), coords.begin() + offset * 3 );
+        std::copy( line_colors[i].begin(), line_colors[i].end(), colors.begin() + offset * 3 );
+        std::vector<kvs::Real32>().swap( line_coords[i] );
+        std::vector<kvs::UInt8>().swap( line_colors[i] );
+
+        // The seed point that is not traced remains as an isolated vertex.
+        if ( n > 1 )
         {
-            connections.push_back( id0 );
-            connections.push_back( id1 );
+            connections.push_back( static_cast<kvs::UInt32>( offset ) );
+            connections.push_back( static_cast<kvs::UInt32>( offset + n - 1 ) );
         }
+        offset += n;
     }
 
     SuperClass::setLineType( kvs::LineObject::Polyline );
     SuperClass::setColorType( kvs::LineObject::VertexColor );
-    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( coords ) );
+    SuperClass::setCoords( coords );
     SuperClass::setConnections( kvs::ValueArray<kvs::UInt32>( connections ) );
-    SuperClass::setColors( kvs::ValueArray<kvs::UInt8>( colors ) );
+    SuperClass::setColors( colors );
     SuperClass::setSize( 1.0f );
 }
 
@@ -135,4 +161,55 @@ bool StreamlineBase::isTerminatedByIntegrationTimes( const size_t times )
     return false;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Traces the streamline from the seed point.
+ *  @param  integrator [in] pointer to the integrator
+ *  @param  seed [in] seed point
+ *  @param  coords [out] coordinate values of the streamline
+ *  @param  colors [out] color values of the streamline
+ */
+/*===========================================================================*/
+void StreamlineBase::trace(
+    Integrator* integrator,
+    const kvs::Vec3& seed,
+    std::vector<kvs::Real32>* coords,
+    std::vector<kvs::UInt8>* colors )
+{
+    // The step adapted by the integrator while tracing the previous seed is
+    // reset, so that the streamline does not depend on the order of the seeds.
+    integrator->setStep( m_integration_interval * m_integration_direction );
+
+    kvs::Vec3 point = seed;
+    if ( !integrator->contains( point ) ) { return; }
+
+    kvs::Vec3 value = integrator->value( point );
+    if ( this->isTerminatedByVectorLength( value ) ) { return; }
+
+    kvs::RGBColor color = this->interpolatedColor( value );
+    coords->push_back( point.x() );
+    coords->push_back( point.y() );
+    coords->push_back( point.z() );
+    colors->push_back( color.r() );
+    colors->push_back( color.g() );
+    colors->push_back( color.b() );
+
+    for ( size_t j = 0; !this->isTerminatedByIntegrationTimes(j); j++ )
+    {
+        point = integrator->next( point );
+        if ( !integrator->contains( point ) ) { break; }
+
+        value = integrator->value( point );
+        if ( this->isTerminatedByVectorLength( value ) ) { break; }
+
+        color = this->interpolatedColor( value );
+        coords->push_back( point.x() );
+        coords->push_back( point.y() );
+        coords->push_back( point.z() );
+        colors->push_back( color.r() );
+        colors->push_back( color.g() );
+        colors->push_back( color.b() );
+    }
+}
+
 } // end of namespace kvs
@@ -7,6 +7,7 @@
 #ifndef KVS__STREAMLINE_BASE_H_INCLUDE
 #define KVS__STREAMLINE_BASE_H_INCLUDE
 
+#include <vector>
 #include <kvs/Module>
 #include <kvs/MapperBase>
 #include <kvs/LineObject>
@@ -34,7 +35,8 @@ public:
     {
         Euler = 0,
         RungeKutta2nd = 1,
-        RungeKutta4th = 2
+        RungeKutta4th = 2,
+        RungeKuttaFehlberg45 = 3 ///< adaptive step size control
     };
 
     enum IntegrationDirection
@@ -80,11 +82,15 @@ protected:
     IntegrationMethod m_integration_method; ///< integtration method
     IntegrationDirection m_integration_direction; ///< integration direction
     float m_integration_interval; ///< integration interval in the object coordinate
+    float m_integration_tolerance; ///< error tolerance per step for the adaptive integration
+    float m_min_integration_interval; ///< min. integration interval for the adaptive integration
+    float m_max_integration_interval; ///< max. integration interval for the adaptive integration
     float m_vector_length_threshold; ///< threshold of the vector length
     size_t m_integration_times_threshold; ///< threshold of the integration times
     bool m_enable_boundary_condition; ///< flag for the boundray condition
     bool m_enable_vector_length_condition; ///< flag for the vector length condition
     bool m_enable_integration_times_condition; ///< flag for the integration times
+    bool m_enable_mthreading; ///< flag for multi-threaded tracing
 
 public:
 
@@ -95,24 +101,42 @@ public:
     void setIntegrationMethod( const IntegrationMethod method ) { m_integration_method = method; }
     void setIntegrationDirection( const IntegrationDirection direction ) { m_integration_direction = direction; }
     void setIntegrationInterval( const float interval ) { m_integration_interval = interval; }
+    void setIntegrationTolerance( const float tolerance ) { m_integration_tolerance = tolerance; }
+    void setMinIntegrationInterval( const float interval ) { m_min_integration_interval = interval; }
+    void setMaxIntegrationInterval( const float interval ) { m_max_integration_interval = interval; }
     void setVectorLengthThreshold( const float length ) { m_vector_length_threshold = length; }
     void setIntegrationTimesThreshold( const size_t times ) { m_integration_times_threshold = times; }
     void setEnableBoundaryCondition( const bool enabled ) { m_enable_boundary_condition = enabled; }
     void setEnableVectorLengthCondition( const bool enabled ) { m_enable_vector_length_condition = enabled; }
     void setEnableIntegrationTimesCondition( const bool enabled ) { m_enable_integration_times_condition = enabled; }
+    bool isEnabledMultiThreading() const { return m_enable_mthreading; }
+    void setEnabledMultiThreading( const bool enable ) { m_enable_mthreading = enable; }
+    void enableMultiThreading() { this->setEnabledMultiThreading( true ); }
+    void disableMultiThreading() { this->setEnabledMultiThreading( false ); }
 
     IntegrationMethod integrationMethod() const { return m_integration_method; }
     IntegrationDirection integrationDirection() const { return m_integration_direction; }
     float integrationInterval() const { return m_integration_interval; }
+    float integrationTolerance() const { return m_integration_tolerance; }
+    float minIntegrationInterval() const { return m_min_integration_interval; }
+    float maxIntegrationInterval() const { return m_max_integration_interval; }
 
     virtual kvs::ObjectBase* exec( const kvs::ObjectBase* object ) = 0;
 
 protected:
 
     void mapping( Integrator* integrator );
+    void mapping( const std::vector<Integrator*>& integrators );
     kvs::RGBColor interpolatedColor( const kvs::Vec3& value );
     bool isTerminatedByVectorLength( const kvs::Vec3& vector );
     bool isTerminatedByIntegrationTimes( const size_t times );
+
+private:
+    void trace(
+        Integrator* integrator,
+        const kvs::Vec3& seed,
+        std::vector<kvs::Real32>* coords,
+        std::vector<kvs::UInt8>* colors );
 };
 
 } // end of namespace kvs
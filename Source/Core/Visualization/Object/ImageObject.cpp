@@ -213,6 +213,46 @@ size_t ImageObject::numberOfChannels() const
     return ret;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Resizes the image with the resampler.
+ *  @param  width [in] resized width
+ *  @param  height [in] resized height
+ *  @param  resampler [in] image resampler
+ *  @return true, if the image is resized successfully
+ */
+/*===========================================================================*/
+bool ImageObject::resize( const size_t width, const size_t height, const kvs::ImageResampler& resampler )
+{
+    const size_t nchannels = this->numberOfChannels();
+    if ( nchannels == 0 )
+    {
+        kvsMessageError("Unknown pixel type.");
+        return false;
+    }
+
+    kvs::ValueArray<kvs::UInt8> pixels( width * height * this->bytesPerPixel() );
+    bool ret = false;
+    if ( m_type == ImageObject::Gray16 )
+    {
+        ret = resampler.resample(
+            reinterpret_cast<const kvs::UInt16*>( m_pixels.data() ), m_width, m_height, nchannels,
+            reinterpret_cast<kvs::UInt16*>( pixels.data() ), width, height );
+    }
+    else
+    {
+        ret = resampler.resample(
+            m_pixels.data(), m_width, m_height, nchannels,
+            pixels.data(), width, height );
+    }
+    if ( !ret ) { return false; }
+
+    m_width = width;
+    m_height = height;
+    m_pixels = pixels;
+    return true;
+}
+
 /*===========================================================================*/
 /**
  *  @brief  '<<' operator.
@@ -13,6 +13,7 @@
 #include <kvs/Module>
 #include <kvs/Indent>
 #include <kvs/Deprecated>
+#include <kvs/ImageResampler>
 
 
 namespace kvs
@@ -69,6 +70,7 @@ public:
 
     void setSize( const size_t width, const size_t height ) { m_width = width; m_height = height; }
     void setPixels( const kvs::ValueArray<kvs::UInt8>& pixels, const PixelType type = Color24 ) { m_pixels = pixels; m_type = type; }
+    bool resize( const size_t width, const size_t height, const kvs::ImageResampler& resampler = kvs::ImageResampler() );
 
 public:
     KVS_DEPRECATED( const kvs::ValueArray<kvs::UInt8>& data() const ) { return this->pixels(); }
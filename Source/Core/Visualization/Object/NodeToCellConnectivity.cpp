@@ -0,0 +1,116 @@
+/*****************************************************************************/
+/**
+ *  @file   NodeToCellConnectivity.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "NodeToCellConnectivity.h"
+#include <algorithm>
+#include <kvs/UnstructuredVolumeObject>
+#include <kvs/OpenMP>
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new NodeToCellConnectivity class.
+ *  @param  volume [in] pointer to the unstructured volume object
+ *  @param  enable_mthreading [in] if true, the connectivity is built in parallel
+ */
+/*===========================================================================*/
+NodeToCellConnectivity::NodeToCellConnectivity(
+    const kvs::UnstructuredVolumeObject* volume,
+    const bool enable_mthreading )
+{
+    this->build( volume, enable_mthreading );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Builds the node-to-cell connectivity.
+ *
+ *  The number of the cells sharing each node is counted, and the offsets
+ *  are obtained by the prefix sum of the counts. Then, the cell indices are
+ *  scattered into the slots of the nodes. In the multi-threaded build, the
+ *  slots are reserved atomically and the cell indices of each node are
+ *  sorted afterwards, so that the result is identical to the serial build.
+ *  The scattering is done serially when only one thread is available, since
+ *  the atomic operations and the sorting do not pay off in that case.
+ *
+ *  @param  volume [in] pointer to the unstructured volume object
+ *  @param  enable_mthreading [in] if true, the connectivity is built in parallel
+ */
+/*===========================================================================*/
+void NodeToCellConnectivity::build(
+    const kvs::UnstructuredVolumeObject* volume,
+    const bool enable_mthreading )
+{
+    const size_t nnodes = volume->numberOfNodes();
+    const size_t ncells = volume->numberOfCells();
+    const size_t cell_nnodes = volume->numberOfCellNodes();
+    const kvs::UInt32* connections = volume->connections().data();
+
+    m_offsets.allocate( nnodes + 1 );
+    m_offsets.fill( 0 );
+    if ( volume->connections().size() < ncells * cell_nnodes )
+    {
+        m_cells.release();
+        return;
+    }
+
+    // Count the cells sharing each node.
+    kvs::UInt64* offsets = m_offsets.data();
+    const long nincidences = static_cast<long>( ncells * cell_nnodes );
+    KVS_OMP_PARALLEL_FOR( if( enable_mthreading ) schedule(static) )
+    for ( long i = 0; i < nincidences; i++ )
+    {
+        KVS_OMP_ATOMIC
+        offsets[ connections[i] + 1 ]++;
+    }
+
+    for ( size_t i = 0; i < nnodes; i++ ) { offsets[ i + 1 ] += offsets[i]; }
+
+    // Scatter the cell indices.
+    m_cells.allocate( nincidences );
+    kvs::UInt32* cells = m_cells.data();
+    kvs::ValueArray<kvs::UInt64> cursors( offsets, nnodes );
+    if ( enable_mthreading && kvs::OpenMP::GetMaxThreads() > 1 )
+    {
+        const long N = static_cast<long>( ncells );
+        KVS_OMP_PARALLEL_FOR( schedule(static) )
+        for ( long i = 0; i < N; i++ )
+        {
+            const kvs::UInt32* c = connections + i * cell_nnodes;
+            for ( size_t j = 0; j < cell_nnodes; j++ )
+            {
+                kvs::UInt64 slot = 0;
+                KVS_OMP( atomic capture )
+                slot = cursors[ c[j] ]++;
+                cells[ slot ] = static_cast<kvs::UInt32>( i );
+            }
+        }
+
+        // Sort the cell indices of each node.
+        const long M = static_cast<long>( nnodes );
+        KVS_OMP_PARALLEL_FOR( schedule(dynamic,4096) )
+        for ( long i = 0; i < M; i++ )
+        {
+            std::sort( cells + offsets[i], cells + offsets[ i + 1 ] );
+        }
+    }
+    else
+    {
+        for ( size_t i = 0; i < ncells; i++ )
+        {
+            const kvs::UInt32* c = connections + i * cell_nnodes;
+            for ( size_t j = 0; j < cell_nnodes; j++ )
+            {
+                cells[ cursors[ c[j] ]++ ] = static_cast<kvs::UInt32>( i );
+            }
+        }
+    }
+}
+
+} // end of namespace kvs
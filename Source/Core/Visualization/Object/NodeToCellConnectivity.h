@@ -0,0 +1,54 @@
+/*****************************************************************************/
+/**
+ *  @file   NodeToCellConnectivity.h
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#pragma once
+#include <kvs/Type>
+#include <kvs/ValueArray>
+
+
+namespace kvs
+{
+
+class UnstructuredVolumeObject;
+
+/*===========================================================================*/
+/**
+ *  @brief  Node-to-cell connectivity class.
+ *
+ *  The inverse of the connections of the unstructured volume object, which
+ *  gives the cells sharing each node, is stored in the compressed sparse row
+ *  (CSR) format. The indices of the cells sharing the i-th node are stored
+ *  in ascending order in cells()[ offsets()[i] ] to
+ *  cells()[ offsets()[i+1] - 1 ]. The per-node values accumulated from the
+ *  cells can be gathered by each node independently with this connectivity,
+ *  which is suitable for the multi-threaded computation.
+ */
+/*===========================================================================*/
+class NodeToCellConnectivity
+{
+public:
+    using Offsets = kvs::ValueArray<kvs::UInt64>;
+    using Cells = kvs::ValueArray<kvs::UInt32>;
+
+private:
+    Offsets m_offsets{}; ///< offsets to the cell indices for each node
+    Cells m_cells{}; ///< cell indices sorted by the nodes
+
+public:
+    NodeToCellConnectivity() = default;
+    NodeToCellConnectivity( const kvs::UnstructuredVolumeObject* volume, const bool enable_mthreading = false );
+
+    const Offsets& offsets() const { return m_offsets; }
+    const Cells& cells() const { return m_cells; }
+    size_t numberOfNodes() const { return m_offsets.empty() ? 0 : m_offsets.size() - 1; }
+    size_t numberOfCells( const size_t node_index ) const { return m_offsets[ node_index + 1 ] - m_offsets[ node_index ]; }
+    const kvs::UInt32* beginCells( const size_t node_index ) const { return m_cells.data() + m_offsets[ node_index ]; }
+    const kvs::UInt32* endCells( const size_t node_index ) const { return m_cells.data() + m_offsets[ node_index + 1 ]; }
+
+    void build( const kvs::UnstructuredVolumeObject* volume, const bool enable_mthreading = false );
+};
+
+} // end of namespace kvs
@@ -46,13 +46,14 @@ public:
     void deepCopy( const StructuredVolumeObject& object );
     void print( std::ostream& os, const kvs::Indent& indent = kvs::Indent(0) ) const;
     bool read( const std::string& filename );
+    bool read( const std::string& filename, const bool memory_mapping );
     bool write( const std::string& filename, const bool ascii = true, const bool external = false ) const;
 
     void setGridType( GridType grid_type ) { m_grid_type = grid_type; }
     void setGridTypeToUniform() { this->setGridType( Uniform ); }
     void setGridTypeToRectilinear() { this->setGridType( Rectilinear ); }
     void setGridTypeToCurvilinear() { this->setGridType( Curvilinear ); }
-    void setResolution( const kvs::Vec3ui& resolution ) { m_resolution = resolution; }
+    void setResolution( const kvs::Vec3ui& resolution ) { m_resolution = resolution; this->releaseCaches(); }
 
     GridType gridType() const { return m_grid_type; }
     const kvs::Vec3ui& resolution() const { return m_resolution; }
@@ -62,7 +63,6 @@ public:
     size_t numberOfCells() const;
 
     void updateMinMaxCoords();
-    void updateMinMaxValues() const;
 
 public:
     KVS_DEPRECATED( StructuredVolumeObject(
@@ -6,6 +6,14 @@
 /*****************************************************************************/
 #include "StructuredVolumeObjectList.h"
 #include <kvs/StructuredVolumeImporter>
+#include <kvs/OpenMP>
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
 
 
 namespace kvs
@@ -13,6 +21,179 @@ namespace kvs
 
 using ThisClass = StructuredVolumeObjectList;
 
+/*===========================================================================*/
+/**
+ *  @brief  Prefetcher class.
+ *
+ *  The objects are read by the worker threads in the order of the requests.
+ *  Each request of the object at the current step also requests the objects
+ *  of the following steps as lookahead, and the objects out of the window
+ *  of the current and the following steps are discarded, so that the memory
+ *  is bounded by the number of the steps in the window.
+ */
+/*===========================================================================*/
+class ThisClass::Prefetcher
+{
+private:
+    struct Slot
+    {
+        bool ready = false; ///< true if the object has been read
+        Object object{}; ///< read object
+        std::exception_ptr error{}; ///< exception thrown by the importer
+    };
+
+    const FilenameList m_filenames; ///< filename list
+    const Importer m_importer; ///< importer
+    const size_t m_nsteps; ///< number of the prefetch steps
+    std::vector<std::thread> m_workers{}; ///< worker threads
+    std::mutex m_mutex{}; ///< mutex for the queue and the slots
+    std::condition_variable m_condition{}; ///< condition for the queue and the slots
+    std::deque<size_t> m_queue{}; ///< indices of the requested objects
+    std::map<size_t,Slot> m_slots{}; ///< slots of the objects in the window
+    bool m_quit = false; ///< flag to quit the worker threads
+
+public:
+    Prefetcher(
+        const FilenameList& filenames,
+        const Importer& importer,
+        const size_t nsteps,
+        const size_t nthreads );
+    ~Prefetcher();
+
+    Object load( const size_t index );
+
+private:
+    void run();
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new Prefetcher class and starts the worker threads.
+ *  @param  filenames [in] filename list
+ *  @param  importer [in] importer
+ *  @param  nsteps [in] number of the prefetch steps
+ *  @param  nthreads [in] number of the worker threads
+ */
+/*===========================================================================*/
+ThisClass::Prefetcher::Prefetcher(
+    const FilenameList& filenames,
+    const Importer& importer,
+    const size_t nsteps,
+    const size_t nthreads ):
+    m_filenames( filenames ),
+    m_importer( importer ),
+    m_nsteps( nsteps )
+{
+    for ( size_t i = 0; i < kvs::Math::Max( nthreads, size_t(1) ); i++ )
+    {
+        m_workers.emplace_back( [this] { this->run(); } );
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Destroys the Prefetcher class after the worker threads finish.
+ */
+/*===========================================================================*/
+ThisClass::Prefetcher::~Prefetcher()
+{
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_quit = true;
+    }
+    m_condition.notify_all();
+    for ( auto& worker : m_workers ) { worker.join(); }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the object at the step and requests the following steps.
+ *  @param  index [in] index of the objects
+ *  @return loaded object
+ */
+/*===========================================================================*/
+ThisClass::Object ThisClass::Prefetcher::load( const size_t index )
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+
+    // Discard the objects and the requests out of the window.
+    const size_t nfiles = m_filenames.size();
+    const size_t nwindow = kvs::Math::Min( m_nsteps + 1, nfiles );
+    auto outside = [&] ( const size_t i ) { return ( i + nfiles - index ) % nfiles >= nwindow; };
+    for ( auto slot = m_slots.begin(); slot != m_slots.end(); )
+    {
+        if ( outside( slot->first ) ) { slot = m_slots.erase( slot ); }
+        else { ++slot; }
+    }
+    m_queue.erase( std::remove_if( m_queue.begin(), m_queue.end(), outside ), m_queue.end() );
+
+    // Request the objects in the window. The current step is read first.
+    auto current = std::find( m_queue.begin(), m_queue.end(), index );
+    if ( current != m_queue.end() ) { m_queue.erase( current ); m_queue.push_front( index ); }
+    for ( size_t i = 0; i < nwindow; i++ )
+    {
+        const size_t step = ( index + i ) % nfiles;
+        if ( m_slots.find( step ) != m_slots.end() ) { continue; }
+        m_slots[ step ] = Slot();
+        if ( i == 0 ) { m_queue.push_front( step ); }
+        else { m_queue.push_back( step ); }
+    }
+    m_condition.notify_all();
+
+    // Wait for the object at the current step. The exception thrown by the
+    // importer on the worker thread is rethrown here, and the slot is
+    // discarded so that the object is read again by the next request.
+    m_condition.wait( lock, [&] { return m_slots[ index ].ready; } );
+    const std::exception_ptr error = m_slots[ index ].error;
+    if ( error )
+    {
+        m_slots.erase( index );
+        std::rethrow_exception( error );
+    }
+    return m_slots[ index ].object;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the requested objects on the worker thread.
+ */
+/*===========================================================================*/
+void ThisClass::Prefetcher::run()
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    for ( ;; )
+    {
+        m_condition.wait( lock, [&] { return m_quit || !m_queue.empty(); } );
+        if ( m_quit ) { return; }
+
+        const size_t index = m_queue.front();
+        m_queue.pop_front();
+
+        lock.unlock();
+        Object object;
+        std::exception_ptr error;
+        try
+        {
+            object = m_importer( m_filenames[ index ] );
+        }
+        catch ( ... )
+        {
+            error = std::current_exception();
+        }
+        lock.lock();
+
+        // The object discarded during reading is not stored.
+        auto slot = m_slots.find( index );
+        if ( slot != m_slots.end() && !slot->second.ready )
+        {
+            slot->second.object = object;
+            slot->second.error = error;
+            slot->second.ready = true;
+            m_condition.notify_all();
+        }
+    }
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Returns structured volume object imported from the specified file.
@@ -45,23 +226,24 @@ size_t ThisClass::size() const
 /*===========================================================================*/
 void ThisClass::updateMinMaxValues()
 {
-    if ( this->size() > 0 )
+    const size_t nobjects = this->size();
+    if ( nobjects > 0 )
     {
-        auto object = this->load(0);
-        object.updateMinMaxValues();
-
-        auto min_value = object.minValue();
-        auto max_value = object.maxValue();
-        for ( size_t i = 1; i < this->size(); ++i )
+        // The objects are loaded without the prefetcher, and the min/max
+        // values are calculated in parallel if the multi-threading is enabled.
+        std::vector<kvs::Real64> min_values( nobjects );
+        std::vector<kvs::Real64> max_values( nobjects );
+        KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(dynamic) )
+        for ( size_t i = 0; i < nobjects; ++i )
         {
-            object = this->load(i);
+            auto object = i < m_objects.size() ? m_objects[i] : m_importer( m_filenames[i] );
             object.updateMinMaxValues();
-            min_value = kvs::Math::Min( min_value, object.minValue() );
-            max_value = kvs::Math::Max( max_value, object.maxValue() );
+            min_values[i] = object.minValue();
+            max_values[i] = object.maxValue();
         }
 
-        m_min_value = min_value;
-        m_max_value = max_value;
+        m_min_value = *std::min_element( min_values.begin(), min_values.end() );
+        m_max_value = *std::max_element( max_values.begin(), max_values.end() );
     }
 }
 
@@ -88,7 +270,11 @@ void ThisClass::setMinMaxValues( const float min_value, const float max_value )
 ThisClass::Object ThisClass::load( const size_t index ) const
 {
     if ( index < m_objects.size() ) { return m_objects[ index ]; }
-    if ( index < m_filenames.size() ) { return m_importer( m_filenames[ index ] ); }
+    if ( index < m_filenames.size() )
+    {
+        if ( m_prefetcher ) { return m_prefetcher->load( index ); }
+        return m_importer( m_filenames[ index ] );
+    }
     return Object();
 }
 
@@ -108,15 +294,51 @@ bool ThisClass::load()
 
     if ( m_filenames.empty() ) { return false; }
 
-    bool ret = true;
-    for ( auto& filename : m_filenames )
+    // The files are read in parallel if the multi-threading is enabled.
+    const size_t nfiles = m_filenames.size();
+    ObjectList objects( nfiles );
+    std::vector<char> succeeded( nfiles, 1 );
+    KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(dynamic) )
+    for ( size_t i = 0; i < nfiles; ++i )
     {
-        auto object = m_importer( filename );
-        if ( object.values().empty() ) { ret = false; }
-        m_objects.push_back( object );
+        objects[i] = m_importer( m_filenames[i] );
+        if ( objects[i].values().empty() ) { succeeded[i] = 0; }
     }
 
-    return ret;
+    m_objects.swap( objects );
+    return std::find( succeeded.begin(), succeeded.end(), 0 ) == succeeded.end();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Enables the prefetching of the objects in the background.
+ *
+ *  The importer is called on the worker threads, so that the importer must
+ *  be thread-safe if two or more worker threads are used.
+ *
+ *  @param  nsteps [in] number of the steps read ahead of the current step
+ *  @param  nthreads [in] number of the worker threads
+ */
+/*===========================================================================*/
+void ThisClass::enablePrefetching( const size_t nsteps, const size_t nthreads )
+{
+    m_prefetch_steps = nsteps;
+    m_prefetch_threads = kvs::Math::Max( nthreads, size_t(1) );
+    this->update_prefetcher();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Updates the prefetcher for the current filenames and importer.
+ */
+/*===========================================================================*/
+void ThisClass::update_prefetcher()
+{
+    m_prefetcher.reset();
+    if ( m_prefetch_steps > 0 && !m_filenames.empty() )
+    {
+        m_prefetcher.reset( new Prefetcher( m_filenames, m_importer, m_prefetch_steps, m_prefetch_threads ) );
+    }
 }
 
 } // end of namespace kvs
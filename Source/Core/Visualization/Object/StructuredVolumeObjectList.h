@@ -8,6 +8,7 @@
 #include <kvs/ObjectBase>
 #include <kvs/StructuredVolumeObject>
 #include <kvs/Module>
+#include <kvs/SharedPointer>
 #include <vector>
 #include <string>
 #include <functional>
@@ -19,6 +20,15 @@ namespace kvs
 /*===========================================================================*/
 /**
  *  @brief  StructuredVolumeObjectList class.
+ *
+ *  The objects in the time series can be read from the files one by one with
+ *  load(index). If the prefetching is enabled, the objects of the following
+ *  steps are read on the worker threads in the background, so that the
+ *  rendering of the current step overlaps the reading of the next steps.
+ *  The prefetched objects are kept only for the current step and the
+ *  following prefetch steps (wrapped around at the end of the list). The
+ *  exception thrown by the importer on the worker thread is rethrown from
+ *  load(index) of the step.
  */
 /*===========================================================================*/
 class StructuredVolumeObjectList : public kvs::ObjectBase
@@ -40,6 +50,12 @@ private:
     Importer m_importer{ DefaultImporter }; ///< importer
     kvs::Real64 m_min_value = 0.0; ///< min value
     kvs::Real64 m_max_value = 0.0; ///< max value
+    bool m_enable_mthreading = false; ///< flag for multi-threaded loading
+    size_t m_prefetch_steps = 0; ///< number of prefetch steps (0: disabled)
+    size_t m_prefetch_threads = 1; ///< number of prefetch worker threads
+
+    class Prefetcher;
+    kvs::SharedPointer<Prefetcher> m_prefetcher{}; ///< prefetcher of the objects
 
 public:
     StructuredVolumeObjectList() = default;
@@ -54,8 +70,18 @@ public:
     const FilenameList& filenames() const { return m_filenames; }
 
     void setObjects( const ObjectList& objects ) { m_objects = objects; }
-    void setFilenames( const FilenameList& filenames ) { m_filenames = filenames; }
-    void setImporter( Importer importer ) { m_importer = importer; }
+    void setFilenames( const FilenameList& filenames ) { m_filenames = filenames; this->update_prefetcher(); }
+    void setImporter( Importer importer ) { m_importer = importer; this->update_prefetcher(); }
+
+    bool isEnabledMultiThreading() const { return m_enable_mthreading; }
+    void setEnabledMultiThreading( const bool enable ) { m_enable_mthreading = enable; }
+    void enableMultiThreading() { this->setEnabledMultiThreading( true ); }
+    void disableMultiThreading() { this->setEnabledMultiThreading( false ); }
+
+    size_t prefetchSteps() const { return m_prefetch_steps; }
+    size_t prefetchThreads() const { return m_prefetch_threads; }
+    void enablePrefetching( const size_t nsteps = 1, const size_t nthreads = 1 );
+    void disablePrefetching() { m_prefetch_steps = 0; this->update_prefetcher(); }
 
     kvs::Real64 minValue() const { return m_min_value; }
     kvs::Real64 maxValue() const { return m_max_value; }
@@ -65,6 +91,9 @@ public:
     size_t size() const;
     Object load( const size_t index ) const;
     bool load();
+
+private:
+    void update_prefetcher();
 };
 
 } // end of namespace kvs
@@ -6,7 +6,12 @@
 /****************************************************************************/
 #include "UnstructuredVolumeObject.h"
 #include <kvs/KVSMLUnstructuredVolumeObject>
+#include <kvs/CellTree>
+#include <kvs/NodeToCellConnectivity>
 #include <kvs/Range>
+#include <kvs/OpenMP>
+#include <vector>
+#include <cmath>
 
 
 namespace
@@ -78,92 +83,77 @@ kvs::KVSMLUnstructuredVolumeObject::WritingDataType GetWritingDataType( const bo
     }
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns the min/max values of the nodes referred by the cells.
+ *
+ *  The min/max values are calculated in parallel over the chunks of the
+ *  cells. For the vector values, the min/max magnitudes are returned.
+ *
+ *  @param  volume [in] pointer to the unstructured volume object
+ *  @return min/max values
+ */
+/*===========================================================================*/
 template<typename T>
 kvs::Range GetMinMaxValues( const kvs::UnstructuredVolumeObject* volume )
 {
     KVS_ASSERT( volume->values().size() != 0 );
 
     const auto* values = reinterpret_cast<const T*>( volume->values().data() );
+    const auto* connections = volume->connections().data();
     const auto veclen = volume->veclen();
-    if ( volume->connections().empty() )
+    const auto ncells = volume->numberOfCells();
+    const auto cell_nnodes = volume->numberOfCellNodes();
+
+    const size_t chunk_size = 16384;
+    const long nchunks = static_cast<long>( ( ncells + chunk_size - 1 ) / chunk_size );
+    if ( nchunks == 0 ) { return kvs::Range( 0.0, 0.0 ); }
+
+    std::vector<kvs::Real64> mins( nchunks ), maxs( nchunks );
+    KVS_OMP_PARALLEL_FOR( schedule(static) )
+    for ( long chunk = 0; chunk < nchunks; chunk++ )
     {
-        const auto nnodes = volume->numberOfNodes();
+        const size_t begin = chunk * chunk_size * cell_nnodes;
+        const size_t end = kvs::Math::Min( ( chunk + 1 ) * chunk_size, ncells ) * cell_nnodes;
         if ( veclen == 1 )
         {
-            T min_value = *values;
-            T max_value = *values;
-            for ( size_t i = 0; i < nnodes; ++i )
+            T min_value = values[ connections[ begin ] ];
+            T max_value = values[ connections[ begin ] ];
+            for ( size_t i = begin; i < end; ++i )
             {
-                const T value = *values++;
+                const T value = values[ connections[i] ];
                 min_value = kvs::Math::Min( value, min_value );
                 max_value = kvs::Math::Max( value, max_value );
             }
-            return kvs::Range( static_cast<double>( min_value ), static_cast<double>( max_value ) );
+            mins[ chunk ] = static_cast<kvs::Real64>( min_value );
+            maxs[ chunk ] = static_cast<kvs::Real64>( max_value );
         }
         else
         {
             kvs::Real64 min_value = kvs::Value<kvs::Real64>::Max();
             kvs::Real64 max_value = kvs::Value<kvs::Real64>::Min();
-            for ( size_t i = 0; i < nnodes; ++i )
+            for ( size_t i = begin; i < end; ++i )
             {
-                const T* value = values + veclen * i;
+                const T* value = values + veclen * connections[i];
                 kvs::Real64 magnitude = 0.0;
-                for ( size_t j = 0; j < veclen; ++j )
+                for ( size_t k = 0; k < veclen; ++k )
                 {
-                    magnitude += static_cast<kvs::Real64>( ( *value ) * ( *value ) );
-                    ++value;
+                    magnitude += static_cast<kvs::Real64>( value[k] * value[k] );
                 }
                 min_value = kvs::Math::Min( magnitude, min_value );
                 max_value = kvs::Math::Max( magnitude, max_value );
             }
-            return kvs::Range( std::sqrt( min_value ), std::sqrt( max_value ) );
-
+            mins[ chunk ] = std::sqrt( min_value );
+            maxs[ chunk ] = std::sqrt( max_value );
         }
     }
-    else
+
+    kvs::Range range( mins[0], maxs[0] );
+    for ( long chunk = 1; chunk < nchunks; chunk++ )
     {
-        const auto* connections = volume->connections().data();
-        const auto ncells = volume->numberOfCells();
-        const auto cell_nnodes = volume->numberOfCellNodes();
-        if ( veclen == 1 )
-        {
-            T min_value = *values;
-            T max_value = *values;
-            for ( size_t i = 0; i < ncells; ++i )
-            {
-                for ( size_t j = 0; j < cell_nnodes; ++j )
-                {
-                    const auto index = *connections++;
-                    const T value = values[ index ];
-                    min_value = kvs::Math::Min( value, min_value );
-                    max_value = kvs::Math::Max( value, max_value );
-                }
-            }
-            return kvs::Range( static_cast<double>( min_value ), static_cast<double>( max_value ) );
-        }
-        else
-        {
-            kvs::Real64 min_value = kvs::Value<kvs::Real64>::Max();
-            kvs::Real64 max_value = kvs::Value<kvs::Real64>::Min();
-            for ( size_t i = 0; i < ncells; ++i )
-            {
-                for ( size_t j = 0; j < cell_nnodes; ++j )
-                {
-                    const auto index = *connections++;
-                    const T* value = values + veclen * index;
-                    kvs::Real64 magnitude = 0.0;
-                    for ( size_t k = 0; k < veclen; ++k )
-                    {
-                        magnitude += static_cast<kvs::Real64>( ( *value ) * ( *value ) );
-                        ++value;
-                    }
-                    min_value = kvs::Math::Min( magnitude, min_value );
-                    max_value = kvs::Math::Max( magnitude, max_value );
-                }
-            }
-            return kvs::Range( std::sqrt( min_value ), std::sqrt( max_value ) );
-        }
+        range.extend( kvs::Range( mins[ chunk ], maxs[ chunk ] ) );
     }
+    return range;
 }
 
 } // end of namespace
@@ -185,6 +175,8 @@ void UnstructuredVolumeObject::shallowCopy( const UnstructuredVolumeObject& obje
     m_nnodes = object.numberOfNodes();
     m_ncells = object.numberOfCells();
     m_connections = object.connections();
+    m_cell_tree = object.m_cell_tree;
+    m_node_to_cell = object.m_node_to_cell;
 }
 
 /*===========================================================================*/
@@ -200,6 +192,8 @@ void UnstructuredVolumeObject::deepCopy( const UnstructuredVolumeObject& object
     m_nnodes = object.numberOfNodes();
     m_ncells = object.numberOfCells();
     m_connections = object.connections().clone();
+    m_cell_tree.reset();
+    m_node_to_cell.reset();
 }
 
 /*===========================================================================*/
@@ -229,6 +223,19 @@ void UnstructuredVolumeObject::print( std::ostream& os, const kvs::Indent& inden
  */
 /*===========================================================================*/
 bool UnstructuredVolumeObject::read( const std::string& filename )
+{
+    return this->read( filename, false );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Read a unstructured volume object from the specified file in KVSML.
+ *  @param  filename [in] input filename
+ *  @param  memory_mapping [in] if true, the external binary data is mapped into the memory
+ *  @return true, if the reading process is done successfully
+ */
+/*===========================================================================*/
+bool UnstructuredVolumeObject::read( const std::string& filename, const bool memory_mapping )
 {
     if ( !kvs::KVSMLUnstructuredVolumeObject::CheckExtension( filename ) )
     {
@@ -237,6 +244,7 @@ bool UnstructuredVolumeObject::read( const std::string& filename )
     }
 
     kvs::KVSMLUnstructuredVolumeObject kvsml;
+    kvsml.setEnabledMemoryMapping( memory_mapping );
     if ( !kvsml.read( filename ) ) { return false; }
 
     this->setVeclen( kvsml.veclen() );
@@ -388,6 +396,51 @@ size_t UnstructuredVolumeObject::numberOfCellNodes() const
     return ::NumberOfCellNodes[ size_t( m_cell_type ) ];
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns the cell tree of the volume.
+ *
+ *  The cell tree is built at the first call and cached on the volume object,
+ *  so that the cell locators for the same volume share it over the mappers
+ *  and the frames. The cache is released when the coordinates or the cell
+ *  structure of the volume are re-set. Since the tree is not modified after
+ *  it is built, it can be read from the threads simultaneously, but this
+ *  method should be called before the threads are started.
+ *
+ *  @param  enable_mthreading [in] flag for the multi-threaded building
+ *  @return shared pointer to the cell tree
+ */
+/*===========================================================================*/
+const kvs::SharedPointer<kvs::CellTree>& UnstructuredVolumeObject::cellTree( const bool enable_mthreading ) const
+{
+    if ( !m_cell_tree )
+    {
+        m_cell_tree.reset( new kvs::CellTree( this, enable_mthreading ) );
+    }
+    return m_cell_tree;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the node-to-cell connectivity of the volume.
+ *
+ *  The connectivity is built at the first call and cached on the volume
+ *  object in the same way as the cell tree. The cache is released when the
+ *  cell structure of the volume is re-set.
+ *
+ *  @param  enable_mthreading [in] flag for the multi-threaded building
+ *  @return shared pointer to the node-to-cell connectivity
+ */
+/*===========================================================================*/
+const kvs::SharedPointer<kvs::NodeToCellConnectivity>& UnstructuredVolumeObject::nodeToCellConnectivity( const bool enable_mthreading ) const
+{
+    if ( !m_node_to_cell )
+    {
+        m_node_to_cell.reset( new kvs::NodeToCellConnectivity( this, enable_mthreading ) );
+    }
+    return m_node_to_cell;
+}
+
 /*==========================================================================*/
 /**
  *  @brief  Updates the min/max node coordinates.
@@ -466,9 +519,34 @@ void UnstructuredVolumeObject::updateMinMaxCoords()
     }
 }
 
-void UnstructuredVolumeObject::updateMinMaxValues() const
+/*===========================================================================*/
+/**
+ *  @brief  Releases the caches calculated from the volume data.
+ *
+ *  The cell tree is released in addition to the caches of the base class,
+ *  since it depends on the coordinates.
+ */
+/*===========================================================================*/
+void UnstructuredVolumeObject::releaseCaches() const
+{
+    BaseClass::releaseCaches();
+    this->releaseCellTree();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Calculates the value range of the nodes referred by the cells.
+ *  @return min/max values (min/max magnitudes for the vector volume)
+ */
+/*===========================================================================*/
+kvs::Range UnstructuredVolumeObject::calculateValueRange() const
 {
-    kvs::Range range;
+    if ( this->connections().empty() || this->values().size() == 0 )
+    {
+        return BaseClass::calculateValueRange();
+    }
+
+    kvs::Range range( 0.0, 0.0 );
     switch ( this->values().typeID() )
     {
     case kvs::Type::TypeInt8:   { range = ::GetMinMaxValues<kvs::Int8  >( this ); break; }
@@ -484,7 +562,7 @@ void UnstructuredVolumeObject::updateMinMaxValues() const
     default: break;
     }
 
-    this->setMinMaxValues( range.lower(), range.upper() );
+    return range;
 }
 
 std::ostream& operator << ( std::ostream& os, const UnstructuredVolumeObject& object )
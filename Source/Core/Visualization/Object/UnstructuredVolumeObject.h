@@ -9,12 +9,16 @@
 #include <kvs/Module>
 #include <kvs/VolumeObjectBase>
 #include <kvs/Indent>
+#include <kvs/SharedPointer>
 #include <kvs/Deprecated>
 
 
 namespace kvs
 {
 
+class CellTree;
+class NodeToCellConnectivity;
+
 /*==========================================================================*/
 /**
  *  Unstructured volume object class.
@@ -45,6 +49,8 @@ private:
     size_t m_nnodes = 0; ///< Number of nodes.
     size_t m_ncells = 0; ///< Number of cells.
     Connections m_connections{}; ///< Connection ( Node ID ) array.
+    mutable kvs::SharedPointer<kvs::CellTree> m_cell_tree{}; ///< Cell tree for the cell location (built on demand)
+    mutable kvs::SharedPointer<kvs::NodeToCellConnectivity> m_node_to_cell{}; ///< Node-to-cell connectivity (built on demand)
 
 public:
     UnstructuredVolumeObject(): BaseClass( Unstructured ) {}
@@ -54,9 +60,10 @@ public:
     void deepCopy( const UnstructuredVolumeObject& object );
     void print( std::ostream& os, const kvs::Indent& indent = kvs::Indent(0) ) const;
     bool read( const std::string& filename );
+    bool read( const std::string& filename, const bool memory_mapping );
     bool write( const std::string& filename, const bool ascii = true, const bool external = false ) const;
 
-    void setCellType( CellType cell_type ) { m_cell_type = cell_type; }
+    void setCellType( CellType cell_type ) { m_cell_type = cell_type; this->releaseCaches(); this->releaseNodeToCellConnectivity(); }
     void setCellTypeToTetrahedra() { this->setCellType( Tetrahedra ); }
     void setCellTypeToHexahedra() { this->setCellType( Hexahedra ); }
     void setCellTypeToQuadraticTetrahedra() { this->setCellType( QuadraticTetrahedra ); }
@@ -64,9 +71,9 @@ public:
     void setCellTypeToPyramid() { this->setCellType( Pyramid ); }
     void setCellTypeToPoint() { this->setCellType( Point ); }
     void setCellTypeToPrism() { this->setCellType( Prism ); }
-    void setNumberOfNodes( const size_t nnodes ) { m_nnodes = nnodes; }
-    void setNumberOfCells( const size_t ncells ) { m_ncells = ncells; }
-    void setConnections( const Connections& connections ) { m_connections = connections; }
+    void setNumberOfNodes( const size_t nnodes ) { m_nnodes = nnodes; BaseClass::releaseValueCache(); this->releaseNodeToCellConnectivity(); }
+    void setNumberOfCells( const size_t ncells ) { m_ncells = ncells; this->releaseCaches(); this->releaseNodeToCellConnectivity(); }
+    void setConnections( const Connections& connections ) { m_connections = connections; this->releaseCaches(); this->releaseNodeToCellConnectivity(); }
 
     CellType cellType() const { return m_cell_type; }
     size_t numberOfNodes() const { return m_nnodes; }
@@ -74,8 +81,19 @@ public:
     const Connections& connections() const { return m_connections; }
     size_t numberOfCellNodes() const;
 
+    bool hasCellTree() const { return static_cast<bool>( m_cell_tree ); }
+    const kvs::SharedPointer<kvs::CellTree>& cellTree( const bool enable_mthreading = false ) const;
+    void releaseCellTree() const { m_cell_tree.reset(); }
+
+    bool hasNodeToCellConnectivity() const { return static_cast<bool>( m_node_to_cell ); }
+    const kvs::SharedPointer<kvs::NodeToCellConnectivity>& nodeToCellConnectivity( const bool enable_mthreading = false ) const;
+    void releaseNodeToCellConnectivity() const { m_node_to_cell.reset(); }
+
     void updateMinMaxCoords();
-    void updateMinMaxValues() const;
+
+protected:
+    kvs::Range calculateValueRange() const;
+    void releaseCaches() const;
 
 public:
     KVS_DEPRECATED( UnstructuredVolumeObject(
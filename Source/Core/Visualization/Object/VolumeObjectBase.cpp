@@ -5,11 +5,204 @@
  */
 /****************************************************************************/
 #include "VolumeObjectBase.h"
+#include <kvs/MinMaxMacroCells>
+#include <kvs/OpenMP>
+#include <kvs/Type>
+#include <kvs/Mutex>
+#include <kvs/MutexLocker>
+#include <vector>
+#include <cmath>
+
+
+namespace
+{
+
+template <typename T>
+const T* Data( const kvs::AnyValueArray& values )
+{
+    return static_cast<const T*>( values.data() );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the min/max values of the node values.
+ *
+ *  The min/max values are calculated in parallel over the chunks of the
+ *  nodes. For the vector values, the min/max magnitudes are returned.
+ *
+ *  @param  values [in] pointer to the node values
+ *  @param  veclen [in] vector length
+ *  @param  nnodes [in] number of nodes
+ *  @return min/max values
+ */
+/*===========================================================================*/
+template <typename T>
+kvs::Range ValueRange( const T* values, const size_t veclen, const size_t nnodes )
+{
+    const size_t chunk_size = 65536;
+    const long nchunks = static_cast<long>( ( nnodes + chunk_size - 1 ) / chunk_size );
+    if ( nchunks == 0 ) { return kvs::Range(); }
+
+    std::vector<kvs::Real64> mins( nchunks ), maxs( nchunks );
+
+    KVS_OMP_PARALLEL_FOR( schedule(static) )
+    for ( long chunk = 0; chunk < nchunks; chunk++ )
+    {
+        const size_t begin = chunk * chunk_size;
+        const size_t end = kvs::Math::Min( begin + chunk_size, nnodes );
+        if ( veclen == 1 )
+        {
+            T min_value = values[ begin ];
+            T max_value = values[ begin ];
+            for ( size_t i = begin; i < end; i++ )
+            {
+                min_value = kvs::Math::Min( values[i], min_value );
+                max_value = kvs::Math::Max( values[i], max_value );
+            }
+            mins[ chunk ] = static_cast<kvs::Real64>( min_value );
+            maxs[ chunk ] = static_cast<kvs::Real64>( max_value );
+        }
+        else
+        {
+            kvs::Real64 min_value = kvs::Value<kvs::Real64>::Max();
+            kvs::Real64 max_value = kvs::Value<kvs::Real64>::Min();
+            for ( size_t i = begin; i < end; i++ )
+            {
+                const T* value = values + veclen * i;
+                kvs::Real64 magnitude = 0.0;
+                for ( size_t j = 0; j < veclen; j++ )
+                {
+                    magnitude += static_cast<kvs::Real64>( value[j] * value[j] );
+                }
+                min_value = kvs::Math::Min( magnitude, min_value );
+                max_value = kvs::Math::Max( magnitude, max_value );
+            }
+            mins[ chunk ] = std::sqrt( min_value );
+            maxs[ chunk ] = std::sqrt( max_value );
+        }
+    }
+
+    kvs::Range range( mins[0], maxs[0] );
+    for ( long chunk = 1; chunk < nchunks; chunk++ )
+    {
+        range.extend( kvs::Range( mins[ chunk ], maxs[ chunk ] ) );
+    }
+    return range;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the histogram of the node values.
+ *
+ *  The nodes are counted into the thread-local bins in parallel, and the
+ *  local bins are summed up. For the vector values, the magnitudes are
+ *  counted. The values out of the range are counted into the first/last bin.
+ *
+ *  @param  values [in] pointer to the node values
+ *  @param  veclen [in] vector length
+ *  @param  nnodes [in] number of nodes
+ *  @param  nbins [in] number of bins
+ *  @param  min_range [in] value of the first bin
+ *  @param  max_range [in] value of the last bin
+ *  @param  ignore_values [in] values which are not counted
+ *  @return histogram
+ */
+/*===========================================================================*/
+template <typename T>
+kvs::ValueArray<size_t> Histogram(
+    const T* values,
+    const size_t veclen,
+    const size_t nnodes,
+    const size_t nbins,
+    const kvs::Real64 min_range,
+    const kvs::Real64 max_range,
+    const std::list<kvs::Real64>& ignore_values )
+{
+    kvs::ValueArray<size_t> bins( nbins );
+    bins.fill( 0 );
+    if ( nbins == 0 ) { return bins; }
+
+    const std::vector<kvs::Real64> ignores( ignore_values.begin(), ignore_values.end() );
+    const kvs::Real64 width = nbins > 1 ? ( max_range - min_range ) / kvs::Real64( nbins - 1 ) : 0.0;
+    const long n = static_cast<long>( nnodes );
+
+    KVS_OMP_PARALLEL()
+    {
+        std::vector<size_t> local_bins( nbins, 0 );
+
+        KVS_OMP_FOR( schedule(static) )
+        for ( long i = 0; i < n; i++ )
+        {
+            kvs::Real64 value = 0.0;
+            if ( veclen == 1 )
+            {
+                value = static_cast<kvs::Real64>( values[i] );
+            }
+            else
+            {
+                const T* v = values + veclen * i;
+                for ( size_t j = 0; j < veclen; j++ )
+                {
+                    value += kvs::Math::Square( static_cast<kvs::Real64>( v[j] ) );
+                }
+                value = std::sqrt( value );
+            }
+
+            bool ignored = false;
+            for ( size_t j = 0; j < ignores.size() && !ignored; j++ )
+            {
+                ignored = kvs::Math::Equal( value, ignores[j] );
+            }
+            if ( ignored ) { continue; }
+
+            const kvs::Real64 t = width > 0.0 ? ( value - min_range ) / width : 0.0;
+            const size_t index = t > 0.0 ? kvs::Math::Min( static_cast<size_t>( t ), nbins - 1 ) : 0;
+            local_bins[ index ]++;
+        }
+
+        KVS_OMP_CRITICAL()
+        {
+            for ( size_t i = 0; i < nbins; i++ ) { bins[i] += local_bins[i]; }
+        }
+    }
+
+    return bins;
+}
+
+} // end of namespace
 
 
 namespace kvs
 {
 
+/*===========================================================================*/
+/**
+ *  @brief  Cache of the value range and the histograms of the node values.
+ *
+ *  The cache is shared by the shallow copies of the volume object, so that
+ *  the accesses to the cache are serialized by the mutex.
+ */
+/*===========================================================================*/
+class VolumeObjectBase::ValueCache
+{
+public:
+    struct Histogram
+    {
+        size_t nbins; ///< number of bins
+        kvs::Real64 min_range; ///< value of the first bin
+        kvs::Real64 max_range; ///< value of the last bin
+        std::list<kvs::Real64> ignore_values; ///< values which are not counted
+        kvs::ValueArray<size_t> bins; ///< counts of the bins
+    };
+
+    static const size_t MaxHistograms = 4; ///< max. number of the cached histograms
+
+    kvs::Mutex mutex{}; ///< mutex for the cache
+    bool has_range = false; ///< whether the value range has been calculated
+    kvs::Range range{}; ///< value range
+    std::list<Histogram> histograms{}; ///< histograms (recently used first)
+};
+
 /*==========================================================================*/
 /**
  *  @brief  Sets the min/max values.
@@ -26,6 +219,228 @@ void VolumeObjectBase::setMinMaxValues(
     m_has_min_max_values = true;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Updates the min/max values with the value range of the volume.
+ *
+ *  The value range is re-calculated from the current values, since the
+ *  values can be modified in place via values().data(). The cached
+ *  histograms and macro-cells are released as well.
+ */
+/*===========================================================================*/
+void VolumeObjectBase::updateMinMaxValues() const
+{
+    this->releaseMacroCells();
+
+    const kvs::SharedPointer<ValueCache> cache = this->value_cache();
+    kvs::MutexLocker locker( &cache->mutex );
+    cache->range = this->calculateValueRange();
+    cache->has_range = true;
+    cache->histograms.clear();
+    this->setMinMaxValues( cache->range.lower(), cache->range.upper() );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the value range of the volume.
+ *
+ *  The value range is calculated at the first call and cached on the volume
+ *  object, so that the repeated queries, e.g. updateMinMaxValues(), do not
+ *  scan the values again. The cache is released when the values, the veclen
+ *  or the number of the nodes/cells of the volume are re-set.
+ *
+ *  @return min/max values (min/max magnitudes for the vector volume)
+ */
+/*===========================================================================*/
+kvs::Range VolumeObjectBase::valueRange() const
+{
+    const kvs::SharedPointer<ValueCache> cache = this->value_cache();
+    kvs::MutexLocker locker( &cache->mutex );
+    if ( !cache->has_range )
+    {
+        cache->range = this->calculateValueRange();
+        cache->has_range = true;
+    }
+    return cache->range;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the histogram of the node values.
+ *
+ *  The values are counted into the bins of the width of
+ *  ( max_range - min_range ) / ( nbins - 1 ). The histogram is cached on
+ *  the volume object with the specified parameters, in the same way as the
+ *  value range.
+ *
+ *  @param  nbins [in] number of bins
+ *  @param  min_range [in] value of the first bin
+ *  @param  max_range [in] value of the last bin
+ *  @param  ignore_values [in] values which are not counted
+ *  @return counts of the bins
+ */
+/*===========================================================================*/
+kvs::ValueArray<size_t> VolumeObjectBase::histogram(
+    const size_t nbins,
+    const kvs::Real64 min_range,
+    const kvs::Real64 max_range,
+    const std::list<kvs::Real64>& ignore_values ) const
+{
+    const kvs::SharedPointer<ValueCache> cache = this->value_cache();
+    kvs::MutexLocker locker( &cache->mutex );
+    auto& histograms = cache->histograms;
+    for ( auto h = histograms.begin(); h != histograms.end(); ++h )
+    {
+        if ( h->nbins == nbins &&
+             h->min_range == min_range &&
+             h->max_range == max_range &&
+             h->ignore_values == ignore_values )
+        {
+            histograms.splice( histograms.begin(), histograms, h );
+            return histograms.front().bins;
+        }
+    }
+
+    ValueCache::Histogram h{ nbins, min_range, max_range, ignore_values, {} };
+    const size_t nnodes = ( m_values.size() == 0 || m_veclen == 0 ) ? 0 : this->numberOfNodes();
+    switch ( m_values.typeID() )
+    {
+    case kvs::Type::TypeInt8:   { h.bins = ::Histogram( ::Data<kvs::Int8>( m_values ), m_veclen, nnodes, nbins, min_range, max_range, ignore_values ); break; }
+    case kvs::Type::TypeInt16:  { h.bins = ::Histogram( ::Data<kvs::Int16>( m_values ), m_veclen, nnodes, nbins, min_range, max_range, ignore_values ); break; }
+    case kvs::Type::TypeInt32:  { h.bins = ::Histogram( ::Data<kvs::Int32>( m_values ), m_veclen, nnodes, nbins, min_range, max_range, ignore_values ); break; }
+    case kvs::Type::TypeInt64:  { h.bins = ::Histogram( ::Data<kvs::Int64>( m_values ), m_veclen, nnodes, nbins, min_range, max_range, ignore_values ); break; }
+    case kvs::Type::TypeUInt8:  { h.bins = ::Histogram( ::Data<kvs::UInt8>( m_values ), m_veclen, nnodes, nbins, min_range, max_range, ignore_values ); break; }
+    case kvs::Type::TypeUInt16: { h.bins = ::Histogram( ::Data<kvs::UInt16>( m_values ), m_veclen, nnodes, nbins, min_range, max_range, ignore_values ); break; }
+    case kvs::Type::TypeUInt32: { h.bins = ::Histogram( ::Data<kvs::UInt32>( m_values ), m_veclen, nnodes, nbins, min_range, max_range, ignore_values ); break; }
+    case kvs::Type::TypeUInt64: { h.bins = ::Histogram( ::Data<kvs::UInt64>( m_values ), m_veclen, nnodes, nbins, min_range, max_range, ignore_values ); break; }
+    case kvs::Type::TypeReal32: { h.bins = ::Histogram( ::Data<kvs::Real32>( m_values ), m_veclen, nnodes, nbins, min_range, max_range, ignore_values ); break; }
+    case kvs::Type::TypeReal64: { h.bins = ::Histogram( ::Data<kvs::Real64>( m_values ), m_veclen, nnodes, nbins, min_range, max_range, ignore_values ); break; }
+    default: { h.bins.allocate( nbins ); h.bins.fill( 0 ); break; }
+    }
+
+    histograms.push_front( h );
+    if ( histograms.size() > ValueCache::MaxHistograms ) { histograms.pop_back(); }
+    return histograms.front().bins;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Calculates the value range of all of the nodes.
+ *  @return min/max values (min/max magnitudes for the vector volume)
+ */
+/*===========================================================================*/
+kvs::Range VolumeObjectBase::calculateValueRange() const
+{
+    if ( m_values.size() == 0 || m_veclen == 0 ) { return kvs::Range( 0.0, 0.0 ); }
+
+    KVS_ASSERT( m_values.size() == m_veclen * this->numberOfNodes() );
+
+    const size_t nnodes = this->numberOfNodes();
+    switch ( m_values.typeID() )
+    {
+    case kvs::Type::TypeInt8:   return ::ValueRange( ::Data<kvs::Int8>( m_values ), m_veclen, nnodes );
+    case kvs::Type::TypeInt16:  return ::ValueRange( ::Data<kvs::Int16>( m_values ), m_veclen, nnodes );
+    case kvs::Type::TypeInt32:  return ::ValueRange( ::Data<kvs::Int32>( m_values ), m_veclen, nnodes );
+    case kvs::Type::TypeInt64:  return ::ValueRange( ::Data<kvs::Int64>( m_values ), m_veclen, nnodes );
+    case kvs::Type::TypeUInt8:  return ::ValueRange( ::Data<kvs::UInt8>( m_values ), m_veclen, nnodes );
+    case kvs::Type::TypeUInt16: return ::ValueRange( ::Data<kvs::UInt16>( m_values ), m_veclen, nnodes );
+    case kvs::Type::TypeUInt32: return ::ValueRange( ::Data<kvs::UInt32>( m_values ), m_veclen, nnodes );
+    case kvs::Type::TypeUInt64: return ::ValueRange( ::Data<kvs::UInt64>( m_values ), m_veclen, nnodes );
+    case kvs::Type::TypeReal32: return ::ValueRange( ::Data<kvs::Real32>( m_values ), m_veclen, nnodes );
+    case kvs::Type::TypeReal64: return ::ValueRange( ::Data<kvs::Real64>( m_values ), m_veclen, nnodes );
+    default: return kvs::Range( 0.0, 0.0 );
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the min/max macro-cells of the volume.
+ *
+ *  The macro-cells are built at the first call and cached on the volume
+ *  object, so that the repeated isosurface/slice extractions from the same
+ *  volume can share them. The cache is released when the coordinates, the
+ *  values or the cell structure of the volume are re-set.
+ *
+ *  @param  enable_mthreading [in] if true, the macro-cells are built with the multi-threading
+ *  @return min/max macro-cells
+ */
+/*===========================================================================*/
+const kvs::MinMaxMacroCells& VolumeObjectBase::macroCells( const bool enable_mthreading ) const
+{
+    kvs::MutexLocker locker( m_cache_mutex.get() );
+    if ( !m_macro_cells )
+    {
+        m_macro_cells.reset( new kvs::MinMaxMacroCells( this, 0, enable_mthreading ) );
+    }
+    return *m_macro_cells;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns true if the macro-cells have been built.
+ *  @return true, if the macro-cells have been built
+ */
+/*===========================================================================*/
+bool VolumeObjectBase::hasMacroCells() const
+{
+    kvs::MutexLocker locker( m_cache_mutex.get() );
+    return static_cast<bool>( m_macro_cells );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Releases the cached macro-cells.
+ */
+/*===========================================================================*/
+void VolumeObjectBase::releaseMacroCells() const
+{
+    kvs::MutexLocker locker( m_cache_mutex.get() );
+    m_macro_cells.reset();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Releases the cached value range and histograms.
+ */
+/*===========================================================================*/
+void VolumeObjectBase::releaseValueCache() const
+{
+    kvs::MutexLocker locker( m_cache_mutex.get() );
+    m_value_cache.reset();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Releases the caches calculated from the volume data.
+ *
+ *  This is called when the veclen, the coordinates or the values are re-set.
+ *  The derived classes which have their own caches override this method.
+ */
+/*===========================================================================*/
+void VolumeObjectBase::releaseCaches() const
+{
+    this->releaseMacroCells();
+    this->releaseValueCache();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the value cache, which is created at the first call.
+ *
+ *  The cache pointer is created and copied under the lock, so that the
+ *  first calls from the different threads share the same cache, and the
+ *  returned cache is kept alive even if it is released during the use.
+ *
+ *  @return value cache
+ */
+/*===========================================================================*/
+kvs::SharedPointer<VolumeObjectBase::ValueCache> VolumeObjectBase::value_cache() const
+{
+    kvs::MutexLocker locker( m_cache_mutex.get() );
+    if ( !m_value_cache ) { m_value_cache.reset( new ValueCache() ); }
+    return m_value_cache;
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Shallow copys from the specified volume object.
@@ -43,6 +458,18 @@ void VolumeObjectBase::shallowCopy( const VolumeObjectBase& object )
     m_veclen = object.veclen();
     m_coords = object.coords();
     m_values = object.values();
+
+    // The caches are shared with the object.
+    kvs::SharedPointer<kvs::MinMaxMacroCells> macro_cells;
+    kvs::SharedPointer<ValueCache> value_cache;
+    {
+        kvs::MutexLocker locker( object.m_cache_mutex.get() );
+        macro_cells = object.m_macro_cells;
+        value_cache = object.m_value_cache;
+    }
+    kvs::MutexLocker locker( m_cache_mutex.get() );
+    m_macro_cells = macro_cells;
+    m_value_cache = value_cache;
 }
 
 /*===========================================================================*/
@@ -62,6 +489,7 @@ void VolumeObjectBase::deepCopy( const VolumeObjectBase& object )
     m_veclen = object.veclen();
     m_coords = object.coords().clone();
     m_values = object.values().clone();
+    this->releaseCaches();
 }
 
 /*===========================================================================*/
@@ -7,18 +7,24 @@
 #pragma once
 #include <string>
 #include <ostream>
+#include <list>
 #include <kvs/ObjectBase>
 #include <kvs/Value>
 #include <kvs/ValueArray>
 #include <kvs/AnyValueArray>
 #include <kvs/Math>
+#include <kvs/Range>
 #include <kvs/Indent>
 #include <kvs/Deprecated>
+#include <kvs/SharedPointer>
+#include <kvs/Mutex>
 
 
 namespace kvs
 {
 
+class MinMaxMacroCells;
+
 /*==========================================================================*/
 /**
  *  @brief  VolumeObjectBase.
@@ -51,6 +57,10 @@ private:
     mutable bool m_has_min_max_values = false; ///< Whether includes min/max values or not
     mutable kvs::Real64 m_min_value = 0.0; ///< Minimum field value
     mutable kvs::Real64 m_max_value = 0.0; ///< Maximum field value
+    mutable kvs::SharedPointer<kvs::MinMaxMacroCells> m_macro_cells{}; ///< Min/max macro-cells (built on demand)
+    class ValueCache;
+    mutable kvs::SharedPointer<ValueCache> m_value_cache{}; ///< Value range and histograms (calculated on demand)
+    mutable kvs::SharedPointer<kvs::Mutex> m_cache_mutex{ new kvs::Mutex() }; ///< Mutex for creating/releasing the caches
 
 public:
     VolumeObjectBase( const VolumeType type = UnknownVolumeType ):
@@ -64,9 +74,9 @@ public:
 
     void setLabel( const std::string& label ) { m_label = label; }
     void setUnit( const std::string& unit ) { m_unit = unit; }
-    void setVeclen( const size_t veclen ) { m_veclen = veclen; }
-    void setCoords( const Coords& coords ) { m_coords = coords; }
-    void setValues( const Values& values ) { m_values = values; }
+    void setVeclen( const size_t veclen ) { m_veclen = veclen; this->releaseCaches(); }
+    void setCoords( const Coords& coords ) { m_coords = coords; this->releaseCaches(); }
+    void setValues( const Values& values ) { m_values = values; this->releaseCaches(); }
     void setMinMaxValues( const kvs::Real64 min_value, const kvs::Real64 max_value ) const;
 
     const std::string& label() const { return m_label; }
@@ -77,14 +87,29 @@ public:
     bool hasMinMaxValues() const { return m_has_min_max_values; }
     kvs::Real64 minValue() const { return m_min_value; }
     kvs::Real64 maxValue() const { return m_max_value; }
+    bool hasMacroCells() const;
+    const kvs::MinMaxMacroCells& macroCells( const bool enable_mthreading = false ) const;
+    void releaseMacroCells() const;
+    kvs::Range valueRange() const;
+    kvs::ValueArray<size_t> histogram(
+        const size_t nbins,
+        const kvs::Real64 min_range,
+        const kvs::Real64 max_range,
+        const std::list<kvs::Real64>& ignore_values = std::list<kvs::Real64>() ) const;
+    void releaseValueCache() const;
 
     VolumeType volumeType() const { return m_volume_type; }
     virtual size_t numberOfNodes() const = 0;
     virtual size_t numberOfCells() const = 0;
-    virtual void updateMinMaxValues() const {}
+    virtual void updateMinMaxValues() const;
 
 protected:
     void setVolumeType( VolumeType volume_type ) { m_volume_type = volume_type; }
+    virtual kvs::Range calculateValueRange() const;
+    virtual void releaseCaches() const;
+
+private:
+    kvs::SharedPointer<ValueCache> value_cache() const;
 
 public:
     KVS_DEPRECATED( VolumeObjectBase(
@@ -0,0 +1,281 @@
+/****************************************************************************/
+/**
+ *  @file   PipelineCache.cpp
+ *  @author Naohisa Sakamoto
+ */
+/****************************************************************************/
+#include "PipelineCache.h"
+#include <list>
+#include <unordered_map>
+#include <kvs/Mutex>
+#include <kvs/MutexLocker>
+#include <kvs/GeometryObjectBase>
+#include <kvs/PointObject>
+#include <kvs/LineObject>
+#include <kvs/PolygonObject>
+#include <kvs/VolumeObjectBase>
+#include <kvs/UnstructuredVolumeObject>
+#include <kvs/ImageObject>
+#include <kvs/TableObject>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Cache entry.
+ */
+/*===========================================================================*/
+struct Entry
+{
+    std::string key; ///< key of the stage
+    kvs::PipelineCache::ObjectPointer object; ///< cached object
+    size_t size; ///< memory size of the object in bytes
+};
+
+using EntryList = std::list<Entry>;
+
+// Static parameters.
+size_t Budget = size_t(1024) * 1024 * 1024; ///< memory budget in bytes (default: 1GB)
+size_t Usage = 0; ///< total memory size of the cached objects
+EntryList Entries; ///< cached entries in the order of the recent use
+std::unordered_map<std::string,EntryList::iterator> Index; ///< entry index keyed by the stage key
+kvs::Mutex Lock; ///< mutex for the cache
+
+/*===========================================================================*/
+/**
+ *  @brief  Evicts the least recently used entries until the usage fits in the budget.
+ *  @param  budget [in] memory budget in bytes
+ */
+/*===========================================================================*/
+void Evict( const size_t budget )
+{
+    while ( ::Usage > budget && !::Entries.empty() )
+    {
+        const Entry& entry = ::Entries.back();
+        ::Usage -= entry.size;
+        ::Index.erase( entry.key );
+        ::Entries.pop_back();
+    }
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the memory budget of the cache.
+ *  @param  budget [in] memory budget in bytes (0: the objects are not cached)
+ */
+/*===========================================================================*/
+void PipelineCache::SetMemoryBudget( const size_t budget )
+{
+    kvs::MutexLocker locker( &::Lock );
+    ::Budget = budget;
+    ::Evict( ::Budget );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the memory budget of the cache.
+ *  @return memory budget in bytes
+ */
+/*===========================================================================*/
+size_t PipelineCache::MemoryBudget()
+{
+    kvs::MutexLocker locker( &::Lock );
+    return ::Budget;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the total memory size of the cached objects.
+ *  @return memory size in bytes
+ */
+/*===========================================================================*/
+size_t PipelineCache::MemoryUsage()
+{
+    kvs::MutexLocker locker( &::Lock );
+    return ::Usage;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of the cached objects.
+ *  @return number of the cached objects
+ */
+/*===========================================================================*/
+size_t PipelineCache::NumberOfEntries()
+{
+    kvs::MutexLocker locker( &::Lock );
+    return ::Entries.size();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Removes all of the cached objects.
+ */
+/*===========================================================================*/
+void PipelineCache::Clear()
+{
+    kvs::MutexLocker locker( &::Lock );
+    ::Evict( 0 );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Finds the cached object and marks it as the most recently used.
+ *  @param  key [in] key of the stage
+ *  @return pointer to the cached object (null if not found)
+ */
+/*===========================================================================*/
+PipelineCache::ObjectPointer PipelineCache::Find( const std::string& key )
+{
+    kvs::MutexLocker locker( &::Lock );
+    auto found = ::Index.find( key );
+    if ( found == ::Index.end() ) { return ObjectPointer(); }
+
+    ::Entries.splice( ::Entries.begin(), ::Entries, found->second );
+    return found->second->object;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Inserts the object to the cache.
+ *
+ *  If the object with the same key has already been cached, the object is
+ *  replaced. The object larger than the memory budget is not cached.
+ *
+ *  @param  key [in] key of the stage
+ *  @param  object [in] pointer to the object
+ */
+/*===========================================================================*/
+void PipelineCache::Insert( const std::string& key, const ObjectPointer& object )
+{
+    if ( !object ) { return; }
+
+    const size_t size = PipelineCache::ByteSize( object.get() );
+
+    kvs::MutexLocker locker( &::Lock );
+    auto found = ::Index.find( key );
+    if ( found != ::Index.end() )
+    {
+        ::Usage -= found->second->size;
+        ::Entries.erase( found->second );
+        ::Index.erase( found );
+    }
+
+    if ( size > ::Budget ) { return; }
+
+    ::Entries.push_front( Entry{ key, object, size } );
+    ::Index[ key ] = ::Entries.begin();
+    ::Usage += size;
+    ::Evict( ::Budget );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Removes the cached object.
+ *  @param  key [in] key of the stage
+ */
+/*===========================================================================*/
+void PipelineCache::Remove( const std::string& key )
+{
+    kvs::MutexLocker locker( &::Lock );
+    auto found = ::Index.find( key );
+    if ( found == ::Index.end() ) { return; }
+
+    ::Usage -= found->second->size;
+    ::Entries.erase( found->second );
+    ::Index.erase( found );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the estimated memory size of the object.
+ *
+ *  The size is estimated from the data arrays of the object, which occupy
+ *  most of the memory. The arrays shared with other objects are counted in
+ *  each object.
+ *
+ *  @param  object [in] pointer to the object
+ *  @return memory size in bytes
+ */
+/*===========================================================================*/
+size_t PipelineCache::ByteSize( const kvs::ObjectBase* object )
+{
+    if ( !object ) { return 0; }
+
+    size_t size = sizeof( kvs::ObjectBase );
+    switch ( object->objectType() )
+    {
+    case kvs::ObjectBase::Geometry:
+    {
+        const auto* geometry = kvs::GeometryObjectBase::DownCast( object );
+        size += geometry->coords().byteSize();
+        size += geometry->colors().byteSize();
+        size += geometry->normals().byteSize();
+        switch ( geometry->geometryType() )
+        {
+        case kvs::GeometryObjectBase::Point:
+        {
+            const auto* point = kvs::PointObject::DownCast( object );
+            size += point->sizes().byteSize();
+            break;
+        }
+        case kvs::GeometryObjectBase::Line:
+        {
+            const auto* line = kvs::LineObject::DownCast( object );
+            size += line->connections().byteSize();
+            size += line->sizes().byteSize();
+            break;
+        }
+        case kvs::GeometryObjectBase::Polygon:
+        {
+            const auto* polygon = kvs::PolygonObject::DownCast( object );
+            size += polygon->connections().byteSize();
+            size += polygon->opacities().byteSize();
+            break;
+        }
+        default: break;
+        }
+        break;
+    }
+    case kvs::ObjectBase::Volume:
+    {
+        const auto* volume = kvs::VolumeObjectBase::DownCast( object );
+        size += volume->coords().byteSize();
+        size += volume->values().byteSize();
+        if ( volume->volumeType() == kvs::VolumeObjectBase::Unstructured )
+        {
+            const auto* unstructured = kvs::UnstructuredVolumeObject::DownCast( object );
+            size += unstructured->connections().byteSize();
+        }
+        break;
+    }
+    case kvs::ObjectBase::Image:
+    {
+        const auto* image = kvs::ImageObject::DownCast( object );
+        size += image->pixels().byteSize();
+        break;
+    }
+    case kvs::ObjectBase::Table:
+    {
+        const auto* table = kvs::TableObject::DownCast( object );
+        for ( size_t i = 0; i < table->numberOfColumns(); i++ )
+        {
+            size += table->column(i).byteSize();
+        }
+        break;
+    }
+    default: break;
+    }
+
+    return size;
+}
+
+} // end of namespace kvs
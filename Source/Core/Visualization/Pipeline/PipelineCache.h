@@ -0,0 +1,53 @@
+/****************************************************************************/
+/**
+ *  @file   PipelineCache.h
+ *  @author Naohisa Sakamoto
+ *  @brief  Cache of the intermediate objects of the visualization pipelines
+ */
+/****************************************************************************/
+#pragma once
+#include <string>
+#include <kvs/ObjectBase>
+#include <kvs/SharedPointer>
+
+
+namespace kvs
+{
+
+/*==========================================================================*/
+/**
+ *  @brief  Pipeline cache class.
+ *
+ *  The objects imported from the files and the objects output from the
+ *  upstream modules of the visualization pipelines are shared through this
+ *  process-wide cache, so that re-running the pipeline with the same input
+ *  file and the same upstream modules skips the import and the module
+ *  executions. Each object is stored with the key that identifies the
+ *  stage of the pipeline. The total memory size of the cached objects is
+ *  limited by the memory budget, and the least recently used objects are
+ *  evicted from the cache when the budget is exceeded. The evicted object
+ *  is not deleted until the pipelines using the object are destroyed.
+ */
+/*==========================================================================*/
+class PipelineCache
+{
+public:
+    using ObjectPointer = kvs::SharedPointer<kvs::ObjectBase>;
+
+public:
+    static void SetMemoryBudget( const size_t budget );
+    static size_t MemoryBudget();
+    static size_t MemoryUsage();
+    static size_t NumberOfEntries();
+    static void Clear();
+
+    static ObjectPointer Find( const std::string& key );
+    static void Insert( const std::string& key, const ObjectPointer& object );
+    static void Remove( const std::string& key );
+    static size_t ByteSize( const kvs::ObjectBase* object );
+
+private:
+    PipelineCache();
+};
+
+} // end of namespace kvs
@@ -156,6 +156,7 @@ void PipelineModule::shallow_copy( const PipelineModule& module )
     m_counter = module.m_counter;
     m_category = module.m_category;
     m_module = module.m_module;
+    m_cache_key = module.m_cache_key;
     this->ref();
 }
 
@@ -171,6 +172,7 @@ void PipelineModule::deep_copy( const PipelineModule& module )
     this->create_counter();
     m_category = module.m_category;
     m_module = module.m_module;
+    m_cache_key = module.m_cache_key;
 }
 
 /*===========================================================================*/
@@ -6,6 +6,7 @@
 /****************************************************************************/
 #pragma once
 #include <cstring>
+#include <string>
 #include <kvs/FilterBase>
 #include <kvs/MapperBase>
 #include <kvs/ObjectBase>
@@ -50,6 +51,7 @@ protected:
     kvs::ReferenceCounter* m_counter = nullptr;  ///< Reference counter.
     Category m_category = Category::Empty; ///< module category
     Module m_module{}; ///< pointer to the module (SHARED)
+    std::string m_cache_key{}; ///< key of the module parameters for the pipeline cache
 
 public:
     PipelineModule() = default;
@@ -84,6 +86,9 @@ public:
     const char* name() const;
     bool unique() const;
 
+    const std::string& cacheKey() const { return m_cache_key; }
+    void setCacheKey( const std::string& key ) { m_cache_key = key; }
+
 private:
 
     template <typename T>
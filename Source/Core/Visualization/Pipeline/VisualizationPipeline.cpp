@@ -13,6 +13,9 @@
 #include <kvs/LineRenderer>
 #include <kvs/PolygonRenderer>
 #include <kvs/RayCastingRenderer>
+#include <sstream>
+#include <iterator>
+#include <sys/stat.h>
 
 
 // Static parameters.
@@ -39,6 +42,67 @@ void ExitFunction()
     ::context.clear();
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns the cache key of the imported object.
+ *  @param  filename [in] input data filename
+ *  @return key that identifies the file and its modification
+ */
+/*===========================================================================*/
+std::string SourceKey( const std::string& filename )
+{
+    std::ostringstream key;
+    key << kvs::File( filename ).filePath( true );
+
+    struct stat filestat;
+    if ( stat( filename.c_str(), &filestat ) == 0 )
+    {
+        key << ":" << filestat.st_size << ":" << filestat.st_mtime;
+    }
+
+    return key.str();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns true if the output object is the module itself.
+ *  @param  module [in] pipeline module
+ *  @param  object [in] output object of the module
+ *  @return true, if the output object is the module
+ */
+/*===========================================================================*/
+bool IsModuleObject( const kvs::PipelineModule& module, const kvs::ObjectBase* object )
+{
+    switch ( module.category() )
+    {
+    case kvs::PipelineModule::Filter: return dynamic_cast<const kvs::ObjectBase*>( module.filter() ) == object;
+    case kvs::PipelineModule::Mapper: return dynamic_cast<const kvs::ObjectBase*>( module.mapper() ) == object;
+    default: break;
+    }
+
+    return false;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Deleter of the output object of the module shared with the cache.
+ *
+ *  The module is kept alive until the output object is released, since the
+ *  output object is usually the module itself, which is deleted when all of
+ *  the references to the module are released.
+ */
+/*===========================================================================*/
+struct ModuleObjectDeleter
+{
+    kvs::PipelineModule module; ///< pipeline module that outputs the object
+
+    explicit ModuleObjectDeleter( const kvs::PipelineModule& m ): module( m ) {}
+    void operator () ( kvs::ObjectBase* object )
+    {
+        if ( !::IsModuleObject( module, object ) ) { delete object; }
+    }
+};
+
 } // end of namespace
 
 
@@ -125,6 +189,17 @@ bool VisualizationPipeline::import()
             return false;
         }
 
+        // Reuse the object imported by the other pipeline.
+        if ( m_cache )
+        {
+            m_source = kvs::PipelineCache::Find( ::SourceKey( m_filename ) );
+            if ( m_source )
+            {
+                m_object = m_source.get();
+                return true;
+            }
+        }
+
         // Import object.
         kvs::ObjectImporter importer( m_filename );
         kvs::ObjectBase* object = importer.import();
@@ -136,6 +211,7 @@ bool VisualizationPipeline::import()
 
         // Attache the imported object.
         m_object = object;
+        m_imported = true;
     }
 
     return true;
@@ -156,35 +232,90 @@ bool VisualizationPipeline::exec()
         return false;
     }
 
-    const kvs::ObjectBase* object = m_object;
     ModuleList::iterator module = m_module_list.begin();
     ModuleList::iterator last   = m_module_list.end();
 
     // Skip the renderer module since the renderer is executed in the display function.
     if ( this->hasRenderer() ) --last;
 
-    // Execute the filter or the mapper module.
-    while ( module != last )
+    const size_t nstages = static_cast<size_t>( std::distance( module, last ) );
+    const bool caching = m_cache && !m_filename.empty() && nstages > 0;
+
+    // Setup the input object of the first module.
+    const kvs::ObjectBase* object = m_object;
+    if ( m_source )
+    {
+        object = m_source.get();
+    }
+    else if ( caching && m_imported )
+    {
+        m_source = kvs::PipelineCache::ObjectPointer( const_cast<kvs::ObjectBase*>( m_object ) );
+        kvs::PipelineCache::Insert( ::SourceKey( m_filename ), m_source );
+    }
+    m_imported = false;
+
+    if ( nstages == 0 && m_source )
     {
-        object = module->exec( object );
+        // The object registered in the screen cannot be shared with the cache,
+        // so that the object is imported again.
+        kvs::ObjectImporter importer( m_filename );
+        object = importer.import();
         if ( !object )
+        {
+            kvsMessageError() << "Cannot import an object." << std::endl;
+            return false;
+        }
+        m_source.reset();
+    }
+
+    // Execute the filter or the mapper module. The output objects of the
+    // upstream modules are reused if they are found in the cache.
+    std::string key = caching ? ::SourceKey( m_filename ) : "";
+    std::vector<kvs::PipelineCache::ObjectPointer> stages;
+    for ( size_t stage = 0; stage < nstages; ++stage, ++module )
+    {
+        const bool cacheable = !key.empty() && !module->cacheKey().empty() && stage + 1 < nstages;
+        if ( cacheable )
+        {
+            key += std::string(" >> ") + module->name() + "(" + module->cacheKey() + ")";
+            kvs::PipelineCache::ObjectPointer cached = kvs::PipelineCache::Find( key );
+            if ( cached )
+            {
+                object = cached.get();
+                stages.push_back( cached );
+                continue;
+            }
+        }
+        else
+        {
+            key.clear();
+        }
+
+        kvs::ObjectBase* output = module->exec( object );
+        if ( !output )
         {
             kvsMessageError("Cannot execute '%s'.", module->name() );
             return false;
         }
 
-        ++module;
+        if ( cacheable )
+        {
+            kvs::PipelineCache::ObjectPointer shared( output, ::ModuleObjectDeleter( *module ) );
+            kvs::PipelineCache::Insert( key, shared );
+            stages.push_back( shared );
+        }
+
+        object = output;
 
         // Don't delete the last module of the pipeline since the object will be registered
         // and managed in the screen class.
-        if ( module == last )
-        {
-            module--;
-            module->disable_auto_delete();
-            module++;
-        }
+        if ( stage + 1 == nstages ) { module->disable_auto_delete(); }
     }
 
+    // The upstream objects used in the previous execution are released here,
+    // after the objects in the cache are referred by this execution.
+    m_stages.swap( stages );
+
     // Attache the pointer to the object that is registered in the object manager.
     m_object = object;
 
@@ -8,6 +8,7 @@
 #include <iostream>
 #include <string>
 #include <list>
+#include <vector>
 #include <kvs/Indent>
 #include <kvs/ObjectBase>
 #include <kvs/GeometryObjectBase>
@@ -15,6 +16,7 @@
 #include <kvs/RendererBase>
 #include <kvs/Module>
 #include <kvs/PipelineModule>
+#include <kvs/PipelineCache>
 
 
 namespace kvs
@@ -23,6 +25,17 @@ namespace kvs
 /*==========================================================================*/
 /**
  *  Visualization pipeline class.
+ *
+ *  In the cache mode, which is disabled by default and enabled by
+ *  enableCache(), the object imported from the file and the objects output
+ *  from the upstream modules are stored in kvs::PipelineCache and reused by
+ *  re-running the pipeline or by other pipelines with the same input file.
+ *  The output object of the module is identified by the module name and the
+ *  cache key of the module given with kvs::PipelineModule::setCacheKey,
+ *  which should represent the parameters of the module. The module without
+ *  the cache key and the downstream modules are always executed, and the
+ *  last module is always executed since its output object is registered in
+ *  the screen.
  */
 /*==========================================================================*/
 class VisualizationPipeline
@@ -33,8 +46,11 @@ public:
 private:
     size_t m_id = 0; ///< pipeline ID
     std::string m_filename{""}; ///< filename
-    bool m_cache = true; ///< cache mode (DISABLE NOW)
+    bool m_cache = false; ///< cache mode
     ModuleList m_module_list{}; ///< pipeline module list
+    bool m_imported = false; ///< flag whether the object is imported and not shared with the cache
+    kvs::PipelineCache::ObjectPointer m_source{}; ///< imported object shared with the cache
+    std::vector<kvs::PipelineCache::ObjectPointer> m_stages{}; ///< upstream objects shared with the cache
 
     const kvs::ObjectBase* m_object = nullptr; ///< pointer to the object inserted to the manager
     const kvs::RendererBase* m_renderer = nullptr; ///< pointer to the renderer inserted to the manager
@@ -20,7 +20,9 @@
 /*****************************************************************************/
 #include "HAVSVolumeRenderer.h"
 #include <set>
+#include <vector>
 #include <kvs/Coordinate>
+#include <kvs/OpenMP>
 #include <kvs/OpenGL>
 #include <kvs/VertexShader>
 #include <kvs/FragmentShader>
@@ -95,6 +97,122 @@ union FloatOrInt
   unsigned int i;
 };
 
+// Min. number of the faces sorted in parallel.
+const int MinParallelSortSize = 65536;
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the face sorted by the squared distance from the eye.
+ *  @param  eye [in] eye position
+ *  @param  face [in] face ID
+ *  @param  center [in] center of the face
+ *  @return face for the radix sort
+ */
+/*===========================================================================*/
+inline kvs::HAVSVolumeRenderer::SortedFace FaceFromEye(
+    const kvs::HAVSVolumeRenderer::Vertex& eye,
+    const kvs::UInt32 face,
+    const kvs::HAVSVolumeRenderer::Vertex& center )
+{
+    ::FloatOrInt dist2;
+    dist2.f = static_cast<float>( ( eye - center ).norm2() );
+    return kvs::HAVSVolumeRenderer::SortedFace( face, dist2.i );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sorts a byte of the distances in parallel (a pass of the radix sort).
+ *
+ *  The faces are divided into the chunks, and the digits are counted for
+ *  each chunk. Since the offsets are accumulated in the order of the digits
+ *  and then the chunks, the faces are scattered stably as PartialSort.
+ *
+ *  @param  byte [in] byte of the distance
+ *  @param  length [in] number of the faces
+ *  @param  src [in] source faces
+ *  @param  dst [out] destination faces
+ *  @param  nchunks [in] number of the chunks
+ */
+/*===========================================================================*/
+void ParallelPartialSort(
+    int byte,
+    int length,
+    kvs::HAVSVolumeRenderer::SortedFace* src,
+    kvs::HAVSVolumeRenderer::SortedFace* dst,
+    int nchunks )
+{
+    const int shift = byte * 8;
+    const int chunk_size = ( length + nchunks - 1 ) / nchunks;
+    std::vector<int> index( nchunks * 256, 0 );
+
+    KVS_OMP_PARALLEL_FOR( schedule(static) )
+    for ( int c = 0; c < nchunks; c++ )
+    {
+        int* count = &index[ c * 256 ];
+        const int end = kvs::Math::Min( length, ( c + 1 ) * chunk_size );
+        for ( int i = c * chunk_size; i < end; i++ )
+        {
+            count[ ( src[i].distance() >> shift ) & 0xff ]++;
+        }
+    }
+
+    int sum = 0;
+    for ( int i = 0; i < 256; i++ )
+    {
+        for ( int c = 0; c < nchunks; c++ )
+        {
+            const int count = index[ c * 256 + i ];
+            index[ c * 256 + i ] = sum;
+            sum += count;
+        }
+    }
+
+    KVS_OMP_PARALLEL_FOR( schedule(static) )
+    for ( int c = 0; c < nchunks; c++ )
+    {
+        int* offset = &index[ c * 256 ];
+        const int end = kvs::Math::Min( length, ( c + 1 ) * chunk_size );
+        for ( int i = c * chunk_size; i < end; i++ )
+        {
+            dst[ offset[ ( src[i].distance() >> shift ) & 0xff ]++ ] = src[i];
+        }
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sorts the almost sorted faces with the insertion sort.
+ *  @param  array [in/out] faces
+ *  @param  length [in] number of the faces
+ *  @param  max_moves [in] max. number of the moves of the faces
+ *  @param  moves [out] number of the moves of the faces
+ *  @return true, if the faces are sorted within the max. number of the moves
+ */
+/*===========================================================================*/
+bool InsertionSort(
+    kvs::HAVSVolumeRenderer::SortedFace* array,
+    const size_t length,
+    const size_t max_moves,
+    size_t* moves )
+{
+    *moves = 0;
+    for ( size_t i = 1; i < length; i++ )
+    {
+        const kvs::HAVSVolumeRenderer::SortedFace face = array[i];
+        size_t j = i;
+        while ( j > 0 && face < array[ j - 1 ] )
+        {
+            array[j] = array[ j - 1 ];
+            j--;
+        }
+        array[j] = face;
+
+        *moves += i - j;
+        if ( *moves > max_moves ) { return false; }
+    }
+    return true;
+}
+
 } // end of namespace
 
 
@@ -180,6 +298,9 @@ void HAVSVolumeRenderer::initialize()
     m_meshes = NULL;
     m_enable_vbo = true;
     m_pindices = NULL;
+    m_enable_mthreading = false;
+    m_enable_incremental_sorting = false;
+    m_incremental_sorting_threshold = 0.01f;
 }
 
 void HAVSVolumeRenderer::attachVolumeObject( const kvs::UnstructuredVolumeObject* volume )
@@ -255,6 +376,7 @@ void HAVSVolumeRenderer::initialize_table()
     table.setScalarResolution( dim_scalar );
     table.setDepthResolution( dim_depth );
     table.setTransferFunction( BaseClass::transferFunction(), min_value, max_value );
+    table.setEnabledMultiThreading( m_enable_mthreading );
     table.create( max_size_of_cell );
 
     m_preintegration_texture.setWrapS( GL_CLAMP_TO_EDGE );
@@ -367,32 +489,45 @@ void HAVSVolumeRenderer::disable_MRT_rendering()
 
 void HAVSVolumeRenderer::sort_geometry( kvs::Camera* camera, kvs::ObjectBase* object )
 {
+    m_sorting_timer.start();
+
     // Visibility sorting in the object coordinate system.
     const kvs::Vec3 position = kvs::WorldCoordinate( camera->position() ).toObjectCoordinate( object ).position();
     const HAVSVolumeRenderer::Vertex eye( position );
-    m_meshes->sort( eye );
+    m_meshes->setEnabledMultiThreading( m_enable_mthreading );
+    m_meshes->setIncrementalSortingEnabled( m_enable_incremental_sorting );
+    m_meshes->setIncrementalSortingThreshold( m_incremental_sorting_threshold );
+    const bool changed = m_meshes->sort( eye );
 
-    if ( this->isVBOEnabled() )
+    // The index array is updated only if the order of the faces is changed.
+    if ( changed )
     {
-        m_vertex_indices.bind();
-        m_pindices = static_cast<GLuint*>( m_vertex_indices.map( kvs::IndexBufferObject::WriteOnly ) );
-    }
+        if ( this->isVBOEnabled() )
+        {
+            m_vertex_indices.bind();
+            m_pindices = static_cast<GLuint*>( m_vertex_indices.map( kvs::IndexBufferObject::WriteOnly ) );
+        }
 
-    for ( size_t i = 0, index = 0; i < m_meshes->nrenderfaces(); i++ )
-    {
-        for ( size_t j = 0; j < 3; j++, index++ )
+        const long nfaces = static_cast<long>( m_meshes->nrenderfaces() );
+        KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(static) )
+        for ( long i = 0; i < nfaces; i++ )
         {
             const kvs::UInt32 face_index = m_meshes->sortedFace( i );
-            const GLuint vertex_index = static_cast<GLuint>( m_meshes->face( face_index ).index( j ) );
-            m_pindices[ index ] = vertex_index;
+            const HAVSVolumeRenderer::Face& face = m_meshes->face( face_index );
+            for ( size_t j = 0; j < 3; j++ )
+            {
+                m_pindices[ 3 * i + j ] = static_cast<GLuint>( face.index( j ) );
+            }
         }
-    }
 
-    if ( this->isVBOEnabled() )
-    {
-        m_vertex_indices.unmap();
-        m_vertex_indices.unbind();
+        if ( this->isVBOEnabled() )
+        {
+            m_vertex_indices.unmap();
+            m_vertex_indices.unbind();
+        }
     }
+
+    m_sorting_timer.stop();
 }
 
 void HAVSVolumeRenderer::draw_initialization_pass()
@@ -567,7 +702,11 @@ HAVSVolumeRenderer::Meshes::Meshes():
     m_ninternalfaces( 0 ),
     m_nrenderfaces( 0 ),
     m_diagonal( 0.0f ),
-    m_depth_scale( 0.0f )
+    m_depth_scale( 0.0f ),
+    m_enable_mthreading( false ),
+    m_enable_incremental_sorting( false ),
+    m_incremental_sorting_threshold( 0.01f ),
+    m_sorted( false )
 {
     m_bb_min = kvs::Vector3f( 0.0f, 0.0f, 0.0f );
     m_bb_max = kvs::Vector3f( 0.0f, 0.0f, 0.0f );
@@ -735,35 +874,74 @@ void HAVSVolumeRenderer::Meshes::build()
     m_diagonal = static_cast<float>( ( m_bb_max - m_bb_min ).length() );
 }
 
-void HAVSVolumeRenderer::Meshes::sort( HAVSVolumeRenderer::Vertex eye )
+/*===========================================================================*/
+/**
+ *  @brief  Sorts the faces by the distance from the eye.
+ *
+ *  If the incremental sorting is enabled and the eye moves less than the
+ *  threshold (relative to the diagonal length of the bounding box) from
+ *  the previous sorting, the faces are sorted from the order of the previous
+ *  sorting with the insertion sort, since the order barely changes for the
+ *  small movement of the eye. If the faces are not sorted within a quarter
+ *  move per face, they are sorted with the radix sort.
+ *
+ *  @param  eye [in] eye position in the object coordinate system
+ *  @return true, if the order of the faces is changed
+ */
+/*===========================================================================*/
+bool HAVSVolumeRenderer::Meshes::sort( HAVSVolumeRenderer::Vertex eye )
 {
-    HAVSVolumeRenderer::SortedFace sorted_face;
-    ::FloatOrInt dist2;
-    size_t sorted_face_count = 0;
-    size_t i = 0;
+    const float threshold = m_incremental_sorting_threshold * m_diagonal;
+    const float movement = ( eye - m_sorted_eye ).norm2();
+    const bool incremental = m_enable_incremental_sorting && m_sorted && movement <= threshold * threshold;
+    m_sorted = true;
+    m_sorted_eye = eye;
 
-    // Add boundary faces first.
-    for ( i = 0; i < m_nboundaryfaces; i++ )
+    if ( incremental )
     {
-        const size_t f = m_boundary_faces[i];
-        const HAVSVolumeRenderer::Vertex fc = m_centers[f];
-        dist2.f = static_cast<float>(( eye - fc ).norm2());
-        sorted_face = HAVSVolumeRenderer::SortedFace( f, dist2.i );
-        m_sorted_faces[sorted_face_count++] = sorted_face;
-    }
+        // The faces have already been sorted for the same eye position.
+        if ( movement == 0.0f ) { return false; }
+
+        // Update the distances in the order of the previous sorting.
+        const long nrenderfaces = static_cast<long>( m_nrenderfaces );
+        KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(static) )
+        for ( long i = 0; i < nrenderfaces; i++ )
+        {
+            const kvs::UInt32 f = m_sorted_faces[i].face();
+            m_sorted_faces[i] = ::FaceFromEye( eye, f, m_centers[f] );
+        }
 
-    // Add internal faces as determined by LOD budget
-    const size_t internal_count = m_nrenderfaces - m_nboundaryfaces;
-    for ( i = 0; i < internal_count; i++ )
+        // Since the insertion sort is slower than the radix sort for more
+        // than several moves per face, it is given up at a quarter move.
+        size_t moves = 0;
+        if ( ::InsertionSort( m_sorted_faces, m_nrenderfaces, m_nrenderfaces / 4, &moves ) )
+        {
+            return moves > 0;
+        }
+    }
+    else
     {
-        const size_t f = m_internal_faces[i];
-        const HAVSVolumeRenderer::Vertex fc = m_centers[f];
-        dist2.f = static_cast<float>(( eye - fc ).norm2());
-        sorted_face = HAVSVolumeRenderer::SortedFace( f, dist2.i );
-        m_sorted_faces[sorted_face_count++] = sorted_face;
+        // Add boundary faces first.
+        const long nboundaryfaces = static_cast<long>( m_nboundaryfaces );
+        KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(static) )
+        for ( long i = 0; i < nboundaryfaces; i++ )
+        {
+            const kvs::UInt32 f = m_boundary_faces[i];
+            m_sorted_faces[i] = ::FaceFromEye( eye, f, m_centers[f] );
+        }
+
+        // Add internal faces as determined by LOD budget
+        const long internal_count = static_cast<long>( m_nrenderfaces - m_nboundaryfaces );
+        KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(static) )
+        for ( long i = 0; i < internal_count; i++ )
+        {
+            const kvs::UInt32 f = m_internal_faces[i];
+            m_sorted_faces[ m_nboundaryfaces + i ] = ::FaceFromEye( eye, f, m_centers[f] );
+        }
     }
 
     this->radix_sort( m_sorted_faces, m_radix_temp, 0, m_nrenderfaces );
+    return true;
 }
 
 void HAVSVolumeRenderer::Meshes::clean()
@@ -791,6 +969,18 @@ void HAVSVolumeRenderer::Meshes::radix_sort(
     unsigned int u;
 
     SortedFace* uints = array + lo;
+
+    // Parallel sorting.
+    const int nthreads = m_enable_mthreading ? kvs::OpenMP::GetMaxThreads() : 1;
+    if ( nthreads > 1 && length >= ::MinParallelSortSize )
+    {
+        ::ParallelPartialSort( 0, length, uints, temp,  nthreads );
+        ::ParallelPartialSort( 1, length, temp,  uints, nthreads );
+        ::ParallelPartialSort( 2, length, uints, temp,  nthreads );
+        ::ParallelPartialSort( 3, length, temp,  uints, nthreads );
+        return;
+    }
+
     int count[4][256] = {{0}};
 
     // Generate count arrays.
@@ -31,6 +31,7 @@
 #include <kvs/IndexBufferObject>
 #include <kvs/ProgramObject>
 #include <kvs/FrameBufferObject>
+#include <kvs/Timer>
 #include <kvs/Deprecated>
 
 
@@ -74,6 +75,10 @@ private:
     kvs::FrameBufferObject m_mrt_framebuffer; ///< MRT frame buffer object
     kvs::Texture2D m_mrt_texture[4]; ///< MRT textures
     float m_modelview[16]; ///< modelview matrix
+    bool m_enable_mthreading; ///< flag for multi-threading
+    bool m_enable_incremental_sorting; ///< flag for the incremental face sorting
+    float m_incremental_sorting_threshold; ///< max. eye movement for the incremental sorting
+    kvs::Timer m_sorting_timer; ///< timer for the face sorting and the index update
 
 public:
     HAVSVolumeRenderer();
@@ -86,6 +91,19 @@ public:
     size_t kBufferSize() const { return m_k_size; }
     bool isVBOEnabled() const { return m_enable_vbo; }
 
+    bool isEnabledMultiThreading() const { return m_enable_mthreading; }
+    void setEnabledMultiThreading( const bool enable ) { m_enable_mthreading = enable; }
+    void enableMultiThreading() { this->setEnabledMultiThreading( true ); }
+    void disableMultiThreading() { this->setEnabledMultiThreading( false ); }
+
+    bool isIncrementalSortingEnabled() const { return m_enable_incremental_sorting; }
+    void setIncrementalSortingEnabled( const bool enable ) { m_enable_incremental_sorting = enable; }
+    void enableIncrementalSorting() { this->setIncrementalSortingEnabled( true ); }
+    void disableIncrementalSorting() { this->setIncrementalSortingEnabled( false ); }
+    float incrementalSortingThreshold() const { return m_incremental_sorting_threshold; }
+    void setIncrementalSortingThreshold( const float threshold ) { m_incremental_sorting_threshold = threshold; }
+    const kvs::Timer& sortingTimer() const { return m_sorting_timer; }
+
     void exec( kvs::ObjectBase* object, kvs::Camera* camera, kvs::Light* light );
     void initialize();
     void attachVolumeObject( const kvs::UnstructuredVolumeObject* volume );
@@ -318,6 +336,11 @@ private:
     kvs::Vector3f m_bb_min;
     kvs::Vector3f m_bb_max;
     float m_depth_scale;
+    bool m_enable_mthreading;
+    bool m_enable_incremental_sorting;
+    float m_incremental_sorting_threshold;
+    bool m_sorted;
+    Vertex m_sorted_eye;
 
 public:
     Meshes();
@@ -334,11 +357,18 @@ public:
     size_t nrenderfaces() const { return m_nrenderfaces; }
     float depthScale() const { return m_depth_scale; }
     float diagonal() const { return m_diagonal; }
+    bool isEnabledMultiThreading() const { return m_enable_mthreading; }
+    bool isIncrementalSortingEnabled() const { return m_enable_incremental_sorting; }
+    float incrementalSortingThreshold() const { return m_incremental_sorting_threshold; }
+
+    void setEnabledMultiThreading( const bool enable ) { m_enable_mthreading = enable; }
+    void setIncrementalSortingEnabled( const bool enable ) { m_enable_incremental_sorting = enable; }
+    void setIncrementalSortingThreshold( const float threshold ) { m_incremental_sorting_threshold = threshold; }
 
     void setVolume( const kvs::UnstructuredVolumeObject* volume );
     void build();
     void clean();
-    void sort( Vertex eye );
+    bool sort( Vertex eye );
 
 private:
     void radix_sort( SortedFace* array, SortedFace* temp, int lo, int up );
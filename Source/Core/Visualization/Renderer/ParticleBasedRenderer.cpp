@@ -9,6 +9,48 @@
 #include <kvs/PointObject>
 #include <kvs/Camera>
 #include <kvs/Assert>
+#include <kvs/OpenMP>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Projects the point to the window coordinate system.
+ *  @param  v [in] pointer to the coordinate values of the point
+ *  @param  t [in] projection-view-modeling matrix (column major)
+ *  @param  w [in] half width of the window
+ *  @param  h [in] half height of the window
+ *  @param  p_win [out] projected point (x, y and depth)
+ */
+/*===========================================================================*/
+inline void ProjectToWindow(
+    const kvs::Real32* v,
+    const float* t,
+    const size_t w,
+    const size_t h,
+    float* p_win )
+{
+    /* Calculate the projected point position in the window coordinate system.
+     * Ex.) Camera::projectObjectToWindow().
+     */
+    float p_tmp[4] = {
+        v[0]*t[0] + v[1]*t[4] + v[2]*t[ 8] + t[12],
+        v[0]*t[1] + v[1]*t[5] + v[2]*t[ 9] + t[13],
+        v[0]*t[2] + v[1]*t[6] + v[2]*t[10] + t[14],
+        v[0]*t[3] + v[1]*t[7] + v[2]*t[11] + t[15] };
+    p_tmp[3] = 1.0f / p_tmp[3];
+    p_tmp[0] *= p_tmp[3];
+    p_tmp[1] *= p_tmp[3];
+    p_tmp[2] *= p_tmp[3];
+
+    p_win[0] = ( 1.0f + p_tmp[0] ) * w;
+    p_win[1] = ( 1.0f + p_tmp[1] ) * h;
+    p_win[2] = ( 1.0f + p_tmp[2] ) * 0.5f;
+}
+
+} // end of namespace
 
 
 namespace kvs
@@ -23,7 +65,8 @@ ParticleBasedRenderer::ParticleBasedRenderer():
     m_ref_point( NULL ),
     m_enable_rendering( true ),
     m_subpixel_level( 1 ),
-    m_buffer( NULL )
+    m_buffer( NULL ),
+    m_enable_mthreading( false )
 {
     BaseClass::setShader( kvs::Shader::Lambert() );
 }
@@ -41,7 +84,8 @@ ParticleBasedRenderer::ParticleBasedRenderer(
     m_ref_point( NULL ),
     m_enable_rendering( true ),
     m_subpixel_level( 1 ),
-    m_buffer( NULL )
+    m_buffer( NULL ),
+    m_enable_mthreading( false )
 {
     BaseClass::setShader( kvs::Shader::Lambert() );
     this->setSubpixelLevel( subpixel_level );
@@ -191,39 +235,53 @@ void ParticleBasedRenderer::project_particle(
     // Attach the shader and the point object to the point buffer.
     m_buffer->attachShader( &BaseClass::shader() );
     m_buffer->attachPointObject( point );
+    m_buffer->setEnabledMultiThreading( m_enable_mthreading );
 
     // Aliases.
     const size_t nv = point->numberOfVertices();
     const kvs::Real32* v = point->coords().data();
 
-    size_t index3 = 0;
     const size_t bounds_width = BaseClass::windowWidth() - 1;
     const size_t bounds_height = BaseClass::windowHeight() - 1;
-    for ( size_t index = 0; index < nv; index++, index3 += 3 )
+    if ( m_enable_mthreading && kvs::OpenMP::GetMaxThreads() > 1 )
     {
-        /* Calculate the projected point position in the window coordinate system.
-         * Ex.) Camera::projectObjectToWindow().
-         */
-        float p_tmp[4] = {
-            v[index3]*t[0] + v[index3+1]*t[4] + v[index3+2]*t[ 8] + t[12],
-            v[index3]*t[1] + v[index3+1]*t[5] + v[index3+2]*t[ 9] + t[13],
-            v[index3]*t[2] + v[index3+1]*t[6] + v[index3+2]*t[10] + t[14],
-            v[index3]*t[3] + v[index3+1]*t[7] + v[index3+2]*t[11] + t[15] };
-        p_tmp[3] = 1.0f / p_tmp[3];
-        p_tmp[0] *= p_tmp[3];
-        p_tmp[1] *= p_tmp[3];
-        p_tmp[2] *= p_tmp[3];
-
-        const float p_win_x = ( 1.0f + p_tmp[0] ) * w;
-        const float p_win_y = ( 1.0f + p_tmp[1] ) * h;
-        const float depth   = ( 1.0f + p_tmp[2] ) * 0.5f;
-
-        // Store the projected point in the point buffer.
-        if ( ( 0 < p_win_x ) & ( 0 < p_win_y ) )
+        // The points are stored in the buffer concurrently, and the result is
+        // the same as the one stored in serial.
+        m_buffer->beginConcurrentAdd();
+
+        size_t nprojected = 0;
+        const long nvertices = static_cast<long>( nv );
+        KVS_OMP_PARALLEL_FOR( schedule(static) reduction(+:nprojected) )
+        for ( long index = 0; index < nvertices; index++ )
         {
-            if ( ( p_win_x < bounds_width ) & ( p_win_y < bounds_height ) )
+            float p_win[3];
+            ::ProjectToWindow( v + 3 * index, t, w, h, p_win );
+            if ( ( 0 < p_win[0] ) & ( 0 < p_win[1] ) )
+            {
+                if ( ( p_win[0] < bounds_width ) & ( p_win[1] < bounds_height ) )
+                {
+                    m_buffer->addConcurrently( p_win[0], p_win[1], p_win[2], index );
+                    nprojected++;
+                }
+            }
+        }
+
+        m_buffer->endConcurrentAdd( nprojected );
+    }
+    else
+    {
+        for ( size_t index = 0; index < nv; index++ )
+        {
+            float p_win[3];
+            ::ProjectToWindow( v + 3 * index, t, w, h, p_win );
+
+            // Store the projected point in the point buffer.
+            if ( ( 0 < p_win[0] ) & ( 0 < p_win[1] ) )
             {
-                m_buffer->add( p_win_x, p_win_y, depth, index );
+                if ( ( p_win[0] < bounds_width ) & ( p_win[1] < bounds_height ) )
+                {
+                    m_buffer->add( p_win[0], p_win[1], p_win[2], index );
+                }
             }
         }
     }
@@ -37,6 +37,7 @@ protected:
     bool m_enable_rendering; ///< rendering flag
     size_t m_subpixel_level; ///< number of divisions in a pixel
     kvs::ParticleBuffer* m_buffer; ///< particle buffer
+    bool m_enable_mthreading; ///< flag for multi-threading
 
 public:
     ParticleBasedRenderer();
@@ -51,6 +52,11 @@ public:
     void enableRendering() { m_enable_rendering = true; }
     void disableRendering() { m_enable_rendering = false; }
 
+    bool isEnabledMultiThreading() const { return m_enable_mthreading; }
+    void setEnabledMultiThreading( const bool enable ) { m_enable_mthreading = enable; }
+    void enableMultiThreading() { this->setEnabledMultiThreading( true ); }
+    void disableMultiThreading() { this->setEnabledMultiThreading( false ); }
+
 protected:
     bool createParticleBuffer( const size_t width, const size_t height, const size_t subpixel_level );
     void cleanParticleBuffer();
@@ -61,7 +67,7 @@ private:
     void project_particle( const kvs::PointObject* point, const kvs::Camera* camera, const kvs::Light* light );
 
 public:
-    KVS_DEPRECATED( void initialize() ) { m_enable_rendering = true; m_subpixel_level = 1; m_buffer = NULL; }
+    KVS_DEPRECATED( void initialize() ) { m_enable_rendering = true; m_subpixel_level = 1; m_buffer = NULL; m_enable_mthreading = false; }
 };
 
 } // end of namespace kvs
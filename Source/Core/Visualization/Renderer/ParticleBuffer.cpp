@@ -8,6 +8,7 @@
 #include <kvs/Type>
 #include <kvs/Math>
 #include <kvs/PointObject>
+#include <kvs/OpenMP>
 
 
 namespace kvs
@@ -19,6 +20,7 @@ namespace kvs
  */
 /*===========================================================================*/
 ParticleBuffer::ParticleBuffer():
+    m_enable_mthreading( false ),
     m_ref_shader( NULL ),
     m_ref_point_object( NULL )
 {
@@ -38,6 +40,7 @@ ParticleBuffer::ParticleBuffer(
     const size_t height,
     const size_t subpixel_level,
     const size_t device_pixel_ratio ):
+    m_enable_mthreading( false ),
     m_ref_shader( NULL )
 {
     this->create( width, height, subpixel_level, device_pixel_ratio );
@@ -120,6 +123,67 @@ void ParticleBuffer::clear()
 {
     m_index_buffer.release();
     m_depth_buffer.release();
+    std::vector<std::atomic<kvs::UInt64>>().swap( m_packed_buffer );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Begins to add the points with addConcurrently().
+ *
+ *  The packed buffer is initialized with the points stored in the buffer.
+ */
+/*===========================================================================*/
+void ParticleBuffer::beginConcurrentAdd()
+{
+    const size_t size = m_depth_buffer.size();
+    if ( m_packed_buffer.size() != size )
+    {
+        std::vector<std::atomic<kvs::UInt64>>( size ).swap( m_packed_buffer );
+    }
+
+    const kvs::UInt64 empty = ~kvs::UInt64(0);
+    const long nelements = static_cast<long>( size );
+    KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(static) )
+    for ( long i = 0; i < nelements; i++ )
+    {
+        kvs::UInt64 key = empty;
+        if ( m_depth_buffer[i] > 0.0f )
+        {
+            kvs::UInt32 bits = 0;
+            std::memcpy( &bits, &m_depth_buffer[i], sizeof( bits ) );
+            key = ( kvs::UInt64( bits ) << 32 ) | m_index_buffer[i];
+        }
+        m_packed_buffer[i].store( key, std::memory_order_relaxed );
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Ends to add the points with addConcurrently().
+ *
+ *  The points in the packed buffer are unpacked into the depth and index
+ *  buffers.
+ *
+ *  @param  nprojected_particles [in] number of the points added concurrently
+ */
+/*===========================================================================*/
+void ParticleBuffer::endConcurrentAdd( const size_t nprojected_particles )
+{
+    const kvs::UInt64 empty = ~kvs::UInt64(0);
+    const long nelements = static_cast<long>( m_packed_buffer.size() );
+    KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(static) )
+    for ( long i = 0; i < nelements; i++ )
+    {
+        const kvs::UInt64 key = m_packed_buffer[i].load( std::memory_order_relaxed );
+        if ( key != empty )
+        {
+            const kvs::UInt32 bits = static_cast<kvs::UInt32>( key >> 32 );
+            std::memcpy( &m_depth_buffer[i], &bits, sizeof( bits ) );
+            m_index_buffer[i] = static_cast<kvs::UInt32>( key & 0xffffffff );
+        }
+    }
+
+    m_num_of_projected_particles += nprojected_particles;
 }
 
 /*==========================================================================*/
@@ -155,14 +219,18 @@ void ParticleBuffer::create_image_with_shading(
     const float inv_ssize = 1.0f / ( m_subpixel_level * m_subpixel_level );
     const float normalize_alpha = 255.0f * inv_ssize;
 
-    size_t pindex = 0;
-    size_t pindex4 = 0;
+    // The pixel rows are independent of each other.
     const size_t bw = m_extended_width;
     const size_t dpr = m_device_pixel_ratio;
-    for ( size_t py = 0; py < m_height * dpr; py++ )
+    const size_t width = m_width * dpr;
+    const long height = static_cast<long>( m_height * dpr );
+    KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(dynamic) )
+    for ( long py = 0; py < height; py++ )
     {
         const size_t by_start = ( py / dpr ) * m_subpixel_level;
-        for ( size_t px = 0; px < m_width * dpr; px++, pindex++, pindex4 += 4 )
+        size_t pindex = py * width;
+        size_t pindex4 = pindex * 4;
+        for ( size_t px = 0; px < width; px++, pindex++, pindex4 += 4 )
         {
             const size_t bx_start = ( px / dpr ) * m_subpixel_level;
             float R = 0.0f;
@@ -221,14 +289,18 @@ void ParticleBuffer::create_image_without_shading(
     const float inv_ssize = 1.0f / ( m_subpixel_level * m_subpixel_level );
     const float normalize_alpha = 255.0f * inv_ssize;
 
-    size_t pindex = 0;
-    size_t pindex4 = 0;
+    // The pixel rows are independent of each other.
     const size_t bw = m_extended_width;
     const size_t dpr = m_device_pixel_ratio;
-    for ( size_t py = 0; py < m_height * dpr; py++ )
+    const size_t width = m_width * dpr;
+    const long height = static_cast<long>( m_height * dpr );
+    KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(dynamic) )
+    for ( long py = 0; py < height; py++ )
     {
         const size_t by_start = ( py / dpr ) * m_subpixel_level;
-        for ( size_t px = 0; px < m_width * dpr; px++, pindex++, pindex4 += 4 )
+        size_t pindex = py * width;
+        size_t pindex4 = pindex * 4;
+        for ( size_t px = 0; px < width; px++, pindex++, pindex4 += 4 )
         {
             const size_t bx_start = ( px / dpr ) * m_subpixel_level;
             float R = 0.0f;
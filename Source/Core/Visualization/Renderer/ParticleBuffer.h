@@ -5,6 +5,9 @@
  */
 /****************************************************************************/
 #pragma once
+#include <vector>
+#include <atomic>
+#include <cstring>
 #include <kvs/ValueArray>
 #include <kvs/Type>
 #include <kvs/Shader>
@@ -35,6 +38,8 @@ protected:
     size_t m_device_pixel_ratio; ///< device pixel ratio
     kvs::ValueArray<kvs::UInt32> m_index_buffer; ///< index buffer
     kvs::ValueArray<kvs::Real32> m_depth_buffer; ///< depth buffer
+    bool m_enable_mthreading; ///< flag for multi-threading
+    std::vector<std::atomic<kvs::UInt64>> m_packed_buffer; ///< packed depth and index buffer for concurrent add
 
     // Reference shader (NOTE: not allocated in thie class).
     const kvs::Shader::ShadingModel* m_ref_shader;
@@ -62,7 +67,15 @@ public:
     void enableShading() { m_enable_shading = true; }
     void disableShading() { m_enable_shading = false; }
 
+    bool isEnabledMultiThreading() const { return m_enable_mthreading; }
+    void setEnabledMultiThreading( const bool enable ) { m_enable_mthreading = enable; }
+    void enableMultiThreading() { this->setEnabledMultiThreading( true ); }
+    void disableMultiThreading() { this->setEnabledMultiThreading( false ); }
+
     void add( const float x, const float y, const kvs::Real32 depth, const kvs::UInt32 index );
+    void beginConcurrentAdd();
+    void addConcurrently( const float x, const float y, const kvs::Real32 depth, const kvs::UInt32 index );
+    void endConcurrentAdd( const size_t nprojected_particles );
     bool create( const size_t width, const size_t height, const size_t subpixel_level, const size_t device_pixel_ratio = 1.0f );
     void clean();
     void clear();
@@ -119,4 +132,44 @@ inline void ParticleBuffer::add(
     }
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Adds a point to the buffer from the multiple threads.
+ *
+ *  The depth and the voxel index are packed into a 64-bit key, which is
+ *  stored with the atomic minimum operation. Since the bit pattern of the
+ *  positive float value increases with the value, the nearest point wins and
+ *  the smaller voxel index wins on the tie, which is the same result as the
+ *  points added in the order of the index with add(). The points with the
+ *  non-positive depth, which are never drawn, are not stored. This method
+ *  must be called between beginConcurrentAdd() and endConcurrentAdd().
+ *
+ *  @param  x [in] x coordinate value in the buffer
+ *  @param  y [in] y coordinate value in the buffer
+ *  @param  depth [in] depth value
+ *  @param  voxel_index [in] voxel index
+ */
+/*===========================================================================*/
+inline void ParticleBuffer::addConcurrently(
+    const float x,
+    const float y,
+    const kvs::Real32 depth,
+    const kvs::UInt32 voxel_index )
+{
+    if ( !( depth > 0.0f ) ) { return; }
+
+    // Buffer coordinate value.
+    const size_t bx = static_cast<size_t>( x * m_subpixel_level );
+    const size_t by = static_cast<size_t>( y * m_subpixel_level );
+    const size_t index = m_extended_width * by + bx;
+
+    kvs::UInt32 bits = 0;
+    std::memcpy( &bits, &depth, sizeof( bits ) );
+    const kvs::UInt64 key = ( kvs::UInt64( bits ) << 32 ) | voxel_index;
+
+    std::atomic<kvs::UInt64>& packed = m_packed_buffer[index];
+    kvs::UInt64 current = packed.load( std::memory_order_relaxed );
+    while ( key < current && !packed.compare_exchange_weak( current, key, std::memory_order_relaxed ) ) {}
+}
+
 } // end of namespace kvs
@@ -7,6 +7,7 @@
 #include "PreIntegrationTable2D.h"
 #include <kvs/Assert>
 #include <kvs/Math>
+#include <kvs/OpenMP>
 
 
 namespace
@@ -154,11 +155,13 @@ void PreIntegrationTable2D::create()
     kvs::ValueArray<kvs::Real64> T = m_T;
     kvs::ValueArray<kvs::Real64> tau = m_tau;
 
-    const size_t resolution = tau.size();
+    const long resolution = static_cast<long>( tau.size() );
     kvs::ValueArray<kvs::Real32> table( resolution * resolution );
-    for ( size_t i = 0, index = 0; i < resolution; i++ )
+    KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(static) )
+    for ( long i = 0; i < resolution; i++ )
     {
-        for ( size_t j = 0; j < resolution; j++, index++ )
+        size_t index = i * resolution;
+        for ( long j = 0; j < resolution; j++, index++ )
         {
             if ( i == j )
             {
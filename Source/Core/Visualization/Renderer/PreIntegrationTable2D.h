@@ -32,6 +32,7 @@ private:
     kvs::ValueArray<kvs::Real64> m_tau; ///< extinction densities
     kvs::ValueArray<kvs::Real64> m_T; ///< integral of the tau
     kvs::ValueArray<kvs::Real32> m_table; ///< 2D pre-integration table
+    bool m_enable_mthreading = false; ///< flag for multi-threading
 
 public:
 
@@ -43,6 +44,12 @@ public:
     kvs::ValueArray<kvs::Real32> inverseT( const size_t resolution ) const;
 
     void setTransferFunction( const kvs::TransferFunction& transfer_function );
+
+    bool isEnabledMultiThreading() const { return m_enable_mthreading; }
+    void setEnabledMultiThreading( const bool enable ) { m_enable_mthreading = enable; }
+    void enableMultiThreading() { this->setEnabledMultiThreading( true ); }
+    void disableMultiThreading() { this->setEnabledMultiThreading( false ); }
+
     void create();
 };
 
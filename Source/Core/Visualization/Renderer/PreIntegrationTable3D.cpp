@@ -14,6 +14,7 @@
 #include <vector>
 #include <kvs/Math>
 #include <kvs/ValueArray>
+#include <kvs/OpenMP>
 
 
 namespace
@@ -190,6 +191,19 @@ inline kvs::Vec4 OpacityWeightedColor( const kvs::Vec4& color, const float t )
     return kvs::Vec4( color[0] * a, color[1] * a, color[2] * a, a );
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns the front-to-back composition of two colors.
+ *  @param  front [in] opacity-weighted front color
+ *  @param  back [in] opacity-weighted back color
+ *  @return composed color
+ */
+/*===========================================================================*/
+inline kvs::Vec4 Over( const kvs::Vec4& front, const kvs::Vec4& back )
+{
+    return front + back * ( 1.0f - front[3] );
+}
+
 }
 
 
@@ -201,7 +215,8 @@ namespace kvs
  *  @brief  Constructs a new PreIntegrationTable3D class.
  */
 /*===========================================================================*/
-PreIntegrationTable3D::PreIntegrationTable3D()
+PreIntegrationTable3D::PreIntegrationTable3D():
+    m_enable_mthreading( false )
 {
     this->setScalarResolution( 128 );
     this->setDepthResolution( 128 );
@@ -216,7 +231,8 @@ PreIntegrationTable3D::PreIntegrationTable3D()
 /*===========================================================================*/
 PreIntegrationTable3D::PreIntegrationTable3D( const size_t scalar_resolution, const size_t depth_resolution ):
     m_scalar_resolution( scalar_resolution ),
-    m_depth_resolution( depth_resolution )
+    m_depth_resolution( depth_resolution ),
+    m_enable_mthreading( false )
 {
 }
 
@@ -269,6 +285,17 @@ void PreIntegrationTable3D::create( const float max_size_of_cell )
 /*===========================================================================*/
 /**
  *  @brief  Computes 2D pre-integration table by numerical integration.
+ *
+ *  The entry for the scalar pair (sb, sf) is the front-to-back composition
+ *  of the supersampled colors over the d = |sb - sf| segments between them,
+ *  where the opacity correction depends only on d. Since the composition is
+ *  associative, the segments are composed once for each d, and the
+ *  compositions over the d successive segments are obtained by composing a
+ *  suffix and a prefix of the blocks of d segments (sliding window). This
+ *  reduces the cost from O(N^3) to O(N^2) compositions of the segments.
+ *  The entries are computed in parallel for each d, and the table is
+ *  symmetric with respect to sb and sf.
+ *
  *  @param  slice0 [in/out] pointer to the head of the first slice
  *  @param  dl [in] thickness of a slice
  */
@@ -277,45 +304,89 @@ void PreIntegrationTable3D::compute_exact_level( float* slice0, const float dl )
 {
     const size_t N = m_scalar_resolution;
     const kvs::ValueArray<kvs::Real32>& TF = m_transfer_function;
-    for ( size_t sb = 0, index = 0; sb < N; sb++ )
+
+    // Diagonal entries (sb == sf).
+    for ( size_t s = 0; s < N; s++ )
+    {
+        const kvs::Vec4 c = ::OpacityWeightedColor( kvs::Vec4( &TF[4*s] ), dl );
+        const size_t index = s * N + s;
+        slice0[ 4 * index + 0 ] = c[0];
+        slice0[ 4 * index + 1 ] = c[1];
+        slice0[ 4 * index + 2 ] = c[2];
+        slice0[ 4 * index + 3 ] = c[3];
+    }
+
+    if ( N < 2 ) { return; }
+
+    const size_t M = 32; // supersampling factor
+    const float dw = 1.0f / static_cast<float>( M - 1 );
+    const long D = static_cast<long>( N - 1 ); // max. number of segments
+
+    KVS_OMP_PARALLEL( if( m_enable_mthreading ) )
     {
-        for ( size_t sf = 0; sf < N; sf++, index++ )
+        std::vector<kvs::Vec4> colors( N ); // opacity-weighted colors
+        std::vector<kvs::Vec4> segments( N - 1 ); // compositions in the segments
+        std::vector<kvs::Vec4> suffixes( N - 1 ); // suffix compositions in the blocks
+        std::vector<kvs::Vec4> prefixes( N - 1 ); // prefix compositions in the blocks
+
+        KVS_OMP_FOR( schedule(dynamic) )
+        for ( long d = 1; d <= D; d++ )
         {
-            kvs::Vec4 c( 0.0f, 0.0f, 0.0f, 0.0f );
+            const size_t nsegments = N - 1;
+            const size_t width = static_cast<size_t>( d );
 
-            if ( sb == sf )
+            // Opacity correction.
+            const float t = dw * dl / static_cast<float>( d );
+            for ( size_t k = 0; k < N; k++ )
             {
-                const float t = dl;
-                c = ::OpacityWeightedColor( kvs::Vec4( &TF[4*sb] ), t );
+                colors[k] = ::OpacityWeightedColor( kvs::Vec4( &TF[4*k] ), t );
             }
-            else
+
+            // Acutual composition in each segment.
+            for ( size_t k = 0; k < nsegments; k++ )
             {
-                const size_t smin = kvs::Math::Min( sb, sf );
-                const size_t smax = kvs::Math::Max( sb, sf );
+                kvs::Vec4 c( 0.0f, 0.0f, 0.0f, 0.0f );
+                float w = 0.0f;
+                for ( size_t m = 0; m < M; m++, w += dw )
+                {
+                    const kvs::Vec4 ck = ::Interpolate( colors[k], colors[k+1], w );
+                    c = c + ck * ( 1.0f - c[3] );
+                }
+                segments[k] = c;
+            }
 
-                const size_t M = 32; // supersampling factor
-                const float dw = 1.0f / static_cast<float>( M - 1 );
-                const float t = dw * dl / static_cast<float>( smax - smin );
-                for ( size_t k = smin; k < smax; k++ )
+            // Suffix and prefix compositions in the blocks of the d segments.
+            for ( size_t begin = 0; begin < nsegments; begin += width )
+            {
+                const size_t end = kvs::Math::Min( begin + width, nsegments );
+                prefixes[ begin ] = segments[ begin ];
+                for ( size_t k = begin + 1; k < end; k++ )
                 {
-                    // Opacity correction.
-                    const kvs::Vec4 c0 = ::OpacityWeightedColor( kvs::Vec4( &TF[4*k] ), t );
-                    const kvs::Vec4 c1 = ::OpacityWeightedColor( kvs::Vec4( &TF[4*(k+1)] ), t );
-
-                    // Acutual composition.
-                    float w = 0.0f;
-                    for ( size_t m = 0; m < M; m++, w += dw )
-                    {
-                        const kvs::Vec4 ck = ::Interpolate( c0, c1, w );
-                        c = c + ck * ( 1.0f - c[3] );
-                    }
+                    prefixes[k] = ::Over( prefixes[ k - 1 ], segments[k] );
+                }
+                suffixes[ end - 1 ] = segments[ end - 1 ];
+                for ( size_t k = end - 1; k > begin; k-- )
+                {
+                    suffixes[ k - 1 ] = ::Over( segments[ k - 1 ], suffixes[k] );
                 }
             }
 
-            slice0[ 4 * index + 0 ] = c[0];
-            slice0[ 4 * index + 1 ] = c[1];
-            slice0[ 4 * index + 2 ] = c[2];
-            slice0[ 4 * index + 3 ] = c[3];
+            // Composition over the segments [smin, smax).
+            for ( size_t smin = 0; smin + width <= nsegments; smin++ )
+            {
+                const size_t smax = smin + width;
+                const kvs::Vec4 c = ( smin % width == 0 ) ?
+                    suffixes[ smin ] :
+                    ::Over( suffixes[ smin ], prefixes[ smax - 1 ] );
+
+                const size_t index0 = smin * N + smax;
+                const size_t index1 = smax * N + smin;
+                for ( size_t e = 0; e < 4; e++ )
+                {
+                    slice0[ 4 * index0 + e ] = c[e];
+                    slice0[ 4 * index1 + e ] = c[e];
+                }
+            }
         }
     }
 }
@@ -337,16 +408,18 @@ void PreIntegrationTable3D::compute_incremental_level(
     const float l,
     const float dl )
 {
-    const size_t N = m_scalar_resolution;
-    for ( size_t i = 0, index = 0; i < N; i++ )
+    const long N = static_cast<long>( m_scalar_resolution );
+    KVS_OMP_PARALLEL_FOR( if( m_enable_mthreading ) schedule(static) )
+    for ( long i = 0; i < N; i++ )
     {
-        for ( size_t j = 0; j < N; j++, index++ )
+        size_t index = i * N;
+        for ( long j = 0; j < N; j++, index++ )
         {
             const float sf = ( 2.0f * j + 1.0f ) / ( 2.0f * N );
             const float sb = ( 2.0f * i + 1.0f ) / ( 2.0f * N );
             const float sp = ( ( l - dl ) * sf + ( dl * sb ) ) / l;
 
-            const size_t k = static_cast<size_t>( sp * N - 0.5f );
+            const long k = static_cast<long>( sp * N - 0.5f );
             const float w = sp * N - ( k + 0.5f );
 
             kvs::Vec4 c; // current color
@@ -34,6 +34,7 @@ private:
     kvs::ValueArray<kvs::Real32> m_table; ///< 3D pre-integration table
     size_t m_scalar_resolution; ///< resolution of the scalar axis
     size_t m_depth_resolution; ///< resolution of the depth axis
+    bool m_enable_mthreading; ///< flag for multi-threading
 
 public:
 
@@ -43,12 +44,18 @@ public:
     size_t scalarResolution() const { return m_scalar_resolution; }
     size_t depthResolution() const { return m_depth_resolution; }
     const kvs::Vector3ui resolution() const { return kvs::Vector3ui( m_scalar_resolution, m_scalar_resolution, m_depth_resolution); }
+    const kvs::ValueArray<kvs::Real32>& transferFunction() const { return m_transfer_function; }
     const kvs::ValueArray<kvs::Real32>& table() const { return m_table; }
 
     void setScalarResolution( const size_t scalar_resolution ) { m_scalar_resolution = scalar_resolution; }
     void setDepthResolution( const size_t depth_resolution ) { m_depth_resolution = depth_resolution; }
     void setTransferFunction( const kvs::TransferFunction& transfer_function, const float min_scalar, const float max_scalar );
 
+    bool isEnabledMultiThreading() const { return m_enable_mthreading; }
+    void setEnabledMultiThreading( const bool enable ) { m_enable_mthreading = enable; }
+    void enableMultiThreading() { this->setEnabledMultiThreading( true ); }
+    void disableMultiThreading() { this->setEnabledMultiThreading( false ); }
+
     void create( const float max_size_of_cell );
 
 private:
@@ -6,6 +6,7 @@
 /****************************************************************************/
 #include "RayCastingRenderer.h"
 #include <cstring>
+#include <limits>
 #include <kvs/Math>
 #include <kvs/Type>
 #include <kvs/Message>
@@ -13,6 +14,59 @@
 #include <kvs/TrilinearInterpolator>
 #include <kvs/VolumeRayIntersector>
 #include <kvs/OpenGL>
+#include <kvs/OpenMP>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the index of the macro-cell including the sampling point.
+ *  @param  point [in] sampling point in the index space of the volume
+ *  @param  resolution [in] resolution of the volume
+ *  @param  cells [in] macro-cells of the volume
+ *  @return index of the macro-cell
+ */
+/*===========================================================================*/
+inline size_t MacroCellIndex(
+    const kvs::Vec3& point,
+    const kvs::Vec3ui& resolution,
+    const kvs::MinMaxMacroCells& cells )
+{
+    // The cell is selected in the same manner as the trilinear interpolator.
+    const size_t bs = cells.blockSize();
+    const size_t i = kvs::Math::Min( static_cast<size_t>( point.x() ), size_t( resolution.x() - 2 ) );
+    const size_t j = kvs::Math::Min( static_cast<size_t>( point.y() ), size_t( resolution.y() - 2 ) );
+    const size_t k = kvs::Math::Min( static_cast<size_t>( point.z() ), size_t( resolution.z() - 2 ) );
+    return cells.blockIndex( i / bs, j / bs, k / bs );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the ray parameter where the ray exits from the macro-cell.
+ *  @param  ray [in] ray
+ *  @param  min_coord [in] min. coord of the macro-cell
+ *  @param  max_coord [in] max. coord of the macro-cell
+ *  @return ray parameter at the exit point
+ */
+/*===========================================================================*/
+inline float ExitParameter(
+    const kvs::Ray& ray,
+    const kvs::Vec3& min_coord,
+    const kvs::Vec3& max_coord )
+{
+    float t_exit = std::numeric_limits<float>::max();
+    for ( int i = 0; i < 3; i++ )
+    {
+        const float d = ray.direction()[i];
+        if ( d > 0.0f ) { t_exit = kvs::Math::Min( t_exit, ( max_coord[i] - ray.from()[i] ) / d ); }
+        else if ( d < 0.0f ) { t_exit = kvs::Math::Min( t_exit, ( min_coord[i] - ray.from()[i] ) / d ); }
+    }
+    return t_exit;
+}
+
+} // end of namespace
 
 
 namespace kvs
@@ -130,6 +184,74 @@ void RayCastingRenderer::exec(
     BaseClass::stopTimer();
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Updates the visibility flags of the macro-cells for skipping.
+ *
+ *  A macro-cell is transparent if the opacity map is zero over the range of
+ *  the table entries referred by the values between the min. and max. values
+ *  of the macro-cell. The range is extended by one entry on each side to
+ *  absorb the rounding errors of the interpolated values. The flags are
+ *  recalculated only if the opacity map or the volume is changed.
+ *
+ *  @param  volume [in] pointer to the volume object
+ *  @return true, if the empty-space skipping is available
+ */
+/*===========================================================================*/
+bool RayCastingRenderer::update_occupancy( const kvs::StructuredVolumeObject* volume )
+{
+    if ( volume->veclen() != 1 ) { return false; }
+
+    const auto& cells = volume->macroCells( m_enable_mthreading );
+    if ( !cells.hasValues() || cells.blockSize() == 0 ) { return false; }
+
+    const auto& omap = BaseClass::transferFunction().opacityMap();
+    const size_t resolution = omap.resolution();
+    if ( resolution < 2 || omap.table().size() != resolution ) { return false; }
+
+    // The macro-cells held by this renderer keep the arrays of the previous
+    // macro-cells alive, so that the new macro-cells never share the address.
+    const bool changed =
+        m_macro_cells.minValues().data() != cells.minValues().data() ||
+        m_opacity_map.minValue() != omap.minValue() ||
+        m_opacity_map.maxValue() != omap.maxValue() ||
+        m_opacity_map.table() != omap.table();
+    if ( !changed ) { return true; }
+
+    m_macro_cells = cells;
+    m_opacity_map = kvs::OpacityMap( omap.table().clone(), omap.minValue(), omap.maxValue() );
+
+    // Table index in the same manner as kvs::OpacityMap::at.
+    const float min_value = omap.minValue();
+    const float max_value = omap.maxValue();
+    const float r = static_cast<float>( resolution - 1 );
+    auto index = [&]( const double value )
+    {
+        const float v0 = kvs::Math::Clamp( static_cast<float>( value ), min_value, max_value );
+        return static_cast<size_t>( ( v0 - min_value ) / ( max_value - min_value ) * r );
+    };
+
+    const auto* const table = omap.table().data();
+    const size_t nblocks = cells.numberOfBlocks();
+    m_occupancy.allocate( nblocks );
+    for ( size_t i = 0; i < nblocks; i++ )
+    {
+        const size_t s0 = index( cells.minValue(i) );
+        const size_t s1 = index( cells.maxValue(i) );
+        const size_t first = s0 > 0 ? s0 - 1 : 0;
+        const size_t last = kvs::Math::Min( s1 + 2, resolution - 1 );
+
+        kvs::UInt8 visible = 0;
+        for ( size_t s = first; s <= last && !visible; s++ )
+        {
+            if ( table[s] != 0.0f ) { visible = 1; }
+        }
+        m_occupancy[i] = visible;
+    }
+
+    return true;
+}
+
 /*==========================================================================*/
 /**
  *  @brief  Rasterization.
@@ -169,94 +291,147 @@ void RayCastingRenderer::rasterize(
         memcpy( m_modelview, modelview, sizeof( modelview ) );
     }
 
-    // Set the trilinear interpolator.
-    kvs::TrilinearInterpolator interpolator( volume );
-
     // Calculate the ray in the object coordinate system.
     float modelview[16]; kvs::OpenGL::GetModelViewMatrix( static_cast<GLfloat*>( modelview ) );
     float projection[16]; kvs::OpenGL::GetProjectionMatrix( static_cast<GLfloat*>( projection ) );
     int viewport[4]; kvs::OpenGL::GetViewport( static_cast<GLint*>( viewport ) );
-    kvs::VolumeRayIntersector ray( volume, modelview, projection, viewport );
+    const kvs::VolumeRayIntersector intersector( volume, modelview, projection, viewport );
 
-    // Execute ray casting.
+    // Execute ray casting. The framebuffer is divided into the tiles of
+    // tile_size x tile_size rays, which are scheduled dynamically on the
+    // threads if the multi-threading is enabled. Since each ray is cast
+    // independently, the image is identical to the one by a single thread.
     const size_t width = BaseClass::framebufferWidth();
     const size_t height = BaseClass::framebufferHeight();
+    const size_t tile_size = 32 * ray_width;
+    const size_t ntiles_x = ( width + tile_size - 1 ) / tile_size;
+    const size_t ntiles_y = ( height + tile_size - 1 ) / tile_size;
+    const size_t ntiles = ntiles_x * ntiles_y;
     const auto& shader = BaseClass::shader();
     const auto& cmap = BaseClass::transferFunction().colorMap();
     const auto& omap = BaseClass::transferFunction().opacityMap();
     const float step = m_step;
     const float opaque = m_opaque;
-    size_t depth_index = 0;
-    size_t pixel_index = 0;
-    for ( size_t y = 0; y < height; y += ray_width )
+
+    // Empty-space skipping with the macro-cells. The samples in a transparent
+    // macro-cell are skipped up to the last one before the exit point of the
+    // macro-cell, where the depth test is applied. Since the depth increases
+    // along the ray, the test is equivalent to the one at every sample.
+    const bool skipping = m_enable_skipping && this->update_occupancy( volume );
+    const kvs::Vec3ui resolution = volume->resolution();
+    const auto& cells = m_macro_cells;
+    const auto* const occupancy = m_occupancy.data();
+    const float margin = 0.01f;
+    KVS_OMP_PARALLEL( if( m_enable_mthreading ) )
     {
-        const size_t offset = y * width;
-        for ( size_t x = 0; x < width; x += ray_width, depth_index = offset + x, pixel_index = depth_index * 4 )
-        {
-            ray.setOrigin( x, y );
+        // Each thread has the interpolator and the ray.
+        kvs::TrilinearInterpolator interpolator( volume );
+        kvs::VolumeRayIntersector ray( intersector );
 
-            // Intersection the ray with the bounding box.
-            if ( ray.isIntersected() )
+        KVS_OMP_FOR( schedule(dynamic) )
+        for ( size_t tile = 0; tile < ntiles; tile++ )
+        {
+            const size_t x0 = ( tile % ntiles_x ) * tile_size;
+            const size_t y0 = ( tile / ntiles_x ) * tile_size;
+            const size_t x1 = kvs::Math::Min( x0 + tile_size, width );
+            const size_t y1 = kvs::Math::Min( y0 + tile_size, height );
+            for ( size_t y = y0; y < y1; y += ray_width )
             {
-                float r = 0.0f;
-                float g = 0.0f;
-                float b = 0.0f;
-                float a = 0.0f;
-
-                const float depth0 = depth_data[ depth_index ];
-                depth_data[ depth_index ] = ray.depth();
-
-                do
+                for ( size_t x = x0; x < x1; x += ray_width )
                 {
-                    // Interpolation.
-                    interpolator.attachPoint( ray.point() );
+                    const size_t depth_index = y * width + x;
+                    const size_t pixel_index = depth_index * 4;
+                    ray.setOrigin( x, y );
 
-                    // Classification.
-                    const float s = interpolator.template scalar<T>();
-                    const float opacity = omap.at(s);
-                    if ( !kvs::Math::IsZero( opacity ) )
+                    // Intersection the ray with the bounding box.
+                    if ( ray.isIntersected() )
                     {
-                        // Shading.
-                        const auto vertex = ray.point();
-                        const auto normal = interpolator.template gradient<T>();
-                        const auto color = shader.shadedColor( cmap.at(s), vertex, normal );
-
-                        // Front-to-back accumulation.
-                        const float current_alpha = ( 1.0f - a ) * opacity;
-                        r += current_alpha * color.r();
-                        g += current_alpha * color.g();
-                        b += current_alpha * color.b();
-                        a += current_alpha;
-                        if ( a > opaque )
+                        float r = 0.0f;
+                        float g = 0.0f;
+                        float b = 0.0f;
+                        float a = 0.0f;
+
+                        const float depth0 = depth_data[ depth_index ];
+                        depth_data[ depth_index ] = ray.depth();
+                        float t_visible = 0.0f;
+
+                        do
                         {
-                            a = 1.0f;
-                            break;
-                        }
+                            // The macro-cell is looked up only when the ray
+                            // leaves the visible macro-cell found last.
+                            bool transparent = false;
+                            if ( skipping && ray.t() >= t_visible )
+                            {
+                                const size_t block = ::MacroCellIndex( ray.point(), resolution, cells );
+                                const float t_exit = ::ExitParameter( ray, cells.minCoord( block ), cells.maxCoord( block ) ) - margin;
+                                if ( occupancy[ block ] ) { t_visible = t_exit; }
+                                else
+                                {
+                                    // Skip the samples in the transparent macro-cell.
+                                    while ( ray.t() + step < t_exit )
+                                    {
+                                        const float t = ray.t();
+                                        ray.step( step );
+                                        if ( !ray.isInside() ) { ray.setT( t ); break; }
+                                    }
+                                    transparent = true;
+                                }
+                            }
+
+                            if ( !transparent )
+                            {
+                                // Interpolation.
+                                interpolator.attachPoint( ray.point() );
+
+                                // Classification.
+                                const float s = interpolator.template scalar<T>();
+                                const float opacity = omap.at(s);
+                                if ( !kvs::Math::IsZero( opacity ) )
+                                {
+                                    // Shading.
+                                    const auto vertex = ray.point();
+                                    const auto normal = interpolator.template gradient<T>();
+                                    const auto color = shader.shadedColor( cmap.at(s), vertex, normal );
+
+                                    // Front-to-back accumulation.
+                                    const float current_alpha = ( 1.0f - a ) * opacity;
+                                    r += current_alpha * color.r();
+                                    g += current_alpha * color.g();
+                                    b += current_alpha * color.b();
+                                    a += current_alpha;
+                                    if ( a > opaque )
+                                    {
+                                        a = 1.0f;
+                                        break;
+                                    }
+                                }
+                            }
+
+                            const float depth = ray.depth();
+                            if ( depth > depth0 )
+                            {
+                                const float current_alpha = 1.0f - a;
+                                r += current_alpha * pixel_data[ pixel_index ];
+                                g += current_alpha * pixel_data[ pixel_index + 1 ];
+                                b += current_alpha * pixel_data[ pixel_index + 2 ];
+                                a = 1.0f;
+                                break;
+                            }
+
+                            ray.step( step );
+                        } while ( ray.isInside() );
+
+                        // Set pixel value.
+                        pixel_data[ pixel_index + 0 ] = static_cast<kvs::UInt8>( kvs::Math::Min( r, 255.0f ) + 0.5f );
+                        pixel_data[ pixel_index + 1 ] = static_cast<kvs::UInt8>( kvs::Math::Min( g, 255.0f ) + 0.5f );
+                        pixel_data[ pixel_index + 2 ] = static_cast<kvs::UInt8>( kvs::Math::Min( b, 255.0f ) + 0.5f );
+                        pixel_data[ pixel_index + 3 ] = static_cast<kvs::UInt8>( kvs::Math::Round( a * 255.0f ) );
                     }
-
-                    const float depth = ray.depth();
-                    if ( depth > depth0 )
+                    else
                     {
-                        const float current_alpha = 1.0f - a;
-                        r += current_alpha * pixel_data[ pixel_index ];
-                        g += current_alpha * pixel_data[ pixel_index + 1 ];
-                        b += current_alpha * pixel_data[ pixel_index + 2 ];
-                        a = 1.0f;
-                        break;
+                        depth_data[ depth_index ] = 1.0;
                     }
-
-                    ray.step( step );
-                } while ( ray.isInside() );
-
-                // Set pixel value.
-                pixel_data[ pixel_index + 0 ] = static_cast<kvs::UInt8>( kvs::Math::Min( r, 255.0f ) + 0.5f );
-                pixel_data[ pixel_index + 1 ] = static_cast<kvs::UInt8>( kvs::Math::Min( g, 255.0f ) + 0.5f );
-                pixel_data[ pixel_index + 2 ] = static_cast<kvs::UInt8>( kvs::Math::Min( b, 255.0f ) + 0.5f );
-                pixel_data[ pixel_index + 3 ] = static_cast<kvs::UInt8>( kvs::Math::Round( a * 255.0f ) );
-            }
-            else
-            {
-                depth_data[ depth_index ] = 1.0;
+                }
             }
         }
     }
@@ -264,19 +439,20 @@ void RayCastingRenderer::rasterize(
     // Mosaicing by using ray_width x ray_width mask.
     if ( ray_width > 1 )
     {
-        pixel_index = 0;
-        depth_index = 0;
         for ( size_t y = 0; y < height; y += ray_width )
         {
             // Shift the y position of the mask by -ray_width/2.
             const size_t Y = kvs::Math::Max( int( y - ray_width / 2 ), 0 );
 
             const size_t offset = y * width;
-            for ( size_t x = 0; x < width; x += ray_width, depth_index = offset + x, pixel_index = depth_index * 4 )
+            for ( size_t x = 0; x < width; x += ray_width )
             {
                 // Shift the x position of the mask by -ray_width/2.
                 const size_t X = kvs::Math::Max( int( x - ray_width / 2 ), 0 );
 
+                const size_t depth_index = offset + x;
+                const size_t pixel_index = depth_index * 4;
+
                 const auto r = pixel_data[ pixel_index ];
                 const auto g = pixel_data[ pixel_index + 1 ];
                 const auto b = pixel_data[ pixel_index + 2 ];
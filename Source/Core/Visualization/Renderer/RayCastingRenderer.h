@@ -8,6 +8,9 @@
 #include <kvs/VolumeRendererBase>
 #include <kvs/TransferFunction>
 #include <kvs/StructuredVolumeObject>
+#include <kvs/MinMaxMacroCells>
+#include <kvs/OpacityMap>
+#include <kvs/ValueArray>
 #include <kvs/Module>
 #include <kvs/Deprecated>
 
@@ -18,6 +21,13 @@ namespace kvs
 /*==========================================================================*/
 /**
  *  Ray casting volume renderer.
+ *
+ *  If the empty-space skipping is enabled, the rays leap over the macro-cells
+ *  of the volume where the opacity is zero for any value between the min.
+ *  and max. values of the macro-cell. The visibility of the macro-cells is
+ *  updated only when the opacity map or the volume is changed. Since only
+ *  the samples of zero opacity are skipped, the rendered image is identical
+ *  to the one without skipping.
  */
 /*==========================================================================*/
 class RayCastingRenderer : public kvs::VolumeRendererBase
@@ -30,6 +40,11 @@ private:
     float m_opaque = 0.97f; ///< opaque value for early ray termination
     size_t m_ray_width = 1; ///< ray width
     bool m_enable_lod = false; ///< enable LOD rendering
+    bool m_enable_mthreading = false; ///< flag for multi-threaded ray casting
+    bool m_enable_skipping = true; ///< flag for empty-space skipping
+    kvs::MinMaxMacroCells m_macro_cells{}; ///< macro-cells of the volume used for skipping
+    kvs::OpacityMap m_opacity_map{}; ///< opacity map used for skipping
+    kvs::ValueArray<kvs::UInt8> m_occupancy{}; ///< visibility flag of each macro-cell (0: transparent)
     float m_modelview[16] = {0}; ///< modelview matrix
 
 public:
@@ -43,8 +58,17 @@ public:
     void setOpaqueValue( const float opaque ) { m_opaque = opaque; }
     void enableLODControl( const size_t ray_width = 3 ) { m_enable_lod = true; m_ray_width = ray_width; }
     void disableLODControl() { m_enable_lod = false; m_ray_width = 1; }
+    bool isEnabledMultiThreading() const { return m_enable_mthreading; }
+    void setEnabledMultiThreading( const bool enable ) { m_enable_mthreading = enable; }
+    void enableMultiThreading() { this->setEnabledMultiThreading( true ); }
+    void disableMultiThreading() { this->setEnabledMultiThreading( false ); }
+    bool isEmptySpaceSkippingEnabled() const { return m_enable_skipping; }
+    void setEmptySpaceSkippingEnabled( const bool enable ) { m_enable_skipping = enable; }
+    void enableEmptySpaceSkipping() { this->setEmptySpaceSkippingEnabled( true ); }
+    void disableEmptySpaceSkipping() { this->setEmptySpaceSkippingEnabled( false ); }
 
 private:
+    bool update_occupancy( const kvs::StructuredVolumeObject* volume );
     template <typename T>
     void rasterize(
         const kvs::StructuredVolumeObject* volume,
@@ -24,6 +24,8 @@
 #include <kvs/TetrahedralCell>
 #include <kvs/ProjectedTetrahedraTable>
 #include <kvs/PreIntegrationTable2D>
+#include <kvs/NodeToCellConnectivity>
+#include <kvs/OpenMP>
 
 
 namespace
@@ -114,6 +116,14 @@ kvs::ValueArray<kvs::Real32> NormalizedValues(
 /*===========================================================================*/
 /**
  *  @brief  Returns normal vector array for type of value array of the input volume.
+ *
+ *  The normal vector of each node is the average of the negative gradients
+ *  of the cells sharing the node. The gradients are calculated for each cell
+ *  in parallel and gathered to each node through the node-to-cell
+ *  connectivity of the volume, so that each node is written by only one
+ *  thread. The cells are gathered in ascending order, which gives the same
+ *  result as the accumulation over the cells.
+ *
  *  @param  volume [in] pointer to the volume object
  */
 /*===========================================================================*/
@@ -122,47 +132,42 @@ kvs::ValueArray<kvs::Real32> VertexNormalsForType(
 {
     const size_t nnodes = volume->numberOfNodes();
     const size_t ncells = volume->numberOfCells();
-    kvs::TetrahedralCell cell( volume );
-    kvs::ValueArray<kvs::Int32> counter( nnodes );
-    kvs::ValueArray<kvs::Real32> normals( nnodes * 3 );
-    counter.fill(0);
-    normals.fill(0);
-    for ( size_t i = 0; i < ncells; i++ )
+
+    // Negative gradient vectors of the cells.
+    kvs::ValueArray<kvs::Real32> gradients( ncells * 3 );
+    KVS_OMP_PARALLEL()
     {
-        cell.bindCell( i );
-        const kvs::Vec3 g = -cell.gradientVector();
-        const kvs::UInt32 index0 = volume->connections()[ 4 * i + 0 ];
-        const kvs::UInt32 index1 = volume->connections()[ 4 * i + 1 ];
-        const kvs::UInt32 index2 = volume->connections()[ 4 * i + 2 ];
-        const kvs::UInt32 index3 = volume->connections()[ 4 * i + 3 ];
-
-        counter[ index0 ]++;
-        counter[ index1 ]++;
-        counter[ index2 ]++;
-        counter[ index3 ]++;
-
-        normals[ 3 * index0 + 0 ] += g.x();
-        normals[ 3 * index0 + 1 ] += g.y();
-        normals[ 3 * index0 + 2 ] += g.z();
-
-        normals[ 3 * index1 + 0 ] += g.x();
-        normals[ 3 * index1 + 1 ] += g.y();
-        normals[ 3 * index1 + 2 ] += g.z();
-
-        normals[ 3 * index2 + 0 ] += g.x();
-        normals[ 3 * index2 + 1 ] += g.y();
-        normals[ 3 * index2 + 2 ] += g.z();
-
-        normals[ 3 * index3 + 0 ] += g.x();
-        normals[ 3 * index3 + 1 ] += g.y();
-        normals[ 3 * index3 + 2 ] += g.z();
+        kvs::TetrahedralCell cell( volume );
+        const long N = static_cast<long>( ncells );
+        KVS_OMP_FOR( schedule(static) )
+        for ( long i = 0; i < N; i++ )
+        {
+            cell.bindCell( i );
+            const kvs::Vec3 g = -cell.gradientVector();
+            gradients[ 3 * i + 0 ] = g.x();
+            gradients[ 3 * i + 1 ] = g.y();
+            gradients[ 3 * i + 2 ] = g.z();
+        }
     }
 
-    for ( size_t i = 0; i < nnodes; i++ )
+    // Averaged normal vectors of the nodes.
+    const auto& connectivity = volume->nodeToCellConnectivity( true );
+    kvs::ValueArray<kvs::Real32> normals( nnodes * 3 );
+    const long N = static_cast<long>( nnodes );
+    KVS_OMP_PARALLEL_FOR( schedule(static) )
+    for ( long i = 0; i < N; i++ )
     {
-        const kvs::Real32 c = static_cast<kvs::Real32>( counter[i] );
-        const kvs::Vec3 v( normals.data() + 3 * i );
-        const kvs::Vec3 n = ( v / c ).normalized();
+        kvs::Real32 v[3] = { 0.0f, 0.0f, 0.0f };
+        const kvs::UInt32* end = connectivity->endCells(i);
+        for ( const kvs::UInt32* c = connectivity->beginCells(i); c != end; c++ )
+        {
+            v[0] += gradients[ 3 * *c + 0 ];
+            v[1] += gradients[ 3 * *c + 1 ];
+            v[2] += gradients[ 3 * *c + 2 ];
+        }
+
+        const kvs::Real32 c = static_cast<kvs::Real32>( connectivity->numberOfCells(i) );
+        const kvs::Vec3 n = ( kvs::Vec3( v ) / c ).normalized();
         normals[ 3 * i + 0 ] = n.x();
         normals[ 3 * i + 1 ] = n.y();
         normals[ 3 * i + 2 ] = n.z();
@@ -242,6 +247,17 @@ void StochasticTetrahedraRenderer::setEdgeFactor( const float factor )
     static_cast<Engine&>( engine() ).setEdgeFactor( factor );
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Sets the flag for the multi-threaded creation of the pre-integration table.
+ *  @param  enable [in] if true, the table is created with the multi-threading
+ */
+/*===========================================================================*/
+void StochasticTetrahedraRenderer::setEnabledMultiThreading( const bool enable )
+{
+    static_cast<Engine&>( engine() ).setEnabledMultiThreading( enable );
+}
+
 const kvs::TransferFunction& StochasticTetrahedraRenderer::transferFunction() const
 {
     return static_cast<const Engine&>( engine() ).transferFunction();
@@ -252,6 +268,11 @@ float StochasticTetrahedraRenderer::samplingStep() const
     return static_cast<const Engine&>( engine() ).samplingStep();
 }
 
+bool StochasticTetrahedraRenderer::isEnabledMultiThreading() const
+{
+    return static_cast<const Engine&>( engine() ).isEnabledMultiThreading();
+}
+
 void StochasticTetrahedraRenderer::setVertexShaderFile( const std::string& file )
 {
     static_cast<Engine&>( engine() ).setVertexShaderFile( file );
@@ -306,6 +327,7 @@ void StochasticTetrahedraRenderer::Engine::PreIntegrationBuffer::create(
 {
     kvs::PreIntegrationTable2D table;
     table.setTransferFunction( tfunc );
+    table.setEnabledMultiThreading( m_enable_mthreading );
     table.create();
 
     auto T = table.T();
@@ -45,8 +45,12 @@ public:
     void setTransferFunction( const kvs::TransferFunction& transfer_function );
     void setSamplingStep( const float sampling_step );
     void setEdgeFactor( const float factor );
+    void setEnabledMultiThreading( const bool enable );
+    void enableMultiThreading() { this->setEnabledMultiThreading( true ); }
+    void disableMultiThreading() { this->setEnabledMultiThreading( false ); }
     const kvs::TransferFunction& transferFunction() const;
     float samplingStep() const;
+    bool isEnabledMultiThreading() const;
     void setVertexShaderFile( const std::string& file );
     void setGeometryShaderFile( const std::string& file );
     void setFragmentShaderFile( const std::string& file );
@@ -81,9 +85,12 @@ public:
         kvs::Texture1D m_T_texture{}; ///< T function for pre-integration
         kvs::Texture1D m_T_inv_texture{}; ///< inverse function of T for pre-integration
         kvs::Real32 m_T_max = 0.0f; ///< maximum value of T
+        bool m_enable_mthreading = false; ///< flag for the multi-threading of the table creation
     public:
         PreIntegrationBuffer() = default;
         virtual ~PreIntegrationBuffer() { this->release(); }
+        bool isEnabledMultiThreading() const { return m_enable_mthreading; }
+        void setEnabledMultiThreading( const bool enable ) { m_enable_mthreading = enable; }
         const kvs::Texture2D& texture() const { return m_texture; }
         const kvs::Texture1D& T() const { return m_T_texture; }
         const kvs::Texture1D& Tinverse() const { return m_T_inv_texture; }
@@ -178,6 +185,7 @@ public:
     void draw( kvs::ObjectBase* object, kvs::Camera* camera, kvs::Light* light );
 
     void setEdgeFactor( const float factor ) { m_edge_factor = factor; }
+    void setEnabledMultiThreading( const bool enable ) { m_preintegration_buffer.setEnabledMultiThreading( enable ); }
     void setSamplingStep( const float step ) { m_render_pass.setSamplingStep( step ); }
     void setTransferFunction( const kvs::TransferFunction& transfer_function )
     {
@@ -186,6 +194,7 @@ public:
     }
 
     float samplingStep() const { return m_render_pass.samplingStep(); }
+    bool isEnabledMultiThreading() const { return m_preintegration_buffer.isEnabledMultiThreading(); }
     const kvs::TransferFunction& transferFunction() const { return m_transfer_function; }
 
     const std::string& vertexShaderFile() const { return m_render_pass.vertexShaderFile(); }
@@ -166,6 +166,32 @@ av::VideoFrame Demuxer::retrieve()
         av::VideoFrame();
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Retrieve current rescaled frame into the specified frame.
+ *
+ *  The frame is allocated only if it has not been allocated with the size of
+ *  the rescaled frame, so that the frame can be reused for each retrieval.
+ *
+ *  @param  frame [in/out] rescaled frame
+ *  @return true if the frame is retrieved successfully
+ */
+/*===========================================================================*/
+bool Demuxer::retrieve( av::VideoFrame& frame )
+{
+    if ( !m_current_frame.isValid() ) { return false; }
+
+    const auto width = m_rescaler.dstWidth();
+    const auto height = m_rescaler.dstHeight();
+    if ( !frame.isValid() || frame.width() != width || frame.height() != height )
+    {
+        frame = av::VideoFrame( m_rescaler.dstPixelFormat(), width, height );
+    }
+
+    m_rescaler.rescale( frame, m_current_frame, m_error );
+    return !m_error;
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Find video stream from the format context.
@@ -73,6 +73,7 @@ public:
     void close();
     bool grab();
     av::VideoFrame retrieve();
+    bool retrieve( av::VideoFrame& frame );
 
 private:
     bool find_stream();
@@ -5,6 +5,11 @@
  */
 /*****************************************************************************/
 #include "MovieObject.h"
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <kvs/Math>
 
 
 namespace kvs
@@ -13,6 +18,190 @@ namespace kvs
 namespace ffmpeg
 {
 
+/*===========================================================================*/
+/**
+ *  @brief  Background decoder class.
+ *
+ *  The frames are decoded by the worker thread into the free slots of the
+ *  ring buffer. The buffer of the taken frame is exchanged with the buffer
+ *  of the current frame, and the allocation is reused for the next decoding
+ *  unless the buffer is still referenced. Each seek request discards the
+ *  decoded frames and the frame being decoded before the request.
+ */
+/*===========================================================================*/
+class MovieObject::Decoder
+{
+private:
+    struct Slot
+    {
+        Buffer buffer{}; ///< RGB buffer of the frame
+        kvs::Int64 index = -1; ///< frame index
+    };
+
+    kvs::ffmpeg::Demuxer& m_demuxer; ///< demuxer (reference)
+    std::thread m_worker{}; ///< worker thread
+    mutable std::mutex m_mutex{}; ///< mutex for the ring buffer
+    std::condition_variable m_condition{}; ///< condition for the ring buffer
+    std::vector<Slot> m_slots; ///< ring buffer of the decoded frames
+    size_t m_head = 0; ///< slot of the oldest decoded frame
+    size_t m_count = 0; ///< number of the decoded frames in the ring buffer
+    size_t m_generation = 0; ///< number of the seek requests
+    kvs::Int64 m_seek_index = -1; ///< requested frame index to seek (-1: not requested)
+    bool m_end = false; ///< true if the decoding reached the end of the stream
+    bool m_quit = false; ///< flag to quit the worker thread
+    size_t m_ndecoded_frames = 0; ///< number of the decoded frames
+    size_t m_ndropped_frames = 0; ///< number of the frames discarded by seeking
+    size_t m_nmissed_frames = 0; ///< number of the grabs without decoded frame
+
+public:
+    Decoder( kvs::ffmpeg::Demuxer& demuxer, const size_t nframes );
+    ~Decoder();
+
+    size_t numberOfDecodedFrames() const { std::lock_guard<std::mutex> lock( m_mutex ); return m_ndecoded_frames; }
+    size_t numberOfDroppedFrames() const { std::lock_guard<std::mutex> lock( m_mutex ); return m_ndropped_frames; }
+    size_t numberOfMissedFrames() const { std::lock_guard<std::mutex> lock( m_mutex ); return m_nmissed_frames; }
+
+    bool pop( Buffer* buffer, kvs::Int64* index, const bool wait );
+    void seek( const kvs::Int64 index );
+
+private:
+    void run();
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new Decoder class and starts the worker thread.
+ *  @param  demuxer [in] demuxer
+ *  @param  nframes [in] number of frames in the ring buffer
+ */
+/*===========================================================================*/
+MovieObject::Decoder::Decoder( kvs::ffmpeg::Demuxer& demuxer, const size_t nframes ):
+    m_demuxer( demuxer ),
+    m_slots( kvs::Math::Max( nframes, size_t(1) ) )
+{
+    m_worker = std::thread( [this] { this->run(); } );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Destroys the Decoder class after the worker thread finishes.
+ */
+/*===========================================================================*/
+MovieObject::Decoder::~Decoder()
+{
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_quit = true;
+    }
+    m_condition.notify_all();
+    m_worker.join();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Takes the oldest decoded frame from the ring buffer.
+ *  @param  buffer [in/out] buffer exchanged with the buffer of the frame
+ *  @param  index [out] frame index
+ *  @param  wait [in] if true, waits for the decoding of the frame
+ *  @return true if the frame is taken
+ */
+/*===========================================================================*/
+bool MovieObject::Decoder::pop( Buffer* buffer, kvs::Int64* index, const bool wait )
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    if ( wait ) { m_condition.wait( lock, [&] { return m_count > 0 || m_end; } ); }
+    if ( m_count == 0 )
+    {
+        if ( !m_end ) { m_nmissed_frames++; }
+        return false;
+    }
+
+    Slot& slot = m_slots[ m_head ];
+    std::swap( *buffer, slot.buffer );
+    *index = slot.index;
+    m_head = ( m_head + 1 ) % m_slots.size();
+    m_count--;
+    m_condition.notify_all();
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Requests to seek the frame and discards the decoded frames.
+ *  @param  index [in] frame index
+ */
+/*===========================================================================*/
+void MovieObject::Decoder::seek( const kvs::Int64 index )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_ndropped_frames += m_count;
+    m_count = 0;
+    m_generation++;
+    m_seek_index = index;
+    m_end = false;
+    m_condition.notify_all();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Decodes the frames on the worker thread.
+ */
+/*===========================================================================*/
+void MovieObject::Decoder::run()
+{
+    av::VideoFrame frame; // rescaled frame reused for each decoding
+    Buffer buffer;
+
+    std::unique_lock<std::mutex> lock( m_mutex );
+    for ( ;; )
+    {
+        m_condition.wait( lock, [&] {
+            return m_quit || m_seek_index >= 0 || ( !m_end && m_count < m_slots.size() ); } );
+        if ( m_quit ) { return; }
+
+        const size_t generation = m_generation;
+        const kvs::Int64 seek_index = m_seek_index;
+        m_seek_index = -1;
+
+        // The buffer of the free slot is decoded outside the lock.
+        std::swap( buffer, m_slots[ ( m_head + m_count ) % m_slots.size() ].buffer );
+        lock.unlock();
+
+        if ( seek_index >= 0 ) { m_demuxer.seek( int64_t( seek_index ) ); }
+        bool valid = m_demuxer.grab() && m_demuxer.retrieve( frame );
+        if ( valid )
+        {
+            std::error_code error;
+            const size_t size = frame.bufferSize( 1, error );
+            if ( buffer.size() != size || !buffer.sharedPointer().unique() ) { buffer.allocate( size ); }
+            valid = !error && frame.copyToBuffer( buffer.data(), size, 1, error );
+        }
+        const kvs::Int64 index = m_demuxer.currentFrameIndex();
+
+        lock.lock();
+        if ( generation != m_generation )
+        {
+            // The frame was requested before the seek request.
+            if ( valid ) { m_ndropped_frames++; }
+            continue;
+        }
+
+        if ( !valid )
+        {
+            m_end = true;
+            m_condition.notify_all();
+            continue;
+        }
+
+        Slot& slot = m_slots[ ( m_head + m_count ) % m_slots.size() ];
+        std::swap( buffer, slot.buffer );
+        slot.index = index;
+        m_count++;
+        m_ndecoded_frames++;
+        m_condition.notify_all();
+    }
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Return the current frame as a kvs::ColorImage.
@@ -40,9 +229,50 @@ bool MovieObject::jumpToFrame( const size_t index )
 {
     if ( this->currentFrameIndex() == kvs::Int64(index) ) { return true; }
     this->seekToFrame( index );
+    if ( m_decoder )
+    {
+        // The frame at the index is waited for after the seek.
+        return m_decoder->pop( &m_buffer, &m_current_index, true );
+    }
     return this->grabFrame();
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Seeks the frame specified by the index, which is grabbed next.
+ *  @param  index [in] frame index
+ */
+/*===========================================================================*/
+void MovieObject::seekToFrame( const size_t index )
+{
+    if ( m_decoder ) { m_decoder->seek( kvs::Int64( index ) ); }
+    else { m_demuxer.seek( index ); }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns true if the current frame is the last frame.
+ *  @return true if the current frame is the last frame
+ */
+/*===========================================================================*/
+bool MovieObject::isLastFrame() const
+{
+    if ( m_decoder ) { return m_current_index == m_demuxer.numberOfFrames() - 1; }
+    return m_demuxer.isLastFrame();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the index of the current frame.
+ *  @return frame index
+ */
+/*===========================================================================*/
+kvs::Int64 MovieObject::currentFrameIndex() const
+{
+    if ( m_decoder ) { return m_current_index; }
+    return m_demuxer.currentFrameIndex();
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Grabs and retrieves the current frame.
@@ -51,6 +281,12 @@ bool MovieObject::jumpToFrame( const size_t index )
 /*===========================================================================*/
 bool MovieObject::grabFrame()
 {
+    if ( m_decoder )
+    {
+        // The current frame is kept if the next frame has not been decoded.
+        return m_decoder->pop( &m_buffer, &m_current_index, false );
+    }
+
     if ( m_demuxer.grab() )
     {
         auto frame = m_demuxer.retrieve();
@@ -74,14 +310,95 @@ bool MovieObject::grabFrame()
 /*===========================================================================*/
 bool MovieObject::read( const std::string& filename )
 {
+    m_decoder.reset();
     if ( m_demuxer.open( filename ) )
     {
-        return this->grabFrame();
+        // The top frame is grabbed before the decode-ahead is started.
+        const bool grabbed = this->grabFrame();
+        if ( m_enable_decode_ahead ) { this->setDecodeAheadEnabled( true ); }
+        return grabbed;
     }
 
     return false;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Sets the decode-ahead enabled.
+ *
+ *  The decoding of the frames following the current frame is started on the
+ *  background thread if the movie has been read. If the decode-ahead is
+ *  disabled, the decoded frames are discarded and the frame next to the
+ *  current frame is grabbed next.
+ *
+ *  @param  enable [in] if true, the decode-ahead is enabled
+ */
+/*===========================================================================*/
+void MovieObject::setDecodeAheadEnabled( const bool enable )
+{
+    m_enable_decode_ahead = enable;
+    if ( enable && !m_decoder && m_demuxer.formatContext().isOpened() )
+    {
+        m_current_index = m_demuxer.currentFrameIndex();
+        m_decoder = kvs::SharedPointer<Decoder>( new Decoder( m_demuxer, m_nbuffered_frames ) );
+    }
+    else if ( !enable && m_decoder )
+    {
+        m_decoder.reset();
+        m_demuxer.seek( int64_t( m_current_index + 1 ) );
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the number of frames in the ring buffer for the decode-ahead.
+ *  @param  nframes [in] number of frames
+ */
+/*===========================================================================*/
+void MovieObject::setNumberOfBufferedFrames( const size_t nframes )
+{
+    m_nbuffered_frames = nframes;
+    if ( m_decoder )
+    {
+        // The decode-ahead is restarted with the new ring buffer.
+        this->setDecodeAheadEnabled( false );
+        this->setDecodeAheadEnabled( true );
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of frames decoded by the decode-ahead.
+ *  @return number of frames
+ */
+/*===========================================================================*/
+size_t MovieObject::numberOfDecodedFrames() const
+{
+    return m_decoder ? m_decoder->numberOfDecodedFrames() : 0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of decoded frames discarded by seeking.
+ *  @return number of frames
+ */
+/*===========================================================================*/
+size_t MovieObject::numberOfDroppedFrames() const
+{
+    return m_decoder ? m_decoder->numberOfDroppedFrames() : 0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of grabs without the decoded frame.
+ *  @return number of grabs
+ */
+/*===========================================================================*/
+size_t MovieObject::numberOfMissedFrames() const
+{
+    return m_decoder ? m_decoder->numberOfMissedFrames() : 0;
+}
+
 } // end of namespace ffmpeg
 
 } // end of namespace kvs
@@ -10,6 +10,7 @@
 #include <kvs/Module>
 #include <kvs/ValueArray>
 #include <kvs/ColorImage>
+#include <kvs/SharedPointer>
 #include <SupportFFmpeg/Demuxer.h>
 
 
@@ -22,6 +23,13 @@ namespace ffmpeg
 /*===========================================================================*/
 /**
  *  @brief  Movie object class.
+ *
+ *  If the decode-ahead is enabled, the frames following the current frame
+ *  are decoded on the background thread into the ring buffer of the frames,
+ *  and grabFrame takes the decoded frame from the buffer without waiting for
+ *  the decoding. If no frame has been decoded yet, the current frame is kept
+ *  and counted as a missed frame. The decoded frames are discarded by seeking
+ *  and counted as dropped frames.
  */
 /*===========================================================================*/
 class MovieObject : public kvs::ObjectBase
@@ -33,8 +41,13 @@ public:
     using Buffer = kvs::ValueArray<kvs::UInt8>;
 
 private:
+    class Decoder;
     kvs::ffmpeg::Demuxer m_demuxer{}; ///< demuxer (decoder)
     Buffer m_buffer{}; ///< RGB buffer of current frame
+    kvs::Int64 m_current_index = 0; ///< index of current frame (for the decode-ahead)
+    bool m_enable_decode_ahead = false; ///< flag for the decode-ahead
+    size_t m_nbuffered_frames = 8; ///< number of frames in the ring buffer
+    kvs::SharedPointer<Decoder> m_decoder{}; ///< background decoder
 
 public:
     MovieObject() = default;
@@ -44,16 +57,26 @@ public:
     size_t numberOfFrames() const { return static_cast<size_t>( m_demuxer.numberOfFrames() ); }
     size_t width() const { return static_cast<size_t>( m_demuxer.decoder().width() ); }
     size_t height() const { return static_cast<size_t>( m_demuxer.decoder().height() ); }
-    bool isLastFrame() const { return m_demuxer.isLastFrame(); }
-    kvs::Int64 currentFrameIndex() const { return m_demuxer.currentFrameIndex(); }
+    bool isLastFrame() const;
+    kvs::Int64 currentFrameIndex() const;
     const Buffer& currentBuffer() const { return m_buffer; }
     const kvs::ColorImage currentImage() const;
 
     bool jumpToFrame( const size_t index );
     bool jumpToNextFrame() { return this->grabFrame(); }
-    void seekToFrame( const size_t index ) { m_demuxer.seek( index ); }
+    void seekToFrame( const size_t index );
     bool grabFrame();
     bool read( const std::string& filename );
+
+    bool isDecodeAheadEnabled() const { return m_enable_decode_ahead; }
+    void setDecodeAheadEnabled( const bool enable );
+    void enableDecodeAhead() { this->setDecodeAheadEnabled( true ); }
+    void disableDecodeAhead() { this->setDecodeAheadEnabled( false ); }
+    size_t numberOfBufferedFrames() const { return m_nbuffered_frames; }
+    void setNumberOfBufferedFrames( const size_t nframes );
+    size_t numberOfDecodedFrames() const;
+    size_t numberOfDroppedFrames() const;
+    size_t numberOfMissedFrames() const;
 };
 
 } // end of namespace ffmpeg
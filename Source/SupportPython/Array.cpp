@@ -24,65 +24,151 @@ template <> int Type<kvs::UInt64>() { return NPY_UINT64;  }
 template <> int Type<kvs::Real32>() { return NPY_FLOAT32; }
 template <> int Type<kvs::Real64>() { return NPY_FLOAT64; }
 
-template <typename IN, typename OUT>
-PyObject* Convert( const kvs::ValueArray<IN>& array )
+template <typename T>
+void Release( PyObject* capsule )
 {
-    const int ndim = 1;
-    npy_intp dims[1] = { (npy_intp)(array.size()) };
+    delete static_cast<kvs::SharedPointer<T>*>( PyCapsule_GetPointer( capsule, NULL ) );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Deleter of the values owned by the NumPy array.
+ */
+/*===========================================================================*/
+struct Releaser
+{
+    PyObject* object; ///< NumPy array
 
-    PyArrayObject* object = (PyArrayObject*)PyArray_SimpleNew( ndim, dims, Type<OUT>() );
-    for ( size_t i = 0; i < array.size(); i++ )
+    void operator () ( void* ) const
     {
-        *(OUT*)PyArray_GETPTR1( object, i ) = static_cast<OUT>( array[i] );
+        if ( !Py_IsInitialized() ) { return; }
+
+        // The values can be released in the thread without the GIL.
+        PyGILState_STATE state = PyGILState_Ensure();
+        Py_DECREF( object );
+        PyGILState_Release( state );
     }
+};
 
-    Py_XINCREF( object );
-    return PyArray_Return( object );
+/*===========================================================================*/
+/**
+ *  @brief  Returns the NumPy array sharing the values with the value array.
+ *  @param  array [in] value array
+ *  @param  dims [in] dimensions of the NumPy array
+ *  @return NumPy array
+ */
+/*===========================================================================*/
+template <typename T>
+PyObject* Convert( const kvs::ValueArray<T>& array, const std::vector<npy_intp>& dims )
+{
+    const int ndim = static_cast<int>( dims.size() );
+    npy_intp* shape = const_cast<npy_intp*>( dims.data() );
+    if ( array.empty() ) { return PyArray_SimpleNew( ndim, shape, Type<T>() ); }
+
+    // The capsule holding the shared pointer of the values is set as the base
+    // object, so that the values are alive while the NumPy array is referenced.
+    void* data = const_cast<T*>( array.data() );
+    PyObject* object = PyArray_SimpleNewFromData( ndim, shape, Type<T>(), data );
+    PyObject* capsule = PyCapsule_New( new kvs::SharedPointer<T>( array.sharedPointer() ), NULL, ::Release<T> );
+    PyArray_SetBaseObject( (PyArrayObject*)object, capsule );
+
+    return PyArray_Return( (PyArrayObject*)object );
 }
 
-template <typename IN>
-PyObject* Convert( const kvs::ValueArray<IN>& array )
+template <typename T>
+PyObject* Convert( const kvs::ValueArray<T>& array )
 {
-    using OUT = IN;
-    return Convert<IN,OUT>( array );
+    const std::vector<npy_intp> dims( 1, (npy_intp)( array.size() ) );
+    return ::Convert<T>( array, dims );
 }
 
-template <typename IN, typename OUT>
-kvs::ValueArray<OUT> Convert( const PyArrayObject* object )
+PyObject* Convert( const kvs::AnyValueArray& array, const std::vector<size_t>& shape )
 {
-    const size_t size = PyArray_DIMS( (PyArrayObject*)object )[0];
+    size_t size = 1;
+    std::vector<npy_intp> dims( shape.begin(), shape.end() );
+    for ( size_t i = 0; i < shape.size(); i++ ) { size *= shape[i]; }
+    if ( shape.empty() || size != array.size() )
+    {
+        kvsMessageError() << "Shape does not match the array size." << std::endl;
+        dims.assign( 1, (npy_intp)( array.size() ) );
+    }
 
-    kvs::ValueArray<OUT> array( size );
-    for ( size_t i = 0; i < size; i++ )
+    switch ( array.typeID() )
     {
-        array[i] = static_cast<OUT>( *(IN*)PyArray_GETPTR1( (PyArrayObject*)object, i ) );
+    case kvs::Type::TypeInt8:   return ::Convert( array.asValueArray<kvs::Int8>(), dims );
+    case kvs::Type::TypeInt16:  return ::Convert( array.asValueArray<kvs::Int16>(), dims );
+    case kvs::Type::TypeInt32:  return ::Convert( array.asValueArray<kvs::Int32>(), dims );
+    case kvs::Type::TypeInt64:  return ::Convert( array.asValueArray<kvs::Int64>(), dims );
+    case kvs::Type::TypeUInt8:  return ::Convert( array.asValueArray<kvs::UInt8>(), dims );
+    case kvs::Type::TypeUInt16: return ::Convert( array.asValueArray<kvs::UInt16>(), dims );
+    case kvs::Type::TypeUInt32: return ::Convert( array.asValueArray<kvs::UInt32>(), dims );
+    case kvs::Type::TypeUInt64: return ::Convert( array.asValueArray<kvs::UInt64>(), dims );
+    case kvs::Type::TypeReal32: return ::Convert( array.asValueArray<kvs::Real32>(), dims );
+    case kvs::Type::TypeReal64: return ::Convert( array.asValueArray<kvs::Real64>(), dims );
+    default:
+        kvsMessageError() << "Array type is not supported type." << std::endl;
+        break;
     }
 
-    return array;
+    npy_intp empty[1] = { 0 };
+    return PyArray_SimpleNew( 1, empty, NPY_FLOAT32 ); // empty array
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns the value array converted from the NumPy array.
+ *
+ *  The values of the NumPy array are read in the row-major (C) order. If
+ *  the NumPy array is the writable contiguous array of the output type, the
+ *  values are shared with the NumPy array without copying.
+ *
+ *  @param  array [in] NumPy array
+ *  @return value array
+ */
+/*===========================================================================*/
 template <typename OUT>
 kvs::ValueArray<OUT> Convert( const PyArrayObject* array )
 {
     const int type = PyArray_TYPE( array );
     switch ( type )
     {
-    case NPY_INT8:    { using IN = kvs::Int8;   return ::Convert<IN,OUT>( array ); }
-    case NPY_INT16:   { using IN = kvs::Int16;  return ::Convert<IN,OUT>( array ); }
-    case NPY_INT32:   { using IN = kvs::Int32;  return ::Convert<IN,OUT>( array ); }
-    case NPY_INT64:   { using IN = kvs::Int64;  return ::Convert<IN,OUT>( array ); }
-    case NPY_UINT8:   { using IN = kvs::UInt8;  return ::Convert<IN,OUT>( array ); }
-    case NPY_UINT16:  { using IN = kvs::UInt16; return ::Convert<IN,OUT>( array ); }
-    case NPY_UINT32:  { using IN = kvs::UInt32; return ::Convert<IN,OUT>( array ); }
-    case NPY_UINT64:  { using IN = kvs::UInt64; return ::Convert<IN,OUT>( array ); }
-    case NPY_FLOAT32: { using IN = kvs::Real32; return ::Convert<IN,OUT>( array ); }
-    case NPY_FLOAT64: { using IN = kvs::Real64; return ::Convert<IN,OUT>( array ); }
+    case NPY_INT8:
+    case NPY_INT16:
+    case NPY_INT32:
+    case NPY_INT64:
+    case NPY_UINT8:
+    case NPY_UINT16:
+    case NPY_UINT32:
+    case NPY_UINT64:
+    case NPY_FLOAT32:
+    case NPY_FLOAT64:
+        break;
     default:
         kvsMessageError() << "PyArray type is not supported type." << std::endl;
-        break;
+        return kvs::ValueArray<OUT>(); // empty array
     }
 
-    return kvs::ValueArray<OUT>(); // empty table
+    // NumPy returns the input array itself if the array has already been the
+    // contiguous array of the output type, otherwise the converted copy.
+    const int flags = NPY_ARRAY_CARRAY_RO | NPY_ARRAY_FORCECAST;
+    PyArrayObject* object = (PyArrayObject*)PyArray_FROMANY( (PyObject*)array, Type<OUT>(), 0, 0, flags );
+    if ( !object )
+    {
+        PyErr_Clear();
+        kvsMessageError() << "Cannot convert PyArray." << std::endl;
+        return kvs::ValueArray<OUT>(); // empty array
+    }
+
+    const size_t size = static_cast<size_t>( PyArray_SIZE( object ) );
+    OUT* data = static_cast<OUT*>( PyArray_DATA( object ) );
+    if ( size == 0 || !PyArray_ISWRITEABLE( object ) )
+    {
+        const kvs::ValueArray<OUT> values( data, size );
+        Py_DECREF( object );
+        return values;
+    }
+
+    return kvs::ValueArray<OUT>( kvs::SharedPointer<OUT>( data, ::Releaser{ (PyObject*)object } ), size );
 }
 
 } // end of namespace
@@ -151,11 +237,24 @@ Array::Array( const kvs::ValueArray<kvs::Real64>& array ):
 {
 }
 
+Array::Array( const kvs::AnyValueArray& array, const std::vector<size_t>& shape ):
+    kvs::python::Object( ::Convert( array, shape ) )
+{
+}
+
 Array::Array( const kvs::python::Object& value ):
     kvs::python::Object( value )
 {
 }
 
+std::vector<size_t> Array::shape() const
+{
+    const auto* array = (const PyArrayObject*)get();
+    const int ndim = PyArray_NDIM( array );
+    const npy_intp* dims = PyArray_DIMS( (PyArrayObject*)array );
+    return std::vector<size_t>( dims, dims + ndim );
+}
+
 Array::operator kvs::ValueArray<kvs::Int8>() const
 {
     const auto* array = (const PyArrayObject*)get();
@@ -286,6 +385,32 @@ Array::operator kvs::ValueArray<kvs::Real64>() const
     return ::Convert<kvs::Real64>( array );
 }
 
+Array::operator kvs::AnyValueArray() const
+{
+    // The values of the multi-dimensional array are flattened in the
+    // row-major (C) order with the type of the NumPy array.
+    const auto* array = (const PyArrayObject*)get();
+    const int type = PyArray_TYPE( array );
+    switch ( type )
+    {
+    case NPY_INT8:    return kvs::AnyValueArray( ::Convert<kvs::Int8>( array ) );
+    case NPY_INT16:   return kvs::AnyValueArray( ::Convert<kvs::Int16>( array ) );
+    case NPY_INT32:   return kvs::AnyValueArray( ::Convert<kvs::Int32>( array ) );
+    case NPY_INT64:   return kvs::AnyValueArray( ::Convert<kvs::Int64>( array ) );
+    case NPY_UINT8:   return kvs::AnyValueArray( ::Convert<kvs::UInt8>( array ) );
+    case NPY_UINT16:  return kvs::AnyValueArray( ::Convert<kvs::UInt16>( array ) );
+    case NPY_UINT32:  return kvs::AnyValueArray( ::Convert<kvs::UInt32>( array ) );
+    case NPY_UINT64:  return kvs::AnyValueArray( ::Convert<kvs::UInt64>( array ) );
+    case NPY_FLOAT32: return kvs::AnyValueArray( ::Convert<kvs::Real32>( array ) );
+    case NPY_FLOAT64: return kvs::AnyValueArray( ::Convert<kvs::Real64>( array ) );
+    default:
+        kvsMessageError() << "PyArray type is not supported type." << std::endl;
+        break;
+    }
+
+    return kvs::AnyValueArray(); // empty array
+}
+
 } // end of namespace python
 
 } // end of namespace kvs
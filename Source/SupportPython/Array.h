@@ -6,7 +6,9 @@
 /*****************************************************************************/
 #pragma once
 #include "Object.h"
+#include <vector>
 #include <kvs/ValueArray>
+#include <kvs/AnyValueArray>
 #include <kvs/Type>
 
 
@@ -16,6 +18,18 @@ namespace kvs
 namespace python
 {
 
+/*===========================================================================*/
+/**
+ *  @brief  NumPy array class.
+ *
+ *  The values are shared between the value array and the NumPy array
+ *  without copying. The NumPy array created from the value array holds the
+ *  shared pointer of the values, and the value array converted from the
+ *  contiguous NumPy array of the same type holds the reference to the NumPy
+ *  array. The values are copied only if the type or the memory layout is
+ *  different, or if the NumPy array is read-only.
+ */
+/*===========================================================================*/
 class Array : public kvs::python::Object
 {
 public:
@@ -32,8 +46,11 @@ public:
     Array( const kvs::ValueArray<kvs::UInt64>& array );
     Array( const kvs::ValueArray<kvs::Real32>& array );
     Array( const kvs::ValueArray<kvs::Real64>& array );
+    Array( const kvs::AnyValueArray& array, const std::vector<size_t>& shape );
     Array( const kvs::python::Object& array );
 
+    std::vector<size_t> shape() const;
+
     operator kvs::ValueArray<kvs::Int8>() const;
     operator kvs::ValueArray<kvs::Int16>() const;
     operator kvs::ValueArray<kvs::Int32>() const;
@@ -44,6 +61,7 @@ public:
     operator kvs::ValueArray<kvs::UInt64>() const;
     operator kvs::ValueArray<kvs::Real32>() const;
     operator kvs::ValueArray<kvs::Real64>() const;
+    operator kvs::AnyValueArray() const;
 };
 
 } // end of namespace python
@@ -17,6 +17,7 @@ $(OUTDIR)/./Python.o \
 $(OUTDIR)/./String.o \
 $(OUTDIR)/./Table.o \
 $(OUTDIR)/./Tuple.o \
+$(OUTDIR)/./Volume.o \
 
 
 
@@ -17,6 +17,7 @@ $(OUTDIR)\.\Python.obj \
 $(OUTDIR)\.\String.obj \
 $(OUTDIR)\.\Table.obj \
 $(OUTDIR)\.\Tuple.obj \
+$(OUTDIR)\.\Volume.obj \
 
 
 
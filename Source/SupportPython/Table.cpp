@@ -6,6 +6,7 @@
 /*****************************************************************************/
 #include "Table.h"
 #include "NumPy.h"
+#include <cstring>
 #include <kvs/Message>
 
 
@@ -18,72 +19,109 @@ template <> int Type<kvs::Int64>() { return NPY_INT64; }
 template <> int Type<kvs::Real32>() { return NPY_FLOAT32; }
 template <> int Type<kvs::Real64>() { return NPY_FLOAT64; }
 
-template <typename IN, typename OUT>
-PyObject* Convert( const kvs::ValueTable<IN>& table )
+/*===========================================================================*/
+/**
+ *  @brief  Deleter of the values owned by the NumPy array.
+ */
+/*===========================================================================*/
+struct Releaser
 {
-    const int ndim = 2;
-    const int nrows = table.rowSize();
-    const int ncols = table.columnSize();
-    npy_intp dims[2] = { nrows, ncols };
+    PyObject* object; ///< NumPy array
 
-    // array: row-major 2D array
-    // table: column-major table
-    PyArrayObject* array = (PyArrayObject*)PyArray_SimpleNew( ndim, dims, Type<OUT>() );
-    for ( int j = 0; j < nrows; ++j )
+    void operator () ( void* ) const
     {
-        for ( int i = 0; i < ncols; ++i )
-        {
-            *(OUT*)PyArray_GETPTR2( array, j, i ) = static_cast<OUT>( table[i][j] );
-        }
-    }
-
-    Py_XINCREF( array );
-    return PyArray_Return( array );
-}
+        if ( !Py_IsInitialized() ) { return; }
 
-template <typename IN>
-PyObject* Convert( const kvs::ValueTable<IN>& table )
-{
-    using OUT = IN;
-    return ::Convert<IN,OUT>( table );
-}
+        // The values can be released in the thread without the GIL.
+        PyGILState_STATE state = PyGILState_Ensure();
+        Py_DECREF( object );
+        PyGILState_Release( state );
+    }
+};
 
-template <typename IN, typename OUT>
-kvs::ValueTable<OUT> Convert( const PyArrayObject* array )
+template <typename T>
+PyObject* Convert( const kvs::ValueTable<T>& table )
 {
-    const int nrows = PyArray_DIMS( (PyArrayObject*)array )[0];
-    const int ncols = PyArray_DIMS( (PyArrayObject*)array )[1];
+    const int ndim = 2;
+    const size_t nrows = table.rowSize();
+    const size_t ncols = table.columnSize();
+    npy_intp dims[2] = { (npy_intp)( nrows ), (npy_intp)( ncols ) };
 
-    // array: row-major 2D array
+    // array: column-major (Fortran) 2D array
     // table: column-major table
-    kvs::ValueTable<OUT> table( nrows, ncols );
-    for ( int j = 0; j < nrows; ++j )
+    const int fortran = 1;
+    PyArrayObject* array = (PyArrayObject*)PyArray_EMPTY( ndim, dims, Type<T>(), fortran );
+    T* data = static_cast<T*>( PyArray_DATA( array ) );
+    for ( size_t i = 0; nrows > 0 && i < ncols; ++i )
     {
-        for ( int i = 0; i < ncols; i++ )
-        {
-            table[i][j] = static_cast<OUT>( *(IN*)PyArray_GETPTR2( (PyArrayObject*)array, j, i ) );
-        }
+        std::memcpy( data + i * nrows, table[i].data(), sizeof( T ) * nrows );
     }
 
-    return table;
+    return PyArray_Return( array );
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns the table converted from the 2D NumPy array.
+ *
+ *  If the NumPy array is the writable column-major (Fortran) array of the
+ *  output type, each column of the table shares the values with the NumPy
+ *  array without copying.
+ *
+ *  @param  array [in] NumPy array
+ *  @return table
+ */
+/*===========================================================================*/
 template <typename OUT>
 kvs::ValueTable<OUT> Convert( const PyArrayObject* array )
 {
     const int type = PyArray_TYPE( array );
     switch ( type )
     {
-    case NPY_INT32:   { using IN = kvs::Int32;  return ::Convert<IN,OUT>( array ); }
-    case NPY_INT64:   { using IN = kvs::Int64;  return ::Convert<IN,OUT>( array ); }
-    case NPY_FLOAT32: { using IN = kvs::Real32; return ::Convert<IN,OUT>( array ); }
-    case NPY_FLOAT64: { using IN = kvs::Real64; return ::Convert<IN,OUT>( array ); }
+    case NPY_INT32:
+    case NPY_INT64:
+    case NPY_FLOAT32:
+    case NPY_FLOAT64:
+        break;
     default:
         kvsMessageError() << "PyArray type is not supported type." << std::endl;
-        break;
+        return kvs::ValueTable<OUT>(); // empty table
     }
 
-    return kvs::ValueTable<OUT>(); // empty table
+    // NumPy returns the input array itself if the array has already been the
+    // column-major array of the output type, otherwise the converted copy.
+    const int flags = NPY_ARRAY_FARRAY_RO | NPY_ARRAY_FORCECAST;
+    PyArrayObject* object = (PyArrayObject*)PyArray_FROMANY( (PyObject*)array, Type<OUT>(), 2, 2, flags );
+    if ( !object )
+    {
+        PyErr_Clear();
+        kvsMessageError() << "Cannot convert PyArray." << std::endl;
+        return kvs::ValueTable<OUT>(); // empty table
+    }
+
+    const size_t nrows = PyArray_DIMS( object )[0];
+    const size_t ncols = PyArray_DIMS( object )[1];
+    OUT* data = static_cast<OUT*>( PyArray_DATA( object ) );
+    if ( nrows * ncols == 0 || !PyArray_ISWRITEABLE( object ) )
+    {
+        kvs::ValueTable<OUT> table( nrows, ncols );
+        for ( size_t i = 0; nrows > 0 && i < ncols; ++i )
+        {
+            std::memcpy( table[i].data(), data + i * nrows, sizeof( OUT ) * nrows );
+        }
+        Py_DECREF( object );
+        return table;
+    }
+
+    const kvs::SharedPointer<OUT> values( data, ::Releaser{ (PyObject*)object } );
+    kvs::ValueTable<OUT> table( ncols );
+    for ( size_t i = 0; i < ncols; ++i )
+    {
+        const kvs::SharedPointer<OUT> column( values, data + i * nrows );
+        table[i] = kvs::ValueArray<OUT>( column, nrows );
+    }
+
+    return table;
 }
 
 } // end of namespace
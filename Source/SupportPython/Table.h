@@ -16,6 +16,16 @@ namespace kvs
 namespace python
 {
 
+/*===========================================================================*/
+/**
+ *  @brief  NumPy 2D array class for the value table.
+ *
+ *  The table with the columns is exchanged as the NumPy array with the shape
+ *  (nrows, ncolumns) in the column-major (Fortran) order. The table converted
+ *  from the column-major NumPy array of the same type shares the values
+ *  without copying, and the other arrays are copied.
+ */
+/*===========================================================================*/
 class Table : public kvs::python::Object
 {
 public:
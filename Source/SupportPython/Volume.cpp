@@ -0,0 +1,93 @@
+/*****************************************************************************/
+/**
+ *  @file   Volume.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "Volume.h"
+#include "Array.h"
+#include "NumPy.h"
+#include <vector>
+#include <kvs/Message>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the shape of the NumPy array for the volume.
+ *  @param  volume [in] structured volume object
+ *  @return shape (nz, ny, nx) or (nz, ny, nx, veclen)
+ */
+/*===========================================================================*/
+std::vector<size_t> Shape( const kvs::StructuredVolumeObject& volume )
+{
+    const kvs::Vec3ui resolution = volume.resolution();
+    std::vector<size_t> shape = { resolution.z(), resolution.y(), resolution.x() };
+    if ( volume.veclen() > 1 ) { shape.push_back( volume.veclen() ); }
+    return shape;
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+namespace python
+{
+
+bool Volume::Check( const kvs::python::Object& object )
+{
+    return
+        PyArray_Check( (const PyArrayObject*)object.get() ) &&
+        ( PyArray_NDIM( (const PyArrayObject*)object.get() ) == 3 ||
+          PyArray_NDIM( (const PyArrayObject*)object.get() ) == 4 );
+}
+
+Volume::Volume( const kvs::StructuredVolumeObject& volume ):
+    kvs::python::Object( kvs::python::Array( volume.values(), ::Shape( volume ) ) )
+{
+}
+
+Volume::Volume( const kvs::python::Object& value ):
+    kvs::python::Object( value )
+{
+}
+
+kvs::Vec3ui Volume::resolution() const
+{
+    const std::vector<size_t> shape = kvs::python::Array( *this ).shape();
+    if ( shape.size() < 3 )
+    {
+        kvsMessageError() << "PyArray is not volume." << std::endl;
+        return kvs::Vec3ui::Zero();
+    }
+
+    return kvs::Vec3ui(
+        static_cast<kvs::UInt32>( shape[2] ),
+        static_cast<kvs::UInt32>( shape[1] ),
+        static_cast<kvs::UInt32>( shape[0] ) );
+}
+
+size_t Volume::veclen() const
+{
+    const std::vector<size_t> shape = kvs::python::Array( *this ).shape();
+    return shape.size() > 3 ? shape[3] : 1;
+}
+
+Volume::operator kvs::AnyValueArray() const
+{
+    if ( !Volume::Check( *this ) )
+    {
+        kvsMessageError() << "PyArray is not volume." << std::endl;
+        return kvs::AnyValueArray(); // empty array
+    }
+
+    return kvs::python::Array( *this );
+}
+
+} // end of namespace python
+
+} // end of namespace kvs
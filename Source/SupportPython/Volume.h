@@ -0,0 +1,47 @@
+/*****************************************************************************/
+/**
+ *  @file   Volume.h
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#pragma once
+#include "Object.h"
+#include <kvs/StructuredVolumeObject>
+#include <kvs/AnyValueArray>
+#include <kvs/Vector3>
+
+
+namespace kvs
+{
+
+namespace python
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  NumPy array class for the values of the structured volume.
+ *
+ *  The values of the volume with the resolution (nx, ny, nz) are exchanged
+ *  as the NumPy array with the shape (nz, ny, nx) for the scalar volume and
+ *  (nz, ny, nx, veclen) for the vector volume, which share the values
+ *  without copying in the same manner as kvs::python::Array.
+ */
+/*===========================================================================*/
+class Volume : public kvs::python::Object
+{
+public:
+    static bool Check( const kvs::python::Object& object );
+
+public:
+    Volume( const kvs::StructuredVolumeObject& volume );
+    Volume( const kvs::python::Object& volume );
+
+    kvs::Vec3ui resolution() const;
+    size_t veclen() const;
+
+    operator kvs::AnyValueArray() const;
+};
+
+} // end of namespace python
+
+} // end of namespace kvs